@@ -41,6 +41,8 @@ public:
 		  annotations({ 0 }) {
 	};
 
+	ARENA_ALLOCATED(AnnotatedAstNode)
+
 	inline ~AnnotatedAstNode() {
 		AnnotatedAstNode* current_node = child;
 		while (current_node != NULL) {
@@ -83,7 +85,7 @@ public:
 		return sibling;
 	};
 
-	inline AnnotatedAstNode* get_parent() {
+	inline AnnotatedAstNode* get_parent() const {
 		return parent;
 	}
 
@@ -128,7 +130,7 @@ public:
 		return symtab;
 	}
 
-	inline const Token* get_terminal() const
+	inline const TokenRef* get_terminal() const
 	{
 		return ast_node->get_terminal();
 	}
@@ -188,7 +190,8 @@ public:
 
 	inline void print(
 	    string const& parent_prefix = "",
-		string const& child_prefix  = "")
+		string const& child_prefix  = "",
+		ostream     & out           = cout)
 	{
 		const int name_i         
 			= (int) ast_node->get_name();
@@ -198,24 +201,25 @@ public:
 			= ast_form_string_reprs[name_i];
 		const char* const alt_s  
 			= ast_node_alt_string_reprs[alt_i];
-		cout << parent_prefix
+		out << parent_prefix
 			<< "name="
 			<< name_s
 			<< ",alt="
 			<< alt_s;
 		if (get_is_constant_evaluation()) {
-			cout << ", constant_value="
-				 << get_constant_val();
+			out << ", constant_value="
+				<< get_constant_val();
 		}
 		if (annotations.type != NULL) {
-			cout << ",type=";
-			print_type(annotations.type);
+			out << ",type=";
+			print_type(annotations.type, out);
 		}
-		cout << endl;
+		out << endl;
 
 		if (annotations.symbol_table) {
 			annotations.symbol_table->print(
-				child_prefix);
+				child_prefix,
+				out);
 		}
 
 		for (AnnotatedAstNode* node = child;
@@ -231,7 +235,8 @@ public:
 					  + "|    ";
 				node->print(
 					appended_p, 
-					appended_c);
+					appended_c,
+					out);
 			} else {
 				string appended_p 
 					= child_prefix 
@@ -241,7 +246,8 @@ public:
 					  + "     ";
 				node->print(
 					appended_p, 
-					appended_c);
+					appended_c,
+					out);
 			}
 		}
 	}
@@ -0,0 +1,267 @@
+/* Authored by Charlie Keaney                */
+/* arena.h - Responsible for allocating the
+			 data structures of a compilation
+			 from large chunks, all freed at
+			 once when the compilation ends.
+
+			 Implementation Notes:
+			 Allocation bumps a pointer
+			 through the current chunk. A
+			 chunk is never freed on its
+			 own, so deleting an object from
+			 an arena only runs its
+			 destructor. Releasing the arena
+			 frees every chunk together and
+			 runs no destructors at all, so
+			 trees need not be walked.
+			 Resetting frees all but the
+			 newest chunk and allocates from
+			 it again, so that an arena used
+			 as scratch space stays the size
+			 of its largest use.
+
+			 Classes opt in with
+			 ARENA_ALLOCATED, which sends
+			 their new to the arena active
+			 on the calling thread, or to
+			 the heap when there is none.
+			 The byte before each object
+			 records which, so that delete
+			 frees only heap objects without
+			 searching the arena's chunks,
+			 whether or not an arena is
+			 active when it runs. The byte
+			 takes a whole alignment of the
+			 object's type in front of it.  */
+
+#ifndef ARENA_H
+#define ARENA_H 1
+
+#include <cstddef>
+#include <new>
+
+#define ARENA_INITIAL_CHUNK_SZ (64 * 1024)
+#define ARENA_MAX_CHUNK_SZ     (4 * 1024 * 1024)
+
+/* Routes a class' new and delete through the active arena. */
+#define ARENA_ALLOCATED(T)                              \
+	static inline void* operator new(                   \
+		size_t size)                                    \
+	{                                                   \
+		return allocate_from_active_arena(              \
+			size,                                       \
+			alignof(T));                                \
+	}                                                   \
+	static inline void operator delete(                 \
+		void* ptr)                                      \
+	{                                                   \
+		free_to_active_arena(ptr);                      \
+	}
+
+using namespace std;
+
+/*****************************************************//**
+*                      Declarations                      *
+/********************************************************/
+
+struct ArenaChunk {
+	ArenaChunk* previous;
+	char*       begin;
+	char*       end;
+};
+
+class Arena {
+private:
+	ArenaChunk* chunks;
+	char*       next;
+	char*       end;
+	size_t      chunk_size;
+	size_t      bytes_used;
+
+	/**
+	* Starts a new chunk large enough for the given
+	* allocation.
+	**/
+	inline void grow(
+		size_t const& size,
+		size_t const& alignment)
+	{
+		size_t capacity = chunk_size;
+		if (capacity < size + alignment) {
+			capacity = size + alignment;
+		}
+		char* const block
+			= (char*) ::operator new(sizeof(ArenaChunk) + capacity);
+		ArenaChunk* const chunk
+			= (ArenaChunk*) block;
+		chunk->previous = chunks;
+		chunk->begin    = block + sizeof(ArenaChunk);
+		chunk->end      = chunk->begin + capacity;
+		chunks = chunk;
+		next   = chunk->begin;
+		end    = chunk->end;
+		if (chunk_size < ARENA_MAX_CHUNK_SZ) {
+			chunk_size *= 2;
+		}
+	}
+
+public:
+	inline Arena()
+		: chunks(NULL),
+		  next(NULL),
+		  end(NULL),
+		  chunk_size(ARENA_INITIAL_CHUNK_SZ),
+		  bytes_used(0) {
+	};
+
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+
+	inline ~Arena() {
+		release();
+	};
+
+	/**
+	* Allocates memory which lasts until the arena is
+	* released.
+	*
+	* @param size The number of bytes to allocate.
+	* @param alignment The alignment the memory needs, a power of two.
+	* @return Returns the allocated memory.
+	**/
+	inline void* allocate(
+		size_t const& size,
+		size_t const& alignment)
+	{
+		char* aligned
+			= (char*) (((size_t) next + alignment - 1)
+					   & ~(alignment - 1));
+		if (next == NULL
+			|| aligned + size > end) {
+			grow(size, alignment);
+			aligned
+				= (char*) (((size_t) next + alignment - 1)
+						   & ~(alignment - 1));
+		}
+		next = aligned + size;
+		bytes_used += size;
+		return aligned;
+	}
+
+
+	inline size_t get_bytes_used() const
+	{
+		return bytes_used;
+	}
+
+	/**
+	* Frees everything allocated so far, keeping the
+	* newest, largest chunk to allocate from again. As
+	* with release, nothing allocated before may be
+	* used afterwards.
+	**/
+	inline void reset()
+	{
+		if (chunks == NULL) {
+			return;
+		}
+		while (chunks->previous != NULL) {
+			ArenaChunk* const previous
+				= chunks->previous->previous;
+			::operator delete(chunks->previous);
+			chunks->previous = previous;
+		}
+		next       = chunks->begin;
+		end        = chunks->end;
+		bytes_used = 0;
+	}
+
+	/**
+	* Frees every chunk at once. Nothing allocated from
+	* the arena may be used afterwards.
+	**/
+	inline void release()
+	{
+		while (chunks != NULL) {
+			ArenaChunk* const previous
+				= chunks->previous;
+			::operator delete(chunks);
+			chunks = previous;
+		}
+		next       = NULL;
+		end        = NULL;
+		chunk_size = ARENA_INITIAL_CHUNK_SZ;
+		bytes_used = 0;
+	}
+};
+
+/* The arena objects are made in on this thread, or
+   NULL if they are to be allocated individually.   */
+static thread_local
+Arena* active_arena = NULL;
+
+/**
+* Allocates from the active arena, or from the heap
+* if there is none, recording which in the byte
+* before the memory returned.
+*
+* @param size The number of bytes to allocate.
+* @param alignment The alignment the memory needs, a
+*		 power of two no greater than that of
+*		 max_align_t.
+* @return Returns the allocated memory.
+**/
+static inline
+void* allocate_from_active_arena(
+	size_t const& size,
+	size_t const& alignment);
+
+/**
+* Frees memory from allocate_from_active_arena. Memory
+* from an arena is left for the arena to free.
+*
+* @param ptr The memory to free.
+**/
+static inline
+void free_to_active_arena(
+	void* const& ptr);
+
+/*****************************************************//**
+*                         Definitions                    *
+/********************************************************/
+
+static inline
+void* allocate_from_active_arena(
+	size_t const& size,
+	size_t const& alignment)
+{
+	/* The tag is the distance back to the start of a
+	   heap block, or 0 for memory from an arena.    */
+	unsigned char* block;
+	if (active_arena != NULL) {
+		block = (unsigned char*) active_arena->allocate(
+			size + alignment,
+			alignment);
+		block[alignment - 1] = 0;
+	} else {
+		block = (unsigned char*) ::operator new(size + alignment);
+		block[alignment - 1] = (unsigned char) alignment;
+	}
+	return block + alignment;
+}
+
+static inline
+void free_to_active_arena(
+	void* const& ptr)
+{
+	if (ptr == NULL) {
+		return;
+	}
+	const unsigned char offset
+		= ((const unsigned char*) ptr)[-1];
+	if (offset != 0) {
+		::operator delete((unsigned char*) ptr - offset);
+	}
+}
+
+#endif
@@ -0,0 +1,532 @@
+/* Authored by Charlie Keaney                     */
+/* asm-writer.h - Responsible for writing assembly
+				  out quickly, formatting it into
+				  one large buffer rather than a
+				  stream.
+
+				  Implementation Notes:
+				  A writer sends its buffer to
+				  one of three places: an
+				  ostream, written in large
+				  blocks; a file, written with
+				  a few calls to write(2); or a
+				  file mapped into memory, which
+				  is formatted into directly and
+				  grown as it fills.
+
+				  Integers are formatted by hand
+				  rather than through iostream
+				  manipulators. Without POSIX,
+				  files are written with stdio
+				  and mapping is not used.     */
+
+#ifndef ASM_WRITER_H
+#define ASM_WRITER_H 1
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#if defined(_WIN32)
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#define ASM_WRITER_BUFFER_SZ       (1 << 20)
+#define ASM_WRITER_INITIAL_MAP_SZ  (1 << 20)
+
+using namespace std;
+
+/*****************************************************//**
+*                      Declarations                      *
+/********************************************************/
+
+enum class AsmWriterExitCode {
+	SUCCESS,
+	FAILURE
+};
+
+enum class AsmWriterSink {
+	STREAM,
+	FILE_DESCRIPTOR,
+	MAPPED_FILE
+};
+
+struct AsmWriter {
+	AsmWriterSink sink;
+	char*         buffer;
+	size_t        size;
+	size_t        capacity;
+	ostream*      out;
+	int           fd;
+	FILE*         file;
+	bool          failed;
+};
+
+/**
+* Opens a writer which writes to a stream.
+*
+* @param out The stream to write to.
+* @param writer The writer to open.
+**/
+static inline
+void open_asm_writer(
+	ostream  & out,
+	AsmWriter& writer);
+
+/**
+* Opens a writer which writes to a file, creating or
+* truncating it.
+*
+* @param filename The path of the file to write.
+* @param mapped Whether to write into the file mapped into memory.
+* @param writer The writer to open.
+* @return Returns an exitcode for success or failure.
+**/
+static inline
+AsmWriterExitCode open_asm_writer(
+	const char* const& filename,
+	bool        const& mapped,
+	AsmWriter        & writer);
+
+/**
+* Writes out everything buffered and releases the
+* writer.
+*
+* @param writer The writer to close.
+* @return Returns FAILURE if any write went wrong.
+**/
+static inline
+AsmWriterExitCode close_asm_writer(
+	AsmWriter& writer);
+
+/**
+* Makes room in the buffer for the given number of
+* bytes, writing out or growing as needed.
+*
+* @param writer The writer to make room in.
+* @param n The number of bytes needed.
+* @return Returns false if no room could be made.
+**/
+static inline
+bool reserve_asm_writer(
+	AsmWriter     & writer,
+	size_t   const& n);
+
+static inline
+void write_asm_chars(
+	AsmWriter        & writer,
+	const char* const& chars,
+	size_t      const& n);
+
+static inline
+void write_asm_char(
+	AsmWriter  & writer,
+	char  const& c);
+
+static inline
+void write_asm_string(
+	AsmWriter        & writer,
+	const char* const& str);
+
+/**
+* Writes a string, padded with spaces on the right to
+* at least the given width.
+**/
+static inline
+void write_asm_padded_string(
+	AsmWriter        & writer,
+	const char* const& str,
+	size_t      const& width);
+
+static inline
+void write_asm_unsigned(
+	AsmWriter     & writer,
+	uint64_t const& val);
+
+static inline
+void write_asm_signed(
+	AsmWriter    & writer,
+	int64_t const& val);
+
+/**
+* Writes a number in lower case hexadecimal, padded
+* with zeroes on the left to at least the given width.
+**/
+static inline
+void write_asm_hex(
+	AsmWriter     & writer,
+	uint64_t const& val,
+	size_t   const& width);
+
+/*****************************************************//**
+*                         Definitions                    *
+/********************************************************/
+
+static inline
+void open_asm_writer(
+	ostream  & out,
+	AsmWriter& writer)
+{
+	writer = AsmWriter({
+		AsmWriterSink::STREAM,
+		new char[ASM_WRITER_BUFFER_SZ],
+		0,
+		ASM_WRITER_BUFFER_SZ,
+		&out,
+		-1,
+		NULL,
+		false });
+}
+
+#if defined(_WIN32)
+
+static inline
+AsmWriterExitCode open_asm_writer(
+	const char* const& filename,
+	bool        const& mapped,
+	AsmWriter        & writer)
+{
+	writer = AsmWriter({
+		AsmWriterSink::FILE_DESCRIPTOR,
+		NULL,
+		0,
+		0,
+		NULL,
+		-1,
+		NULL,
+		false });
+	if (fopen_s(&writer.file, filename, "wb") != 0
+		|| writer.file == NULL) {
+		return AsmWriterExitCode::FAILURE;
+	}
+	writer.buffer   = new char[ASM_WRITER_BUFFER_SZ];
+	writer.capacity = ASM_WRITER_BUFFER_SZ;
+	return AsmWriterExitCode::SUCCESS;
+}
+
+/**
+* Writes the whole buffer out, leaving it empty.
+**/
+static inline
+void flush_asm_writer(
+	AsmWriter& writer)
+{
+	if (writer.sink == AsmWriterSink::STREAM) {
+		writer.out->write(writer.buffer, writer.size);
+	} else if (fwrite(writer.buffer, 1, writer.size, writer.file)
+			   != writer.size) {
+		writer.failed = true;
+	}
+	writer.size = 0;
+}
+
+static inline
+bool reserve_asm_writer(
+	AsmWriter     & writer,
+	size_t   const& n)
+{
+	if (writer.size + n <= writer.capacity) {
+		return true;
+	}
+	flush_asm_writer(writer);
+	return n <= writer.capacity;
+}
+
+static inline
+AsmWriterExitCode close_asm_writer(
+	AsmWriter& writer)
+{
+	flush_asm_writer(writer);
+	if (writer.file != NULL
+		&& fclose(writer.file) != 0) {
+		writer.failed = true;
+	}
+	delete[] writer.buffer;
+	writer.buffer = NULL;
+	return writer.failed
+		   ? AsmWriterExitCode::FAILURE
+		   : AsmWriterExitCode::SUCCESS;
+}
+
+#else
+
+static inline
+AsmWriterExitCode open_asm_writer(
+	const char* const& filename,
+	bool        const& mapped,
+	AsmWriter        & writer)
+{
+	writer = AsmWriter({
+		AsmWriterSink::FILE_DESCRIPTOR,
+		NULL,
+		0,
+		0,
+		NULL,
+		-1,
+		NULL,
+		false });
+	writer.fd = open(
+		filename,
+		(mapped ? O_RDWR : O_WRONLY) | O_CREAT | O_TRUNC,
+		0644);
+	if (writer.fd < 0) {
+		return AsmWriterExitCode::FAILURE;
+	}
+	if (mapped) {
+		void* mapping = MAP_FAILED;
+		if (ftruncate(writer.fd, ASM_WRITER_INITIAL_MAP_SZ) == 0) {
+			mapping = mmap(
+				NULL,
+				ASM_WRITER_INITIAL_MAP_SZ,
+				PROT_READ | PROT_WRITE,
+				MAP_SHARED,
+				writer.fd,
+				0);
+		}
+		if (mapping != MAP_FAILED) {
+			writer.sink     = AsmWriterSink::MAPPED_FILE;
+			writer.buffer   = (char*) mapping;
+			writer.capacity = ASM_WRITER_INITIAL_MAP_SZ;
+			return AsmWriterExitCode::SUCCESS;
+		}
+		/* Fall back on writing, the file is still open. */
+	}
+	writer.buffer   = new char[ASM_WRITER_BUFFER_SZ];
+	writer.capacity = ASM_WRITER_BUFFER_SZ;
+	return AsmWriterExitCode::SUCCESS;
+}
+
+/**
+* Writes the whole buffer out, leaving it empty. A
+* mapped file has nothing to write.
+**/
+static inline
+void flush_asm_writer(
+	AsmWriter& writer)
+{
+	switch (writer.sink) {
+
+		case AsmWriterSink::STREAM:
+			writer.out->write(writer.buffer, writer.size);
+			writer.size = 0;
+			break;
+
+		case AsmWriterSink::FILE_DESCRIPTOR:
+		{
+			size_t written = 0;
+			while (written < writer.size) {
+				const ssize_t n = write(
+					writer.fd,
+					writer.buffer + written,
+					writer.size - written);
+				if (n < 0 && errno == EINTR) {
+					continue;
+				}
+				if (n <= 0) {
+					writer.failed = true;
+					break;
+				}
+				written += n;
+			}
+			writer.size = 0;
+			break;
+		}
+
+		default:
+			break;
+	}
+}
+
+/**
+* Doubles the size of a mapped file and maps it again.
+**/
+static inline
+bool grow_mapped_asm_writer(
+	AsmWriter     & writer,
+	size_t   const& n)
+{
+	size_t capacity = 2 * writer.capacity;
+	while (capacity < writer.size + n) {
+		capacity *= 2;
+	}
+	munmap(writer.buffer, writer.capacity);
+	writer.buffer = NULL;
+	if (ftruncate(writer.fd, capacity) != 0) {
+		writer.failed = true;
+		return false;
+	}
+	void* mapping = mmap(
+		NULL,
+		capacity,
+		PROT_READ | PROT_WRITE,
+		MAP_SHARED,
+		writer.fd,
+		0);
+	if (mapping == MAP_FAILED) {
+		writer.failed = true;
+		return false;
+	}
+	writer.buffer   = (char*) mapping;
+	writer.capacity = capacity;
+	return true;
+}
+
+static inline
+bool reserve_asm_writer(
+	AsmWriter     & writer,
+	size_t   const& n)
+{
+	if (writer.size + n <= writer.capacity) {
+		return writer.buffer != NULL;
+	}
+	if (writer.sink == AsmWriterSink::MAPPED_FILE) {
+		return writer.buffer != NULL
+			   && grow_mapped_asm_writer(writer, n);
+	}
+	flush_asm_writer(writer);
+	return n <= writer.capacity;
+}
+
+static inline
+AsmWriterExitCode close_asm_writer(
+	AsmWriter& writer)
+{
+	if (writer.sink == AsmWriterSink::MAPPED_FILE) {
+		if (writer.buffer != NULL) {
+			munmap(writer.buffer, writer.capacity);
+		}
+		/* Trim the file to what was written. */
+		if (ftruncate(writer.fd, writer.size) != 0) {
+			writer.failed = true;
+		}
+	} else {
+		flush_asm_writer(writer);
+		delete[] writer.buffer;
+	}
+	writer.buffer = NULL;
+	if (writer.fd >= 0
+		&& close(writer.fd) != 0) {
+		writer.failed = true;
+	}
+	writer.fd = -1;
+	return writer.failed
+		   ? AsmWriterExitCode::FAILURE
+		   : AsmWriterExitCode::SUCCESS;
+}
+
+#endif
+
+static inline
+void write_asm_chars(
+	AsmWriter        & writer,
+	const char* const& chars,
+	size_t      const& n)
+{
+	if (n > writer.capacity
+		&& writer.sink != AsmWriterSink::MAPPED_FILE) {
+		/* Too large to buffer, so write it in pieces. */
+		for (size_t i = 0; i < n; i += writer.capacity) {
+			write_asm_chars(
+				writer,
+				chars + i,
+				n - i < writer.capacity
+				? n - i
+				: writer.capacity);
+		}
+		return;
+	}
+	if (reserve_asm_writer(writer, n)) {
+		memcpy(writer.buffer + writer.size, chars, n);
+		writer.size += n;
+	}
+}
+
+static inline
+void write_asm_char(
+	AsmWriter  & writer,
+	char  const& c)
+{
+	if (reserve_asm_writer(writer, 1)) {
+		writer.buffer[writer.size++] = c;
+	}
+}
+
+static inline
+void write_asm_string(
+	AsmWriter        & writer,
+	const char* const& str)
+{
+	write_asm_chars(writer, str, strlen(str));
+}
+
+static inline
+void write_asm_padded_string(
+	AsmWriter        & writer,
+	const char* const& str,
+	size_t      const& width)
+{
+	const size_t len = strlen(str);
+	write_asm_chars(writer, str, len);
+	for (size_t i = len; i < width; i++) {
+		write_asm_char(writer, ' ');
+	}
+}
+
+static inline
+void write_asm_unsigned(
+	AsmWriter     & writer,
+	uint64_t const& val)
+{
+	/* Formatted from the least significant digit back. */
+	char digits[20];
+	char* d = digits + sizeof(digits);
+	uint64_t v = val;
+	do {
+		*--d = '0' + (char) (v % 10);
+		v /= 10;
+	} while (v != 0);
+	write_asm_chars(writer, d, digits + sizeof(digits) - d);
+}
+
+static inline
+void write_asm_signed(
+	AsmWriter    & writer,
+	int64_t const& val)
+{
+	if (val < 0) {
+		write_asm_char(writer, '-');
+		write_asm_unsigned(writer, 0 - (uint64_t) val);
+	} else {
+		write_asm_unsigned(writer, (uint64_t) val);
+	}
+}
+
+static inline
+void write_asm_hex(
+	AsmWriter     & writer,
+	uint64_t const& val,
+	size_t   const& width)
+{
+	static const char hex_digits[] = "0123456789abcdef";
+	char digits[16];
+	char* d = digits + sizeof(digits);
+	uint64_t v = val;
+	do {
+		*--d = hex_digits[v & 0xf];
+		v >>= 4;
+	} while (v != 0);
+	for (size_t len = digits + sizeof(digits) - d;
+		 len < width;
+		 len++) {
+		write_asm_char(writer, '0');
+	}
+	write_asm_chars(writer, d, digits + sizeof(digits) - d);
+}
+
+#endif
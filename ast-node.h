@@ -6,6 +6,8 @@
 #define AST_NODE_CPP 1
 
 #include "token.h"
+#include "token-store.h"
+#include "arena.h"
 #include <cstddef>
 #include <iostream>
 
@@ -634,14 +636,14 @@ class AstNode {
 private:
 	const AstNodeName name;
 	const AstNodeAlt  alt;	
-	const Token*      terminal;
+	TokenRef          terminal;
 	AstNode*          child;	
 	AstNode*          sibling;
 public:
 	inline AstNode(
 		AstNodeName const& n,
 		AstNodeAlt  const& a,
-		const Token* const& t) :
+		TokenRef    const& t) :
 		name(n), 
 		alt(a), 
 		terminal(t), 
@@ -649,6 +651,8 @@ public:
 		sibling(NULL) { 
 	}
 
+	ARENA_ALLOCATED(AstNode)
+
 	inline ~AstNode() {
 		const AstNode* current_node 
 			= child;
@@ -663,7 +667,7 @@ public:
 	inline AstNode() :
 		name(AstNodeName::ERROR),
 		alt(AstNodeAlt::ERROR),
-		terminal(NULL),
+		terminal(),
 		child(NULL),
 		sibling(NULL) {
 	}
@@ -678,9 +682,9 @@ public:
 		return alt;
 	};
 
-	inline const Token* get_terminal() const
+	inline const TokenRef* get_terminal() const
 	{
-		return terminal;
+		return terminal.is_null() ? NULL : &terminal;
 	};
 
 	inline AstNode* get_child() const
@@ -722,7 +726,8 @@ public:
 
 	inline void print(
 		string const& parent_prefix = "", 
-		string const& child_prefix = "") const
+		string const& child_prefix  = "",
+		ostream     & out           = cout) const
 	{
 		const int name_i         
 			= (int) name;
@@ -733,17 +738,17 @@ public:
 		const char* const alt_s  
 			= ast_node_alt_string_reprs[alt_i];
 
-		cout << parent_prefix
-			 << "name="
-			 << name_s
-			 << ",alt="
-			 << alt_s;
+		out << parent_prefix
+			<< "name="
+			<< name_s
+			<< ",alt="
+			<< alt_s;
 		
-		if (terminal) {
-			cout << ", terminal==";
-			terminal->print();
+		if (!terminal.is_null()) {
+			out << ", terminal==";
+			terminal.print(out);
 		}
-		cout << endl;
+		out << endl;
 
 		const AstNode* node = child;
 		for (;node; node = node->sibling) {
@@ -757,7 +762,8 @@ public:
 					  + "|    ";
 				node->print(
 					appended_p, 
-					appended_c);
+					appended_c,
+					out);
 			
 			} else {
 				string appended_p 
@@ -768,7 +774,8 @@ public:
 					  + "     ";
 				node->print(
 					appended_p, 
-					appended_c);
+					appended_c,
+					out);
 			
 			}
 		}
@@ -780,26 +787,29 @@ public:
 /********************************************************/
 
 /**
-* @param token
+* @param tokens The cursor at the token, which is kept
+*		 for the terminal to refer to.
 * @returns
 **/
 static inline
 AstNode* construct_terminal(
-	const Token* const& token);
+	TokenCursor const& tokens);
 
 static inline 
 AstNode* construct_terminal(
-	const Token* const& token)
+	TokenCursor const& tokens)
 {
+	const TokenRef token
+		= tokens.keep();
 	if (DEBUG_AST_NODE_SHOW_CREATION) {
 		cout << "ast-node.cpp:construct_terminal:"
 			 << " constructing terminal from the following token, ";
-		token->print();
+		token.print();
 		cout << endl;
 	}
 
 	AstNodeName name;
-	switch (token->get_name()) {
+	switch (token.get_name()) {
 
 		case TokenName::KEYWORD: 
 			name = AstNodeName::KEYWORD;
@@ -0,0 +1,380 @@
+/* Authored by Charlie Keaney                    */
+/* char-scan-tester.h - Responsible for testing
+						that every level of
+						character scanning finds
+						what the scalar scans do. */
+
+#ifndef CHAR_SCAN_TESTER_H
+#define CHAR_SCAN_TESTER_H 1
+
+#include <cstring>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#include "tester-tools.h"
+#include "char-scan.h"
+
+#define NUM_CHAR_SCAN_TESTS 2
+
+/* Each input is scanned from every offset into a
+   buffer of this alignment, so that every kernel's
+   first, partial, block starts at every byte.     */
+#define CHAR_SCAN_TEST_ALIGNMENT 64
+#define CHAR_SCAN_TEST_BUFFER_SZ 512
+
+//////////////////////////////////////////////////////////////////
+//        Testing the vector scans against the scalar           //
+//////////////////////////////////////////////////////////////////
+
+#define NUM_CHAR_SCAN_LEVEL_TESTS 14
+
+struct char_scan_level_test_case {
+	const char* input;
+};
+
+static const
+char_scan_level_test_case
+test_char_scan_level_table[NUM_CHAR_SCAN_LEVEL_TESTS] = {
+	{ "" },
+	{ "x" },
+	{ "identifier_1234567890_abcdefghijklmnopqrstuvwxyz"
+	  "ABCDEFGHIJKLMNOPQRSTUVWXYZ_0123456789 rest" },
+	{ "                                                  "
+	  "                         x" },
+	{ "0123456789012345678901234567890123456789"
+	  "0123456789012345678901234567890123456789a" },
+	{ "a line with no end, which runs on past one and "
+	  "then two of the widest vectors before it stops" },
+	{ "line 1\nline 2\n\n\nline 5 is somewhat longer than "
+	  "a vector is wide\n\n" },
+	{ "\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n"
+	  "\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n" },
+	{ "comment body * / * not yet ** nearly *" "/ after" },
+	{ "a comment that is never closed, however long it "
+	  "runs on for, ending in a lone *" },
+	{ "****************************************"
+	  "****************************************/" },
+	{ "*\n/*/ x */" },
+	{ "az_AZ09`{@[/:\x7f\x80\xff _ 9" },
+	{ "\xc3\xa9t\xc3\xa9_ident \t\r\n  \xe2\x80\x8b 12" }
+};
+
+static const CharClass char_scan_test_classes[] = {
+	CharClass::IDENTIFIER,
+	CharClass::DECIMAL_DIGIT,
+	CharClass::SPACE
+};
+
+/**
+* Checks that every scan, at the scan level in use,
+* finds what the scalar scan does, from every offset
+* into the input, with the input at every alignment.
+**/
+static inline bool check_char_scans(
+	const char* const& input)
+{
+	alignas(CHAR_SCAN_TEST_ALIGNMENT)
+		char buffer[CHAR_SCAN_TEST_BUFFER_SZ];
+	const size_t length = strlen(input);
+	if (length + CHAR_SCAN_TEST_ALIGNMENT + 1
+		> CHAR_SCAN_TEST_BUFFER_SZ) {
+		return false;
+	}
+	for (size_t a = 0; a < CHAR_SCAN_TEST_ALIGNMENT; a++) {
+		memset(buffer, 'x', CHAR_SCAN_TEST_BUFFER_SZ);
+		memcpy(buffer + a, input, length + 1);
+		for (size_t start = 0; start <= length; start++) {
+			const char* const from = buffer + a + start;
+			for (const CharClass& cls : char_scan_test_classes) {
+				if (skip_char_class(from, cls)
+					!= scalar_skip_char_class(from, cls)) {
+					return false;
+				}
+			}
+			if (find_line_end(from)
+				!= scalar_find_line_end(from)) {
+				return false;
+			}
+			if (find_block_comment_end(from)
+				!= scalar_find_block_comment_end(from)) {
+				return false;
+			}
+			vector<uint32_t> line_starts;
+			vector<uint32_t> scalar_line_starts;
+			find_line_starts(from, line_starts);
+			scalar_find_line_starts(from, scalar_line_starts);
+			if (line_starts != scalar_line_starts) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/**
+* Runs the scans of each input at every level the CPU
+* supports, expecting each to agree with the scalar
+* scans.
+**/
+static inline TestResult test_char_scan_level(
+	TestResult results[NUM_CHAR_SCAN_LEVEL_TESTS])
+{
+	bool all_tests_passed = true;
+	const CharScanLevel detected_level
+		= char_scan_level;
+	for (const char_scan_level_test_case* ctc
+			= test_char_scan_level_table;
+		ctc < test_char_scan_level_table + NUM_CHAR_SCAN_LEVEL_TESTS;
+		ctc++) {
+		bool success_criteria = true;
+		for (int level = (int) CharScanLevel::SCALAR;
+			 level <= (int) detected_level;
+			 level++) {
+			char_scan_level = (CharScanLevel) level;
+			if (!check_char_scans(ctc->input)) {
+				success_criteria = false;
+			}
+		}
+		char_scan_level = detected_level;
+		results[ctc - test_char_scan_level_table]
+			= success_criteria ? TestResult::SUCCESS : TestResult::FAIL;
+		if (!success_criteria) {
+			all_tests_passed = false;
+		}
+	}
+	return all_tests_passed ? TestResult::SUCCESS : TestResult::FAIL;
+}
+
+//////////////////////////////////////////////////////////////////
+//        Testing the vector scans at the end of a page         //
+//////////////////////////////////////////////////////////////////
+
+#define NUM_CHAR_SCAN_PAGE_EDGE_TESTS 6
+
+struct char_scan_page_edge_test_case {
+	const char* input;
+};
+
+/* Each input is ended by its NUL just before a page
+   which may not be read, with the bytes between filled
+   with stars, as a star ending a block is the one byte
+   a kernel looks past.                               */
+static const
+char_scan_page_edge_test_case
+test_char_scan_page_edge_table[NUM_CHAR_SCAN_PAGE_EDGE_TESTS] = {
+	{ "" },
+	{ "abc" },
+	{ "comment body" },
+	{ "comment body ending in a star *" },
+	{ "line 1\nline 2\n" },
+	{ "identifier_1234567890 \t " }
+};
+
+/**
+* Allocates two pages, the second of which may not be
+* read, so that a read past the first faults.
+*
+* @param page Set to the first page.
+* @param page_sz Set to the size of a page.
+* @return Returns whether the pages were allocated.
+**/
+static inline bool allocate_char_scan_test_pages(
+	char*  & page,
+	size_t & page_sz)
+{
+#if defined(_WIN32)
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	page_sz = (size_t) info.dwPageSize;
+	page = (char*) VirtualAlloc(
+		NULL,
+		2 * page_sz,
+		MEM_RESERVE | MEM_COMMIT,
+		PAGE_READWRITE);
+	DWORD protection;
+	return page != NULL
+		   && VirtualProtect(
+				  page + page_sz,
+				  page_sz,
+				  PAGE_NOACCESS,
+				  &protection);
+#else
+	page_sz = (size_t) sysconf(_SC_PAGESIZE);
+	void* mapping = mmap(
+		NULL,
+		2 * page_sz,
+		PROT_READ | PROT_WRITE,
+		MAP_PRIVATE | MAP_ANONYMOUS,
+		-1,
+		0);
+	if (mapping == MAP_FAILED) {
+		page = NULL;
+		return false;
+	}
+	page = (char*) mapping;
+	return mprotect(page + page_sz, page_sz, PROT_NONE) == 0;
+#endif
+}
+
+static inline void free_char_scan_test_pages(
+	char*  const& page,
+	size_t const& page_sz)
+{
+	if (page == NULL) {
+		return;
+	}
+#if defined(_WIN32)
+	VirtualFree(page, 0, MEM_RELEASE);
+#else
+	munmap(page, 2 * page_sz);
+#endif
+}
+
+/**
+* Checks that every scan, at the scan level in use,
+* finds what the scalar scan does, from every offset
+* into the input, with its NUL at each of the last
+* bytes of a page.
+**/
+static inline bool check_char_scans_at_page_edge(
+	const char* const& input,
+	char*       const& page,
+	size_t      const& page_sz)
+{
+	const size_t length = strlen(input);
+	if (length + CHAR_SCAN_TEST_ALIGNMENT + 1 > page_sz) {
+		return false;
+	}
+	for (size_t e = 1; e <= CHAR_SCAN_TEST_ALIGNMENT; e++) {
+		char* const end = page + page_sz - e;
+		memset(page, 'x', page_sz);
+		memset(end, '*', e);
+		memcpy(end - length, input, length + 1);
+		for (size_t start = 0; start <= length; start++) {
+			const char* const from = end - length + start;
+			for (const CharClass& cls : char_scan_test_classes) {
+				if (skip_char_class(from, cls)
+					!= scalar_skip_char_class(from, cls)) {
+					return false;
+				}
+			}
+			if (find_line_end(from)
+				!= scalar_find_line_end(from)) {
+				return false;
+			}
+			if (find_block_comment_end(from)
+				!= scalar_find_block_comment_end(from)) {
+				return false;
+			}
+			vector<uint32_t> line_starts;
+			vector<uint32_t> scalar_line_starts;
+			find_line_starts(from, line_starts);
+			scalar_find_line_starts(from, scalar_line_starts);
+			if (line_starts != scalar_line_starts) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/**
+* Runs the scans of each input at the end of a page,
+* at every level the CPU supports, expecting each to
+* agree with the scalar scans without faulting.
+**/
+static inline TestResult test_char_scan_page_edge(
+	TestResult results[NUM_CHAR_SCAN_PAGE_EDGE_TESTS])
+{
+	char* page = NULL;
+	size_t page_sz = 0;
+	const bool is_allocated
+		= allocate_char_scan_test_pages(page, page_sz);
+	bool all_tests_passed = true;
+	const CharScanLevel detected_level
+		= char_scan_level;
+	for (const char_scan_page_edge_test_case* ctc
+			= test_char_scan_page_edge_table;
+		ctc < test_char_scan_page_edge_table
+			  + NUM_CHAR_SCAN_PAGE_EDGE_TESTS;
+		ctc++) {
+		bool success_criteria = is_allocated;
+		for (int level = (int) CharScanLevel::SCALAR;
+			 success_criteria && level <= (int) detected_level;
+			 level++) {
+			char_scan_level = (CharScanLevel) level;
+			if (!check_char_scans_at_page_edge(
+					ctc->input,
+					page,
+					page_sz)) {
+				success_criteria = false;
+			}
+		}
+		char_scan_level = detected_level;
+		results[ctc - test_char_scan_page_edge_table]
+			= success_criteria ? TestResult::SUCCESS : TestResult::FAIL;
+		if (!success_criteria) {
+			all_tests_passed = false;
+		}
+	}
+	free_char_scan_test_pages(page, page_sz);
+	return all_tests_passed ? TestResult::SUCCESS : TestResult::FAIL;
+}
+
+static inline TestResult test_char_scan(
+	TestResult results[NUM_CHAR_SCAN_TESTS],
+	char* &output,
+	int indent = 0)
+{
+	TestResult level_results[NUM_CHAR_SCAN_LEVEL_TESTS];
+	TestResult level_result
+		= test_char_scan_level(level_results);
+	results[0] = level_result;
+
+	TestResult page_edge_results[NUM_CHAR_SCAN_PAGE_EDGE_TESTS];
+	TestResult page_edge_result
+		= test_char_scan_page_edge(page_edge_results);
+	results[1] = page_edge_result;
+
+	for (int i = 0; i < indent; i++) print_to_output("\t", output);
+	print_to_output("<-> CharScanTests (", output);
+	print_to_output(
+		char_scan_level_string_repr[(int) char_scan_level],
+		output);
+	print_to_output(")\n", output);
+
+	const char* level_title = "CharScanLevelTests";
+	present_test_set_synopsis(
+		level_title,
+		level_result,
+		level_results,
+		NUM_CHAR_SCAN_LEVEL_TESTS,
+		output,
+		indent + 1
+	);
+
+	const char* page_edge_title = "CharScanPageEdgeTests";
+	present_test_set_synopsis(
+		page_edge_title,
+		page_edge_result,
+		page_edge_results,
+		NUM_CHAR_SCAN_PAGE_EDGE_TESTS,
+		output,
+		indent + 1
+	);
+
+	for (int i = 0; i < NUM_CHAR_SCAN_TESTS; i++) {
+		if (results[i] != TestResult::SUCCESS) {
+			return TestResult::FAIL;
+		}
+	}
+	return TestResult::SUCCESS;
+}
+
+#endif
@@ -0,0 +1,674 @@
+/* Authored by Charlie Keaney                   */
+/* char-scan.h - Responsible for scanning runs of
+				 characters for the preprocessor
+				 many bytes at a time.
+
+				 Implementation Notes:
+				 Each scan has an SSE2 and an AVX2
+				 kernel, classifying 16 or 32 bytes
+				 per step, and a scalar fallback.
+				 Which is used is decided once, when
+				 kcc starts, from what the CPU
+				 supports.
+
+				 The vector kernels only ever load
+				 whole aligned blocks. An aligned
+				 block holding a byte of the input
+				 never crosses into another page, so
+				 a scan may read past the NUL which
+				 ends the input but never faults.
+				 Those reads are outside what was
+				 allocated, so the kernels are not
+				 instrumented by the address
+				 sanitizer.
+
+				 Every scan stops at a NUL, as no
+				 class scanned over includes it.
+
+				 The AVX2 kernels clear the upper
+				 halves of the vector registers
+				 before returning, as not every
+				 compiler does so unasked, and SSE
+				 code run while they are dirty is
+				 slowed on many CPUs.             */
+
+#ifndef CHAR_SCAN_H
+#define CHAR_SCAN_H 1
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)                \
+	|| defined(__i386__) || defined(_M_IX86)
+#if !defined(KCC_NO_SIMD)
+#define CHAR_SCAN_X86 1
+#endif
+#endif
+
+#if defined(CHAR_SCAN_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <immintrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CHAR_SCAN_TARGET_AVX2 __attribute__((target("avx2")))
+#define CHAR_SCAN_UNSANITIZED __attribute__((no_sanitize_address))
+#else
+#define CHAR_SCAN_TARGET_AVX2
+#define CHAR_SCAN_UNSANITIZED
+#endif
+
+using namespace std;
+
+/*****************************************************//**
+*                      Declarations                      *
+/********************************************************/
+
+enum class CharScanLevel {
+	SCALAR,
+	SSE2,
+	AVX2
+};
+
+static const char* const char_scan_level_string_repr[] = {
+	"scalar",
+	"sse2",
+	"avx2"
+};
+
+/**
+* The classes of character a scan may skip over.
+**/
+enum class CharClass {
+	/* _, a-z, A-Z and 0-9. */
+	IDENTIFIER,
+	/* 0-9. */
+	DECIMAL_DIGIT,
+	/* ' ' alone; tabs and carriage returns move the
+	   column differently, so are handled one by one. */
+	SPACE
+};
+
+/**
+* Returns the fastest level of scanning the CPU kcc is
+* running on supports.
+*
+* @return Returns the level to scan at.
+**/
+static inline
+CharScanLevel detect_char_scan_level();
+
+/* The level scans are run at. */
+static CharScanLevel char_scan_level
+	= detect_char_scan_level();
+
+/**
+* Skips over every character of the given class.
+*
+* @param input The first character to look at.
+* @param cls The class of character to skip.
+* @return Returns the first character not of the class.
+**/
+static inline
+const char* skip_char_class(
+	const char* const& input,
+	CharClass   const& cls);
+
+/**
+* Finds the end of a line.
+*
+* @param input The first character to look at.
+* @return Returns the first '\n' or NUL.
+**/
+static inline
+const char* find_line_end(
+	const char* const& input);
+
+/**
+* Finds the end of a block comment.
+*
+* @param input The first character inside the comment.
+* @return Returns the '*' of the first "*" "/", or the
+*		  NUL ending the input if the comment is
+*		  unterminated.
+**/
+static inline
+const char* find_block_comment_end(
+	const char* const& input);
+
+/**
+* Finds where each line of the input but the first
+* starts.
+*
+* @param input The input, ended by a NUL.
+* @param line_starts Appended with the offset from the
+*		 input of the character after each '\n'.
+**/
+static inline
+void find_line_starts(
+	const char*         const& input,
+	vector<uint32_t>         & line_starts);
+
+/*****************************************************//**
+*                         Definitions                    *
+/********************************************************/
+
+static inline
+bool is_char_of_class(
+	char      const& c,
+	CharClass const& cls)
+{
+	switch (cls) {
+		case CharClass::IDENTIFIER:
+			return (c >= 'a' && c <= 'z')
+				   || (c >= 'A' && c <= 'Z')
+				   || (c >= '0' && c <= '9')
+				   || c == '_';
+		case CharClass::DECIMAL_DIGIT:
+			return c >= '0' && c <= '9';
+		case CharClass::SPACE:
+			return c == ' ';
+		default:
+			return false;
+	}
+}
+
+static inline
+const char* scalar_skip_char_class(
+	const char* input,
+	CharClass   const& cls)
+{
+	while (is_char_of_class(*input, cls)) {
+		input++;
+	}
+	return input;
+}
+
+static inline
+const char* scalar_find_line_end(
+	const char* input)
+{
+	while (*input != '\n'
+		   && *input != '\0') {
+		input++;
+	}
+	return input;
+}
+
+static inline
+const char* scalar_find_block_comment_end(
+	const char* input)
+{
+	while (*input != '\0'
+		   && (*input != '*'
+			   || *(input + 1) != '/')) {
+		input++;
+	}
+	return input;
+}
+
+static inline
+void scalar_find_line_starts(
+	const char*         const& input,
+	vector<uint32_t>         & line_starts)
+{
+	for (const char* c = input; *c != '\0'; c++) {
+		if (*c == '\n') {
+			line_starts.push_back((uint32_t) (c + 1 - input));
+		}
+	}
+}
+
+#if defined(CHAR_SCAN_X86)
+
+static inline
+unsigned int count_trailing_zeros(
+	uint32_t const& mask)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return (unsigned int) index;
+#else
+	return (unsigned int) __builtin_ctz(mask);
+#endif
+}
+
+/* Bytes are compared signed, so any byte of 0x80 or
+   above falls outside every range below.           */
+#define CHAR_SCAN_IN_RANGE(set1, cmpgt, and_, v, lo, hi)  \
+	and_(cmpgt(v, set1((char) ((lo) - 1))),               \
+		 cmpgt(set1((char) ((hi) + 1)), v))
+
+static inline
+__m128i sse2_char_class_mask(
+	__m128i   const& v,
+	CharClass const& cls)
+{
+	switch (cls) {
+		case CharClass::IDENTIFIER:
+		{
+			/* Setting 0x20 folds upper case onto lower. */
+			const __m128i folded
+				= _mm_or_si128(v, _mm_set1_epi8(0x20));
+			return _mm_or_si128(
+				_mm_or_si128(
+					CHAR_SCAN_IN_RANGE(_mm_set1_epi8, _mm_cmpgt_epi8,
+									   _mm_and_si128, folded, 'a', 'z'),
+					CHAR_SCAN_IN_RANGE(_mm_set1_epi8, _mm_cmpgt_epi8,
+									   _mm_and_si128, v, '0', '9')),
+				_mm_cmpeq_epi8(v, _mm_set1_epi8('_')));
+		}
+		case CharClass::DECIMAL_DIGIT:
+			return CHAR_SCAN_IN_RANGE(_mm_set1_epi8, _mm_cmpgt_epi8,
+									  _mm_and_si128, v, '0', '9');
+		case CharClass::SPACE:
+		default:
+			return _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+	}
+}
+
+CHAR_SCAN_UNSANITIZED
+static inline
+const char* sse2_skip_char_class(
+	const char* const& input,
+	CharClass   const& cls)
+{
+	const char* block
+		= (const char*) ((uintptr_t) input & ~(uintptr_t) 15);
+	/* Bytes before the input count as of the class. */
+	uint32_t stop
+		= ~(uint32_t) _mm_movemask_epi8(sse2_char_class_mask(
+			  _mm_load_si128((const __m128i*) block), cls))
+		  & (0xffffu << (input - block))
+		  & 0xffffu;
+	while (stop == 0) {
+		block += 16;
+		stop = ~(uint32_t) _mm_movemask_epi8(sse2_char_class_mask(
+				   _mm_load_si128((const __m128i*) block), cls))
+			   & 0xffffu;
+	}
+	return block + count_trailing_zeros(stop);
+}
+
+CHAR_SCAN_UNSANITIZED
+static inline
+const char* sse2_find_line_end(
+	const char* const& input)
+{
+	const char* block
+		= (const char*) ((uintptr_t) input & ~(uintptr_t) 15);
+	uint32_t valid
+		= 0xffffu << (input - block);
+	for (;;) {
+		const __m128i v
+			= _mm_load_si128((const __m128i*) block);
+		const uint32_t stop
+			= (uint32_t) _mm_movemask_epi8(_mm_or_si128(
+				  _mm_cmpeq_epi8(v, _mm_set1_epi8('\n')),
+				  _mm_cmpeq_epi8(v, _mm_setzero_si128())))
+			  & valid;
+		if (stop != 0) {
+			return block + count_trailing_zeros(stop);
+		}
+		block += 16;
+		valid = 0xffffu;
+	}
+}
+
+CHAR_SCAN_UNSANITIZED
+static inline
+const char* sse2_find_block_comment_end(
+	const char* const& input)
+{
+	const char* block
+		= (const char*) ((uintptr_t) input & ~(uintptr_t) 15);
+	uint32_t valid
+		= 0xffffu << (input - block);
+	for (;;) {
+		const __m128i v
+			= _mm_load_si128((const __m128i*) block);
+		const uint32_t stars
+			= (uint32_t) _mm_movemask_epi8(
+				  _mm_cmpeq_epi8(v, _mm_set1_epi8('*')))
+			  & valid;
+		const uint32_t slashes
+			= (uint32_t) _mm_movemask_epi8(
+				  _mm_cmpeq_epi8(v, _mm_set1_epi8('/')));
+		const uint32_t nuls
+			= (uint32_t) _mm_movemask_epi8(
+				  _mm_cmpeq_epi8(v, _mm_setzero_si128()))
+			  & valid;
+		/* A star ending the block pairs with the next
+		   block's first byte, which is only part of the
+		   input if no NUL comes before it.           */
+		uint32_t stop
+			= (stars & (slashes >> 1)) | nuls;
+		if (nuls == 0
+			&& (stars & 0x8000u)
+			&& *(block + 16) == '/') {
+			stop |= 0x8000u;
+		}
+		if (stop != 0) {
+			return block + count_trailing_zeros(stop);
+		}
+		block += 16;
+		valid = 0xffffu;
+	}
+}
+
+CHAR_SCAN_UNSANITIZED
+static inline
+void sse2_find_line_starts(
+	const char*         const& input,
+	vector<uint32_t>         & line_starts)
+{
+	const char* block
+		= (const char*) ((uintptr_t) input & ~(uintptr_t) 15);
+	uint32_t valid
+		= 0xffffu << (input - block);
+	for (;;) {
+		const __m128i v
+			= _mm_load_si128((const __m128i*) block);
+		uint32_t new_lines
+			= (uint32_t) _mm_movemask_epi8(
+				  _mm_cmpeq_epi8(v, _mm_set1_epi8('\n')))
+			  & valid;
+		const uint32_t nuls
+			= (uint32_t) _mm_movemask_epi8(
+				  _mm_cmpeq_epi8(v, _mm_setzero_si128()))
+			  & valid;
+		/* Only new-lines before the NUL are of the input. */
+		if (nuls != 0) {
+			new_lines &= (nuls & (0u - nuls)) - 1;
+		}
+		while (new_lines != 0) {
+			line_starts.push_back(
+				(uint32_t) (block + count_trailing_zeros(new_lines)
+							+ 1 - input));
+			new_lines &= new_lines - 1;
+		}
+		if (nuls != 0) {
+			return;
+		}
+		block += 16;
+		valid = 0xffffu;
+	}
+}
+
+CHAR_SCAN_TARGET_AVX2
+static inline
+__m256i avx2_char_class_mask(
+	__m256i   const& v,
+	CharClass const& cls)
+{
+	switch (cls) {
+		case CharClass::IDENTIFIER:
+		{
+			const __m256i folded
+				= _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+			return _mm256_or_si256(
+				_mm256_or_si256(
+					CHAR_SCAN_IN_RANGE(_mm256_set1_epi8, _mm256_cmpgt_epi8,
+									   _mm256_and_si256, folded, 'a', 'z'),
+					CHAR_SCAN_IN_RANGE(_mm256_set1_epi8, _mm256_cmpgt_epi8,
+									   _mm256_and_si256, v, '0', '9')),
+				_mm256_cmpeq_epi8(v, _mm256_set1_epi8('_')));
+		}
+		case CharClass::DECIMAL_DIGIT:
+			return CHAR_SCAN_IN_RANGE(_mm256_set1_epi8, _mm256_cmpgt_epi8,
+									  _mm256_and_si256, v, '0', '9');
+		case CharClass::SPACE:
+		default:
+			return _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' '));
+	}
+}
+
+CHAR_SCAN_TARGET_AVX2
+CHAR_SCAN_UNSANITIZED
+static inline
+const char* avx2_skip_char_class(
+	const char* const& input,
+	CharClass   const& cls)
+{
+	const char* block
+		= (const char*) ((uintptr_t) input & ~(uintptr_t) 31);
+	uint32_t stop
+		= ~(uint32_t) _mm256_movemask_epi8(avx2_char_class_mask(
+			  _mm256_load_si256((const __m256i*) block), cls))
+		  & (0xffffffffu << (input - block));
+	while (stop == 0) {
+		block += 32;
+		stop = ~(uint32_t) _mm256_movemask_epi8(avx2_char_class_mask(
+				   _mm256_load_si256((const __m256i*) block), cls));
+	}
+	_mm256_zeroupper();
+	return block + count_trailing_zeros(stop);
+}
+
+CHAR_SCAN_TARGET_AVX2
+CHAR_SCAN_UNSANITIZED
+static inline
+const char* avx2_find_line_end(
+	const char* const& input)
+{
+	const char* block
+		= (const char*) ((uintptr_t) input & ~(uintptr_t) 31);
+	uint32_t valid
+		= 0xffffffffu << (input - block);
+	for (;;) {
+		const __m256i v
+			= _mm256_load_si256((const __m256i*) block);
+		const uint32_t stop
+			= (uint32_t) _mm256_movemask_epi8(_mm256_or_si256(
+				  _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')),
+				  _mm256_cmpeq_epi8(v, _mm256_setzero_si256())))
+			  & valid;
+		if (stop != 0) {
+			_mm256_zeroupper();
+			return block + count_trailing_zeros(stop);
+		}
+		block += 32;
+		valid = 0xffffffffu;
+	}
+}
+
+CHAR_SCAN_TARGET_AVX2
+CHAR_SCAN_UNSANITIZED
+static inline
+const char* avx2_find_block_comment_end(
+	const char* const& input)
+{
+	const char* block
+		= (const char*) ((uintptr_t) input & ~(uintptr_t) 31);
+	uint32_t valid
+		= 0xffffffffu << (input - block);
+	for (;;) {
+		const __m256i v
+			= _mm256_load_si256((const __m256i*) block);
+		const uint32_t stars
+			= (uint32_t) _mm256_movemask_epi8(
+				  _mm256_cmpeq_epi8(v, _mm256_set1_epi8('*')))
+			  & valid;
+		const uint32_t slashes
+			= (uint32_t) _mm256_movemask_epi8(
+				  _mm256_cmpeq_epi8(v, _mm256_set1_epi8('/')));
+		const uint32_t nuls
+			= (uint32_t) _mm256_movemask_epi8(
+				  _mm256_cmpeq_epi8(v, _mm256_setzero_si256()))
+			  & valid;
+		uint32_t stop
+			= (stars & (slashes >> 1)) | nuls;
+		if (nuls == 0
+			&& (stars & 0x80000000u)
+			&& *(block + 32) == '/') {
+			stop |= 0x80000000u;
+		}
+		if (stop != 0) {
+			_mm256_zeroupper();
+			return block + count_trailing_zeros(stop);
+		}
+		block += 32;
+		valid = 0xffffffffu;
+	}
+}
+
+CHAR_SCAN_TARGET_AVX2
+CHAR_SCAN_UNSANITIZED
+static inline
+void avx2_find_line_starts(
+	const char*         const& input,
+	vector<uint32_t>         & line_starts)
+{
+	const char* block
+		= (const char*) ((uintptr_t) input & ~(uintptr_t) 31);
+	uint32_t valid
+		= 0xffffffffu << (input - block);
+	for (;;) {
+		const __m256i v
+			= _mm256_load_si256((const __m256i*) block);
+		uint32_t new_lines
+			= (uint32_t) _mm256_movemask_epi8(
+				  _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')))
+			  & valid;
+		const uint32_t nuls
+			= (uint32_t) _mm256_movemask_epi8(
+				  _mm256_cmpeq_epi8(v, _mm256_setzero_si256()))
+			  & valid;
+		if (nuls != 0) {
+			new_lines &= (nuls & (0u - nuls)) - 1;
+		}
+		while (new_lines != 0) {
+			line_starts.push_back(
+				(uint32_t) (block + count_trailing_zeros(new_lines)
+							+ 1 - input));
+			new_lines &= new_lines - 1;
+		}
+		if (nuls != 0) {
+			_mm256_zeroupper();
+			return;
+		}
+		block += 32;
+		valid = 0xffffffffu;
+	}
+}
+
+#endif
+
+static inline
+CharScanLevel detect_char_scan_level()
+{
+#if defined(CHAR_SCAN_X86)
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuidex(info, 1, 0);
+	const bool has_osxsave
+		= (info[2] & (1 << 27)) != 0;
+	const bool has_avx
+		= (info[2] & (1 << 28)) != 0;
+	__cpuidex(info, 7, 0);
+	const bool has_avx2
+		= (info[1] & (1 << 5)) != 0;
+	/* The OS must save the upper halves of the registers. */
+	if (has_osxsave
+		&& has_avx
+		&& has_avx2
+		&& (_xgetbv(0) & 6) == 6) {
+		return CharScanLevel::AVX2;
+	}
+	return CharScanLevel::SSE2;
+#else
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		return CharScanLevel::AVX2;
+	}
+	if (__builtin_cpu_supports("sse2")) {
+		return CharScanLevel::SSE2;
+	}
+	return CharScanLevel::SCALAR;
+#endif
+#else
+	return CharScanLevel::SCALAR;
+#endif
+}
+
+static inline
+const char* skip_char_class(
+	const char* const& input,
+	CharClass   const& cls)
+{
+	/* Most runs are short, so the first byte is looked
+	   at before starting a vector scan.              */
+	if (!is_char_of_class(*input, cls)) {
+		return input;
+	}
+	switch (char_scan_level) {
+#if defined(CHAR_SCAN_X86)
+		case CharScanLevel::AVX2:
+			return avx2_skip_char_class(input + 1, cls);
+		case CharScanLevel::SSE2:
+			return sse2_skip_char_class(input + 1, cls);
+#endif
+		default:
+			return scalar_skip_char_class(input + 1, cls);
+	}
+}
+
+static inline
+const char* find_line_end(
+	const char* const& input)
+{
+	switch (char_scan_level) {
+#if defined(CHAR_SCAN_X86)
+		case CharScanLevel::AVX2:
+			return avx2_find_line_end(input);
+		case CharScanLevel::SSE2:
+			return sse2_find_line_end(input);
+#endif
+		default:
+			return scalar_find_line_end(input);
+	}
+}
+
+static inline
+const char* find_block_comment_end(
+	const char* const& input)
+{
+	switch (char_scan_level) {
+#if defined(CHAR_SCAN_X86)
+		case CharScanLevel::AVX2:
+			return avx2_find_block_comment_end(input);
+		case CharScanLevel::SSE2:
+			return sse2_find_block_comment_end(input);
+#endif
+		default:
+			return scalar_find_block_comment_end(input);
+	}
+}
+
+static inline
+void find_line_starts(
+	const char*         const& input,
+	vector<uint32_t>         & line_starts)
+{
+	switch (char_scan_level) {
+#if defined(CHAR_SCAN_X86)
+		case CharScanLevel::AVX2:
+			avx2_find_line_starts(input, line_starts);
+			break;
+		case CharScanLevel::SSE2:
+			sse2_find_line_starts(input, line_starts);
+			break;
+#endif
+		default:
+			scalar_find_line_starts(input, line_starts);
+			break;
+	}
+}
+
+#endif
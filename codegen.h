@@ -10,6 +10,8 @@
 #include "semantics.h"
 #include "symbol-table.h"
 #include "annotated-ast-node.h"
+#include "segmented-buffer.h"
+#include "asm-writer.h"
 
 #define DEBUG_CODEGEN_SHOW_INSTR_GEN 0
 #define DEBUG_CODEGEN_SHOW_REG_ALLOC 0
@@ -398,60 +400,61 @@ public:
 		: type(base_type), 
 		  val(v) { }
 
-	inline void print() const {
+	inline void print(
+		ostream& out = cout) const {
 
 		switch (type) {
 
 			case x86_Asm_IR_OperandType::X86_REGISTER_INDEX:
-				cout // TODO; AT&T syntax << "%"
-					 << x86_register_string_reprs[(int)val.reg_index];
+				out // TODO; AT&T syntax << "%"
+					<< x86_register_string_reprs[(int)val.reg_index];
 				break;
 			
 			case x86_Asm_IR_OperandType::X86_REGISTER_CONTAINING_ADDR:
-				cout <<  "["
-					 << x86_register_string_reprs[(int)val.reg_containing_addr]
-					 << "]";
+				out <<  "["
+					<< x86_register_string_reprs[(int)val.reg_containing_addr]
+					<< "]";
 				break;
 			
 			case x86_Asm_IR_OperandType::DOUBLEWORD_UNSIGNED_INTEGER:
-				cout // TODO AT&T Syntax << "$" 
+				out // TODO AT&T Syntax << "$" 
 					<< std::dec 
 					<< val.dwui;
 				break;
 			
 			case x86_Asm_IR_OperandType::NEAR_POINTER:
-				cout << "["
-					 << "0x"
-					 << std::right
-					 << std::hex
-					 << std::setw(8)
-					 << std::setfill('0')
-					 << val.np
-					 << "]";
+				out << "["
+					<< "0x"
+					<< std::right
+					<< std::hex
+					<< std::setw(8)
+					<< std::setfill('0')
+					<< val.np
+					<< "]";
 				break;
 
 			case x86_Asm_IR_OperandType::LABEL_AND_REGISTER:
 			{
-				cout << val.lar.label
-					 << "("
+				out << val.lar.label
+					<< "("
 					 //<< "%" 
-					 << x86_register_string_reprs[(int)val.lar.reg]
-					 << ")";
+					<< x86_register_string_reprs[(int)val.lar.reg]
+					<< ")";
 				break;
 			}
 
 			case x86_Asm_IR_OperandType::REGISTER_AND_OFFSET:
 			{
 				signed int offset = (int) val.rao.offset;
-				//if (offset < 0) cout << "-";				
+				//if (offset < 0) out << "-";				
 				if (offset != 0) {
-					cout << std::dec
+					out << std::dec
 						<< offset; //< 0 ? -1 * offset : offset
 				}
-				cout << "("
+				out << "("
 					 // TODO; AT&T SYNTAX << "%" 
-					 << x86_register_string_reprs[(int)val.rao.reg]
-					 << ")";
+					<< x86_register_string_reprs[(int)val.rao.reg]
+					<< ")";
 				break;
 			}
 			
@@ -460,6 +463,67 @@ public:
 		};
 	}
 
+	/**
+	* Writes the operand as print does, through a
+	* buffered assembly writer.
+	**/
+	inline void emit(
+		AsmWriter& writer) const {
+
+		switch (type) {
+
+			case x86_Asm_IR_OperandType::X86_REGISTER_INDEX:
+				write_asm_string(
+					writer,
+					x86_register_string_reprs[(int)val.reg_index]);
+				break;
+
+			case x86_Asm_IR_OperandType::X86_REGISTER_CONTAINING_ADDR:
+				write_asm_char(writer, '[');
+				write_asm_string(
+					writer,
+					x86_register_string_reprs[(int)val.reg_containing_addr]);
+				write_asm_char(writer, ']');
+				break;
+
+			case x86_Asm_IR_OperandType::DOUBLEWORD_UNSIGNED_INTEGER:
+				write_asm_unsigned(writer, val.dwui);
+				break;
+
+			case x86_Asm_IR_OperandType::NEAR_POINTER:
+				write_asm_string(writer, "[0x");
+				write_asm_hex(writer, val.np, 8);
+				write_asm_char(writer, ']');
+				break;
+
+			case x86_Asm_IR_OperandType::LABEL_AND_REGISTER:
+				write_asm_string(writer, val.lar.label);
+				write_asm_char(writer, '(');
+				write_asm_string(
+					writer,
+					x86_register_string_reprs[(int)val.lar.reg]);
+				write_asm_char(writer, ')');
+				break;
+
+			case x86_Asm_IR_OperandType::REGISTER_AND_OFFSET:
+			{
+				signed int offset = (int) val.rao.offset;
+				if (offset != 0) {
+					write_asm_signed(writer, offset);
+				}
+				write_asm_char(writer, '(');
+				write_asm_string(
+					writer,
+					x86_register_string_reprs[(int)val.rao.reg]);
+				write_asm_char(writer, ')');
+				break;
+			}
+
+			default:
+				break;
+		};
+	}
+
 	inline x86_Asm_IR_OperandType get_type() const {
 		return type;
 	}
@@ -498,7 +562,12 @@ private:
 		  op3(o3) {
 	}
 public:
-	inline x86_Asm_IR() {};
+	inline x86_Asm_IR()
+		: type(x86_Asm_IR_Type::INSTRUCTION),
+		  label(NULL),
+		  mnemonic(x86_Asm_IR_Mnemonic()),
+		  num_operands(0) {
+	};
 
 	inline void set_label(
 		const char* const& l) { 
@@ -512,6 +581,11 @@ public:
 
 	inline x86_Asm_IR(
 		x86_Asm_IR_Mnemonic const& m)
+
+		: type(x86_Asm_IR_Type::INSTRUCTION),
+		  label(NULL),
+		  mnemonic(m),
+		  num_operands(0)
 	{
 		switch (m) {
 
@@ -535,6 +609,11 @@ public:
 	inline x86_Asm_IR(
 		x86_Asm_IR_Mnemonic const& m,
 		x86_Asm_IR_Operand  const& o1)
+
+		: type(x86_Asm_IR_Type::INSTRUCTION),
+		  label(NULL),
+		  mnemonic(m),
+		  num_operands(0)
 	{
 		switch (m) {
 
@@ -565,10 +644,16 @@ public:
 		x86_Asm_IR_Mnemonic const& m,
 		x86_Asm_IR_Operand  const& o1,
 		x86_Asm_IR_Operand  const& o2)
+
+		: type(x86_Asm_IR_Type::INSTRUCTION),
+		  label(NULL),
+		  mnemonic(m),
+		  num_operands(0)
 	{
 		switch (m) {
 
 			case x86_Asm_IR_Mnemonic::ADD:
+			case x86_Asm_IR_Mnemonic::ADDSS:
 			case x86_Asm_IR_Mnemonic::SUB:
 			case x86_Asm_IR_Mnemonic::SUBSS:
 			case x86_Asm_IR_Mnemonic::INC:
@@ -621,35 +706,71 @@ public:
 		}
 	}
 
-	inline void print() const {
+	inline void print(
+		ostream& out = cout) const {
 		if (type == x86_Asm_IR_Type::LABELED_INSTRUCTION) {
-			cout << label 
-				 << ":" 
-				 << endl;
+			out << label 
+				<< ":" 
+				<< endl;
 		} 
 
-		cout << "\t"
-			 << std::left
-			 << setw(5)
-			 << setfill(' ')
-		     << x86_asm_ir_mnemonic_string_reprs[(int) mnemonic]
-		     << " ";
+		out << "\t"
+			<< std::left
+			<< setw(5)
+			<< setfill(' ')
+		    << x86_asm_ir_mnemonic_string_reprs[(int) mnemonic]
+		    << " ";
 		if (num_operands > 0) {
-			op1.print();
+			op1.print(out);
 		}			
 		if (num_operands > 1) {
-			cout << ", ";
-			op2.print();
+			out << ", ";
+			op2.print(out);
+
+		}
+		if (num_operands > 2) {
+			out << ", ";
+			op3.print(out);
+		}
+		out << endl;
+	}
+
+	/**
+	* Writes the instruction as print does, through a
+	* buffered assembly writer.
+	**/
+	inline void emit(
+		AsmWriter& writer) const {
+		if (type == x86_Asm_IR_Type::LABELED_INSTRUCTION) {
+			write_asm_string(writer, label);
+			write_asm_string(writer, ":\n");
+		}
 
+		write_asm_char(writer, '\t');
+		write_asm_padded_string(
+			writer,
+			x86_asm_ir_mnemonic_string_reprs[(int) mnemonic],
+			5);
+		write_asm_char(writer, ' ');
+		if (num_operands > 0) {
+			op1.emit(writer);
+		}
+		if (num_operands > 1) {
+			write_asm_string(writer, ", ");
+			op2.emit(writer);
 		}
 		if (num_operands > 2) {
-			cout << ", ";
-			op3.print();
+			write_asm_string(writer, ", ");
+			op3.emit(writer);
 		}
-		cout << endl;
+		write_asm_char(writer, '\n');
 	}
 };
 
+typedef SegmentedBuffer<x86_Asm_IR>         x86_Asm_IR_Buffer;
+typedef SegmentedBufferCursor<x86_Asm_IR>   x86_Asm_IR_Cursor;
+typedef SegmentedBufferAppender<x86_Asm_IR> x86_Asm_IR_Appender;
+
 /**
 * @param operand
 * @param op1_t
@@ -663,7 +784,7 @@ CodeGeneratorExitCode convert_operand_to_correct_type(
 	x86_Asm_IR_OperandType const& op1_t,
 	x86_Asm_IR_Operand          & converted_operand,
 	x86_Asm_IR_OperandType const& op2_t,
-	x86_Asm_IR*                 & instrs,
+	x86_Asm_IR_Appender         & instrs,
 	x86_RegisterAllocMap        & alloc_map);
 
 /**
@@ -675,11 +796,11 @@ CodeGeneratorExitCode convert_operand_to_correct_type(
 **/
 static inline
 CodeGeneratorExitCode construct_x86_AssemblyInstruction_multiply(
-	const Type*        const& op1_t,
-	x86_Asm_IR_Operand const& op1,
-	const Type*        const& op2_t,
-	x86_Asm_IR_Operand const& op2,
-	x86_Asm_IR*             & instrs) ;
+	const Type*         const& op1_t,
+	x86_Asm_IR_Operand  const& op1,
+	const Type*         const& op2_t,
+	x86_Asm_IR_Operand  const& op2,
+	x86_Asm_IR_Appender      & instrs) ;
 
 /**
 * @param op1_t
@@ -690,11 +811,11 @@ CodeGeneratorExitCode construct_x86_AssemblyInstruction_multiply(
 **/
 static inline
 CodeGeneratorExitCode construct_x86_AssemblyInstruction_divide(
-	const Type*        const& op1_t,
-	x86_Asm_IR_Operand const& op1,
-	const Type*        const& op2_t,
-	x86_Asm_IR_Operand const& op2,
-	x86_Asm_IR*             & instrs);
+	const Type*         const& op1_t,
+	x86_Asm_IR_Operand  const& op1,
+	const Type*         const& op2_t,
+	x86_Asm_IR_Operand  const& op2,
+	x86_Asm_IR_Appender      & instrs);
 
 /**
 * @param dest_t
@@ -705,11 +826,11 @@ CodeGeneratorExitCode construct_x86_AssemblyInstruction_divide(
 **/
 static inline
 CodeGeneratorExitCode construct_x86_AssemblyInstruction_move(
-	const Type*        const& dest_t,
-	x86_Asm_IR_Operand const& dest,
-	const Type*        const& source_t,
-	x86_Asm_IR_Operand const& source,
-	x86_Asm_IR*             & instrs);
+	const Type*         const& dest_t,
+	x86_Asm_IR_Operand  const& dest,
+	const Type*         const& source_t,
+	x86_Asm_IR_Operand  const& source,
+	x86_Asm_IR_Appender      & instrs);
 
 /**
 * @param op1_t
@@ -720,11 +841,11 @@ CodeGeneratorExitCode construct_x86_AssemblyInstruction_move(
 **/
 static inline
 CodeGeneratorExitCode construct_x86_AssemblyInstruction_add(
-	const Type*        const& op1_t,
-	x86_Asm_IR_Operand const& op1,
-	const Type*        const& op2_t,
-	x86_Asm_IR_Operand const& op2,
-	x86_Asm_IR*             & instrs);
+	const Type*         const& op1_t,
+	x86_Asm_IR_Operand  const& op1,
+	const Type*         const& op2_t,
+	x86_Asm_IR_Operand  const& op2,
+	x86_Asm_IR_Appender      & instrs);
 
 /**
 * @param op1_t
@@ -735,11 +856,11 @@ CodeGeneratorExitCode construct_x86_AssemblyInstruction_add(
 **/
 static inline
 CodeGeneratorExitCode construct_x86_AssemblyInstruction_subtract(
-	const Type*        const& op1_t,
-	x86_Asm_IR_Operand const& op1,
-	const Type*        const& op2_t,
-	x86_Asm_IR_Operand const& op2,
-	x86_Asm_IR*             & instrs);
+	const Type*         const& op1_t,
+	x86_Asm_IR_Operand  const& op1,
+	const Type*         const& op2_t,
+	x86_Asm_IR_Operand  const& op2,
+	x86_Asm_IR_Appender      & instrs);
 
 /**
 * @param type
@@ -903,7 +1024,7 @@ x86_RegisterName allocate_register(
 static inline
 CodeGeneratorExitCode gen_symbol(
 	const SymbolTableEntry* const& symbol_entry,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_Asm_IR_Operand           & operand,
 	x86_RegisterAllocMap    const& map);
 
@@ -923,9 +1044,9 @@ const char* construct_label(
 **/
 static inline
 CodeGeneratorExitCode gen_literals(
-	int               & num_labels_used,
-	SymbolTable* const& symbol_table,
-	x86_Asm_IR*       & instrs);
+	int                      & num_labels_used,
+	SymbolTable*        const& symbol_table,
+	x86_Asm_IR_Appender      & instrs);
 
 /**
 * @param num_labels_used
@@ -938,7 +1059,7 @@ static inline
 CodeGeneratorExitCode gen_primary_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand);
 
@@ -953,7 +1074,7 @@ static inline
 CodeGeneratorExitCode gen_postfix_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand);
 
@@ -968,7 +1089,7 @@ static inline
 CodeGeneratorExitCode gen_unary_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand);
 
@@ -983,7 +1104,7 @@ static inline
 CodeGeneratorExitCode gen_cast_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand);
 
@@ -998,7 +1119,7 @@ static inline
 CodeGeneratorExitCode gen_multiplicative_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand);
 
@@ -1013,7 +1134,7 @@ static inline
 CodeGeneratorExitCode gen_additive_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand);
 
@@ -1028,7 +1149,7 @@ static inline
 CodeGeneratorExitCode gen_shift_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand);
 
@@ -1043,7 +1164,7 @@ static inline
 CodeGeneratorExitCode gen_relational_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand);
 
@@ -1058,7 +1179,7 @@ static inline
 CodeGeneratorExitCode gen_equality_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand);
 
@@ -1073,7 +1194,7 @@ static inline
 CodeGeneratorExitCode gen_and_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand);
 
@@ -1088,7 +1209,7 @@ static inline
 CodeGeneratorExitCode gen_exclusive_or_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand);
 
@@ -1103,7 +1224,7 @@ static inline
 CodeGeneratorExitCode gen_inclusive_or_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand);
 
@@ -1118,7 +1239,7 @@ static inline
 CodeGeneratorExitCode gen_logical_and_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand);
 
@@ -1133,7 +1254,7 @@ static inline
 CodeGeneratorExitCode gen_exclusive_or_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand);
 
@@ -1148,7 +1269,7 @@ static inline
 CodeGeneratorExitCode gen_logical_or_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand);
 
@@ -1163,7 +1284,7 @@ static inline
 CodeGeneratorExitCode gen_conditional_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand);
 
@@ -1178,7 +1299,7 @@ static inline
 CodeGeneratorExitCode gen_assignment_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand);
 
@@ -1193,7 +1314,7 @@ static inline
 CodeGeneratorExitCode gen_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand);
 
@@ -1208,7 +1329,7 @@ static inline
 CodeGeneratorExitCode gen_constant_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_RegisterName        const& output_register);
 
@@ -1224,7 +1345,7 @@ static inline
 CodeGeneratorExitCode gen_declaration(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map);
 
 /**
@@ -1238,7 +1359,7 @@ static inline
 CodeGeneratorExitCode gen_declaration_specifiers(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_RegisterName        const& output_register);
 
@@ -1252,7 +1373,7 @@ static inline
 CodeGeneratorExitCode gen_init_declarator_list(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map);
 
 /**
@@ -1265,7 +1386,7 @@ static inline
 CodeGeneratorExitCode gen_init_declarator(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map);
 
 /**
@@ -1279,7 +1400,7 @@ static inline
 CodeGeneratorExitCode gen_initializer(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand);
 
@@ -1293,7 +1414,7 @@ static inline
 CodeGeneratorExitCode gen_initializer_list(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map);
 
 /* Statements. */
@@ -1308,7 +1429,7 @@ static inline
 CodeGeneratorExitCode gen_statement(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map);
 
 /**
@@ -1320,7 +1441,7 @@ static inline
 CodeGeneratorExitCode gen_labeled_statement(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs);
+	x86_Asm_IR_Appender          & instrs);
 
 /**
 * @param num_labels_used
@@ -1332,7 +1453,7 @@ static inline
 CodeGeneratorExitCode gen_compound_statement(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map);
 
 /**
@@ -1345,7 +1466,7 @@ static inline
 CodeGeneratorExitCode gen_block_item(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map);
 
 /**
@@ -1358,7 +1479,7 @@ static inline
 CodeGeneratorExitCode gen_block_item_list(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map);
 
 /**
@@ -1372,7 +1493,7 @@ static inline
 CodeGeneratorExitCode gen_expression_statement(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand);
 
@@ -1385,7 +1506,7 @@ static inline
 CodeGeneratorExitCode gen_selection_statement(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs);
+	x86_Asm_IR_Appender          & instrs);
 
 /**
 * @param num_labels_used
@@ -1396,7 +1517,7 @@ static inline
 CodeGeneratorExitCode gen_iteration_statement(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs);
+	x86_Asm_IR_Appender          & instrs);
 
 /**
 * @param num_labels_used
@@ -1407,7 +1528,7 @@ static inline
 CodeGeneratorExitCode gen_jump_statement(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs);
+	x86_Asm_IR_Appender          & instrs);
 
 /* External definitions. */
 
@@ -1420,7 +1541,7 @@ static inline
 CodeGeneratorExitCode gen_translation_unit(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs);
+	x86_Asm_IR_Appender          & instrs);
 
 /**
 * @param num_labels_used
@@ -1431,7 +1552,7 @@ static inline
 CodeGeneratorExitCode gen_external_declaration(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs);
+	x86_Asm_IR_Appender          & instrs);
 
 /**
 * @param num_labels_used
@@ -1442,7 +1563,7 @@ static inline
 CodeGeneratorExitCode gen_function_definition(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs);
+	x86_Asm_IR_Appender          & instrs);
 
 /**
 * @param num_labels_used
@@ -1455,7 +1576,7 @@ static inline
 CodeGeneratorExitCode gen_declaration_list(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map);
 
 /*****************************************************//**
@@ -1469,7 +1590,7 @@ CodeGeneratorExitCode convert_operand_to_correct_type(
 	x86_Asm_IR_OperandType const& op1_t,
 	x86_Asm_IR_Operand          & converted_operand,
 	x86_Asm_IR_OperandType const& op2_t,
-	x86_Asm_IR*                 & instrs,
+	x86_Asm_IR_Appender         & instrs,
 	x86_RegisterAllocMap        & alloc_map)
 {
 	CodeGeneratorExitCode exitcode
@@ -1694,11 +1815,11 @@ CodeGeneratorExitCode convert_operand_to_correct_type(
 
 static inline
 CodeGeneratorExitCode construct_x86_AssemblyInstruction_multiply(
-	const Type*        const& op1_t,
-	x86_Asm_IR_Operand const& op1,
-	const Type*        const& op2_t,
-	x86_Asm_IR_Operand const& op2,
-	x86_Asm_IR*             & instrs) 
+	const Type*         const& op1_t,
+	x86_Asm_IR_Operand  const& op1,
+	const Type*         const& op2_t,
+	x86_Asm_IR_Operand  const& op2,
+	x86_Asm_IR_Appender      & instrs) 
 {
 	CodeGeneratorExitCode exitcode 
 		= CodeGeneratorExitCode::FAILURE;
@@ -1760,11 +1881,11 @@ CodeGeneratorExitCode construct_x86_AssemblyInstruction_multiply(
 
 static inline
 CodeGeneratorExitCode construct_x86_AssemblyInstruction_divide(
-	const Type*        const& op1_t,
-	x86_Asm_IR_Operand const& op1,
-	const Type*        const& op2_t,
-	x86_Asm_IR_Operand const& op2,
-	x86_Asm_IR*             & instrs)
+	const Type*         const& op1_t,
+	x86_Asm_IR_Operand  const& op1,
+	const Type*         const& op2_t,
+	x86_Asm_IR_Operand  const& op2,
+	x86_Asm_IR_Appender      & instrs)
 {
 	CodeGeneratorExitCode exitcode 
 		= CodeGeneratorExitCode::FAILURE;
@@ -1812,11 +1933,11 @@ CodeGeneratorExitCode construct_x86_AssemblyInstruction_divide(
 
 static inline
 CodeGeneratorExitCode construct_x86_AssemblyInstruction_move(
-	const Type*        const& dest_t,
-	x86_Asm_IR_Operand const& dest,
-	const Type*        const& source_t,
-	x86_Asm_IR_Operand const& source,
-	x86_Asm_IR*             & instrs)
+	const Type*         const& dest_t,
+	x86_Asm_IR_Operand  const& dest,
+	const Type*         const& source_t,
+	x86_Asm_IR_Operand  const& source,
+	x86_Asm_IR_Appender      & instrs)
 {
 	CodeGeneratorExitCode exitcode 
 		= CodeGeneratorExitCode::FAILURE_CONVERSION_ERROR;
@@ -1875,11 +1996,11 @@ CodeGeneratorExitCode construct_x86_AssemblyInstruction_move(
 
 static inline
 CodeGeneratorExitCode construct_x86_AssemblyInstruction_add(
-	const Type*        const& op1_t,
-	x86_Asm_IR_Operand const& op1,
-	const Type*        const& op2_t,
-	x86_Asm_IR_Operand const& op2,
-	x86_Asm_IR*             & instrs)
+	const Type*         const& op1_t,
+	x86_Asm_IR_Operand  const& op1,
+	const Type*         const& op2_t,
+	x86_Asm_IR_Operand  const& op2,
+	x86_Asm_IR_Appender      & instrs)
 {
 	CodeGeneratorExitCode exitcode 
 		= CodeGeneratorExitCode::FAILURE;
@@ -1921,11 +2042,11 @@ CodeGeneratorExitCode construct_x86_AssemblyInstruction_add(
 
 static inline
 CodeGeneratorExitCode construct_x86_AssemblyInstruction_subtract(
-	const Type*        const& op1_t,
-	x86_Asm_IR_Operand const& op1,
-	const Type*        const& op2_t,
-	x86_Asm_IR_Operand const& op2,
-	x86_Asm_IR*             & instrs)
+	const Type*         const& op1_t,
+	x86_Asm_IR_Operand  const& op1,
+	const Type*         const& op2_t,
+	x86_Asm_IR_Operand  const& op2,
+	x86_Asm_IR_Appender      & instrs)
 {
 	CodeGeneratorExitCode exitcode 
 		= CodeGeneratorExitCode::FAILURE;
@@ -2613,7 +2734,7 @@ x86_RegisterName allocate_register(
 static inline
 CodeGeneratorExitCode gen_symbol(
 	const SymbolTableEntry* const& symbol_entry,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_Asm_IR_Operand           & operand,
 	x86_RegisterAllocMap    const& map)
 {
@@ -2700,15 +2821,16 @@ const char* construct_label(
 
 static inline
 CodeGeneratorExitCode gen_literals(
-	int               & num_labels_used,
-	SymbolTable* const& symbol_table,
-	x86_Asm_IR*       & instrs)
+	int                      & num_labels_used,
+	SymbolTable*        const& symbol_table,
+	x86_Asm_IR_Appender      & instrs)
 {
 	report_gen("gen_literals");
 	CodeGeneratorExitCode exitcode
 		= CodeGeneratorExitCode::FAILURE;
 	
-	SymbolTableEntry*  entries [1028]  = { };
+	SymbolTableEntry** entries 
+		= new SymbolTableEntry*[symbol_table->get_num_entries() + 1] { };
 	symbol_table->get_entries(entries);
 	/* for each entry in the symbol table */
 	int literal_constant_ptr_i = 0;
@@ -2741,6 +2863,7 @@ CodeGeneratorExitCode gen_literals(
 			instrs++;
 		}
 	}
+	delete[] entries;
 	return exitcode;
 }
 
@@ -2748,7 +2871,7 @@ static inline
 CodeGeneratorExitCode gen_primary_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand)
 {
@@ -2862,7 +2985,7 @@ static inline
 CodeGeneratorExitCode gen_postfix_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand)
 {
@@ -3131,7 +3254,7 @@ static inline
 CodeGeneratorExitCode gen_unary_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand)
 {
@@ -3408,7 +3531,7 @@ static inline
 CodeGeneratorExitCode gen_cast_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand)
 {
@@ -3466,7 +3589,7 @@ static inline
 CodeGeneratorExitCode gen_multiplicative_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand)
 {
@@ -3652,7 +3775,7 @@ static inline
 CodeGeneratorExitCode gen_additive_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand)
 {
@@ -3784,7 +3907,7 @@ static inline
 CodeGeneratorExitCode gen_shift_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand)
 {
@@ -3910,7 +4033,7 @@ static inline
 CodeGeneratorExitCode gen_relational_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand)
 {
@@ -4031,7 +4154,7 @@ static inline
 CodeGeneratorExitCode gen_equality_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand)
 {
@@ -4132,7 +4255,7 @@ static inline
 CodeGeneratorExitCode gen_and_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand)
 {
@@ -4211,7 +4334,7 @@ static inline
 CodeGeneratorExitCode gen_exclusive_or_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand)
 {
@@ -4290,7 +4413,7 @@ static inline
 CodeGeneratorExitCode gen_inclusive_or_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand)
 {
@@ -4368,7 +4491,7 @@ static inline
 CodeGeneratorExitCode gen_logical_and_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand)
 {
@@ -4446,7 +4569,7 @@ static inline
 CodeGeneratorExitCode gen_logical_or_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand)
 {
@@ -4524,7 +4647,7 @@ static inline
 CodeGeneratorExitCode gen_conditional_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand)
 {
@@ -4695,7 +4818,7 @@ static inline
 CodeGeneratorExitCode gen_assignment_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand)
 {
@@ -4946,7 +5069,7 @@ static inline
 CodeGeneratorExitCode gen_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand)
 {
@@ -5012,7 +5135,7 @@ static inline
 CodeGeneratorExitCode gen_constant_expression(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand)
 {
@@ -5050,7 +5173,7 @@ static inline
 CodeGeneratorExitCode gen_declaration(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map)
 {
 	CodeGeneratorExitCode exitcode = CodeGeneratorExitCode::FAILURE;
@@ -5089,7 +5212,7 @@ static inline
 CodeGeneratorExitCode gen_declaration_specifiers(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_RegisterName        const& output_register)
 {
@@ -5194,7 +5317,7 @@ static inline
 CodeGeneratorExitCode gen_init_declarator_list(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map)
 {
 	CodeGeneratorExitCode exitcode 
@@ -5256,7 +5379,7 @@ static inline
 CodeGeneratorExitCode gen_init_declarator(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map)
 {
 	CodeGeneratorExitCode exitcode 
@@ -5333,7 +5456,7 @@ static inline
 CodeGeneratorExitCode gen_initializer(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand)
 {
@@ -5388,7 +5511,7 @@ static inline
 CodeGeneratorExitCode gen_designator_list(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map)
 {
 	CodeGeneratorExitCode exitcode 
@@ -5429,7 +5552,7 @@ static inline
 CodeGeneratorExitCode gen_designation(
 	int                       & num_labels_used,
 	AnnotatedAstNode*    const& node,
-	x86_Asm_IR*               & instrs,
+	x86_Asm_IR_Appender       & instrs,
 	x86_RegisterAllocMap const& alloc_map)
 {
 	CodeGeneratorExitCode exitcode 
@@ -5468,7 +5591,7 @@ static inline
 CodeGeneratorExitCode gen_initializer_list(
 	int                          &num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map)
 {
 	CodeGeneratorExitCode exitcode 
@@ -5530,7 +5653,7 @@ static inline
 CodeGeneratorExitCode gen_statement(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map)
 {
 	CodeGeneratorExitCode exitcode 
@@ -5646,7 +5769,7 @@ static inline
 CodeGeneratorExitCode gen_labeled_statement(
 	int                          &num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs)
+	x86_Asm_IR_Appender          & instrs)
 {
 	CodeGeneratorExitCode exitcode 
 		= CodeGeneratorExitCode::FAILURE;
@@ -5662,7 +5785,7 @@ CodeGeneratorExitCode gen_labeled_statement(
 			const AnnotatedAstNode* const statement 
 				= identifier->get_sibling();
 
-			x86_Asm_IR* statement_start = instrs;
+			x86_Asm_IR* statement_start = &*instrs;
 			if (gen_statement(				num_labels_used,
 				node,
 				instrs,
@@ -5707,7 +5830,7 @@ static inline
 CodeGeneratorExitCode gen_compound_statement(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map)
 {
 	CodeGeneratorExitCode exitcode 
@@ -5745,7 +5868,7 @@ static inline
 CodeGeneratorExitCode gen_block_item_list(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map)
 {
 	CodeGeneratorExitCode exitcode 
@@ -5811,7 +5934,7 @@ static inline
 CodeGeneratorExitCode gen_block_item(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map)
 {
 	CodeGeneratorExitCode exitcode 
@@ -5864,7 +5987,7 @@ static inline
 CodeGeneratorExitCode gen_expression_statement(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map,
 	x86_Asm_IR_Operand           & operand)
 {
@@ -5900,9 +6023,9 @@ CodeGeneratorExitCode gen_expression_statement(
 
 static inline
 CodeGeneratorExitCode gen_selection_statement(
-	int                           & num_labels_used,
-	const AnnotatedAstNode*  const& node,
-	x86_Asm_IR*                   & instrs)
+	int                          & num_labels_used,
+	const AnnotatedAstNode* const& node,
+	x86_Asm_IR_Appender          & instrs)
 {
 	CodeGeneratorExitCode exitcode 
 		= CodeGeneratorExitCode::FAILURE;
@@ -5928,9 +6051,9 @@ CodeGeneratorExitCode gen_selection_statement(
 
 static inline
 CodeGeneratorExitCode gen_iteration_statement(
-	int                           & num_labels_used,
-	const AnnotatedAstNode*  const& node,
-	x86_Asm_IR*                   & instrs)
+	int                          & num_labels_used,
+	const AnnotatedAstNode* const& node,
+	x86_Asm_IR_Appender          & instrs)
 {
 	CodeGeneratorExitCode exitcode 
 		= CodeGeneratorExitCode::FAILURE;
@@ -5961,7 +6084,7 @@ static inline
 CodeGeneratorExitCode gen_jump_statement(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs)
+	x86_Asm_IR_Appender          & instrs)
 {
 	CodeGeneratorExitCode exitcode 
 		= CodeGeneratorExitCode::FAILURE;
@@ -6023,9 +6146,9 @@ CodeGeneratorExitCode gen_jump_statement(
 
 static inline
 CodeGeneratorExitCode gen_translation_unit(
-	int                    & num_labels_used,
-	AnnotatedAstNode* const& node,
-	x86_Asm_IR*            & instrs)
+	int                          & num_labels_used,
+	const AnnotatedAstNode* const& node,
+	x86_Asm_IR_Appender          & instrs)
 {
 	CodeGeneratorExitCode exitcode 
 		= CodeGeneratorExitCode::FAILURE;
@@ -6034,7 +6157,11 @@ CodeGeneratorExitCode gen_translation_unit(
 
 	x86_RegisterAllocMap alloc_map = construct_blank_alloc_map();
 
-	gen_literals(num_labels_used, node->get_symbol_table(), instrs);
+	/* Literals live in the file's symbol table, so only the
+	   outermost translation unit generates them. */
+	if (node->get_parent() == NULL) {
+		gen_literals(num_labels_used, node->get_symbol_table(), instrs);
+	}
 
 	switch (node->get_alt()) {
 
@@ -6061,14 +6188,14 @@ CodeGeneratorExitCode gen_translation_unit(
 				= translation_unit->get_sibling();
 			if (gen_translation_unit(
 				num_labels_used,
-				node,
+				translation_unit,
 				instrs)
 				== CodeGeneratorExitCode::FAILURE) {
-
+				break;
 			}
 			if (gen_external_declaration(
 				num_labels_used,
-				node,
+				external_declaration,
 				instrs)
 				== CodeGeneratorExitCode::FAILURE) {
 				break;
@@ -6087,7 +6214,7 @@ static inline
 CodeGeneratorExitCode gen_external_declaration(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs)
+	x86_Asm_IR_Appender          & instrs)
 {
 	CodeGeneratorExitCode exitcode 
 		= CodeGeneratorExitCode::FAILURE;
@@ -6137,7 +6264,7 @@ static inline
 CodeGeneratorExitCode gen_function_definition(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs)
+	x86_Asm_IR_Appender          & instrs)
 {
 	CodeGeneratorExitCode exitcode 
 		= CodeGeneratorExitCode::FAILURE;
@@ -6193,7 +6320,8 @@ CodeGeneratorExitCode gen_function_definition(
 			SymbolTable* const func_sym_tab 
 				= node->get_symbol_table();
 
-			SymbolTableEntry* arguments[1028] = { };
+			SymbolTableEntry** arguments 
+				= new SymbolTableEntry*[func_sym_tab->get_num_entries() + 1] { };
 			func_sym_tab->get_entries(arguments);
 			for (SymbolTableEntry** e = arguments;
 				 *e != NULL;
@@ -6220,6 +6348,7 @@ CodeGeneratorExitCode gen_function_definition(
 					xmm1_operand);
 				// TODO; stub.
 			}
+			delete[] arguments;
 
 			if (gen_compound_statement(
 				num_labels_used,
@@ -6251,7 +6380,7 @@ static inline
 CodeGeneratorExitCode gen_declaration_list(
 	int                          & num_labels_used,
 	const AnnotatedAstNode* const& node,
-	x86_Asm_IR*                  & instrs,
+	x86_Asm_IR_Appender          & instrs,
 	x86_RegisterAllocMap    const& alloc_map)
 {
 	CodeGeneratorExitCode exitcode 
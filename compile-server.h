@@ -0,0 +1,380 @@
+/* Authored by Charlie Keaney                        */
+/* compile-server.h - Responsible for running kcc as a
+					  resident compile server which
+					  accepts compile requests on a
+					  local Unix socket.
+
+					  Implementation Notes:
+					  A client connects, writes a
+					  single line holding the same
+					  arguments kcc takes on the
+					  command line and reads back
+					  everything kcc would print,
+					  followed by a final line
+					  'kcc:exit:<code>'. Paths are
+					  resolved against the server's
+					  working directory. The line
+					  '--shutdown' stops the server.
+
+					  Between requests the lexema
+					  pool and symbol tables are
+					  reset rather than reallocated
+					  and the parser's lookahead
+					  tables stay built, so a small
+					  compile pays for none of the
+					  set-up a fresh process does.
+					  Requests are served one at a
+					  time, so -j is ignored, and a
+					  client which stays silent for
+					  longer than the read timeout is
+					  hung up on so that it cannot
+					  hold up the rest.            */
+
+#ifndef COMPILE_SERVER_H
+#define COMPILE_SERVER_H 1
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#if defined(_WIN32)
+#else
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "driver.h"
+
+#define COMPILE_SERVER_MAX_REQUEST_SZ (1 << 16)
+#define COMPILE_SERVER_BACKLOG        64
+/* Seconds a client may leave a request unfinished. */
+#define COMPILE_SERVER_TIMEOUT_S      5
+
+using namespace std;
+
+/*****************************************************//**
+*                      Declarations                      *
+/********************************************************/
+
+enum class CompileServerExitCode {
+	SUCCESS,
+	FAILURE
+};
+
+/**
+* The state kept warm between requests.
+**/
+struct CompileServer {
+	int             listen_fd;
+	LexemaPool*     lexema;
+	SymbolTablePool symbol_tables;
+	bool            shutting_down;
+};
+
+/**
+* Listens on the given socket and serves compile
+* requests until asked to shut down.
+*
+* @param socket_path The path of the Unix socket to create.
+* @return Returns an exitcode for success or failure.
+**/
+static inline
+CompileServerExitCode serve(
+	const char* const& socket_path);
+
+/**
+* Reads a request line from a client.
+*
+* @param fd The client's connection.
+* @param request The line read, without its new-line.
+* @return Returns false if no complete line was read.
+**/
+static inline
+bool read_compile_request(
+	int    const& fd,
+	string      & request);
+
+/**
+* Writes the whole of the given data to a client.
+*
+* @param fd The client's connection.
+* @param data The data to write.
+* @param size The number of bytes to write.
+* @return Returns false if the client went away.
+**/
+static inline
+bool write_compile_response(
+	int         const& fd,
+	const char* const& data,
+	size_t      const& size);
+
+/**
+* Compiles what a single request asks for, writing
+* the output to the given stream.
+*
+* @param server The server handling the request.
+* @param request The request line.
+* @param out The stream to write output to.
+* @return Returns an exitcode based on how compilation went.
+**/
+static inline
+KccExitCode handle_compile_request(
+	CompileServer      & server,
+	string        const& request,
+	ostream            & out);
+
+/*****************************************************//**
+*                         Definitions                    *
+/********************************************************/
+
+static inline
+KccExitCode handle_compile_request(
+	CompileServer      & server,
+	string        const& request,
+	ostream            & out)
+{
+	/* Split the line into arguments, in place. */
+	char* line = new char[request.size() + 1];
+	memcpy(line, request.c_str(), request.size() + 1);
+	const char** argv
+		= new const char*[request.size() / 2 + 2];
+	int argc = 0;
+	argv[argc++] = "kcc";
+	for (char* c = line; *c; ) {
+		while (*c == ' ' || *c == '\t' || *c == '\r') {
+			*c++ = '\0';
+		}
+		if (*c) {
+			argv[argc++] = c;
+			while (*c && *c != ' ' && *c != '\t' && *c != '\r') {
+				c++;
+			}
+		}
+	}
+
+	KccExitCode exitcode
+		= KccExitCode::FAIL;
+	CompilerArgs args
+		= interpret_args(argv, argc);
+	if (args.flags.help) {
+		out << help_msg;
+	}
+	CompilerFlags flags = args.flags;
+	flags.help = false;
+
+	if (args.num_dests > 0) {
+		exitcode = KccExitCode::SUCCESS;
+	}
+	for (int i = 0; i < args.num_dests; i++) {
+		if (drive(
+				args.dests[i],
+				flags,
+				out,
+				server.lexema)
+			!= KccExitCode::SUCCESS) {
+			exitcode = KccExitCode::FAIL;
+		}
+		/* Everything from this compile is finished with,
+		   the symbol tables go first as they name lexema. */
+		server.symbol_tables.reset();
+		reset_lexema_pool(*server.lexema);
+	}
+
+	free_compiler_args(args);
+	delete[] argv;
+	delete[] line;
+	return exitcode;
+}
+
+#if defined(_WIN32)
+
+static inline
+CompileServerExitCode serve(
+	const char* const& socket_path)
+{
+	cout << ERR_COLOUR_START
+		 << "kcc:error:the compile server needs Unix sockets"
+		 << ERR_COLOUR_FINISHED
+		 << endl;
+	return CompileServerExitCode::FAILURE;
+}
+
+#else
+
+static inline
+bool read_compile_request(
+	int    const& fd,
+	string      & request)
+{
+	request.clear();
+	char buffer[4096];
+	while (request.size() < COMPILE_SERVER_MAX_REQUEST_SZ) {
+		const ssize_t n
+			= read(fd, buffer, sizeof(buffer));
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			return false;
+		}
+		request.append(buffer, n);
+		const size_t new_line
+			= request.find('\n');
+		if (new_line != string::npos) {
+			request.resize(new_line);
+			return true;
+		}
+	}
+	return false;
+}
+
+static inline
+bool write_compile_response(
+	int         const& fd,
+	const char* const& data,
+	size_t      const& size)
+{
+	size_t written = 0;
+	while (written < size) {
+		const ssize_t n
+			= write(fd, data + written, size - written);
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			return false;
+		}
+		written += n;
+	}
+	return true;
+}
+
+static inline
+CompileServerExitCode serve(
+	const char* const& socket_path)
+{
+	struct sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (strlen(socket_path) >= sizeof(address.sun_path)) {
+		cout << ERR_COLOUR_START
+			 << "kcc:error:socket path too long "
+			 << socket_path
+			 << ERR_COLOUR_FINISHED
+			 << endl;
+		return CompileServerExitCode::FAILURE;
+	}
+	strcpy(address.sun_path, socket_path);
+
+	/* Remove a socket left behind by an earlier server,
+	   but nothing else that happens to be at the path. */
+	struct stat st;
+	if (lstat(socket_path, &st) == 0) {
+		if (!S_ISSOCK(st.st_mode)) {
+			cout << ERR_COLOUR_START
+				 << "kcc:error:"
+				 << socket_path
+				 << " exists and is not a socket"
+				 << ERR_COLOUR_FINISHED
+				 << endl;
+			return CompileServerExitCode::FAILURE;
+		}
+		unlink(socket_path);
+	}
+
+	CompileServer server;
+	server.listen_fd
+		= socket(AF_UNIX, SOCK_STREAM, 0);
+	if (server.listen_fd < 0
+		|| bind(
+			   server.listen_fd,
+			   (struct sockaddr*) &address,
+			   sizeof(address)) != 0
+		|| listen(
+			   server.listen_fd,
+			   COMPILE_SERVER_BACKLOG) != 0) {
+		cout << ERR_COLOUR_START
+			 << "kcc:error:could not listen on "
+			 << socket_path
+			 << ERR_COLOUR_FINISHED
+			 << endl;
+		if (server.listen_fd >= 0) {
+			close(server.listen_fd);
+		}
+		return CompileServerExitCode::FAILURE;
+	}
+	/* A client hanging up early must not kill us. */
+	signal(SIGPIPE, SIG_IGN);
+
+	server.lexema = new LexemaPool();
+	server.shutting_down = false;
+	active_symbol_table_pool = &server.symbol_tables;
+
+	while (!server.shutting_down) {
+		const int client_fd
+			= accept(server.listen_fd, NULL, NULL);
+		if (client_fd < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			break;
+		}
+
+		/* Reads and writes give up on a stalled client. */
+		struct timeval timeout;
+		timeout.tv_sec  = COMPILE_SERVER_TIMEOUT_S;
+		timeout.tv_usec = 0;
+		setsockopt(
+			client_fd,
+			SOL_SOCKET,
+			SO_RCVTIMEO,
+			&timeout,
+			sizeof(timeout));
+		setsockopt(
+			client_fd,
+			SOL_SOCKET,
+			SO_SNDTIMEO,
+			&timeout,
+			sizeof(timeout));
+
+		string request;
+		if (read_compile_request(client_fd, request)) {
+			ostringstream output;
+			KccExitCode exitcode
+				= KccExitCode::SUCCESS;
+			if (request == "--shutdown") {
+				server.shutting_down = true;
+			} else {
+				exitcode = handle_compile_request(
+					server,
+					request,
+					output);
+			}
+			output << "kcc:exit:"
+				   << (int) exitcode
+				   << endl;
+			const string response
+				= output.str();
+			write_compile_response(
+				client_fd,
+				response.c_str(),
+				response.size());
+		}
+		close(client_fd);
+	}
+
+	active_symbol_table_pool = NULL;
+	delete server.lexema;
+	close(server.listen_fd);
+	unlink(socket_path);
+	return CompileServerExitCode::SUCCESS;
+}
+
+#endif
+
+#endif
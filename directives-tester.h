@@ -0,0 +1,722 @@
+/* Authored by Charlie Keaney                     */
+/* directives-tester.h - Responsible for testing
+						 the preprocessor's
+						 execution of directives,
+						 by preprocessing small
+						 sources and comparing the
+						 pp-tokens they produce.  */
+
+#ifndef DIRECTIVES_TESTER_H
+#define DIRECTIVES_TESTER_H 1
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "tester-tools.h"
+#include "token-stream.h"
+#include "parser.h"
+
+#define NUM_DIRECTIVES_TESTS 5
+
+/* What preprocessing a test's source should do: fail,
+   or produce the pp-tokens expected.               */
+enum class DirectiveTestOutcome {
+	FAILURE,
+	SUCCESS
+};
+
+using namespace std;
+
+/**
+* Preprocesses a source, as the driver does, into the
+* spellings of its pp-tokens, each followed by a space.
+*
+* @param source The source, ended by a NUL.
+* @param filename The name to give the source.
+* @param include_dirs The directories #include searches.
+* @param num_include_dirs The number of directories.
+* @param spelling Set to the pp-tokens produced.
+* @return Returns whether preprocessing succeeded.
+**/
+static inline DirectiveTestOutcome preprocess_test_source(
+	const char*        const& source,
+	const char*        const& filename,
+	const char* const* const& include_dirs,
+	int                const& num_include_dirs,
+	string                  & spelling)
+{
+	Arena arena;
+	active_arena = &arena;
+	DirectiveTestOutcome outcome;
+	{
+		LexemaPool lexema;
+		SourceMap sources;
+		IncludeTable includes(include_dirs, num_include_dirs);
+		AlertList bkl = AlertList();
+		PreprocessorStream pp_tokens(
+			source,
+			lexema,
+			filename,
+			sources,
+			includes,
+			bkl);
+		PreprocessingTokenRing ring;
+		spelling.clear();
+		while (pp_tokens.fill(ring)) {
+			for (; !ring.is_empty(); ring.pop()) {
+				spelling += ring.front().get_lexeme();
+				spelling += ' ';
+			}
+		}
+		outcome = pp_tokens.get_exitcode()
+			== PreprocessorExitCode::SUCCESS
+			? DirectiveTestOutcome::SUCCESS
+			: DirectiveTestOutcome::FAILURE;
+		/* As with the driver, nothing is shown of a
+		   source that fails part way. */
+		if (outcome == DirectiveTestOutcome::FAILURE) {
+			spelling.clear();
+		}
+	}
+	active_arena = NULL;
+	return outcome;
+}
+
+//////////////////////////////////////////////////////////////////
+//        Testing for the evaluation of #if expressions         //
+//////////////////////////////////////////////////////////////////
+
+#define NUM_IF_EXPRESSION_TESTS 36
+
+struct if_expression_test_case {
+	const char*          expression;
+	DirectiveTestOutcome outcome;
+	bool                 is_true;
+};
+
+/* Each expression is tested in this source, so ONE and
+   EMPTY are defined.                               */
+#define IF_EXPRESSION_TEST_PREFIX \
+	"#define ONE 1\n"             \
+	"#define EMPTY\n"             \
+	"#if "
+#define IF_EXPRESSION_TEST_SUFFIX \
+	"\n"                          \
+	"yes\n"                       \
+	"#else\n"                     \
+	"no\n"                        \
+	"#endif\n"
+
+static const
+if_expression_test_case
+test_if_expression_table[NUM_IF_EXPRESSION_TESTS] = {
+	{ "1",                            DirectiveTestOutcome::SUCCESS, true  },
+	{ "0",                            DirectiveTestOutcome::SUCCESS, false },
+	{ "1 + 2 * 3 == 7",               DirectiveTestOutcome::SUCCESS, true  },
+	{ "(1 + 2) * 3 == 9",             DirectiveTestOutcome::SUCCESS, true  },
+	{ "7 / 2 == 3 && 7 % 2 == 1",     DirectiveTestOutcome::SUCCESS, true  },
+	{ "3 > 2 > 1",                    DirectiveTestOutcome::SUCCESS, false },
+	{ "1 << 62 > 0",                  DirectiveTestOutcome::SUCCESS, true  },
+	{ "(6 & 3) == 2 && (6 | 3) == 7", DirectiveTestOutcome::SUCCESS, true  },
+	{ "(6 ^ 3) == 5",                 DirectiveTestOutcome::SUCCESS, true  },
+	{ "~0 == -1",                     DirectiveTestOutcome::SUCCESS, true  },
+	{ "!0 && !!2",                    DirectiveTestOutcome::SUCCESS, true  },
+	{ "-1 < 0",                       DirectiveTestOutcome::SUCCESS, true  },
+	{ "-1 < 0u",                      DirectiveTestOutcome::SUCCESS, false },
+	{ "18446744073709551615u == -1",  DirectiveTestOutcome::SUCCESS, true  },
+	{ "-9223372036854775807 - 1 < 0", DirectiveTestOutcome::SUCCESS, true  },
+	{ "0x10 == 16 && 010 == 8",       DirectiveTestOutcome::SUCCESS, true  },
+	{ "10L == 10 && 10ull == 10",     DirectiveTestOutcome::SUCCESS, true  },
+	{ "'a' == 97 && '\\n' == 10",     DirectiveTestOutcome::SUCCESS, true  },
+	{ "1 ? 2 : 0",                    DirectiveTestOutcome::SUCCESS, true  },
+	{ "0 ? 1 : 0",                    DirectiveTestOutcome::SUCCESS, false },
+	{ "1 ? 0 : 1 ? 1 : 1",            DirectiveTestOutcome::SUCCESS, false },
+	{ "0 && 1 / 0",                   DirectiveTestOutcome::SUCCESS, false },
+	{ "1 || 1 / 0",                   DirectiveTestOutcome::SUCCESS, true  },
+	{ "(2 || 0) == 1",                DirectiveTestOutcome::SUCCESS, true  },
+	{ "defined ONE",                  DirectiveTestOutcome::SUCCESS, true  },
+	{ "defined(EMPTY)",               DirectiveTestOutcome::SUCCESS, true  },
+	{ "defined UNDEFINED_NAME",       DirectiveTestOutcome::SUCCESS, false },
+	{ "!defined ONE",                 DirectiveTestOutcome::SUCCESS, false },
+	{ "ONE + ONE == 2",               DirectiveTestOutcome::SUCCESS, true  },
+	{ "undefined_name",               DirectiveTestOutcome::SUCCESS, false },
+	{ "1 / 0",                        DirectiveTestOutcome::FAILURE, false },
+	{ "1 % 0",                        DirectiveTestOutcome::FAILURE, false },
+	{ "1.0",                          DirectiveTestOutcome::FAILURE, false },
+	{ "(1",                           DirectiveTestOutcome::FAILURE, false },
+	{ "1 +",                          DirectiveTestOutcome::FAILURE, false },
+	{ "",                             DirectiveTestOutcome::FAILURE, false }
+};
+
+/**
+* Preprocesses an #if of each expression, expecting
+* the group or the #else group to be kept as the
+* expression is true or false, or an error.
+**/
+static inline TestResult test_if_expression(
+	TestResult results[NUM_IF_EXPRESSION_TESTS])
+{
+	bool all_tests_passed = true;
+	for (const if_expression_test_case* itc
+			= test_if_expression_table;
+		itc < test_if_expression_table + NUM_IF_EXPRESSION_TESTS;
+		itc++) {
+		const string source
+			= string(IF_EXPRESSION_TEST_PREFIX)
+			  + itc->expression
+			  + IF_EXPRESSION_TEST_SUFFIX;
+		string spelling;
+		const DirectiveTestOutcome outcome = preprocess_test_source(
+			source.c_str(),
+			"if-expression.c",
+			NULL,
+			0,
+			spelling);
+		const bool success_criteria
+			= outcome == itc->outcome
+			  && (outcome == DirectiveTestOutcome::FAILURE
+				  || spelling == (itc->is_true ? "yes " : "no "));
+		results[itc - test_if_expression_table]
+			= success_criteria ? TestResult::SUCCESS : TestResult::FAIL;
+		if (!success_criteria) {
+			all_tests_passed = false;
+		}
+	}
+	return all_tests_passed ? TestResult::SUCCESS : TestResult::FAIL;
+}
+
+//////////////////////////////////////////////////////////////////
+//          Testing for the skipping of false groups            //
+//////////////////////////////////////////////////////////////////
+
+#define NUM_SKIPPED_GROUP_TESTS 21
+
+struct skipped_group_test_case {
+	const char*          source;
+	DirectiveTestOutcome outcome;
+	const char*          spelling;
+};
+
+static const
+skipped_group_test_case
+test_skipped_group_table[NUM_SKIPPED_GROUP_TESTS] = {
+	{ "#if 0\nint a;\n#endif\nint b;\n",
+	  DirectiveTestOutcome::SUCCESS, "int b ; " },
+	{ "#if 0\nint a;\n#else\nint b;\n#endif\n",
+	  DirectiveTestOutcome::SUCCESS, "int b ; " },
+	{ "#if 0\nint a;\n#elif 1\nint b;\n#else\nint c;\n#endif\n",
+	  DirectiveTestOutcome::SUCCESS, "int b ; " },
+	{ "#if 1\nint a;\n#elif 1\nint b;\n#else\nint c;\n#endif\n",
+	  DirectiveTestOutcome::SUCCESS, "int a ; " },
+	{ "#ifdef UNDEFINED_NAME\nint a;\n#endif\nint b;\n",
+	  DirectiveTestOutcome::SUCCESS, "int b ; " },
+	{ "#if 0\n#if 1\nint a;\n#endif\nint b;\n#endif\nint c;\n",
+	  DirectiveTestOutcome::SUCCESS, "int c ; " },
+	{ "#if 0\n#ifdef X\n#ifndef Y\n#endif\n#else\n#endif\n#else\nint c;\n#endif\n",
+	  DirectiveTestOutcome::SUCCESS, "int c ; " },
+	{ "#if 0\n  #  if 1\nint a;\n\t#\tendif\nint b;\n#endif\nint c;\n",
+	  DirectiveTestOutcome::SUCCESS, "int c ; " },
+	{ "#if 0\n# /* c */ if 1\nint a;\n#endif\nint b;\n#endif\nint c;\n",
+	  DirectiveTestOutcome::SUCCESS, "int c ; " },
+	{ "#if 0\n/* c */ # if 1\nint a;\n#endif\nint b;\n#endif\nint c;\n",
+	  DirectiveTestOutcome::SUCCESS, "int c ; " },
+	{ "#if 0\n# /* c\n*/ if 1\nint a;\n#endif\nint b;\n#endif\nint c;\n",
+	  DirectiveTestOutcome::SUCCESS, "int c ; " },
+	{ "#if 0\n%:if 1\nint a;\n%:endif\nint b;\n#endif\nint c;\n",
+	  DirectiveTestOutcome::SUCCESS, "int c ; " },
+	{ "#if 0\n#i\\\nf 1\nint a;\n#endif\nint b;\n#endif\nint c;\n",
+	  DirectiveTestOutcome::SUCCESS, "int c ; " },
+	{ "#if 0\n#\\\nif 1\nint a;\n#endif\nint b;\n#endif\nint c;\n",
+	  DirectiveTestOutcome::SUCCESS, "int c ; " },
+	{ "#if 0\nint a; \\\n#if 1\nint b;\n#endif\nint c;\n",
+	  DirectiveTestOutcome::SUCCESS, "int c ; " },
+	{ "#if 0\n// a \\\n#if 1\nint b;\n#endif\nint c;\n",
+	  DirectiveTestOutcome::SUCCESS, "int c ; " },
+	{ "#if 0\n/*\n#if 1\n*/\nint b;\n#endif\nint c;\n",
+	  DirectiveTestOutcome::SUCCESS, "int c ; " },
+	{ "#if 0\n#iff 1\n#endif\nint c;\n",
+	  DirectiveTestOutcome::SUCCESS, "int c ; " },
+	{ "#if 0\n# /* */ if 1\nint bad2;\n#endif\nint bad3;\n#endif\n",
+	  DirectiveTestOutcome::SUCCESS, "" },
+	{ "#if 0\nint a;\n#endif\n#endif\nint b;\n",
+	  DirectiveTestOutcome::FAILURE, "" },
+	{ "#if 0\nint a;\n",
+	  DirectiveTestOutcome::FAILURE, "" }
+};
+
+/**
+* Preprocesses each source, expecting the directives
+* in its false groups to be nested as they would be
+* were the groups tokenised.
+**/
+static inline TestResult test_skipped_group(
+	TestResult results[NUM_SKIPPED_GROUP_TESTS])
+{
+	bool all_tests_passed = true;
+	for (const skipped_group_test_case* stc
+			= test_skipped_group_table;
+		stc < test_skipped_group_table + NUM_SKIPPED_GROUP_TESTS;
+		stc++) {
+		string spelling;
+		const DirectiveTestOutcome outcome = preprocess_test_source(
+			stc->source,
+			"skipped-group.c",
+			NULL,
+			0,
+			spelling);
+		const bool success_criteria
+			= outcome == stc->outcome
+			  && spelling == stc->spelling;
+		results[stc - test_skipped_group_table]
+			= success_criteria ? TestResult::SUCCESS : TestResult::FAIL;
+		if (!success_criteria) {
+			all_tests_passed = false;
+		}
+	}
+	return all_tests_passed ? TestResult::SUCCESS : TestResult::FAIL;
+}
+
+//////////////////////////////////////////////////////////////////
+//             Testing for the inclusion of files               //
+//////////////////////////////////////////////////////////////////
+
+/* The files the include tests find, written beneath a
+   directory of the system's temporary directory. The
+   directory inc/ is searched as -I inc would search it. */
+#define NUM_INCLUDE_TEST_FILES 11
+
+struct include_test_file {
+	const char* path;
+	const char* contents;
+};
+
+static const
+include_test_file
+include_test_files[NUM_INCLUDE_TEST_FILES] = {
+	{ "local.h",          "int local;\n" },
+	{ "inc/local.h",      "int shadowed;\n" },
+	{ "inc/plain.h",      "int plain;\n" },
+	{ "inc/nested.h",     "#include \"plain.h\"\nint nested;\n" },
+	{ "inc/guarded.h",    "#ifndef GUARDED_H\n"
+						  "#define GUARDED_H\n"
+						  "int guarded;\n"
+						  "#endif\n" },
+	{ "inc/commented.h",  "/* guard */\n"
+						  "#ifndef COMMENTED_H\n"
+						  "#define COMMENTED_H\n"
+						  "int commented;\n"
+						  "#endif\n"
+						  "// end\n" },
+	{ "inc/unguarded.h",  "#ifndef UNGUARDED_H\n"
+						  "#define UNGUARDED_H\n"
+						  "int first;\n"
+						  "#else\n"
+						  "int again;\n"
+						  "#endif\n" },
+	{ "inc/once.h",       "#pragma once\nint once;\n" },
+	{ "inc/self.h",       "#include \"self.h\"\n" },
+	{ "inc/invalid.h",    "int invalid;\n#endif\n" },
+	{ "inc/sub/deep.h",   "#include \"../plain.h\"\nint deep;\n" }
+};
+
+/**
+* Writes the files the include tests find.
+*
+* @param dir Set to the directory written beneath,
+*		 ending in '/'.
+* @return Returns whether every file was written.
+**/
+static inline bool write_include_test_files(
+	string& dir)
+{
+	error_code error;
+	const filesystem::path root
+		= filesystem::temp_directory_path(error)
+		  / "kcc-include-tests";
+	if (error) {
+		return false;
+	}
+	dir = root.generic_string() + "/";
+	for (const include_test_file* itf = include_test_files;
+		itf < include_test_files + NUM_INCLUDE_TEST_FILES;
+		itf++) {
+		const filesystem::path path = root / itf->path;
+		filesystem::create_directories(path.parent_path(), error);
+		ofstream file(path, ios::binary);
+		file << itf->contents;
+		if (error || !file) {
+			return false;
+		}
+	}
+	return true;
+}
+
+#define NUM_INCLUDE_TESTS 20
+
+struct include_test_case {
+	const char*          source;
+	DirectiveTestOutcome outcome;
+	const char*          spelling;
+};
+
+static const
+include_test_case
+test_include_table[NUM_INCLUDE_TESTS] = {
+	{ "#include \"local.h\"\n",
+	  DirectiveTestOutcome::SUCCESS, "int local ; " },
+	{ "#include <local.h>\n",
+	  DirectiveTestOutcome::SUCCESS, "int shadowed ; " },
+	{ "#include \"plain.h\"\n",
+	  DirectiveTestOutcome::SUCCESS, "int plain ; " },
+	{ "#include <plain.h>\nint a;\n#include <plain.h>\n",
+	  DirectiveTestOutcome::SUCCESS, "int plain ; int a ; int plain ; " },
+	{ "#include \"inc/plain.h\"\n#include <plain.h>\n",
+	  DirectiveTestOutcome::SUCCESS, "int plain ; int plain ; " },
+	{ "#include <nested.h>\n",
+	  DirectiveTestOutcome::SUCCESS, "int plain ; int nested ; " },
+	{ "#include <sub/deep.h>\n",
+	  DirectiveTestOutcome::SUCCESS, "int plain ; int deep ; " },
+	{ "#include <guarded.h>\n#include <guarded.h>\n",
+	  DirectiveTestOutcome::SUCCESS, "int guarded ; " },
+	{ "#include <guarded.h>\n#include \"inc/guarded.h\"\n",
+	  DirectiveTestOutcome::SUCCESS, "int guarded ; " },
+	{ "#include <guarded.h>\n#ifdef GUARDED_H\nint a;\n#endif\n",
+	  DirectiveTestOutcome::SUCCESS, "int guarded ; int a ; " },
+	{ "#define GUARDED_H\n#include <guarded.h>\nint a;\n",
+	  DirectiveTestOutcome::SUCCESS, "int a ; " },
+	{ "#include <commented.h>\n#include <commented.h>\n",
+	  DirectiveTestOutcome::SUCCESS, "int commented ; " },
+	{ "#include <unguarded.h>\n#include <unguarded.h>\n",
+	  DirectiveTestOutcome::SUCCESS, "int first ; int again ; " },
+	{ "#include <once.h>\n#include <once.h>\n",
+	  DirectiveTestOutcome::SUCCESS, "int once ; " },
+	{ "#include <once.h>\n#include \"inc/once.h\"\n",
+	  DirectiveTestOutcome::SUCCESS, "int once ; " },
+	{ "#if 0\n#include <missing.h>\n#endif\nint a;\n",
+	  DirectiveTestOutcome::SUCCESS, "int a ; " },
+	{ "#include <missing.h>\n",
+	  DirectiveTestOutcome::FAILURE, "" },
+	{ "#include <>\n",
+	  DirectiveTestOutcome::FAILURE, "" },
+	{ "#include <self.h>\n",
+	  DirectiveTestOutcome::FAILURE, "" },
+	{ "#include <invalid.h>\n",
+	  DirectiveTestOutcome::FAILURE, "" }
+};
+
+/**
+* Preprocesses each source as a file of the include
+* tests' directory, searching inc/ for angled names.
+**/
+static inline TestResult test_include(
+	TestResult results[NUM_INCLUDE_TESTS])
+{
+	string dir;
+	const bool is_written = write_include_test_files(dir);
+	const string filename = dir + "main.c";
+	const string include_dir = dir + "inc";
+	const char* const include_dirs[] = { include_dir.c_str() };
+	bool all_tests_passed = true;
+	for (const include_test_case* itc = test_include_table;
+		itc < test_include_table + NUM_INCLUDE_TESTS;
+		itc++) {
+		string spelling;
+		const DirectiveTestOutcome outcome = preprocess_test_source(
+			itc->source,
+			filename.c_str(),
+			include_dirs,
+			1,
+			spelling);
+		const bool success_criteria
+			= is_written
+			  && outcome == itc->outcome
+			  && spelling == itc->spelling;
+		results[itc - test_include_table]
+			= success_criteria ? TestResult::SUCCESS : TestResult::FAIL;
+		if (!success_criteria) {
+			all_tests_passed = false;
+		}
+	}
+	return all_tests_passed ? TestResult::SUCCESS : TestResult::FAIL;
+}
+
+//////////////////////////////////////////////////////////////////
+//            Testing for the caching of #include lookups       //
+//////////////////////////////////////////////////////////////////
+
+#define NUM_INCLUDE_CACHE_TESTS 12
+
+struct include_cache_test_case {
+	const char*          includer_dir;
+	const char*          spelling;
+	bool                 is_angled;
+	IncludeCacheExitCode exitcode;
+	/* Where the file should be found, beneath the
+	   include tests' directory.                   */
+	const char*          path;
+};
+
+/* Each lookup is made twice, in order, through one
+   cache, so that later lookups are answered from it. */
+static const
+include_cache_test_case
+test_include_cache_table[NUM_INCLUDE_CACHE_TESTS] = {
+	{ "",     "local.h",        false, IncludeCacheExitCode::SUCCESS, "local.h"        },
+	{ "",     "local.h",        true,  IncludeCacheExitCode::SUCCESS, "inc/local.h"    },
+	{ "inc/", "local.h",        false, IncludeCacheExitCode::SUCCESS, "inc/local.h"    },
+	{ "",     "plain.h",        false, IncludeCacheExitCode::SUCCESS, "inc/plain.h"    },
+	{ "",     "plain.h",        true,  IncludeCacheExitCode::SUCCESS, "inc/plain.h"    },
+	{ "inc/", "plain.h",        false, IncludeCacheExitCode::SUCCESS, "inc/plain.h"    },
+	{ "",     "inc/plain.h",    false, IncludeCacheExitCode::SUCCESS, "inc/plain.h"    },
+	{ "",     "sub/deep.h",     true,  IncludeCacheExitCode::SUCCESS, "inc/sub/deep.h" },
+	{ "",     "missing.h",      false, IncludeCacheExitCode::FAILURE, NULL             },
+	{ "",     "missing.h",      true,  IncludeCacheExitCode::FAILURE, NULL             },
+	{ "",     "sub",            true,  IncludeCacheExitCode::FAILURE, NULL             },
+	{ "",     "",               true,  IncludeCacheExitCode::FAILURE, NULL             }
+};
+
+/**
+* Looks up each name through an IncludeCache of inc/,
+* expecting it to be found as a file of the same
+* identity as the one at the path expected, the
+* second time as the first.
+**/
+static inline TestResult test_include_cache(
+	TestResult results[NUM_INCLUDE_CACHE_TESTS])
+{
+	string dir;
+	const bool is_written = write_include_test_files(dir);
+	const string include_dir = dir + "inc";
+	const char* const include_dirs[] = { include_dir.c_str() };
+	IncludeCache cache(include_dirs, 1);
+	bool all_tests_passed = true;
+	for (int lookup = 0; lookup < 2; lookup++) {
+		for (const include_cache_test_case* ictc
+				= test_include_cache_table;
+			ictc < test_include_cache_table + NUM_INCLUDE_CACHE_TESTS;
+			ictc++) {
+			string path;
+			FileIdentity identity = { };
+			const IncludeCacheExitCode exitcode = cache.find(
+				dir + ictc->includer_dir,
+				ictc->spelling,
+				ictc->is_angled,
+				path,
+				identity);
+			bool success_criteria
+				= is_written && exitcode == ictc->exitcode;
+			if (success_criteria
+				&& exitcode == IncludeCacheExitCode::SUCCESS) {
+				FileIdentity expected = { };
+				success_criteria
+					= get_file_identity(
+						(dir + ictc->path).c_str(),
+						expected)
+					  == IncludeCacheExitCode::SUCCESS
+					  && identity.device == expected.device
+					  && identity.inode == expected.inode;
+				FileIdentity found = { };
+				success_criteria
+					= success_criteria
+					  && get_file_identity(path.c_str(), found)
+						 == IncludeCacheExitCode::SUCCESS
+					  && found.device == expected.device
+					  && found.inode == expected.inode;
+			}
+			if (!success_criteria) {
+				results[ictc - test_include_cache_table]
+					= TestResult::FAIL;
+				all_tests_passed = false;
+			}
+			else if (lookup == 0) {
+				results[ictc - test_include_cache_table]
+					= TestResult::SUCCESS;
+			}
+		}
+	}
+	return all_tests_passed ? TestResult::SUCCESS : TestResult::FAIL;
+}
+
+//////////////////////////////////////////////////////////////////
+//     Testing for the streaming of tokens into the parser      //
+//////////////////////////////////////////////////////////////////
+
+#define NUM_STREAMING_TESTS 5
+
+struct streaming_test_case {
+	const char* prefix;
+	int         num_functions;
+	const char* suffix;
+};
+
+/* Each source holds the function below, repeated, between
+   its prefix and suffix.                              */
+#define STREAMING_TEST_FUNCTION      \
+	"int f(int x)\n"              \
+	"{\n"                         \
+	"\tint y;\n"                  \
+	"\ty = ((x - 1) * 2) + 3;\n"   \
+	"\treturn y;\n"               \
+	"}\n"
+
+static const
+streaming_test_case
+test_streaming_table[NUM_STREAMING_TESTS] = {
+	{ "",                     1,    ""                  },
+	{ "",                     3000, ""                  },
+	{ "#if 1\n",              3000, "#endif\n"          },
+	{ "#if 0\n#else\n",       3000, "#endif\n"          },
+	{ "#define N 1\n#if N\n", 3000, "#endif\n#undef N\n" }
+};
+
+/**
+* Preprocesses, lexes and parses each source through a
+* TokenStream, as the driver does, expecting it to
+* parse with no more than two chunks of tokens held,
+* however many tokens it has.
+**/
+static inline TestResult test_streaming(
+	TestResult results[NUM_STREAMING_TESTS])
+{
+	bool all_tests_passed = true;
+	for (const streaming_test_case* stc = test_streaming_table;
+		stc < test_streaming_table + NUM_STREAMING_TESTS;
+		stc++) {
+		string source = stc->prefix;
+		for (int i = 0; i < stc->num_functions; i++) {
+			source += STREAMING_TEST_FUNCTION;
+		}
+		source += stc->suffix;
+
+		Arena arena;
+		active_arena = &arena;
+		bool success_criteria;
+		{
+			LexemaPool lexema;
+			SourceMap sources;
+			IncludeTable includes(NULL, 0);
+			AlertList bkl = AlertList();
+			TokenBuffer tokens;
+			TokenStream token_stream(
+				source.c_str(),
+				lexema,
+				"stream.c",
+				sources,
+				includes,
+				&tokens,
+				&bkl,
+				NULL);
+			TokenCursor tokens_ptr = tokens.begin();
+			AstNode* root = NULL;
+			success_criteria
+				= parse(tokens_ptr, root) == ParserExitCode::SUCCESS
+				  && token_stream.get_pp_exitcode()
+					 == PreprocessorExitCode::SUCCESS
+				  && token_stream.get_exitcode()
+					 == LexerExitCode::SUCCESS
+				  && tokens.get_num_chunks() <= 2;
+		}
+		active_arena = NULL;
+		results[stc - test_streaming_table]
+			= success_criteria ? TestResult::SUCCESS : TestResult::FAIL;
+		if (!success_criteria) {
+			all_tests_passed = false;
+		}
+	}
+	return all_tests_passed ? TestResult::SUCCESS : TestResult::FAIL;
+}
+
+static inline TestResult test_directives(
+	TestResult results[NUM_DIRECTIVES_TESTS],
+	char* &output,
+	int indent = 0)
+{
+	TestResult if_expression_results[NUM_IF_EXPRESSION_TESTS];
+	TestResult if_expression_result
+		= test_if_expression(if_expression_results);
+	results[0] = if_expression_result;
+
+	TestResult skipped_group_results[NUM_SKIPPED_GROUP_TESTS];
+	TestResult skipped_group_result
+		= test_skipped_group(skipped_group_results);
+	results[1] = skipped_group_result;
+
+	TestResult include_results[NUM_INCLUDE_TESTS];
+	TestResult include_result
+		= test_include(include_results);
+	results[2] = include_result;
+
+	TestResult include_cache_results[NUM_INCLUDE_CACHE_TESTS];
+	TestResult include_cache_result
+		= test_include_cache(include_cache_results);
+	results[3] = include_cache_result;
+
+	TestResult streaming_results[NUM_STREAMING_TESTS];
+	TestResult streaming_result
+		= test_streaming(streaming_results);
+	results[4] = streaming_result;
+
+	for (int i = 0; i < indent; i++) print_to_output("\t", output);
+	print_to_output("<-> DirectivesTests", output);
+	print_to_output("\n", output);
+
+	const char* if_expression_title = "IfExpressionTests";
+	present_test_set_synopsis(
+		if_expression_title,
+		if_expression_result,
+		if_expression_results,
+		NUM_IF_EXPRESSION_TESTS,
+		output,
+		indent + 1
+	);
+
+	const char* skipped_group_title = "SkippedGroupTests";
+	present_test_set_synopsis(
+		skipped_group_title,
+		skipped_group_result,
+		skipped_group_results,
+		NUM_SKIPPED_GROUP_TESTS,
+		output,
+		indent + 1
+	);
+
+	const char* include_title = "IncludeTests";
+	present_test_set_synopsis(
+		include_title,
+		include_result,
+		include_results,
+		NUM_INCLUDE_TESTS,
+		output,
+		indent + 1
+	);
+
+	const char* include_cache_title = "IncludeCacheTests";
+	present_test_set_synopsis(
+		include_cache_title,
+		include_cache_result,
+		include_cache_results,
+		NUM_INCLUDE_CACHE_TESTS,
+		output,
+		indent + 1
+	);
+
+	const char* streaming_title = "StreamingTests";
+	present_test_set_synopsis(
+		streaming_title,
+		streaming_result,
+		streaming_results,
+		NUM_STREAMING_TESTS,
+		output,
+		indent + 1
+	);
+
+	for (int i = 0; i < NUM_DIRECTIVES_TESTS; i++) {
+		if (results[i] != TestResult::SUCCESS) {
+			return TestResult::FAIL;
+		}
+	}
+	return TestResult::SUCCESS;
+}
+
+#endif
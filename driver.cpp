@@ -6,46 +6,59 @@
 #define DRIVER_CPP 1
 
 #include "driver.h"
+#include "compile-server.h"
 
 /*****************************************************//**
 *                         Definitions                    *
 /********************************************************/
 
-int main() {
+int main(int argc, const char** argv) {
 	//kcc_run_tests();
-	const char* input = new char[NUM_INPUT_CHARACTERS] {
-		"#if (6 > (3 + 1 << 1))\n"
-		"c allows literally anything here, so long as the ifdef is not true.\n"
-		"#endif\n"
-		"#if ((2 << 3) > (2 << 2))\n"
-		"float Q_rsqrt( float number )\n"
-		"{\n"
-		"\tlong i;\n"
-		"\tfloat x2, y;\n"
-		"\tconst float threehalfs = 1.5F;\n"
-		"\tx2 = number * 0.5F;\n"
-		"\ty  = number;\n"
-		"\t// evil floating point bit level hacking\n"
-		"\ti  = 0x5f3759df - ( i >> 1 ); // what the\n"
-		"\ty  = * ( float * ) &i;\n"
-		"\ty  = y * ( threehalfs - ( x2 * y * y ) );   // 1st iteration\n"
-		"\t//	y  = y * ( threehalfs - ( x2 * y * y ) );   // 2nd iteration, this can be removed\n"
-		"\treturn y;\n"
-		"}\n"
-		"#endif\n",
-	};
-	//cout << input;
-	CompilerFlags flags = { 0 };	
-	flags.display_pptokens = false;
-	flags.display_tokens   = false;
-	flags.display_annotree = false;
-	flags.display_x86      = true;
-	flags.help             = true;
-
-	//cout << input;
-	//cout << endl;
-	
-	drive("test.c", input, flags);
+	CompilerArgs args
+		= interpret_args(argv, argc);
+
+	if (args.serve_socket) {
+		free_compiler_args(args);
+		return serve(args.serve_socket)
+			   == CompileServerExitCode::SUCCESS
+			   ? (int) KccExitCode::SUCCESS
+			   : (int) KccExitCode::FAIL;
+	}
+
+	if (args.flags.help
+		|| args.num_dests == 0) {
+		print_help();
+		if (args.num_dests == 0) {
+			free_compiler_args(args);
+			return (int) KccExitCode::FAIL;
+		}
+	}
+
+	if (args.flags.output_filename
+		&& args.num_dests > 1) {
+		cout << ERR_COLOUR_START
+			 << "kcc:error:-o takes a single file"
+			 << ERR_COLOUR_FINISHED
+			 << endl;
+		free_compiler_args(args);
+		return (int) KccExitCode::FAIL;
+	}
+
+	CompilerFlags flags = args.flags;
+	flags.help = false;
+
+	KccExitCode exitcode;
+	if (args.num_dests == 1) {
+		exitcode = drive(args.dests[0], flags);
+	} else {
+		exitcode = drive_jobs(
+			args.dests, 
+			args.num_dests, 
+			args.num_jobs, 
+			flags);
+	}
+	free_compiler_args(args);
+	return (int) exitcode;
 }
 
-#endif
\ No newline at end of file
+#endif
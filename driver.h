@@ -5,6 +5,7 @@
 #ifndef DRIVER_H
 #define DRIVER_H 1
 
+#include "source-file.h"
 #include "lexema-pool.h"
 #include "preprocessor.h"
 #include "lexer.h"
@@ -12,12 +13,14 @@
 #include "codegen.h"
 #include "semantic-annotator.h"
 #include "annotated-ast-node.h" 
+#include "work-stealing-pool.h"
+#include "time-report.h"
+#include "mem-report.h"
+#include "token-stream.h"
 
-#include "kcc-tester.h"
+#include <sstream>
 
-#define NUM_INPUT_CHARACTERS	  1028
-#define NUM_PREPROCESSING_TOKENS  1028
-#define NUM_ASSEMBLY_TOKENS		  1028
+#include "kcc-tester.h"
 
 #define DEBUG_DISPLAY_LEXEMA_POOL 0
 
@@ -47,11 +50,24 @@ struct CompilerFlags {
 	bool display_annotree : 1;
 	bool display_x86      : 1;
 	bool display_nothing  : 1;
+	bool time_report      : 1;
+	bool time_report_json : 1;
+	bool mem_report       : 1;
+	bool mem_report_json  : 1;
+	bool mmap_output      : 1;
+	/* Where to write the x86 code, or NULL. */
+	const char*  output_filename;
+	/* The directories searched for #include files. */
+	const char** include_dirs;
+	int          num_include_dirs;
 };
 
 struct CompilerArgs {
 	CompilerFlags flags;
-	const char*   dest;
+	const char**  dests;
+	int           num_dests;
+	int           num_jobs;
+	const char*   serve_socket;
 };
 
 const char* help_msg 
@@ -62,7 +78,7 @@ const char* help_msg
 	  "This compiler is designed for the "
 	  "output of x86-64 Bit.\n"
 	  "Run it with the command :\n"
-	  "\tkcc -<options> <args>\n"
+	  "\tkcc -<options> <filepath> ...\n"
 	  "\n"
 	  "\t\t\tOptions\n"
 	  "\t-h : Display help menu.\n"
@@ -71,17 +87,44 @@ const char* help_msg
 	  "\t-t : Display produced abstract syntax tree.\n"
 	  "\t-s : Display produced abstract syntax tree"
 	        " with semantic annotations.\n"
-	  "\t-p : Display produced x86 code.\n"
-	  "\t-m : Mute (display nothing) (default).\n";
+	  "\t-x : Display produced x86 code.\n"
+	  "\t-m : Mute (display nothing) (default).\n"
+	  "\t-j <n> : Compile the given files using n threads.\n"
+	  "\t-o <filepath> : Write the produced x86 code"
+	        " to a file.\n"
+	  "\t-I <dirpath> : Search the directory for"
+	        " #include files.\n"
+	  "\t-fmmap-output : Write the -o file through"
+	        " a memory mapping.\n"
+	  "\t-ftime-report : Display the time spent in each"
+	        " phase of compilation.\n"
+	  "\t-ftime-report=json : As -ftime-report,"
+	        " printed as JSON.\n"
+	  "\t-fmem-report : Display the allocations made"
+	        " by each phase of compilation"
+	        " (in builds with KCC_MEM_REPORT defined).\n"
+	  "\t-fmem-report=json : As -fmem-report,"
+	        " printed as JSON.\n"
+	  "\t--serve <socket> : Run as a compile server"
+	        " listening on the given Unix socket.\n";
 
 struct CompilationEnvironment {
-	PreprocessingToken* ppts;
-	LexemaPool*         lexema;
-	Token*              tokens;
-	AstNode*            ast_root;
-	AnnotatedAstNode*   anno_ast_root;
-	x86_Asm_IR*         instrs;
-	AlertList           bkl;
+	PreprocessingTokenBuffer* ppts;
+	LexemaPool*               lexema;
+	TokenBuffer*              tokens;
+	AstNode*                  ast_root;
+	AnnotatedAstNode*         anno_ast_root;
+	x86_Asm_IR_Buffer*        instrs;
+	AlertList                 bkl;
+	/* The files read, which alerts are resolved
+	   against when they are printed.          */
+	SourceMap*                sources;
+	/* The files included, whose contents the
+	   source map points into.               */
+	IncludeTable*             includes;
+	/* Holds the trees, types and symbols; NULL if
+	   they were allocated individually.          */
+	Arena*                    arena;
 };
 
 static inline
@@ -95,13 +138,98 @@ static inline
 KccExitCode drive(
 	const char*         const& filename,
 	const char*         const& input,
+	const CompilerFlags const& flags,
+	ostream                  & out           = cout,
+	LexemaPool*         const& lexema_pool   = NULL,
+	IncludeCache*       const& include_cache = NULL);
+
+/**
+* Maps the file at the given path into memory
+* and compiles it.
+*
+* @param filename The path of the file to compile.
+* @param flags The flags to compile with.
+* @param out The stream to write output and diagnostics to.
+* @param lexema_pool A pool owned by the caller to intern
+*		 lexema in, or NULL to use a fresh one.
+* @param include_cache A cache of #include lookups owned
+*		 by the caller, or NULL to use a fresh one.
+* @return Returns an exitcode based on how compilation went.
+**/
+static inline
+KccExitCode drive(
+	const char*         const& filename,
+	const CompilerFlags const& flags,
+	ostream                  & out           = cout,
+	LexemaPool*         const& lexema_pool   = NULL,
+	IncludeCache*       const& include_cache = NULL);
+
+/**
+* A single translation unit compiled by drive_jobs.
+**/
+struct CompilationJob {
+	const char*   filename;
+	KccExitCode   exitcode;
+	ostringstream output;
+};
+
+struct CompilationJobs {
+	CompilationJob* jobs;
+	CompilerFlags   flags;
+	/* Shared by every job, so that a lexeme has the
+	   same atom and address in every file.        */
+	LexemaPool*     lexema;
+	/* Shared by every job, so that each header is
+	   looked for only once across the files.     */
+	IncludeCache*   include_cache;
+};
+
+/**
+* Compiles the job at the given index, used as the
+* work function of the work-stealing pool.
+*
+* @param job_index The index of the job to compile.
+* @param context The CompilationJobs being compiled.
+**/
+static inline
+void drive_job(
+	size_t const& job_index,
+	void*  const& context);
+
+/**
+* Compiles several files, each with its own
+* compilation environment, across num_jobs threads.
+* The files share one concurrent lexema pool, and one
+* cache of where #include directives found their files.
+* Output is written in the order the files were given.
+*
+* @param filenames The paths of the files to compile.
+* @param num_files The number of files to compile.
+* @param num_jobs The number of threads to compile with.
+* @param flags The flags to compile with.
+* @return Returns SUCCESS only if every file compiled.
+**/
+static inline
+KccExitCode drive_jobs(
+	const char**        const& filenames,
+	int                 const& num_files,
+	int                 const& num_jobs,
 	const CompilerFlags const& flags);
 
 static inline
-void interpret_args(
+CompilerArgs interpret_args(
 	const char** const& argv,
 	int          const& argc);
 
+/**
+* Frees what interpret_args allocated.
+*
+* @param args The args to free.
+**/
+static inline
+void free_compiler_args(
+	CompilerArgs& args);
+
 /*****************************************************//**
 *                         Definitions                    *
 /********************************************************/
@@ -110,8 +238,24 @@ static inline
 void free_compilation_environment(
 	CompilationEnvironment& environment)
 {
+	if (environment.arena) {
+		/* The trees are released with the arena,
+		   rather than by walking them.           */
+		environment.ast_root      = NULL;
+		environment.anno_ast_root = NULL;
+		/* Pooled symbol tables hold entries from the
+		   arena, so are emptied before it goes.     */
+		if (active_symbol_table_pool) {
+			active_symbol_table_pool->reset();
+		}
+		if (active_arena == environment.arena) {
+			active_arena = NULL;
+		}
+		delete environment.arena;
+		environment.arena = NULL;
+	}
 	if (environment.ppts) {
-		delete[] environment.ppts;
+		delete environment.ppts;
 		environment.ppts = NULL;
 	}
 	if (environment.lexema) {
@@ -119,7 +263,7 @@ void free_compilation_environment(
 		environment.lexema = NULL;
 	}
 	if (environment.tokens) {
-		delete[] environment.tokens;
+		delete environment.tokens;
 		environment.tokens = NULL;
 	}
 	if (environment.ast_root) {
@@ -131,9 +275,17 @@ void free_compilation_environment(
 		environment.anno_ast_root = NULL;
 	}
 	if (environment.instrs) {
-		delete[] environment.instrs;
+		delete environment.instrs;
 		environment.instrs = NULL;
 	}
+	if (environment.sources) {
+		delete environment.sources;
+		environment.sources = NULL;
+	}
+	if (environment.includes) {
+		delete environment.includes;
+		environment.includes = NULL;
+	}
 }
 
 static inline 
@@ -145,7 +297,10 @@ static inline
 KccExitCode drive(
 	const char*         const& filename,
 	const char*         const& input,
-	const CompilerFlags const& flags)
+	const CompilerFlags const& flags,
+	ostream                  & out,
+	LexemaPool*         const& lexema_pool,
+	IncludeCache*       const& include_cache)
 {
 	if (flags.help) {
 		print_help();
@@ -159,111 +314,312 @@ KccExitCode drive(
 	environment.bkl 
 		= AlertList();
 
+	const bool time_report
+		= flags.time_report || flags.time_report_json;
+	TimeReport report
+		= construct_time_report(filename);
+	MemReport mem_report
+		= construct_mem_report(&report);
+	if (flags.mem_report) {
+		active_mem_report = &mem_report;
+	}
+	environment.arena
+		= new Arena();
+	active_arena
+		= environment.arena;
+
 	/* Preprocessing. */
-	environment.ppts 
-		= new PreprocessingToken[NUM_PREPROCESSING_TOKENS] { };
 	environment.lexema 
-		= new LexemaPool();
-	PreprocessingToken* ppts_ptr 
-		= environment.ppts;
-
-	const char* input_ptr = input;
-	if (preprocess(
-		input_ptr,
-		*environment.lexema,
-		filename,
-		environment.bkl,
-		ppts_ptr)
-		== PreprocessorExitCode::SUCCESS) {
+		= lexema_pool 
+		  ? lexema_pool
+		  : new LexemaPool();
+	environment.sources
+		= new SourceMap();
+	environment.includes
+		= new IncludeTable(
+			flags.include_dirs,
+			flags.num_include_dirs,
+			include_cache);
+
+	/* The stream is dropped before the environment it
+	   reads from and writes to is freed.            */
+	{
+		/* Preprocessing and lexing, on demand as the
+		   parser reads. */
+		environment.tokens 
+			= new TokenBuffer();
+		TokenStream token_stream(
+			input,
+			*environment.lexema,
+			filename,
+			*environment.sources,
+			*environment.includes,
+			environment.tokens,
+			&environment.bkl,
+			&report);
+
+		if (flags.display_pptokens) {
+			environment.ppts
+				= new PreprocessingTokenBuffer();
+			token_stream.record(environment.ppts);
+			token_stream.drain();
+			if (token_stream.get_pp_exitcode()
+				== PreprocessorExitCode::SUCCESS) {
+				print_preprocessing_token_table(
+					*environment.ppts,
+					*environment.sources,
+					out);
+			}
+		}
+
+		if (flags.display_tokens) {
+			token_stream.drain();
+			if (token_stream.get_pp_exitcode()
+				== PreprocessorExitCode::SUCCESS) {
+				/* All but the closing ERROR token. */
+				TokenCursor t = environment.tokens->begin();
+				for (size_t i = 1;
+					 i < environment.tokens->get_size();
+					 i++, t++) {
+					t->print(out);
+					out << endl;
+				}
+			}
+		}
+
+		/* Parsing. */
+		TokenCursor tokens_parse_ptr 
+			= environment.tokens->begin();
+		start_time_report_phase(report, TimeReportPhase::PARSE);
+		const ParserExitCode parse_exitcode = parse(
+			tokens_parse_ptr,
+			environment.ast_root);
+		finish_time_report_phase(
+			report,
+			TimeReportPhase::PARSE,
+			0);
+		/* Counted once the phase is over, so that the
+		   walk is not timed as part of it.          */
+		if (time_report) {
+			report.phases[(int) TimeReportPhase::PARSE].count
+				= count_ast_nodes(environment.ast_root);
+		}
 
 		if (DEBUG_DISPLAY_LEXEMA_POOL) {
 			print_lexema_pool(*(environment.lexema));
 		}
-		int count_pptokens 
-			= ppts_ptr - environment.ppts;
 
-		if (flags.display_pptokens) {
-			print_preprocessing_token_table(
-				environment.ppts, 
-				count_pptokens);
-		}
+		if (token_stream.get_pp_exitcode() == PreprocessorExitCode::SUCCESS
+			&& token_stream.get_exitcode() == LexerExitCode::SUCCESS
+			&& parse_exitcode == ParserExitCode::SUCCESS) {
 
-		/* Lexing. */
-		environment.tokens 
-			= new Token[count_pptokens + 1] { };
-		Token* tokens_lex_ptr 
-			= environment.tokens;
-		if (lex(
-			environment.ppts, 
-			tokens_lex_ptr, 
-			count_pptokens,
-			environment.bkl) 
-			== LexerExitCode::SUCCESS) { 
-			int count_tokens 
-				= tokens_lex_ptr - environment.tokens;
-
-			if (flags.display_tokens) {
-
-				for (Token* t = environment.tokens;
-					 t < environment.tokens + count_tokens;
-					 t++) {
-					t->print();
-					cout << endl;
-				}
+			if (flags.display_tree) {
+				environment.ast_root->print("", "", out);
 			}
 
-			/* Parsing. */
-			const Token* tokens_parse_ptr 
-				= environment.tokens;
-			if (parse(
-				tokens_parse_ptr,
-				environment.ast_root) 
-				== ParserExitCode::SUCCESS) {
+			/* Semantic Analysis. */
+			start_time_report_phase(report, TimeReportPhase::ANNOTATE);
+			const SemanticAnnotatorExitCode anno_exitcode = annotate(
+				environment.ast_root,
+				environment.anno_ast_root);
+			finish_time_report_phase(
+				report,
+				TimeReportPhase::ANNOTATE,
+				0);
+			if (time_report) {
+				report.phases[(int) TimeReportPhase::ANNOTATE].count
+					= count_annotated_ast_nodes(environment.anno_ast_root);
+			}
+			if (anno_exitcode == SemanticAnnotatorExitCode::SUCCESS) { 
 
-				if (flags.display_tree) {
-					environment.ast_root->print();
+				if (flags.display_annotree) {
+					environment.anno_ast_root->print("", "", out);
 				}
 
-				/* Semantic Analysis. */
-				if (annotate(
-					environment.ast_root,
-					environment.anno_ast_root) 
-					== SemanticAnnotatorExitCode::SUCCESS) { 
-
-					if (flags.display_annotree) {
-						environment.anno_ast_root->print();
+				/* Code Generation. */
+				environment.instrs
+					= new x86_Asm_IR_Buffer();
+				x86_Asm_IR_Appender instrs_ptr
+					= environment.instrs->appender();
+									
+				int num_labels = 0;
+				start_time_report_phase(report, TimeReportPhase::GEN);
+				gen(num_labels,
+					environment.anno_ast_root,
+					instrs_ptr);
+				finish_time_report_phase(
+					report,
+					TimeReportPhase::GEN,
+					environment.instrs->get_size());
+				exitcode = KccExitCode::SUCCESS;
+
+				if (flags.display_x86) {
+					AsmWriter writer;
+					open_asm_writer(out, writer);
+					for (x86_Asm_IR_Cursor i = environment.instrs->begin();
+						 i != environment.instrs->end();
+						 i++) {
+						i->emit(writer);
 					}
+					close_asm_writer(writer);
+				}
 
-					/* Code Generation. */
-					environment.instrs
-						= new x86_Asm_IR[NUM_ASSEMBLY_TOKENS]{ };
-					x86_Asm_IR* instrs_ptr
-						= environment.instrs;
-										
-					int num_labels = 0;
-					gen(num_labels,
-						environment.anno_ast_root,
-						instrs_ptr);
-
-					if (flags.display_x86) {
-						
-						for (x86_Asm_IR* i = environment.instrs;
-							 i != instrs_ptr;
+				if (flags.output_filename) {
+					AsmWriter writer;
+					AsmWriterExitCode write_exitcode = open_asm_writer(
+						flags.output_filename,
+						flags.mmap_output,
+						writer);
+					if (write_exitcode == AsmWriterExitCode::SUCCESS) {
+						for (x86_Asm_IR_Cursor i = environment.instrs->begin();
+							 i != environment.instrs->end();
 							 i++) {
-							i->print();
+							i->emit(writer);
 						}
+						write_exitcode = close_asm_writer(writer);
+					}
+					if (write_exitcode != AsmWriterExitCode::SUCCESS) {
+						out << ERR_COLOUR_START
+							<< "kcc:error:could not write "
+							<< flags.output_filename
+							<< ERR_COLOUR_FINISHED
+							<< endl;
+						exitcode = KccExitCode::FAIL;
 					}
 				}
 			}
 		}
 	}
-	environment.bkl.print(input);
+	environment.bkl.print(*environment.sources, out);
+	if (flags.time_report_json) {
+		print_time_report_json(report, out);
+	} else if (flags.time_report) {
+		print_time_report(report, out);
+	}
 	/* Memory Management. */
+	if (lexema_pool) {
+		/* The caller resets its own pool. */
+		environment.lexema = NULL;
+	}
 	free_compilation_environment(environment);
+	/* Reported after freeing, so teardown counts too. */
+	if (flags.mem_report) {
+		active_mem_report = NULL;
+		if (!MEM_REPORT_AVAILABLE) {
+			out << ERR_COLOUR_START
+				<< "kcc:error:-fmem-report needs kcc built"
+				   " with KCC_MEM_REPORT defined"
+				<< ERR_COLOUR_FINISHED
+				<< endl;
+		} else if (flags.mem_report_json) {
+			print_mem_report_json(mem_report, out);
+		} else {
+			print_mem_report(mem_report, out);
+		}
+	}
 	/* Returning*/
 	return exitcode;
 }
 
+static inline
+KccExitCode drive(
+	const char*         const& filename,
+	const CompilerFlags const& flags,
+	ostream                  & out,
+	LexemaPool*         const& lexema_pool,
+	IncludeCache*       const& include_cache)
+{
+	SourceFile source;
+	if (open_source_file(filename, source)
+		!= SourceFileExitCode::SUCCESS) {
+		out << ERR_COLOUR_START
+			<< "kcc:error:could not open "
+			<< filename
+			<< ERR_COLOUR_FINISHED
+			<< endl;
+		return KccExitCode::FAIL;
+	}
+	KccExitCode exitcode
+		= drive(
+			filename,
+			source.data,
+			flags,
+			out,
+			lexema_pool,
+			include_cache);
+	close_source_file(source);
+	return exitcode;
+}
+
+static inline
+void drive_job(
+	size_t const& job_index,
+	void*  const& context)
+{
+	CompilationJobs* const compilation_jobs
+		= (CompilationJobs*) context;
+	CompilationJob& job
+		= compilation_jobs->jobs[job_index];
+	job.exitcode = drive(
+		job.filename,
+		compilation_jobs->flags,
+		job.output,
+		compilation_jobs->lexema,
+		compilation_jobs->include_cache);
+}
+
+static inline
+KccExitCode drive_jobs(
+	const char**        const& filenames,
+	int                 const& num_files,
+	int                 const& num_jobs,
+	const CompilerFlags const& flags)
+{
+	if (flags.help) {
+		print_help();
+	}
+	CompilerFlags job_flags
+		= flags;
+	job_flags.help = false;
+
+	CompilationJobs compilation_jobs;
+	compilation_jobs.jobs
+		= new CompilationJob[num_files];
+	compilation_jobs.flags
+		= job_flags;
+	compilation_jobs.lexema
+		= new LexemaPool(true);
+	compilation_jobs.include_cache
+		= new IncludeCache(
+			flags.include_dirs,
+			flags.num_include_dirs);
+	for (int i = 0; i < num_files; i++) {
+		compilation_jobs.jobs[i].filename = filenames[i];
+		compilation_jobs.jobs[i].exitcode = KccExitCode::FAIL;
+	}
+
+	run_work_stealing_pool(
+		num_files,
+		num_jobs,
+		drive_job,
+		&compilation_jobs);
+
+	/* Merge output in the order the files were given. */
+	KccExitCode exitcode
+		= KccExitCode::SUCCESS;
+	for (int i = 0; i < num_files; i++) {
+		cout << compilation_jobs.jobs[i].output.str();
+		if (compilation_jobs.jobs[i].exitcode
+			!= KccExitCode::SUCCESS) {
+			exitcode = KccExitCode::FAIL;
+		}
+	}
+	delete[] compilation_jobs.jobs;
+	delete compilation_jobs.lexema;
+	delete compilation_jobs.include_cache;
+	return exitcode;
+}
+
 /*
 	kcc-directive:
 		kcc <flags> <filepath>
@@ -283,36 +639,107 @@ KccExitCode drive(
 		| s
 		| x
 		| m
+		| j <number>
+		| o <filepath>
+		| I <dirpath>
+		| fmmap-output
+		| ftime-report
+		| ftime-report=json
+		| fmem-report
+		| fmem-report=json
+		| -serve <socket>
 
 	-<arg>
 */
 
 static inline 
-void interpret_args(
+CompilerArgs interpret_args(
 	const char** const& argv, 
 	int          const& argc) 
 {
 	CompilerArgs  args  = CompilerArgs({ 0 });
 	CompilerFlags flags = CompilerFlags({ 0 });
-	/* Fill args.flags */
-	const char* chr = argv[1];
-	if (*chr == '-') {
-		while (*chr) {
-			switch (*chr++) {
-				case 'h': flags.help             = true; break;
-				case 'p': flags.display_pptokens = true; break;
-				case 'l': flags.display_tokens   = true; break;
-				case 't': flags.display_tree     = true; break;
-				case 's': flags.display_annotree = true; break;
-				case 'x': flags.display_x86      = true; break;
-				case 'm': flags.display_nothing  = true; break;
-				default: break;
+	args.dests    = new const char*[argc] { };
+	args.num_jobs = 1;
+	flags.include_dirs = new const char*[argc] { };
+	for (int i = 1; i < argc; i++) {
+		const char* chr = argv[i];
+		if (strcmp(chr, "--serve") == 0) {
+			if (i + 1 < argc) {
+				args.serve_socket = argv[++i];
+			}
+		} else if (strncmp(chr, "-ftime-report", 13) == 0) {
+			flags.time_report      = true;
+			flags.time_report_json = strcmp(chr + 13, "=json") == 0;
+		} else if (strcmp(chr, "-o") == 0) {
+			if (i + 1 < argc) {
+				flags.output_filename = argv[++i];
 			}
+		} else if (strcmp(chr, "-fmmap-output") == 0) {
+			flags.mmap_output = true;
+		} else if (strncmp(chr, "-fmem-report", 12) == 0) {
+			flags.mem_report       = true;
+			flags.mem_report_json  = strcmp(chr + 12, "=json") == 0;
+		} else if (*chr == '-') {
+			/* Fill args.flags */
+			while (*chr) {
+				switch (*chr++) {
+					case 'j':
+					{
+						/* Accept both -j4 and -j 4. */
+						if (*chr == '\0'
+							&& i + 1 < argc
+							&& isdigit(*argv[i + 1])) {
+							chr = argv[++i];
+						}
+						int num_jobs = atoi(chr);
+						if (num_jobs <= 0) {
+							num_jobs = (int) thread::hardware_concurrency();
+						}
+						args.num_jobs = num_jobs > 0 ? num_jobs : 1;
+						chr += strlen(chr);
+						break;
+					}
+					case 'I':
+					{
+						/* Accept both -Idir and -I dir. */
+						if (*chr == '\0'
+							&& i + 1 < argc) {
+							chr = argv[++i];
+						}
+						if (*chr) {
+							flags.include_dirs[flags.num_include_dirs++] = chr;
+						}
+						chr += strlen(chr);
+						break;
+					}
+					case 'h': flags.help             = true; break;
+					case 'p': flags.display_pptokens = true; break;
+					case 'l': flags.display_tokens   = true; break;
+					case 't': flags.display_tree     = true; break;
+					case 's': flags.display_annotree = true; break;
+					case 'x': flags.display_x86      = true; break;
+					case 'm': flags.display_nothing  = true; break;
+					default: break;
+				}
+			}
+		} else {
+			/* Fill args.dests */
+			args.dests[args.num_dests++] = chr;
 		}
-	} 
+	}
 	args.flags = flags;
-	/* Fill args.dest */
-	args.dest = argv[2];
+	return args;
+}
+
+static inline
+void free_compiler_args(
+	CompilerArgs& args)
+{
+	delete[] args.dests;
+	delete[] args.flags.include_dirs;
+	args.dests              = NULL;
+	args.flags.include_dirs = NULL;
 }
 
 #endif
\ No newline at end of file
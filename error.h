@@ -49,12 +49,19 @@ enum class ErrorCode {
 	ERR_INVALID_PUNCTUATOR,
 	/* Parser Errors. */
 	ERR_PARSER_INVALID_TRANSLATION_UNIT,
+	/* Preprocessor Errors, numbered after the rest so
+	   that earlier codes keep their numbers. */
+	ERR_PP_INVALID_CONSTANT_EXPRESSION,
+	ERR_PP_INVALID_INCLUDE,
+	ERR_PP_INCLUDE_NOT_FOUND,
+	ERR_PP_INVALID_LINE,
 };
 
 struct Error {
 	ErrorCode              error_code;
 	const char*            error_message;
-	FileLocationDescriptor fld;
+	SourceLocation         location;
+	unsigned int           length;
 	Error*                 next_error;
 };
 
@@ -65,7 +72,8 @@ enum class WarningCode {
 struct Warning {
 	WarningCode            warning_code;
 	const char*            warning_message;
-	FileLocationDescriptor fld;
+	SourceLocation         location;
+	unsigned int           length;
 	Warning*               next_warning;
 };
 
@@ -76,38 +84,52 @@ enum class MessageCode {
 struct Message {
 	MessageCode            message_code;
 	const char*            message;
-	FileLocationDescriptor fld;
+	SourceLocation         location;
+	unsigned int           length;
 	Message*               next_message;
 };
 
 Error* construct_error_book(
-	ErrorCode              const& error_code,
-	const char*            const& error_message,
-	FileLocationDescriptor const& fld);
+	ErrorCode      const& error_code,
+	const char*    const& error_message,
+	SourceLocation const& location,
+	unsigned int   const& length);
 
 static inline
 const char* construct_invalid_constant_error_message(
 	const char* const& error_lexeme);
 
+/**
+* Prints the line a location is on, then points out
+* the lexeme at it.
+*
+* @param fld The location, resolved.
+* @param line The start of the line it is on.
+* @param out The stream to print to.
+**/
 static inline
 void display_pointer_to_input_position(
 	FileLocationDescriptor const& fld,
-	const char*            const& input);
+	const char*            const& line,
+	ostream                     & out = cout);
 
 static inline
 void print_error_book(
-	Error*      const& error_book,
-	const char* const& input);
+	Error*    const& error_book,
+	SourceMap      & sources,
+	ostream        & out = cout);
 
 static inline
 void print_warning_book(
-	Warning*    const& warning_book,
-	const char* const& input);
+	Warning*  const& warning_book,
+	SourceMap      & sources,
+	ostream        & out = cout);
 
 static inline
 void print_message_book(
-	Message*    const& message_book,
-	const char* const& input);
+	Message*  const& message_book,
+	SourceMap      & sources,
+	ostream        & out = cout);
 
 class AlertList {
 private:
@@ -130,12 +152,16 @@ public:
 		}
 	}
 
-	/* The messages reference the input, so we will need the input to be passed in too.*/
-	inline void print(const char* input)
+	/* The messages hold only where in the input they
+	   are, so we will need the files to be passed in
+	   too, to resolve them against.                  */
+	inline void print(
+		SourceMap& sources,
+		ostream  & out = cout)
 	{
-		print_error_book(error, input);
-		print_warning_book(warning, input);
-		print_message_book(message, input);
+		print_error_book(error, sources, out);
+		print_warning_book(warning, sources, out);
+		print_message_book(message, sources, out);
 	}
 };
 
@@ -144,15 +170,17 @@ public:
 /********************************************************/
 
 Error* construct_error_book(
-	ErrorCode              const& error_code,
-	const char*            const& error_message,
-	FileLocationDescriptor const& fld)
+	ErrorCode      const& error_code,
+	const char*    const& error_message,
+	SourceLocation const& location,
+	unsigned int   const& length)
 {
 	Error* error
 		= new Error({
 			error_code,
 			error_message,
-			fld,
+			location,
+			length,
 			NULL
 			});
 	return error;
@@ -168,59 +196,62 @@ const char* construct_invalid_constant_error_message(
 static inline
 void display_pointer_to_input_position(
 	FileLocationDescriptor const& fld,
-	const char*            const& input)
+	const char*            const& line,
+	ostream                     & out)
 {
-	int r = 0;
-	int c = 0;
-	const char* input_ptr = input;
-	/* Move pointer to start of error line. */
-	while (r < fld.line_number) {
-		while (*input_ptr++ != '\n') { }
-		r++;
-	}
+	const char* input_ptr = line;
 	/* Print error line. */
-	while (*input_ptr != '\n') {
-		cout << *input_ptr++;
+	while (*input_ptr != '\n'
+		   && *input_ptr != '\0') {
+		out << *input_ptr++;
 	}
-	cout << *input_ptr++;
-	cout << ERR_COLOUR_START;
+	out << '\n';
+	out << ERR_COLOUR_START;
 	/* Now print space before pointer. */
 	for (int i = 0; 
 		 i < fld.character_number; 
 		 i++) {
-		cout << " ";
+		out << " ";
 	}
 	/* Now print pointer with tail. */
-	cout << "^";
-	for (int i = 0; 
-			i < fld.lexeme_length - 1; 
+	out << "^";
+	for (unsigned int i = 1; 
+			i < fld.lexeme_length; 
 			i++) {
-		cout << "~";
+		out << "~";
 	}
-	cout << ERR_COLOUR_FINISHED
-		 << endl;
+	out << ERR_COLOUR_FINISHED
+		<< endl;
 }
 
 static inline
 void print_error_book(
-	Error*      const& error_book,
-	const char* const& input)
+	Error*    const& error_book,
+	SourceMap      & sources,
+	ostream        & out)
 {
 	Error* e = error_book;
 	while (e != NULL) {
+		const FileLocationDescriptor fld
+			= sources.resolve(e->location, e->length);
 		/* Print out the message. */
-		cout << ERR_COLOUR_START
-			 << "kcc"                        << ":"
-			 << "error"                      << ":"
-			 << "err" << (int) e->error_code << ":"
-			 << e->fld.filename              << ":"
-			 << e->fld.line_number           << ":"
-			 << e->fld.character_number      << ":"
-			 << e->error_message
-			 << ERR_COLOUR_FINISHED
-			 << endl;
+		out << ERR_COLOUR_START
+			<< "kcc"                        << ":"
+			<< "error"                      << ":"
+			<< "err" << (int) e->error_code << ":"
+			<< fld.filename                 << ":"
+			<< fld.line_number              << ":"
+			<< fld.character_number         << ":"
+			<< e->error_message
+			<< ERR_COLOUR_FINISHED
+			<< endl;
 		/* Show where the input went wrong. */
-		display_pointer_to_input_position(e->fld, input);
+		if (sources.get_file(e->location.file_id) != NULL) {
+			display_pointer_to_input_position(
+				fld,
+				sources.get_line(e->location),
+				out);
+		}
 		/* Move onto next error. */
 		e = e->next_error;
 	}
@@ -228,23 +259,33 @@ void print_error_book(
 
 static inline
 void print_warning_book(
-	Warning*    const& warning_book,
-	const char* const& input)
+	Warning*  const& warning_book,
+	SourceMap      & sources,
+	ostream        & out)
 {
 	Warning* e = warning_book;
 	while (e != NULL) {
+		const FileLocationDescriptor fld
+			= sources.resolve(
+				warning_book->location,
+				warning_book->length);
 		/* Print out the message. */
-		cout << WARN_COLOUR_START
-			 << "kcc"                                     << ":"
-			 << "error"                                   << ":"
-			 << "err" << (int) warning_book->warning_code << ":"
-			 << warning_book->fld.filename                << ":"
-			 << warning_book->fld.line_number             << ":"
-			 << warning_book->fld.character_number        << ":"
-			 << warning_book->warning_message
-			 << WARN_COLOUR_FINISHED;
+		out << WARN_COLOUR_START
+			<< "kcc"                                     << ":"
+			<< "error"                                   << ":"
+			<< "err" << (int) warning_book->warning_code << ":"
+			<< fld.filename                              << ":"
+			<< fld.line_number                           << ":"
+			<< fld.character_number                      << ":"
+			<< warning_book->warning_message
+			<< WARN_COLOUR_FINISHED;
 		/* Show where the input went wrong. */
-		display_pointer_to_input_position(warning_book->fld, input);
+		if (sources.get_file(warning_book->location.file_id) != NULL) {
+			display_pointer_to_input_position(
+				fld,
+				sources.get_line(warning_book->location),
+				out);
+		}
 		/* Move onto next error. */
 		e = e->next_warning;
 	}
@@ -253,23 +294,33 @@ void print_warning_book(
 
 static inline
 void print_message_book(
-	Message*    const& message_book,
-	const char* const& input)
+	Message*  const& message_book,
+	SourceMap      & sources,
+	ostream        & out)
 {
 	Message* e = message_book;
 	while (e != NULL) {
+		const FileLocationDescriptor fld
+			= sources.resolve(
+				message_book->location,
+				message_book->length);
 		/* Print out the message. */
-		cout << MSG_COLOUR_START
-			 << "kcc"                                     << ":"
-			 << "error"                                   << ":"
-			 << "err" << (int) message_book->message_code << ":"
-			 << message_book->fld.filename                << ":"
-			 << message_book->fld.line_number             << ":"
-			 << message_book->fld.character_number        << ":"
-			 << message_book->message
-			 << MSG_COLOUR_FINISHED;
+		out << MSG_COLOUR_START
+			<< "kcc"                                     << ":"
+			<< "error"                                   << ":"
+			<< "err" << (int) message_book->message_code << ":"
+			<< fld.filename                              << ":"
+			<< fld.line_number                           << ":"
+			<< fld.character_number                      << ":"
+			<< message_book->message
+			<< MSG_COLOUR_FINISHED;
 		/* Show where the input went wrong. */
-		display_pointer_to_input_position(message_book->fld, input);
+		if (sources.get_file(message_book->location.file_id) != NULL) {
+			display_pointer_to_input_position(
+				fld,
+				sources.get_line(message_book->location),
+				out);
+		}
 		/* Move onto next error. */
 		e = e->next_message;
 	}
@@ -0,0 +1,299 @@
+/* Authored by Charlie Keaney                     */
+/* file-location.h - Responsible for describing
+					 where in its source file a
+					 token was found.
+
+					 Implementation Notes:
+					 A token records only the ID of
+					 its file and its offset into
+					 it. Lines and columns are only
+					 needed for diagnostics, so are
+					 worked out then: the first
+					 location resolved in a file
+					 finds where each of its lines
+					 starts, and every location is
+					 then resolved by a binary
+					 search of those starts.     */
+
+#ifndef FILE_LOCATION_H
+#define FILE_LOCATION_H 1
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "char-scan.h"
+
+/* The file ID of a location in no file. */
+#define SOURCE_FILE_ID_NONE UINT32_MAX
+
+using namespace std;
+
+/*****************************************************//**
+*                      Declarations                      *
+/********************************************************/
+
+/**
+* A location resolved into the line and character it
+* is at, both counted from 0.
+**/
+struct FileLocationDescriptor {
+	const char*  filename;
+	unsigned int line_number;
+	unsigned int character_number;
+	unsigned int lexeme_length;
+};
+
+/**
+* Where a token was found, as its offset into the
+* file with the given ID.
+**/
+struct SourceLocation {
+	uint32_t offset;
+	uint32_t file_id;
+};
+
+/**
+* A file of a compilation, as known to its source map.
+**/
+struct SourceMapFile {
+	const char*      filename;
+	const char*      input;
+	uint32_t         file_id;
+	/* The offset each line starts at, found the first
+	   time a location in the file is resolved.      */
+	vector<uint32_t> line_starts;
+	bool             is_indexed;
+};
+
+static inline
+FileLocationDescriptor construct_file_location_descriptor();
+
+static inline
+FileLocationDescriptor construct_file_location_descriptor(
+	const char* const& filen,
+	int         const& line,
+	int         const& character,
+	int         const& lexeme_len);
+
+static inline
+void print_file_location_descriptor(
+	FileLocationDescriptor const& fld,
+	ostream                     & out = cout);
+
+/**
+* Constructs a location in no file.
+*
+* @return Returns the location.
+**/
+static inline
+SourceLocation construct_source_location();
+
+/**
+* Constructs the location of a character of a file.
+*
+* @param file The file the character is in.
+* @param position The character.
+* @return Returns the location.
+**/
+static inline
+SourceLocation locate_in_source_file(
+	SourceMapFile const& file,
+	const char*   const& position);
+
+/**
+* The files of a compilation, by their IDs.
+**/
+class SourceMap {
+private:
+	vector<SourceMapFile*> files;
+
+	inline void index_lines(
+		SourceMapFile* const& file)
+	{
+		file->line_starts.push_back(0);
+		find_line_starts(file->input, file->line_starts);
+		file->is_indexed = true;
+	}
+
+public:
+	inline SourceMap() {
+	};
+
+	SourceMap(const SourceMap&) = delete;
+	SourceMap& operator=(const SourceMap&) = delete;
+
+	inline ~SourceMap() {
+		for (SourceMapFile* file : files) {
+			delete file;
+		}
+	};
+
+	/**
+	* Adds a file, giving it the next ID.
+	*
+	* @param filename The name the file is reported by.
+	* @param input The file's contents, ended by a NUL.
+	* @return Returns the added file.
+	**/
+	inline const SourceMapFile* add_file(
+		const char* const& filename,
+		const char* const& input)
+	{
+		SourceMapFile* file = new SourceMapFile();
+		file->filename   = filename;
+		file->input      = input;
+		file->file_id    = (uint32_t) files.size();
+		file->is_indexed = false;
+		files.push_back(file);
+		return file;
+	}
+
+	inline const SourceMapFile* get_file(
+		uint32_t const& file_id) const
+	{
+		return file_id < files.size()
+			   ? files[file_id]
+			   : NULL;
+	}
+
+	/**
+	* Finds the line a location is on.
+	*
+	* @param location The location to find.
+	* @return Returns the line, counted from 0.
+	**/
+	inline unsigned int find_line(
+		SourceLocation const& location)
+	{
+		SourceMapFile* const file
+			= files[location.file_id];
+		if (!file->is_indexed) {
+			index_lines(file);
+		}
+		/* The last line starting at or before it. */
+		return (unsigned int) (upper_bound(
+			file->line_starts.begin(),
+			file->line_starts.end(),
+			location.offset)
+			- file->line_starts.begin()
+			- 1);
+	}
+
+	/**
+	* Resolves a location into the line and character
+	* it is at.
+	*
+	* @param location The location to resolve.
+	* @param length The length of the lexeme there.
+	* @return Returns the resolved location, in no file
+	*		  if the location is in none.
+	**/
+	inline FileLocationDescriptor resolve(
+		SourceLocation const& location,
+		unsigned int   const& length)
+	{
+		if (get_file(location.file_id) == NULL) {
+			return construct_file_location_descriptor(
+				"",
+				0,
+				0,
+				length);
+		}
+		const SourceMapFile* const file
+			= files[location.file_id];
+		const unsigned int line
+			= find_line(location);
+		return construct_file_location_descriptor(
+			file->filename,
+			line,
+			location.offset - file->line_starts[line],
+			length);
+	}
+
+	/**
+	* Returns the start of the line a location is on.
+	*
+	* @param location The location, in a file.
+	* @return Returns the first character of its line.
+	**/
+	inline const char* get_line(
+		SourceLocation const& location)
+	{
+		const SourceMapFile* const file
+			= files[location.file_id];
+		return file->input
+			   + file->line_starts[find_line(location)];
+	}
+};
+
+/*****************************************************//**
+*                         Definitions                    *
+/********************************************************/
+
+static inline
+FileLocationDescriptor construct_file_location_descriptor()
+{
+	FileLocationDescriptor fld = {
+		NULL,
+		0,
+		0,
+		0
+	};
+	return fld;
+}
+
+static inline
+FileLocationDescriptor construct_file_location_descriptor(
+	const char* const& filen,
+	int         const& line,
+	int         const& character,
+	int         const& lexeme_len)
+{
+	FileLocationDescriptor fld = {
+		filen,
+		(unsigned int) line,
+		(unsigned int) character,
+		(unsigned int) lexeme_len
+	};
+	return fld;
+}
+
+static inline
+void print_file_location_descriptor(
+	FileLocationDescriptor const& fld,
+	ostream                     & out)
+{
+	out << "<FileLocationDescriptor={"
+		<< fld.filename
+		<< ","
+		<< fld.line_number
+		<< ","
+		<< fld.character_number
+		<< "}>";
+}
+
+static inline
+SourceLocation construct_source_location()
+{
+	SourceLocation location = {
+		0,
+		SOURCE_FILE_ID_NONE
+	};
+	return location;
+}
+
+static inline
+SourceLocation locate_in_source_file(
+	SourceMapFile const& file,
+	const char*   const& position)
+{
+	SourceLocation location = {
+		(uint32_t) (position - file.input),
+		file.file_id
+	};
+	return location;
+}
+
+#endif
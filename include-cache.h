@@ -0,0 +1,305 @@
+/* Authored by Charlie Keaney                     */
+/* include-cache.h - Responsible for remembering
+					 where the files #include
+					 directives name were found, so
+					 that the filesystem is asked
+					 about each path only once.
+
+					 Implementation Notes:
+					 Finding a file probes a path in
+					 each search directory in turn
+					 until one holds it. Two tables
+					 stand in front of those probes.
+					 The first maps a header name,
+					 how it was written and the
+					 directory of the file including
+					 it to where the name was found,
+					 so a name already looked up is
+					 found with no probes at all. The
+					 second remembers the result of
+					 every path probed, found or not,
+					 so that a directory already
+					 known not to hold a file is not
+					 asked again by another name's
+					 search.
+
+					 A name written <name>, or as an
+					 absolute path, is found in the
+					 same place from every file, so
+					 it is cached under no including
+					 directory.
+
+					 One cache may be shared by the
+					 compilations of several files,
+					 across threads, so long as they
+					 search the same directories.
+					 Both tables are guarded by a
+					 lock, which is not held while
+					 the filesystem is asked.      */
+
+#ifndef INCLUDE_CACHE_H
+#define INCLUDE_CACHE_H 1
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
+using namespace std;
+
+/*****************************************************//**
+*                      Declarations                      *
+/********************************************************/
+
+enum class IncludeCacheExitCode {
+	SUCCESS,
+	FAILURE
+};
+
+/**
+* The device and inode a file is stored on, which are
+* the same however the path to it is spelt.
+**/
+struct FileIdentity {
+	uint64_t device;
+	uint64_t inode;
+};
+
+/**
+* What probing a path found.
+**/
+struct IncludeProbe {
+	bool         is_found;
+	FileIdentity identity;
+};
+
+/**
+* Where an #include name was found, if it was.
+**/
+struct IncludeResolution {
+	bool         is_found;
+	string       path;
+	FileIdentity identity;
+};
+
+/**
+* Finds the identity of the regular file at a path.
+*
+* @param path The path of the file.
+* @param identity The location to store the identity.
+* @return Returns an exitcode for success or failure,
+*		  failing if there is no regular file there.
+**/
+static inline
+IncludeCacheExitCode get_file_identity(
+	const char*  const& path,
+	FileIdentity      & identity);
+
+/**
+* The places #include names were found and the paths
+* probed to find them, for one set of search
+* directories.
+**/
+class IncludeCache {
+private:
+	const char* const*                        include_dirs;
+	int                                       num_include_dirs;
+	unordered_map<string, IncludeResolution>  resolutions;
+	unordered_map<string, IncludeProbe>       probes;
+	mutex                                     lock;
+
+	/**
+	* Probes a path, asking the filesystem only the
+	* first time.
+	**/
+	inline bool probe(
+		string       const& path,
+		FileIdentity      & identity)
+	{
+		unique_lock<mutex> guard(lock);
+		auto found = probes.find(path);
+		if (found == probes.end()) {
+			/* The filesystem is asked without the lock,
+			   so that other threads' lookups go on. */
+			guard.unlock();
+			IncludeProbe result = { };
+			result.is_found
+				= get_file_identity(path.c_str(), result.identity)
+				  == IncludeCacheExitCode::SUCCESS;
+			guard.lock();
+			found = probes.emplace(path, result).first;
+		}
+		identity = found->second.identity;
+		return found->second.is_found;
+	}
+
+	/**
+	* Searches for a name as find describes, probing
+	* each candidate path.
+	**/
+	inline void search(
+		string            const& includer_dir,
+		string            const& spelling,
+		bool              const& is_angled,
+		IncludeResolution      & resolution)
+	{
+		resolution.is_found = false;
+		if (spelling[0] == '/') {
+			resolution.path     = spelling;
+			resolution.is_found = probe(
+				resolution.path,
+				resolution.identity);
+			return;
+		}
+		if (!is_angled) {
+			resolution.path = includer_dir + spelling;
+			if (probe(resolution.path, resolution.identity)) {
+				resolution.is_found = true;
+				return;
+			}
+		}
+		for (int i = 0; i < num_include_dirs; i++) {
+			resolution.path = include_dirs[i];
+			if (!resolution.path.empty()
+				&& resolution.path.back() != '/') {
+				resolution.path += '/';
+			}
+			resolution.path += spelling;
+			if (probe(resolution.path, resolution.identity)) {
+				resolution.is_found = true;
+				return;
+			}
+		}
+	}
+
+public:
+	inline IncludeCache(
+		const char* const* const& dirs     = NULL,
+		int                const& num_dirs = 0)
+		: include_dirs(dirs),
+		  num_include_dirs(num_dirs) {
+	};
+
+	IncludeCache(const IncludeCache&) = delete;
+	IncludeCache& operator=(const IncludeCache&) = delete;
+
+	/**
+	* Finds the file an #include names. A quoted name
+	* is looked for in the directory of the including
+	* file first, then, as an angled name is, in each
+	* include directory in turn.
+	*
+	* @param includer_dir The directory of the including
+	*		 file, ending in '/', or "" for the current
+	*		 directory.
+	* @param spelling The name between the delimiters.
+	* @param is_angled Whether it was written <name>.
+	* @param path Set to the path the file was found at.
+	* @param identity Set to the identity of the file.
+	* @return Returns an exitcode for success or failure.
+	**/
+	inline IncludeCacheExitCode find(
+		string       const& includer_dir,
+		string       const& spelling,
+		bool         const& is_angled,
+		string            & path,
+		FileIdentity      & identity)
+	{
+		if (spelling.empty()) {
+			return IncludeCacheExitCode::FAILURE;
+		}
+		const bool is_anywhere
+			= is_angled || spelling[0] == '/';
+		string key
+			= is_anywhere ? string() : includer_dir;
+		key += '\0';
+		key += is_angled ? '<' : '"';
+		key += spelling;
+
+		unique_lock<mutex> guard(lock);
+		auto found = resolutions.find(key);
+		if (found == resolutions.end()) {
+			guard.unlock();
+			IncludeResolution resolution;
+			search(
+				includer_dir,
+				spelling,
+				is_angled,
+				resolution);
+			/* Another thread may have found it meanwhile,
+			   in the same place.                        */
+			guard.lock();
+			found = resolutions.emplace(key, resolution).first;
+		}
+		if (!found->second.is_found) {
+			return IncludeCacheExitCode::FAILURE;
+		}
+		path     = found->second.path;
+		identity = found->second.identity;
+		return IncludeCacheExitCode::SUCCESS;
+	}
+};
+
+/*****************************************************//**
+*                         Definitions                    *
+/********************************************************/
+
+#if defined(_WIN32)
+
+static inline
+IncludeCacheExitCode get_file_identity(
+	const char*  const& path,
+	FileIdentity      & identity)
+{
+	HANDLE handle = CreateFileA(
+		path,
+		0,
+		FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		NULL,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL,
+		NULL);
+	if (handle == INVALID_HANDLE_VALUE) {
+		return IncludeCacheExitCode::FAILURE;
+	}
+	BY_HANDLE_FILE_INFORMATION information;
+	const BOOL is_found
+		= GetFileInformationByHandle(handle, &information);
+	CloseHandle(handle);
+	if (!is_found
+		|| (information.dwFileAttributes
+			& FILE_ATTRIBUTE_DIRECTORY)) {
+		return IncludeCacheExitCode::FAILURE;
+	}
+	identity.device = information.dwVolumeSerialNumber;
+	identity.inode  = ((uint64_t) information.nFileIndexHigh << 32)
+					  | information.nFileIndexLow;
+	return IncludeCacheExitCode::SUCCESS;
+}
+
+#else
+
+static inline
+IncludeCacheExitCode get_file_identity(
+	const char*  const& path,
+	FileIdentity      & identity)
+{
+	struct stat st;
+	if (stat(path, &st) != 0
+		|| !S_ISREG(st.st_mode)) {
+		return IncludeCacheExitCode::FAILURE;
+	}
+	identity.device = (uint64_t) st.st_dev;
+	identity.inode  = (uint64_t) st.st_ino;
+	return IncludeCacheExitCode::SUCCESS;
+}
+
+#endif
+
+#endif
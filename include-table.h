@@ -0,0 +1,222 @@
+/* Authored by Charlie Keaney                     */
+/* include-table.h - Responsible for finding the
+					 files that #include directives
+					 name, and remembering which of
+					 them need not be read again.
+
+					 Implementation Notes:
+					 A file is known by its identity,
+					 the device and inode it is
+					 stored on, so that it is
+					 recognised however its path is
+					 spelt. Each file is opened once
+					 per compilation, and read again
+					 by each include that is not
+					 skipped. Where a name is found
+					 is asked of an IncludeCache.
+
+					 When a file has been read the
+					 preprocessor records whether all
+					 of it lies within an #ifndef
+					 guard, and marks it if it says
+					 #pragma once. A later include of
+					 a file marked once, or of one
+					 whose guard macro is defined, is
+					 skipped without the file being
+					 looked at again.              */
+
+#ifndef INCLUDE_TABLE_H
+#define INCLUDE_TABLE_H 1
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "file-location.h"
+#include "include-cache.h"
+#include "source-file.h"
+
+/* How deeply includes may nest, so that a file which
+   includes itself without a guard is stopped.       */
+#define INCLUDE_TABLE_MAX_DEPTH 200
+
+using namespace std;
+
+/*****************************************************//**
+*                      Declarations                      *
+/********************************************************/
+
+enum class IncludeTableExitCode {
+	SUCCESS,
+	FAILURE
+};
+
+/**
+* A file brought in by an #include directive.
+**/
+struct IncludedFile {
+	FileIdentity          identity;
+	string                path;
+	SourceFile            file;
+	const SourceMapFile*  source;
+	/* Set once the file says #pragma once. */
+	bool                  is_once;
+	/* Whether all of the file lies within an #ifndef
+	   of the macro with atom guard.               */
+	bool                  has_guard;
+	uint32_t              guard;
+};
+
+/**
+* The files included by a compilation, and the cache
+* of where to find them.
+**/
+class IncludeTable {
+private:
+	IncludeCache*         cache;
+	bool                  is_cache_owned;
+	vector<IncludedFile*> files;
+	unsigned int          depth;
+
+	inline IncludedFile* find_file(
+		FileIdentity const& identity) const
+	{
+		for (IncludedFile* file : files) {
+			if (file->identity.device == identity.device
+				&& file->identity.inode == identity.inode) {
+				return file;
+			}
+		}
+		return NULL;
+	}
+
+public:
+	/**
+	* @param dirs The directories to search.
+	* @param num_dirs The number of directories.
+	* @param shared_cache A cache of lookups in the same
+	*		 directories shared with other compilations,
+	*		 or NULL to keep one of its own.
+	**/
+	inline IncludeTable(
+		const char* const* const& dirs         = NULL,
+		int                const& num_dirs     = 0,
+		IncludeCache*      const& shared_cache = NULL)
+		: cache(shared_cache),
+		  is_cache_owned(shared_cache == NULL),
+		  depth(0) {
+		if (is_cache_owned) {
+			cache = new IncludeCache(dirs, num_dirs);
+		}
+	};
+
+	IncludeTable(const IncludeTable&) = delete;
+	IncludeTable& operator=(const IncludeTable&) = delete;
+
+	inline ~IncludeTable() {
+		for (IncludedFile* file : files) {
+			close_source_file(file->file);
+			delete file;
+		}
+		if (is_cache_owned) {
+			delete cache;
+		}
+	};
+
+	/**
+	* Finds the file an #include names, as the cache
+	* does, opening it and adding it to the source map
+	* if it is not yet known.
+	*
+	* @param spelling The name between the delimiters.
+	* @param is_angled Whether it was written <name>.
+	* @param includer The path of the including file.
+	* @param sources The files of the compilation, to
+	*		 which a newly opened file is added.
+	* @param file The location to store the file.
+	* @return Returns an exitcode for success or failure.
+	**/
+	inline IncludeTableExitCode find(
+		string        const& spelling,
+		bool          const& is_angled,
+		const char*   const& includer,
+		SourceMap          & sources,
+		IncludedFile*      & file)
+	{
+		const char* const separator
+			= strrchr(includer, '/');
+		const string includer_dir
+			= separator != NULL
+			  ? string(includer, separator + 1)
+			  : string();
+		string path;
+		FileIdentity identity;
+		if (cache->find(
+				includer_dir,
+				spelling,
+				is_angled,
+				path,
+				identity)
+			!= IncludeCacheExitCode::SUCCESS) {
+			return IncludeTableExitCode::FAILURE;
+		}
+		file = find_file(identity);
+		if (file != NULL) {
+			return IncludeTableExitCode::SUCCESS;
+		}
+		file = new IncludedFile();
+		file->identity = identity;
+		file->path     = path;
+		if (open_source_file(file->path.c_str(), file->file)
+			!= SourceFileExitCode::SUCCESS) {
+			delete file;
+			file = NULL;
+			return IncludeTableExitCode::FAILURE;
+		}
+		file->source = sources.add_file(
+			file->path.c_str(),
+			file->file.data);
+		files.push_back(file);
+		return IncludeTableExitCode::SUCCESS;
+	}
+
+	/**
+	* Finds the included file with a source map ID.
+	*
+	* @return Returns the file, or NULL if the ID is
+	*		  not that of an included file.
+	**/
+	inline IncludedFile* get_file(
+		uint32_t const& file_id) const
+	{
+		for (IncludedFile* file : files) {
+			if (file->source->file_id == file_id) {
+				return file;
+			}
+		}
+		return NULL;
+	}
+
+	/**
+	* Notes that an included file is being executed.
+	*
+	* @return Returns false if includes are already
+	*		  nested as deeply as they may be.
+	**/
+	inline bool enter()
+	{
+		if (depth >= INCLUDE_TABLE_MAX_DEPTH) {
+			return false;
+		}
+		depth++;
+		return true;
+	}
+
+	inline void leave()
+	{
+		depth--;
+	}
+};
+
+#endif
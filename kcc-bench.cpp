@@ -0,0 +1,74 @@
+/* Authored by Charlie Keaney                      */
+/* kcc-bench.cpp - Responsible for driving kcc-bench,
+				   taking in arguments.            */
+
+#ifndef KCC_BENCH_CPP
+#define KCC_BENCH_CPP 1
+
+#include <fstream>
+
+#include "kcc-bench.h"
+
+/*****************************************************//**
+*                         Definitions                    *
+/********************************************************/
+
+int main(int argc, const char** argv) {
+	BenchArgs args
+		= interpret_bench_args(argv, argc);
+	if (args.help) {
+		cout << bench_help_msg;
+		return (int) KccExitCode::FAIL;
+	}
+
+	string corpus;
+	generate_bench_corpus(args.params, corpus);
+
+	if (args.corpus_dest) {
+		ofstream corpus_file(args.corpus_dest, ios::binary);
+		corpus_file << corpus;
+		if (!corpus_file) {
+			cout << ERR_COLOUR_START
+				 << "kcc-bench:error:could not write "
+				 << args.corpus_dest
+				 << ERR_COLOUR_FINISHED
+				 << endl;
+			return (int) KccExitCode::FAIL;
+		}
+	}
+
+	cout << "kcc-bench:"
+		 << " functions=" << args.params.num_functions
+		 << " depth="     << args.params.expression_depth
+		 << " macros="    << args.params.macro_density
+		 << " if-depth="  << args.params.if_depth
+		 << " reps="      << args.repetitions
+		 << " bytes="     << corpus.size()
+		 << endl;
+
+	KccExitCode exitcode
+		= KccExitCode::SUCCESS;
+	TimeReport* reports
+		= new TimeReport[args.repetitions];
+	for (int r = 0; r < args.repetitions; r++) {
+		reports[r] = construct_time_report("kcc-bench");
+		if (run_bench_repetition(
+				corpus.c_str(),
+				reports[r])
+			!= KccExitCode::SUCCESS) {
+			exitcode = KccExitCode::FAIL;
+		}
+	}
+	print_bench_results(reports, args.repetitions);
+	if (exitcode != KccExitCode::SUCCESS) {
+		cout << ERR_COLOUR_START
+			 << "kcc-bench:error:the corpus did not compile"
+			 << ERR_COLOUR_FINISHED
+			 << endl;
+	}
+
+	delete[] reports;
+	return (int) exitcode;
+}
+
+#endif
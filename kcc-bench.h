@@ -0,0 +1,499 @@
+/* Authored by Charlie Keaney                     */
+/* kcc-bench.h - Responsible for benchmarking each
+				 phase of the compiler against a
+				 generated corpus of C source.
+
+				 Implementation Notes:
+				 The corpus is parameterised by
+				 its number of functions, the
+				 depth of each function's
+				 expression, the number of macro
+				 definitions per function and
+				 the depth of #if nesting around
+				 each function. Each function's
+				 macros are defined in terms of
+				 one another and the last is
+				 tested by each #if around it.
+				 The #ifs alternate between true
+				 and false, a false one followed
+				 by an #else, so that half of
+				 the groups are skipped. Each
+				 repetition
+				 runs every phase on its own,
+				 from the output of the phase
+				 before, so one phase's time
+				 never includes another's.     */
+
+#ifndef KCC_BENCH_H
+#define KCC_BENCH_H 1
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include "driver.h"
+
+#define BENCH_DEFAULT_NUM_FUNCTIONS    64
+#define BENCH_DEFAULT_EXPRESSION_DEPTH 8
+#define BENCH_DEFAULT_MACRO_DENSITY    0
+#define BENCH_DEFAULT_IF_DEPTH         0
+#define BENCH_DEFAULT_REPETITIONS      10
+
+using namespace std;
+
+/*****************************************************//**
+*                      Declarations                      *
+/********************************************************/
+
+struct BenchCorpusParams {
+	int num_functions;
+	int expression_depth;
+	int macro_density;
+	int if_depth;
+};
+
+struct BenchArgs {
+	BenchCorpusParams params;
+	int               repetitions;
+	const char*       corpus_dest;
+	bool              help;
+};
+
+const char* bench_help_msg
+	= "kcc-bench - Measures the throughput of each phase of kcc.\n"
+	  "Run it with the command :\n"
+	  "\tkcc-bench -<options>\n"
+	  "\n"
+	  "\t\t\tOptions\n"
+	  "\t-h : Display help menu.\n"
+	  "\t-n <n> : Generate n functions.\n"
+	  "\t-d <n> : Nest each function's expression n deep.\n"
+	  "\t-m <n> : Define n chained macros before each function, tested by its #ifs.\n"
+	  "\t-k <n> : Nest each function within n #if groups, alternately true and false.\n"
+	  "\t-r <n> : Repeat each phase n times.\n"
+	  "\t-o <filepath> : Write the generated corpus to a file.\n";
+
+/**
+* Generates a corpus of C source.
+*
+* @param params The shape of the corpus to generate.
+* @param corpus The generated source.
+**/
+static inline
+void generate_bench_corpus(
+	BenchCorpusParams const& params,
+	string                 & corpus);
+
+/**
+* Generates an expression of the given depth.
+*
+* @param depth The depth of the expression.
+* @param expression The string to append the expression to.
+**/
+static inline
+void generate_bench_expression(
+	int    const& depth,
+	string      & expression);
+
+/**
+* Compiles the corpus once, timing each phase
+* separately.
+*
+* @param input The corpus to compile.
+* @param report The report to record each phase into.
+* @return Returns SUCCESS if every phase succeeded.
+**/
+static inline
+KccExitCode run_bench_repetition(
+	const char* const& input,
+	TimeReport       & report);
+
+/**
+* Prints the spread of each phase's throughput over
+* every repetition.
+*
+* @param reports The report of each repetition.
+* @param num_reports The number of repetitions.
+* @param out The stream to print to.
+**/
+static inline
+void print_bench_results(
+	const TimeReport* const& reports,
+	int               const& num_reports,
+	ostream                & out = cout);
+
+static inline
+BenchArgs interpret_bench_args(
+	const char** const& argv,
+	int          const& argc);
+
+/*****************************************************//**
+*                         Definitions                    *
+/********************************************************/
+
+static inline
+void generate_bench_expression(
+	int    const& depth,
+	string      & expression)
+{
+	static const char* operators[] = { "+", "-", "*" };
+	for (int d = 0; d < depth; d++) {
+		expression += "(";
+	}
+	expression += "x";
+	for (int d = 1; d <= depth; d++) {
+		expression += " ";
+		expression += operators[d % 3];
+		expression += " ";
+		expression += to_string(d);
+		expression += ")";
+	}
+}
+
+static inline
+void generate_bench_corpus(
+	BenchCorpusParams const& params,
+	string                 & corpus)
+{
+	/* Lines no compilation ever reads, which the
+	   preprocessor must skip over, nested #if and all. */
+	static const char* skipped_group
+		= "int skipped( int x )\n"
+		  "{\n"
+		  "#if (1)\n"
+		  "\treturn x;\n"
+		  "#endif\n"
+		  "}\n";
+
+	corpus.clear();
+	/* The corpus is kept within a group so that
+	   every line of it is a text line of that group. */
+	corpus += "#if (0)\n";
+	corpus += skipped_group;
+	corpus += "#else\n";
+	for (int f = 0; f < params.num_functions; f++) {
+		/* Each macro expands to the one before it, so
+		   the last takes macro_density replacements.  */
+		string condition = "1";
+		for (int m = 0; m < params.macro_density; m++) {
+			const string name
+				= "KCC_BENCH_"
+				  + to_string(f)
+				  + "_"
+				  + to_string(m);
+			corpus += "#define "
+					  + name
+					  + " ("
+					  + condition
+					  + " + 1)\n";
+			condition = name;
+		}
+		for (int k = 0; k < params.if_depth; k++) {
+			if ((f + k) % 2 == 0) {
+				corpus += "#if " + condition + " > 0\n";
+			} else {
+				corpus += "#if " + condition + " < 0\n";
+				corpus += skipped_group;
+				corpus += "#else\n";
+			}
+		}
+		corpus += "int f" + to_string(f) + "( int x )\n";
+		corpus += "{\n";
+		corpus += "\tint y;\n";
+		corpus += "\ty = ";
+		generate_bench_expression(params.expression_depth, corpus);
+		corpus += ";\n";
+		corpus += "\treturn y;\n";
+		corpus += "}\n";
+		for (int k = params.if_depth - 1; k >= 0; k--) {
+			if ((f + k) % 2 == 0) {
+				corpus += "#else\n";
+				corpus += skipped_group;
+			}
+			corpus += "#endif\n";
+		}
+	}
+	corpus += "#endif\n";
+}
+
+static inline
+KccExitCode run_bench_repetition(
+	const char* const& input,
+	TimeReport       & report)
+{
+	KccExitCode exitcode
+		= KccExitCode::FAIL;
+
+	CompilationEnvironment environment
+		= CompilationEnvironment({ 0 });
+	environment.bkl
+		= AlertList();
+	environment.lexema
+		= new LexemaPool();
+	environment.sources
+		= new SourceMap();
+	environment.includes
+		= new IncludeTable();
+	environment.arena
+		= new Arena();
+	active_arena
+		= environment.arena;
+
+	/* Preprocessing. */
+	environment.ppts
+		= new PreprocessingTokenBuffer();
+	PreprocessingTokenAppender ppts_ptr
+		= environment.ppts->appender();
+	const char* input_ptr = input;
+	start_time_report_phase(report, TimeReportPhase::PREPROCESS);
+	const PreprocessorExitCode pp_exitcode = preprocess(
+		input_ptr,
+		*environment.lexema,
+		report.filename,
+		*environment.sources,
+		*environment.includes,
+		environment.bkl,
+		ppts_ptr);
+	finish_time_report_phase(
+		report,
+		TimeReportPhase::PREPROCESS,
+		environment.ppts->get_size());
+
+	if (pp_exitcode == PreprocessorExitCode::SUCCESS) {
+
+		/* Lexing. */
+		environment.tokens
+			= new TokenBuffer();
+		TokenAppender tokens_lex_ptr
+			= environment.tokens->appender();
+		start_time_report_phase(report, TimeReportPhase::LEX);
+		const LexerExitCode lex_exitcode = lex(
+			*environment.ppts,
+			tokens_lex_ptr,
+			environment.bkl);
+		finish_time_report_phase(
+			report,
+			TimeReportPhase::LEX,
+			environment.tokens->get_size());
+
+		if (lex_exitcode == LexerExitCode::SUCCESS
+			&& environment.tokens->get_size() > 0) {
+
+			/* Parsing. */
+			environment.tokens->push_back(Token());
+			TokenCursor tokens_parse_ptr
+				= environment.tokens->begin();
+			start_time_report_phase(report, TimeReportPhase::PARSE);
+			const ParserExitCode parse_exitcode = parse(
+				tokens_parse_ptr,
+				environment.ast_root);
+			finish_time_report_phase(
+				report,
+				TimeReportPhase::PARSE,
+				0);
+			/* Counted once the phase is over, so that the
+			   walk is not timed as part of it.          */
+			report.phases[(int) TimeReportPhase::PARSE].count
+				= count_ast_nodes(environment.ast_root);
+
+			if (parse_exitcode == ParserExitCode::SUCCESS) {
+
+				/* Semantic Analysis. */
+				start_time_report_phase(report, TimeReportPhase::ANNOTATE);
+				const SemanticAnnotatorExitCode anno_exitcode = annotate(
+					environment.ast_root,
+					environment.anno_ast_root);
+				finish_time_report_phase(
+					report,
+					TimeReportPhase::ANNOTATE,
+					0);
+				report.phases[(int) TimeReportPhase::ANNOTATE].count
+					= count_annotated_ast_nodes(environment.anno_ast_root);
+
+				if (anno_exitcode == SemanticAnnotatorExitCode::SUCCESS) {
+
+					/* Code Generation. */
+					environment.instrs
+						= new x86_Asm_IR_Buffer();
+					x86_Asm_IR_Appender instrs_ptr
+						= environment.instrs->appender();
+					int num_labels = 0;
+					start_time_report_phase(report, TimeReportPhase::GEN);
+					const CodeGeneratorExitCode gen_exitcode = gen(
+						num_labels,
+						environment.anno_ast_root,
+						instrs_ptr);
+					finish_time_report_phase(
+						report,
+						TimeReportPhase::GEN,
+						environment.instrs->get_size());
+
+					if (gen_exitcode == CodeGeneratorExitCode::SUCCESS) {
+						exitcode = KccExitCode::SUCCESS;
+					}
+				}
+			}
+		}
+	}
+
+	reset_lexema_pool(*environment.lexema);
+	free_compilation_environment(environment);
+	return exitcode;
+}
+
+static inline
+void print_bench_results(
+	const TimeReport* const& reports,
+	int               const& num_reports,
+	ostream                & out)
+{
+	const ios_base::fmtflags saved_flags
+		= out.flags();
+
+	out << std::left
+		<< std::setfill(' ')
+		<< std::setw(TIME_REPORT_PHASE_WIDTH) << "Phase"
+		<< std::right
+		<< std::setw(TIME_REPORT_COUNT_WIDTH) << "Count"
+		<< "  "
+		<< std::left
+		<< std::setw(TIME_REPORT_UNIT_WIDTH)  << "Unit"
+		<< std::right
+		<< std::setw(TIME_REPORT_TIME_WIDTH)  << "Median (ms)"
+		<< std::setw(TIME_REPORT_TIME_WIDTH)  << "Min (ms)"
+		<< std::setw(TIME_REPORT_TIME_WIDTH)  << "Stddev (%)"
+		<< std::setw(TIME_REPORT_RATE_WIDTH)  << "Count/s"
+		<< endl;
+
+	double* wall_ms
+		= new double[num_reports];
+	for (int i = 0; i < NUM_TIME_REPORT_PHASES; i++) {
+		out << std::left
+			<< std::setw(TIME_REPORT_PHASE_WIDTH)
+			<< time_report_phase_string_repr[i]
+			<< std::right;
+
+		/* Only repetitions which reached this phase count. */
+		int      num_ran = 0;
+		uint64_t count   = 0;
+		for (int r = 0; r < num_reports; r++) {
+			const TimeReportEntry& entry
+				= reports[r].phases[i];
+			if (entry.ran) {
+				wall_ms[num_ran++] = entry.wall_ns / 1e6;
+				count = entry.count;
+			}
+		}
+		if (num_ran == 0) {
+			out << std::setw(TIME_REPORT_COUNT_WIDTH) << "-"
+				<< "  "
+				<< "did not run"
+				<< endl;
+			continue;
+		}
+
+		sort(wall_ms, wall_ms + num_ran);
+		const double median
+			= num_ran % 2
+			  ? wall_ms[num_ran / 2]
+			  : (wall_ms[num_ran / 2 - 1] + wall_ms[num_ran / 2]) / 2;
+		double mean = 0;
+		for (int r = 0; r < num_ran; r++) {
+			mean += wall_ms[r];
+		}
+		mean /= num_ran;
+		double variance = 0;
+		for (int r = 0; r < num_ran; r++) {
+			variance += (wall_ms[r] - mean) * (wall_ms[r] - mean);
+		}
+		variance /= num_ran;
+		const double stddev_percent
+			= mean > 0
+			  ? 100 * sqrt(variance) / mean
+			  : 0;
+		const double rate
+			= median > 0
+			  ? count * 1e3 / median
+			  : 0;
+
+		out << std::setw(TIME_REPORT_COUNT_WIDTH) << count
+			<< "  "
+			<< std::left
+			<< std::setw(TIME_REPORT_UNIT_WIDTH)
+			<< time_report_unit_string_repr[i]
+			<< std::right
+			<< std::fixed
+			<< std::setprecision(3)
+			<< std::setw(TIME_REPORT_TIME_WIDTH) << median
+			<< std::setw(TIME_REPORT_TIME_WIDTH) << wall_ms[0]
+			<< std::setprecision(1)
+			<< std::setw(TIME_REPORT_TIME_WIDTH) << stddev_percent
+			<< std::setprecision(0)
+			<< std::setw(TIME_REPORT_RATE_WIDTH) << rate
+			<< endl;
+	}
+	delete[] wall_ms;
+
+	out.flags(saved_flags);
+}
+
+/*
+	kcc-bench-directive:
+		kcc-bench <flags>
+
+	flag:
+		-<flag-mnemonic>
+
+	flag-mnemonic:
+		h
+		| n <number>
+		| d <number>
+		| m <number>
+		| k <number>
+		| r <number>
+		| o <filepath>
+*/
+
+static inline
+BenchArgs interpret_bench_args(
+	const char** const& argv,
+	int          const& argc)
+{
+	BenchArgs args = BenchArgs({ 0 });
+	args.params.num_functions    = BENCH_DEFAULT_NUM_FUNCTIONS;
+	args.params.expression_depth = BENCH_DEFAULT_EXPRESSION_DEPTH;
+	args.params.macro_density    = BENCH_DEFAULT_MACRO_DENSITY;
+	args.params.if_depth         = BENCH_DEFAULT_IF_DEPTH;
+	args.repetitions             = BENCH_DEFAULT_REPETITIONS;
+
+	for (int i = 1; i < argc; i++) {
+		const char* chr = argv[i];
+		if (*chr != '-' || !chr[1]) {
+			args.help = true;
+			continue;
+		}
+		const char flag = chr[1];
+		/* Accept both -n4 and -n 4. */
+		const char* value = chr + 2;
+		if (*value == '\0'
+			&& flag != 'h'
+			&& i + 1 < argc) {
+			value = argv[++i];
+		}
+		switch (flag) {
+			case 'n': args.params.num_functions    = atoi(value); break;
+			case 'd': args.params.expression_depth = atoi(value); break;
+			case 'm': args.params.macro_density    = atoi(value); break;
+			case 'k': args.params.if_depth         = atoi(value); break;
+			case 'r': args.repetitions             = atoi(value); break;
+			case 'o': args.corpus_dest             = value;       break;
+			default:  args.help                    = true;        break;
+		}
+	}
+	if (args.repetitions < 1) {
+		args.repetitions = 1;
+	}
+	return args;
+}
+
+#endif
@@ -0,0 +1,21 @@
+/* Authored by Charlie Keaney                       */
+/* kcc-tester.cpp - Responsible for driving
+					kcc-tester, failing if any test
+					fails.                         */
+
+#ifndef KCC_TESTER_CPP
+#define KCC_TESTER_CPP 1
+
+#include "kcc-tester.h"
+
+/*****************************************************//**
+*                         Definitions                    *
+/********************************************************/
+
+int main(int argc, const char** argv) {
+	return kcc_run_tests() == TestResult::SUCCESS
+		   ? 0
+		   : 1;
+}
+
+#endif
@@ -1,31 +1,87 @@
+/* Authored by Charlie Keaney                      */
+/* kcc-tester.h - Responsible for running every
+				  tester and presenting their
+				  results.                       */
 
-#ifdef KCC_TESTER_H
+#ifndef KCC_TESTER_H
 #define KCC_TESTER_H 1
 
+#include <iostream>
+
 #include "lexer-tester.h"
 #include "preprocessor-tester.h"
 #include "parser-tester.h"
+#include "lexema-pool-tester.h"
+#include "symbol-table-tester.h"
+#include "keywords-tester.h"
+#include "char-scan-tester.h"
+#include "punctuators-tester.h"
+#include "numeric-literals-tester.h"
+#include "directives-tester.h"
 
 #define TEST_OUTPUT_STR_LEN 1 << 16
 
- static inline void kcc_run_tests() 
+using namespace std;
+
+static inline TestResult kcc_run_tests()
 {
 	char output[TEST_OUTPUT_STR_LEN];
 	char* o = output;
 
 	print_to_output("<-> KCC-Tests\n", o);
-	
-	TestResult pp_results[NUM_PREPROCESSOR_TESTS];
-	TestResult pp_result = test_preprocessor(pp_results, o, 1);
 
-	TestResult lex_results[NUM_LEX_TESTS];
-	TestResult lex_result = test_lex(lex_results, o, 1);
+	/* The lexer, preprocessor and parser testers
+	   are temporarily defunct.                   */
+
+	// TestResult pp_results[NUM_PREPROCESSOR_TESTS];
+	// TestResult pp_result = test_preprocessor(pp_results, o, 1);
+
+	// TestResult lex_results[NUM_LEX_TESTS];
+	// TestResult lex_result = test_lex(lex_results, o, 1);
 
 	// TestResult parser_results[NUM_PARSER_TESTS];
 	// TestResult parser_result = test_parser(parser_results, o, 1);
-	
-	*o++ = NULL;
+
+	TestResult lexema_pool_results[NUM_LEXEMA_POOL_TESTS];
+	TestResult lexema_pool_result
+		= test_lexema_pool(lexema_pool_results, o, 1);
+
+	TestResult symbol_table_results[NUM_SYMBOL_TABLE_TESTS];
+	TestResult symbol_table_result
+		= test_symbol_table(symbol_table_results, o, 1);
+
+	TestResult keywords_results[NUM_KEYWORDS_TESTS];
+	TestResult keywords_result
+		= test_keywords(keywords_results, o, 1);
+
+	TestResult char_scan_results[NUM_CHAR_SCAN_TESTS];
+	TestResult char_scan_result
+		= test_char_scan(char_scan_results, o, 1);
+
+	TestResult punctuators_results[NUM_PUNCTUATORS_TESTS];
+	TestResult punctuators_result
+		= test_punctuators(punctuators_results, o, 1);
+
+	TestResult numeric_literals_results[NUM_NUMERIC_LITERALS_TESTS];
+	TestResult numeric_literals_result
+		= test_numeric_literals(numeric_literals_results, o, 1);
+
+	TestResult directives_results[NUM_DIRECTIVES_TESTS];
+	TestResult directives_result
+		= test_directives(directives_results, o, 1);
+
+	*o++ = '\0';
 	cout << output;
+
+	return (lexema_pool_result == TestResult::SUCCESS
+			&& symbol_table_result == TestResult::SUCCESS
+			&& keywords_result == TestResult::SUCCESS
+			&& char_scan_result == TestResult::SUCCESS
+			&& punctuators_result == TestResult::SUCCESS
+			&& numeric_literals_result == TestResult::SUCCESS
+			&& directives_result == TestResult::SUCCESS)
+		   ? TestResult::SUCCESS
+		   : TestResult::FAIL;
 }
 
-#endif
\ No newline at end of file
+#endif
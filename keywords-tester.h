@@ -0,0 +1,137 @@
+/* Authored by Charlie Keaney                   */
+/* keywords-tester.h - Responsible for testing
+					   the recognition of
+					   keywords.                */
+
+#ifndef KEYWORDS_TESTER_H
+#define KEYWORDS_TESTER_H 1
+
+#include "tester-tools.h"
+#include "keywords.h"
+
+#define NUM_KEYWORDS_TESTS 1
+
+//////////////////////////////////////////////////////////////////
+//         Testing for the lookup of keywords by hash           //
+//////////////////////////////////////////////////////////////////
+
+#define NUM_KEYWORD_LOOKUP_TESTS 58
+
+struct keyword_lookup_test_case {
+	const char* lexeme;
+	TokenForm   form;
+};
+
+/* Those after the keywords are not keywords. Some of
+   them hash as a keyword does, sharing its first two
+   characters, last character and length.         */
+static const
+keyword_lookup_test_case
+test_keyword_lookup_table[NUM_KEYWORD_LOOKUP_TESTS] = {
+	{ "auto",           TokenForm::AUTO       },
+	{ "break",          TokenForm::BREAK      },
+	{ "case",           TokenForm::CASE       },
+	{ "char",           TokenForm::CHAR       },
+	{ "const",          TokenForm::CONST      },
+	{ "continue",       TokenForm::CONTINUE   },
+	{ "default",        TokenForm::DEFAULT    },
+	{ "do",             TokenForm::DO         },
+	{ "double",         TokenForm::DOUBLE     },
+	{ "else",           TokenForm::ELSE       },
+	{ "enum",           TokenForm::ENUM       },
+	{ "extern",         TokenForm::EXTERN     },
+	{ "float",          TokenForm::FLOAT      },
+	{ "for",            TokenForm::FOR        },
+	{ "goto",           TokenForm::GOTO       },
+	{ "if",             TokenForm::IF         },
+	{ "inline",         TokenForm::INLINE     },
+	{ "int",            TokenForm::INT        },
+	{ "long",           TokenForm::LONG       },
+	{ "register",       TokenForm::REGISTER   },
+	{ "restrict",       TokenForm::RESTRICT   },
+	{ "return",         TokenForm::RETURN     },
+	{ "short",          TokenForm::SHORT      },
+	{ "signed",         TokenForm::SIGNED     },
+	{ "sizeof",         TokenForm::SIZEOF     },
+	{ "static",         TokenForm::STATIC     },
+	{ "struct",         TokenForm::STRUCT     },
+	{ "switch",         TokenForm::SWITCH     },
+	{ "typedef",        TokenForm::TYPEDEF    },
+	{ "union",          TokenForm::UNION      },
+	{ "unsigned",       TokenForm::UNSIGNED   },
+	{ "void",           TokenForm::VOID       },
+	{ "volatile",       TokenForm::VOLATILE   },
+	{ "while",          TokenForm::WHILE      },
+	{ "_Bool",          TokenForm::_BOOL      },
+	{ "_Complex",       TokenForm::_COMPLEX   },
+	{ "_Imaginary",     TokenForm::_IMAGINARY },
+	{ "",               TokenForm::SIMPLE     },
+	{ "i",              TokenForm::SIMPLE     },
+	{ "in",             TokenForm::SIMPLE     },
+	{ "intt",           TokenForm::SIMPLE     },
+	{ "Int",            TokenForm::SIMPLE     },
+	{ "INT",            TokenForm::SIMPLE     },
+	{ "sizeo",          TokenForm::SIMPLE     },
+	{ "whilex",         TokenForm::SIMPLE     },
+	{ "_Boo",           TokenForm::SIMPLE     },
+	{ "_Bools",         TokenForm::SIMPLE     },
+	{ "_Imaginaryx",    TokenForm::SIMPLE     },
+	{ "_Imaginary_too", TokenForm::SIMPLE     },
+	{ "autoadditional", TokenForm::SIMPLE     },
+	{ "identifier",     TokenForm::SIMPLE     },
+	{ "lo_g",           TokenForm::SIMPLE     },
+	{ "retu_n",         TokenForm::SIMPLE     },
+	{ "whi_e",          TokenForm::SIMPLE     },
+	{ "dooble",         TokenForm::SIMPLE     },
+	{ "_Co_plex",       TokenForm::SIMPLE     },
+	{ "unsig_ed",       TokenForm::SIMPLE     },
+	{ "_Imagin_ry",     TokenForm::SIMPLE     }
+};
+
+static inline TestResult test_keyword_lookup(
+	TestResult results[NUM_KEYWORD_LOOKUP_TESTS])
+{
+	bool all_tests_passed = true;
+	for (const keyword_lookup_test_case* ktc
+			= test_keyword_lookup_table;
+		ktc < test_keyword_lookup_table + NUM_KEYWORD_LOOKUP_TESTS;
+		ktc++) {
+		const bool success_criteria
+			= lookup_keyword(ktc->lexeme) == ktc->form;
+		results[ktc - test_keyword_lookup_table]
+			= success_criteria ? TestResult::SUCCESS : TestResult::FAIL;
+		if (!success_criteria) {
+			all_tests_passed = false;
+		}
+	}
+	return all_tests_passed ? TestResult::SUCCESS : TestResult::FAIL;
+}
+
+static inline TestResult test_keywords(
+	TestResult results[NUM_KEYWORDS_TESTS],
+	char* &output,
+	int indent = 0)
+{
+	TestResult lookup_results[NUM_KEYWORD_LOOKUP_TESTS];
+	TestResult lookup_result
+		= test_keyword_lookup(lookup_results);
+	results[0] = lookup_result;
+
+	for (int i = 0; i < indent; i++) print_to_output("\t", output);
+	print_to_output("<-> KeywordsTests", output);
+	print_to_output("\n", output);
+
+	const char* lookup_title = "KeywordLookupTests";
+	present_test_set_synopsis(
+		lookup_title,
+		lookup_result,
+		lookup_results,
+		NUM_KEYWORD_LOOKUP_TESTS,
+		output,
+		indent + 1
+	);
+
+	return lookup_result;
+}
+
+#endif
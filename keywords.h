@@ -0,0 +1,221 @@
+/* Authored by Charlie Keaney                  */
+/* keywords.h - Responsible for recognising the
+				keywords of C in constant time.
+
+				Implementation Notes:
+				The keywords are looked up in a
+				perfect hash table built at
+				compile time. A lexeme is hashed
+				by its first two characters, its
+				last character and its length,
+				multiplied through and shifted.
+				The multiplier is searched for,
+				also at compile time, as the
+				first for which no two keywords
+				share a slot, so the table needs
+				no probing. One comparison of
+				length and characters then tells
+				a keyword from an identifier
+				which happens to hash to it.  */
+
+#ifndef KEYWORDS_H
+#define KEYWORDS_H 1
+
+#include <cstddef>
+#include <cstdint>
+#include <string.h>
+
+#include "token.h"
+
+#define NUM_KEYWORDS 37
+
+/* The most characters and the fewest any keyword has. */
+#define KEYWORD_MAX_LENGTH 10
+#define KEYWORD_MIN_LENGTH 2
+
+/* The table has 1 << KEYWORD_TABLE_BITS slots. */
+#define KEYWORD_TABLE_BITS 7
+#define KEYWORD_TABLE_SZ   (1 << KEYWORD_TABLE_BITS)
+
+/* How many multipliers are tried before giving up. */
+#define KEYWORD_MAX_SEEDS  (1 << 16)
+
+using namespace std;
+
+/*****************************************************//**
+*                      Declarations                      *
+/********************************************************/
+
+/**
+* A keyword and the form of token it lexes to. An
+* empty slot of the table has a length of 0.
+**/
+struct Keyword {
+	const char* spelling;
+	size_t      length;
+	TokenForm   form;
+};
+
+struct KeywordTable {
+	uint32_t multiplier;
+	Keyword  slots[KEYWORD_TABLE_SZ];
+};
+
+static constexpr Keyword keywords[NUM_KEYWORDS] = {
+	{ "auto",       4,  TokenForm::AUTO       },
+	{ "break",      5,  TokenForm::BREAK      },
+	{ "case",       4,  TokenForm::CASE       },
+	{ "char",       4,  TokenForm::CHAR       },
+	{ "const",      5,  TokenForm::CONST      },
+	{ "continue",   8,  TokenForm::CONTINUE   },
+	{ "default",    7,  TokenForm::DEFAULT    },
+	{ "do",         2,  TokenForm::DO         },
+	{ "double",     6,  TokenForm::DOUBLE     },
+	{ "else",       4,  TokenForm::ELSE       },
+	{ "enum",       4,  TokenForm::ENUM       },
+	{ "extern",     6,  TokenForm::EXTERN     },
+	{ "float",      5,  TokenForm::FLOAT      },
+	{ "for",        3,  TokenForm::FOR        },
+	{ "goto",       4,  TokenForm::GOTO       },
+	{ "if",         2,  TokenForm::IF         },
+	{ "inline",     6,  TokenForm::INLINE     },
+	{ "int",        3,  TokenForm::INT        },
+	{ "long",       4,  TokenForm::LONG       },
+	{ "register",   8,  TokenForm::REGISTER   },
+	{ "restrict",   8,  TokenForm::RESTRICT   },
+	{ "return",     6,  TokenForm::RETURN     },
+	{ "short",      5,  TokenForm::SHORT      },
+	{ "signed",     6,  TokenForm::SIGNED     },
+	{ "sizeof",     6,  TokenForm::SIZEOF     },
+	{ "static",     6,  TokenForm::STATIC     },
+	{ "struct",     6,  TokenForm::STRUCT     },
+	{ "switch",     6,  TokenForm::SWITCH     },
+	{ "typedef",    7,  TokenForm::TYPEDEF    },
+	{ "union",      5,  TokenForm::UNION      },
+	{ "unsigned",   8,  TokenForm::UNSIGNED   },
+	{ "void",       4,  TokenForm::VOID       },
+	{ "volatile",   8,  TokenForm::VOLATILE   },
+	{ "while",      5,  TokenForm::WHILE      },
+	{ "_Bool",      5,  TokenForm::_BOOL      },
+	{ "_Complex",   8,  TokenForm::_COMPLEX   },
+	{ "_Imaginary", 10, TokenForm::_IMAGINARY }
+};
+
+/**
+* Hashes a lexeme to a slot of the keyword table.
+*
+* @param lexeme The lexeme, at least KEYWORD_MIN_LENGTH long.
+* @param length The length of the lexeme.
+* @param multiplier The multiplier of the table.
+* @return Returns the slot the lexeme hashes to.
+**/
+static constexpr inline
+uint32_t hash_keyword(
+	const char* const& lexeme,
+	size_t      const& length,
+	uint32_t    const& multiplier);
+
+/**
+* Builds the keyword table, searching for a multiplier
+* under which every keyword has a slot of its own.
+*
+* @return Returns the table, with a multiplier of 0 if
+*         no multiplier was found.
+**/
+static constexpr inline
+KeywordTable construct_keyword_table();
+
+/**
+* Returns the form of keyword the given lexeme spells,
+* looking at no more than KEYWORD_MAX_LENGTH + 1 of
+* its characters.
+*
+* @param lexeme The NUL terminated lexeme.
+* @return Returns the keyword's form, or SIMPLE if the
+*         lexeme is not a keyword.
+**/
+static inline
+TokenForm lookup_keyword(
+	const char* const& lexeme);
+
+/*****************************************************//**
+*                         Definitions                    *
+/********************************************************/
+
+static constexpr inline
+uint32_t hash_keyword(
+	const char* const& lexeme,
+	size_t      const& length,
+	uint32_t    const& multiplier)
+{
+	const uint32_t key
+		= ((uint32_t) (unsigned char) lexeme[0] * 31
+		   + (uint32_t) (unsigned char) lexeme[1]) * 31
+		  + (uint32_t) (unsigned char) lexeme[length - 1]
+		  + (uint32_t) length;
+	return (key * multiplier) >> (32 - KEYWORD_TABLE_BITS);
+}
+
+static constexpr inline
+KeywordTable construct_keyword_table()
+{
+	KeywordTable table = { };
+	for (uint32_t seed = 1; seed < KEYWORD_MAX_SEEDS; seed++) {
+		const uint32_t multiplier
+			= (seed * 2654435761u) | 1;
+		bool taken[KEYWORD_TABLE_SZ] = { };
+		bool perfect = true;
+		for (size_t k = 0; perfect && k < NUM_KEYWORDS; k++) {
+			const uint32_t h = hash_keyword(
+				keywords[k].spelling,
+				keywords[k].length,
+				multiplier);
+			perfect = !taken[h];
+			taken[h] = true;
+		}
+		if (perfect) {
+			table.multiplier = multiplier;
+			for (size_t k = 0; k < NUM_KEYWORDS; k++) {
+				table.slots[hash_keyword(
+					keywords[k].spelling,
+					keywords[k].length,
+					multiplier)] = keywords[k];
+			}
+			return table;
+		}
+	}
+	return table;
+}
+
+static constexpr KeywordTable keyword_table
+	= construct_keyword_table();
+
+static_assert(
+	keyword_table.multiplier != 0,
+	"no perfect hash was found for the keywords");
+
+static inline
+TokenForm lookup_keyword(
+	const char* const& lexeme)
+{
+	size_t length = 0;
+	while (length <= KEYWORD_MAX_LENGTH
+		   && lexeme[length] != '\0') {
+		length++;
+	}
+	if (length < KEYWORD_MIN_LENGTH
+		|| length > KEYWORD_MAX_LENGTH) {
+		return TokenForm::SIMPLE;
+	}
+	const Keyword& keyword
+		= keyword_table.slots[hash_keyword(
+			lexeme,
+			length,
+			keyword_table.multiplier)];
+	return keyword.length == length
+		   && memcmp(keyword.spelling, lexeme, length) == 0
+		   ? keyword.form
+		   : TokenForm::SIMPLE;
+}
+
+#endif
@@ -0,0 +1,580 @@
+/* Authored by Charlie Keaney                      */
+/* lexema-pool-tester.h - Responsible for testing
+						  the lexema pool.       */
+
+#ifndef LEXEMA_POOL_TESTER_H
+#define LEXEMA_POOL_TESTER_H 1
+
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "tester-tools.h"
+#include "lexema-pool.h"
+
+#define NUM_LEXEMA_POOL_TESTS 6
+
+//////////////////////////////////////////////////////////////////
+//          Testing for the interning of lexema                 //
+//////////////////////////////////////////////////////////////////
+
+#define NUM_LEXEMA_POOL_INTERN_TESTS 12
+
+struct lexema_pool_intern_test_case {
+	const char* lexeme;
+};
+
+static const
+lexema_pool_intern_test_case
+test_lexema_pool_intern_table[NUM_LEXEMA_POOL_INTERN_TESTS] = {
+	{ "x"                                          },
+	{ "y"                                          },
+	{ "xy"                                         },
+	{ "yx"                                         },
+	{ "int"                                        },
+	{ "integer"                                    },
+	{ "_"                                          },
+	{ "__func__"                                   },
+	{ "a_rather_long_identifier_to_compare_in_full" },
+	{ "a_rather_long_identifier_to_compare_in_fulL" },
+	{ "0x7fffffff"                                 },
+	{ "\"string literal\""                         }
+};
+
+/**
+* Pools each lexeme, expecting it to be inserted once
+* and to be found again, by its pooled copy, after
+* every lexeme after it has been pooled too.
+**/
+static inline TestResult test_lexema_pool_intern(
+	TestResult results[NUM_LEXEMA_POOL_INTERN_TESTS])
+{
+	bool all_tests_passed = true;
+	LexemaPool pool;
+	const char* pooled[NUM_LEXEMA_POOL_INTERN_TESTS];
+	for (const lexema_pool_intern_test_case* ltc
+			= test_lexema_pool_intern_table;
+		ltc < test_lexema_pool_intern_table + NUM_LEXEMA_POOL_INTERN_TESTS;
+		ltc++) {
+		const bool is_inserted
+			= insert_lexeme_into_pool(pool, ltc->lexeme);
+		const bool is_reinserted
+			= insert_lexeme_into_pool(pool, ltc->lexeme);
+		const LexemaEntry* const entry
+			= lookup_lexeme_in_pool(pool, ltc->lexeme);
+		pooled[ltc - test_lexema_pool_intern_table]
+			= entry ? entry->lexeme.load() : NULL;
+		results[ltc - test_lexema_pool_intern_table]
+			= is_inserted && !is_reinserted && entry != NULL
+			  ? TestResult::SUCCESS
+			  : TestResult::FAIL;
+	}
+	for (const lexema_pool_intern_test_case* ltc
+			= test_lexema_pool_intern_table;
+		ltc < test_lexema_pool_intern_table + NUM_LEXEMA_POOL_INTERN_TESTS;
+		ltc++) {
+		const char* const expected
+			= pooled[ltc - test_lexema_pool_intern_table];
+		const LexemaEntry* const entry
+			= lookup_lexeme_in_pool(pool, ltc->lexeme);
+		const bool success_criteria
+			= expected != NULL
+			  && expected != ltc->lexeme
+			  && strcmp(expected, ltc->lexeme) == 0
+			  && entry != NULL
+			  && entry->lexeme.load() == expected
+			  && entry->length == strlen(ltc->lexeme);
+		if (!success_criteria) {
+			results[ltc - test_lexema_pool_intern_table]
+				= TestResult::FAIL;
+		}
+	}
+	for (int i = 0; i < NUM_LEXEMA_POOL_INTERN_TESTS; i++) {
+		if (results[i] != TestResult::SUCCESS) {
+			all_tests_passed = false;
+		}
+	}
+	return all_tests_passed ? TestResult::SUCCESS : TestResult::FAIL;
+}
+
+//////////////////////////////////////////////////////////////////
+//         Testing that the lexema pool grows intact            //
+//////////////////////////////////////////////////////////////////
+
+#define NUM_LEXEMA_POOL_GROWTH_TESTS 7
+
+struct lexema_pool_growth_test_case {
+	size_t num_lexema;
+	size_t capacity;
+};
+
+static const
+lexema_pool_growth_test_case
+test_lexema_pool_growth_table[NUM_LEXEMA_POOL_GROWTH_TESTS] = {
+	{ 0,                              LEXEMA_POOL_INITIAL_SZ      },
+	{ 1,                              LEXEMA_POOL_INITIAL_SZ      },
+	{ LEXEMA_POOL_INITIAL_SZ / 2,     LEXEMA_POOL_INITIAL_SZ      },
+	{ LEXEMA_POOL_INITIAL_SZ / 2 + 1, LEXEMA_POOL_INITIAL_SZ * 2  },
+	{ LEXEMA_POOL_INITIAL_SZ,         LEXEMA_POOL_INITIAL_SZ * 2  },
+	{ LEXEMA_POOL_INITIAL_SZ * 4 + 1, LEXEMA_POOL_INITIAL_SZ * 16 },
+	{ 10000,                          1 << 15                     }
+};
+
+/**
+* Pools a number of distinct lexema, expecting the
+* pool to have doubled in size to stay at most half
+* full, and every lexeme to be found where it was
+* first pooled, then none to be found once the pool
+* is reset.
+**/
+static inline TestResult test_lexema_pool_growth(
+	TestResult results[NUM_LEXEMA_POOL_GROWTH_TESTS])
+{
+	bool all_tests_passed = true;
+	for (const lexema_pool_growth_test_case* ltc
+			= test_lexema_pool_growth_table;
+		ltc < test_lexema_pool_growth_table + NUM_LEXEMA_POOL_GROWTH_TESTS;
+		ltc++) {
+		LexemaPool pool;
+		const char** pooled
+			= new const char*[ltc->num_lexema + 1];
+		char lexeme[32];
+		bool success_criteria = true;
+		for (size_t i = 0; i < ltc->num_lexema; i++) {
+			snprintf(lexeme, sizeof(lexeme), "lexeme_%zu", i);
+			pooled[i] = intern_lexeme(pool, lexeme, strlen(lexeme));
+		}
+		for (size_t i = 0; i < ltc->num_lexema; i++) {
+			snprintf(lexeme, sizeof(lexeme), "lexeme_%zu", i);
+			const LexemaEntry* const entry
+				= lookup_lexeme_in_pool(pool, lexeme);
+			if (entry == NULL
+				|| entry->lexeme.load() != pooled[i]
+				|| strcmp(pooled[i], lexeme) != 0) {
+				success_criteria = false;
+			}
+		}
+		success_criteria
+			= success_criteria
+			  && pool.num_entries.load() == ltc->num_lexema
+			  && pool.table.load()->capacity == ltc->capacity;
+		reset_lexema_pool(pool);
+		if (ltc->num_lexema > 0
+			&& (pool.num_entries.load() != 0
+				|| lookup_lexeme_in_pool(pool, "lexeme_0") != NULL)) {
+			success_criteria = false;
+		}
+		delete[] pooled;
+		results[ltc - test_lexema_pool_growth_table]
+			= success_criteria ? TestResult::SUCCESS : TestResult::FAIL;
+		if (!success_criteria) {
+			all_tests_passed = false;
+		}
+	}
+	return all_tests_passed ? TestResult::SUCCESS : TestResult::FAIL;
+}
+
+//////////////////////////////////////////////////////////////////
+//        Testing for the interning of spans of source          //
+//////////////////////////////////////////////////////////////////
+
+#define NUM_LEXEMA_POOL_SPAN_TESTS 9
+
+struct lexema_pool_span_test_case {
+	const char* source;
+	size_t      offset;
+	size_t      length;
+	const char* lexeme;
+};
+
+static const
+lexema_pool_span_test_case
+test_lexema_pool_span_table[NUM_LEXEMA_POOL_SPAN_TESTS] = {
+	{ "int x;",               4, 1,  "x"          },
+	{ "int x;",               0, 3,  "int"        },
+	{ "integer",              0, 3,  "int"        },
+	{ "int int",              4, 3,  "int"        },
+	{ "xyz",                  1, 1,  "y"          },
+	{ "a+b",                  2, 1,  "b"          },
+	{ "while(1)",             0, 5,  "while"      },
+	{ "\"str\" x",            0, 5,  "\"str\""    },
+	{ "identifier_with_tail", 0, 10, "identifier" }
+};
+
+/**
+* Pools each lexeme whole, then pools it again as a
+* span of a larger source, expecting the span to find
+* the same pooled copy without adding to the pool.
+**/
+static inline TestResult test_lexema_pool_span(
+	TestResult results[NUM_LEXEMA_POOL_SPAN_TESTS])
+{
+	bool all_tests_passed = true;
+	LexemaPool pool;
+	for (const lexema_pool_span_test_case* ltc
+			= test_lexema_pool_span_table;
+		ltc < test_lexema_pool_span_table + NUM_LEXEMA_POOL_SPAN_TESTS;
+		ltc++) {
+		const char* const whole = intern_lexeme(
+			pool,
+			ltc->lexeme,
+			strlen(ltc->lexeme));
+		const size_t num_entries
+			= pool.num_entries.load();
+		const char* const span
+			= ltc->source + ltc->offset;
+		const char* const pooled = intern_lexeme(
+			pool,
+			span,
+			ltc->length);
+		const LexemaEntry* const entry
+			= lookup_lexeme_span_in_pool(pool, span, ltc->length);
+		const bool success_criteria
+			= pooled == whole
+			  && pooled != span
+			  && pooled[ltc->length] == '\0'
+			  && pool.num_entries.load() == num_entries
+			  && entry != NULL
+			  && entry->lexeme.load() == pooled;
+		results[ltc - test_lexema_pool_span_table]
+			= success_criteria ? TestResult::SUCCESS : TestResult::FAIL;
+		if (!success_criteria) {
+			all_tests_passed = false;
+		}
+	}
+	return all_tests_passed ? TestResult::SUCCESS : TestResult::FAIL;
+}
+
+//////////////////////////////////////////////////////////////////
+//         Testing for the numbering of lexema by atom          //
+//////////////////////////////////////////////////////////////////
+
+#define NUM_LEXEMA_POOL_ATOM_TESTS 10
+
+struct lexema_pool_atom_test_case {
+	const char* lexeme;
+	uint32_t    atom;
+};
+
+static const
+lexema_pool_atom_test_case
+test_lexema_pool_atom_table[NUM_LEXEMA_POOL_ATOM_TESTS] = {
+	{ "main",   1 },
+	{ "argc",   2 },
+	{ "main",   1 },
+	{ "argv",   3 },
+	{ "ar",     4 },
+	{ "argc",   2 },
+	{ "return", 5 },
+	{ "ar",     4 },
+	{ "0",      6 },
+	{ "main",   1 }
+};
+
+/**
+* Pools each lexeme in turn, expecting lexema to be
+* numbered from 1 in the order they were first pooled
+* and the atom read back from the pooled copy to be
+* the one its entry holds.
+**/
+static inline TestResult test_lexema_pool_atom(
+	TestResult results[NUM_LEXEMA_POOL_ATOM_TESTS])
+{
+	bool all_tests_passed = true;
+	LexemaPool pool;
+	for (const lexema_pool_atom_test_case* ltc
+			= test_lexema_pool_atom_table;
+		ltc < test_lexema_pool_atom_table + NUM_LEXEMA_POOL_ATOM_TESTS;
+		ltc++) {
+		const char* const pooled = intern_lexeme(
+			pool,
+			ltc->lexeme,
+			strlen(ltc->lexeme));
+		const LexemaEntry* const entry
+			= lookup_lexeme_in_pool(pool, ltc->lexeme);
+		const bool success_criteria
+			= get_lexeme_atom(pooled) == ltc->atom
+			  && entry != NULL
+			  && entry->atom == ltc->atom;
+		results[ltc - test_lexema_pool_atom_table]
+			= success_criteria ? TestResult::SUCCESS : TestResult::FAIL;
+		if (!success_criteria) {
+			all_tests_passed = false;
+		}
+	}
+	return all_tests_passed ? TestResult::SUCCESS : TestResult::FAIL;
+}
+
+//////////////////////////////////////////////////////////////////
+//       Testing for interning into a concurrent pool           //
+//////////////////////////////////////////////////////////////////
+
+#define NUM_LEXEMA_POOL_CONCURRENT_TESTS 6
+
+struct lexema_pool_concurrent_test_case {
+	size_t num_threads;
+	size_t num_lexema;
+};
+
+static const
+lexema_pool_concurrent_test_case
+test_lexema_pool_concurrent_table[NUM_LEXEMA_POOL_CONCURRENT_TESTS] = {
+	{ 1,  100                         },
+	{ 2,  LEXEMA_POOL_NUM_STRIPES     },
+	{ 4,  LEXEMA_POOL_INITIAL_SZ / 2  },
+	{ 4,  1000                        },
+	{ 8,  5000                        },
+	{ 16, 20000                       }
+};
+
+/**
+* Interns the same lexema from several threads at
+* once into a concurrent pool, each thread starting
+* at a different lexeme, expecting every lexeme to be
+* pooled once, every thread to be given the same copy
+* of it and the atoms to number the lexema from 1
+* without a gap.
+**/
+static inline TestResult test_lexema_pool_concurrent(
+	TestResult results[NUM_LEXEMA_POOL_CONCURRENT_TESTS])
+{
+	bool all_tests_passed = true;
+	for (const lexema_pool_concurrent_test_case* ltc
+			= test_lexema_pool_concurrent_table;
+		ltc < test_lexema_pool_concurrent_table
+			  + NUM_LEXEMA_POOL_CONCURRENT_TESTS;
+		ltc++) {
+		LexemaPool pool(true);
+		const size_t num_lexema = ltc->num_lexema;
+		const size_t num_threads = ltc->num_threads;
+		vector<const char*> pooled(num_threads * num_lexema);
+		vector<thread> threads;
+		for (size_t t = 0; t < num_threads; t++) {
+			threads.emplace_back([&pool, &pooled, t, num_lexema, num_threads]() {
+				char lexeme[32];
+				for (size_t j = 0; j < num_lexema; j++) {
+					const size_t i
+						= (j + t * num_lexema / num_threads) % num_lexema;
+					snprintf(lexeme, sizeof(lexeme), "lexeme_%zu", i);
+					pooled[t * num_lexema + i]
+						= intern_lexeme(pool, lexeme, strlen(lexeme));
+				}
+			});
+		}
+		for (thread& th : threads) {
+			th.join();
+		}
+		bool success_criteria
+			= pool.num_entries.load() == num_lexema;
+		vector<bool> is_atom_seen(num_lexema + 1, false);
+		char lexeme[32];
+		for (size_t i = 0; i < num_lexema; i++) {
+			snprintf(lexeme, sizeof(lexeme), "lexeme_%zu", i);
+			const char* const first = pooled[i];
+			for (size_t t = 1; t < num_threads; t++) {
+				if (pooled[t * num_lexema + i] != first) {
+					success_criteria = false;
+				}
+			}
+			const uint32_t atom = get_lexeme_atom(first);
+			if (strcmp(first, lexeme) != 0
+				|| atom == 0
+				|| atom > num_lexema
+				|| is_atom_seen[atom]) {
+				success_criteria = false;
+			} else {
+				is_atom_seen[atom] = true;
+			}
+		}
+		results[ltc - test_lexema_pool_concurrent_table]
+			= success_criteria ? TestResult::SUCCESS : TestResult::FAIL;
+		if (!success_criteria) {
+			all_tests_passed = false;
+		}
+	}
+	return all_tests_passed ? TestResult::SUCCESS : TestResult::FAIL;
+}
+
+//////////////////////////////////////////////////////////////////
+//      Testing that lexema are spread across the table         //
+//////////////////////////////////////////////////////////////////
+
+#define NUM_LEXEMA_POOL_SPREAD_TESTS 5
+
+struct lexema_pool_spread_test_case {
+	size_t num_lexema;
+};
+
+static const
+lexema_pool_spread_test_case
+test_lexema_pool_spread_table[NUM_LEXEMA_POOL_SPREAD_TESTS] = {
+	{ 1000   },
+	{ 4096   },
+	{ 10000  },
+	{ 50000  },
+	{ 100000 }
+};
+
+/**
+* Pools a number of distinct lexema, expecting their
+* probes to start from odd and even slots alike, and
+* to be about as long as linear probing's are at the
+* pool's load, (1 + 1 / (1 - load)) / 2.
+**/
+static inline TestResult test_lexema_pool_spread(
+	TestResult results[NUM_LEXEMA_POOL_SPREAD_TESTS])
+{
+	bool all_tests_passed = true;
+	for (const lexema_pool_spread_test_case* ltc
+			= test_lexema_pool_spread_table;
+		ltc < test_lexema_pool_spread_table + NUM_LEXEMA_POOL_SPREAD_TESTS;
+		ltc++) {
+		LexemaPool pool;
+		char lexeme[32];
+		for (size_t i = 0; i < ltc->num_lexema; i++) {
+			snprintf(lexeme, sizeof(lexeme), "lexeme_%zu", i);
+			intern_lexeme(pool, lexeme, strlen(lexeme));
+		}
+		const LexemaTable* const table
+			= pool.table.load();
+		const size_t mask
+			= table->capacity - 1;
+		size_t num_odd_homes = 0;
+		size_t num_probes = 0;
+		for (size_t i = 0; i < table->capacity; i++) {
+			const LexemaEntry& entry = table->slots[i];
+			if (entry.lexeme.load() == NULL) {
+				continue;
+			}
+			const size_t home
+				= (entry.hash.load() >> 1) & mask;
+			num_odd_homes += home & 1;
+			num_probes += ((i - home) & mask) + 1;
+		}
+		const double load
+			= (double) ltc->num_lexema / table->capacity;
+		const double mean_probes
+			= (double) num_probes / ltc->num_lexema;
+		const bool success_criteria
+			= 5 * num_odd_homes >= 2 * ltc->num_lexema
+			  && 5 * num_odd_homes <= 3 * ltc->num_lexema
+			  && mean_probes
+				 <= (1 + 1 / (1 - load)) / 2 + 0.1;
+		results[ltc - test_lexema_pool_spread_table]
+			= success_criteria ? TestResult::SUCCESS : TestResult::FAIL;
+		if (!success_criteria) {
+			all_tests_passed = false;
+		}
+	}
+	return all_tests_passed ? TestResult::SUCCESS : TestResult::FAIL;
+}
+
+static inline TestResult test_lexema_pool(
+	TestResult results[NUM_LEXEMA_POOL_TESTS],
+	char* &output,
+	int indent = 0)
+{
+	TestResult intern_results[NUM_LEXEMA_POOL_INTERN_TESTS];
+	TestResult intern_result
+		= test_lexema_pool_intern(intern_results);
+	results[0] = intern_result;
+
+	TestResult growth_results[NUM_LEXEMA_POOL_GROWTH_TESTS];
+	TestResult growth_result
+		= test_lexema_pool_growth(growth_results);
+	results[1] = growth_result;
+
+	TestResult span_results[NUM_LEXEMA_POOL_SPAN_TESTS];
+	TestResult span_result
+		= test_lexema_pool_span(span_results);
+	results[2] = span_result;
+
+	TestResult atom_results[NUM_LEXEMA_POOL_ATOM_TESTS];
+	TestResult atom_result
+		= test_lexema_pool_atom(atom_results);
+	results[3] = atom_result;
+
+	TestResult concurrent_results[NUM_LEXEMA_POOL_CONCURRENT_TESTS];
+	TestResult concurrent_result
+		= test_lexema_pool_concurrent(concurrent_results);
+	results[4] = concurrent_result;
+
+	TestResult spread_results[NUM_LEXEMA_POOL_SPREAD_TESTS];
+	TestResult spread_result
+		= test_lexema_pool_spread(spread_results);
+	results[5] = spread_result;
+
+	for (int i = 0; i < indent; i++) print_to_output("\t", output);
+	print_to_output("<-> LexemaPoolTests", output);
+	print_to_output("\n", output);
+
+	const char* intern_title = "LexemaPoolInternTests";
+	present_test_set_synopsis(
+		intern_title,
+		intern_result,
+		intern_results,
+		NUM_LEXEMA_POOL_INTERN_TESTS,
+		output,
+		indent + 1
+	);
+
+	const char* growth_title = "LexemaPoolGrowthTests";
+	present_test_set_synopsis(
+		growth_title,
+		growth_result,
+		growth_results,
+		NUM_LEXEMA_POOL_GROWTH_TESTS,
+		output,
+		indent + 1
+	);
+
+	const char* span_title = "LexemaPoolSpanTests";
+	present_test_set_synopsis(
+		span_title,
+		span_result,
+		span_results,
+		NUM_LEXEMA_POOL_SPAN_TESTS,
+		output,
+		indent + 1
+	);
+
+	const char* atom_title = "LexemaPoolAtomTests";
+	present_test_set_synopsis(
+		atom_title,
+		atom_result,
+		atom_results,
+		NUM_LEXEMA_POOL_ATOM_TESTS,
+		output,
+		indent + 1
+	);
+
+	const char* concurrent_title = "LexemaPoolConcurrentTests";
+	present_test_set_synopsis(
+		concurrent_title,
+		concurrent_result,
+		concurrent_results,
+		NUM_LEXEMA_POOL_CONCURRENT_TESTS,
+		output,
+		indent + 1
+	);
+
+	const char* spread_title = "LexemaPoolSpreadTests";
+	present_test_set_synopsis(
+		spread_title,
+		spread_result,
+		spread_results,
+		NUM_LEXEMA_POOL_SPREAD_TESTS,
+		output,
+		indent + 1
+	);
+
+	for (int i = 0; i < NUM_LEXEMA_POOL_TESTS; i++) {
+		if (results[i] != TestResult::SUCCESS) {
+			return TestResult::FAIL;
+		}
+	}
+	return TestResult::SUCCESS;
+}
+
+#endif
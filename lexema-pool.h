@@ -7,11 +7,23 @@
 #ifndef LEXEMA_POOL_H
 #define LEXEMA_POOL_H 1
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <string.h>
 #include <iostream>
 
-#define LEXEMA_POOL_SZ (1 << 16)
+#include "arena.h"
+
+/* The number of slots a pool starts with, a power of two. */
+#define LEXEMA_POOL_INITIAL_SZ (1 << 8)
+
+/* The number of locks a concurrent pool divides its
+   insertions between, a power of two. A pool may run
+   over half full by one insertion per stripe, so this
+   is kept well below LEXEMA_POOL_INITIAL_SZ / 2.     */
+#define LEXEMA_POOL_NUM_STRIPES (1 << 6)
 
 using namespace std;
 
@@ -20,20 +32,93 @@ using namespace std;
 /********************************************************/
 
 /** 
-* Represents an entry in the LexemaPool 
+* Represents an entry in the LexemaPool. The hash and
+* length are kept so that most mismatches are rejected
+* without comparing strings. An empty slot has a hash
+* of 0; the hash of a lexeme always has its low bit
+* set, so never is. That bit is not part of the index
+* a lexeme's probe starts from.
+*
+* A slot is claimed by setting its hash, and filled in
+* by setting its lexeme last, so that a slot is only
+* ever seen with a lexeme once the rest is written.
 **/
 struct LexemaEntry {
-	const char*  lexeme;
-	LexemaEntry* next_entry;
+	atomic<uint32_t>    hash;
+	uint32_t            length;
+	uint32_t            atom;
+	atomic<const char*> lexeme;
+};
+
+/**
+* The slots of a pool. When a pool grows, the table it
+* grew from is kept until the pool is reset, as other
+* threads may still be looking through it.
+**/
+struct LexemaTable {
+	LexemaEntry* slots;
+	size_t       capacity;
+	LexemaTable* previous;
+};
+
+/**
+* A lock over the insertions of every lexeme whose hash
+* falls to it, and the arena those lexema are copied
+* into.
+**/
+struct LexemaPoolStripe {
+	mutex lock;
+	Arena strings;
 };
 
 /** 
 * Represents a pool in which lexema
 * can be stored efficiently and easily
 * managed.
+*
+* The pool is an open addressing table probed
+* linearly, doubled in size whenever it becomes half
+* full. Entries move when it grows, so an entry found
+* is only valid until the next insertion. The lexema
+* themselves are copied, end to end, into an arena
+* owned by the pool, and never move.
+*
+* Each lexeme is numbered, from 1 in the order it was
+* first pooled, by its atom. Its atom is stored just
+* before its first character, so any pooled lexeme
+* can be turned back into its atom without a lookup.
+*
+* A concurrent pool may be shared between threads.
+* Finding a lexeme already pooled takes no lock.
+* Pooling a new one locks the stripe its hash falls
+* to, so that it is pooled once, and copies it into
+* that stripe's arena. Growing locks every stripe.
+* Resetting or destroying a pool must not overlap
+* any other use of it.
 **/
 struct LexemaPool {
-	LexemaEntry* data[LEXEMA_POOL_SZ];
+	atomic<LexemaTable*> table;
+	atomic<size_t>       num_entries;
+	Arena                strings;
+	/* NULL unless the pool is concurrent. */
+	LexemaPoolStripe*    stripes;
+
+	inline LexemaPool(
+		bool const& concurrent = false)
+		: table(new LexemaTable({
+			  new LexemaEntry[LEXEMA_POOL_INITIAL_SZ] { },
+			  LEXEMA_POOL_INITIAL_SZ,
+			  NULL })),
+		  num_entries(0),
+		  stripes(concurrent
+				  ? new LexemaPoolStripe[LEXEMA_POOL_NUM_STRIPES]
+				  : NULL) {
+	};
+
+	LexemaPool(const LexemaPool&) = delete;
+	LexemaPool& operator=(const LexemaPool&) = delete;
+
+	inline ~LexemaPool();
 };
 
 /**
@@ -41,11 +126,13 @@ struct LexemaPool {
 * the lexema table.
 * 
 * @param lexeme The lexeme to hash.
+* @param length The length of the lexeme.
 * @return Returns the hash of the lexeme.
 **/
 static inline 
-size_t hash_lexeme(
-	const char* const& lexeme);
+uint32_t hash_lexeme(
+	const char* const& lexeme,
+	size_t      const& length);
 
 /**
 * Prints out a lexema pool.
@@ -70,7 +157,50 @@ LexemaEntry* lookup_lexeme_in_pool(
 	const char* const& lexeme);
 
 /**
-* Inserts the given lexeme into the given 
+* Looksup a lexeme, given as a span of characters
+* which need not be NUL terminated, in the given
+* lexema pool.
+* 
+* @param pool The given pool to lookup the lexeme in.
+* @param lexeme_start Pointer to the start of the lexeme.
+* @param length The length of the lexeme.
+* @return Returns the entry found or NULL.
+**/
+static inline 
+LexemaEntry* lookup_lexeme_span_in_pool(
+	LexemaPool  const& pool,
+	const char* const& lexeme_start,
+	size_t      const& length);
+
+/**
+* Returns the pooled copy of the given span of
+* characters, copying it into the pool only if it is
+* not already there.
+* 
+* @param pool The given pool.
+* @param lexeme_start Pointer to the start of the lexeme.
+* @param length The length of the lexeme.
+* @return Returns the pooled, NUL terminated, lexeme.
+**/
+static inline 
+const char* intern_lexeme(
+	LexemaPool       & pool,
+	const char* const& lexeme_start,
+	size_t      const& length);
+
+/**
+* Returns the atom of a lexeme from a lexema pool.
+* Must only be given lexema returned by a pool.
+* 
+* @param lexeme The pooled lexeme.
+* @return Returns the atom, or 0 for NULL.
+**/
+static inline 
+uint32_t get_lexeme_atom(
+	const char* const& lexeme);
+
+/**
+* Inserts a copy of the given lexeme into the given 
 * lexema pool.
 * 
 * @param pool The given pool.
@@ -83,20 +213,66 @@ bool insert_lexeme_into_pool(
 	LexemaPool       & pool,
 	const char* const& lexeme);
 
+/**
+* Empties the given lexema pool, freeing its lexema,
+* so that it may be reused. The pool keeps its size.
+* 
+* @param pool The given pool.
+**/
+static inline 
+void reset_lexema_pool(
+	LexemaPool& pool);
+
 /*****************************************************//**
 *                         Definitions                    *
 /********************************************************/
 
+/**
+* Frees the tables a pool grew out of, which only
+* threads already looking through them could need.
+**/
+static inline
+void free_retired_lexema_tables(
+	LexemaTable* const& table)
+{
+	LexemaTable* retired = table->previous;
+	while (retired != NULL) {
+		LexemaTable* const previous
+			= retired->previous;
+		delete[] retired->slots;
+		delete retired;
+		retired = previous;
+	}
+	table->previous = NULL;
+}
+
+inline LexemaPool::~LexemaPool()
+{
+	LexemaTable* const current
+		= table.load(memory_order_relaxed);
+	free_retired_lexema_tables(current);
+	delete[] current->slots;
+	delete current;
+	delete[] stripes;
+}
+
 static inline 
-size_t hash_lexeme(
-	const char* const& lexeme)
+uint32_t hash_lexeme(
+	const char* const& lexeme,
+	size_t      const& length)
 {
-	size_t h = 0;
-	for (const char* c = lexeme; *c; c++) {
-		h *= 128;
-		h += *c;
+	/* FNV-1a, then mixed so that the low bits the
+	   table indexes by depend on every byte.    */
+	uint64_t h = 14695981039346656037ull;
+	for (size_t i = 0; i < length; i++) {
+		h ^= (unsigned char) lexeme[i];
+		h *= 1099511628211ull;
 	}
-	return (h * 36) % LEXEMA_POOL_SZ;
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdull;
+	h ^= h >> 33;
+	/* Never 0, which marks an empty slot. */
+	return (uint32_t) h | 1;
 }
 
 static inline 
@@ -105,37 +281,272 @@ void print_lexema_pool(
 {
 	cout << "---- Lexema Pool ----"
 	     << endl;
+	const LexemaTable* const table
+		= pool.table.load(memory_order_acquire);
 	int i = 0;
-	/* For each bucket. */
-	for (const LexemaEntry* const* bucket = pool.data;
-		bucket < (pool.data + (1 << 16));
-		bucket++) {
-		/* For each entry within that bucket. */
-		for (const LexemaEntry* entry = *bucket;
-			entry;
-			entry = entry->next_entry) {
+	/* For each occupied slot. */
+	for (const LexemaEntry* entry = table->slots;
+		entry < table->slots + table->capacity;
+		entry++) {
+		const char* const lexeme
+			= entry->lexeme.load(memory_order_acquire);
+		if (lexeme) {
 			/* Print out that lexeme. */
 			cout << i++ 
 				 << " : " 
-				 << entry->lexeme 
+				 << lexeme 
 				 << endl;
 		}
 	}
 }
 
+/**
+* Finds the slot holding the given lexeme, or the
+* empty slot where it belongs. Slots claimed but not
+* yet filled in are passed over: they hold some other
+* lexeme, or this one is still being pooled.
+**/
+static inline
+LexemaEntry* probe_lexema_table(
+	const LexemaTable* const& table,
+	const char*        const& lexeme,
+	uint32_t           const& length,
+	uint32_t           const& hash,
+	size_t             const& from = 0)
+{
+	const size_t mask
+		= table->capacity - 1;
+	for (size_t i = ((hash >> 1) + from) & mask; ; i = (i + 1) & mask) {
+		LexemaEntry* const entry
+			= table->slots + i;
+		const uint32_t entry_hash
+			= entry->hash.load(memory_order_acquire);
+		if (entry_hash == 0) {
+			return entry;
+		}
+		if (entry_hash == hash) {
+			const char* const entry_lexeme
+				= entry->lexeme.load(memory_order_acquire);
+			if (entry_lexeme != NULL
+				&& entry->length == length
+				&& memcmp(entry_lexeme, lexeme, length) == 0) {
+				return entry;
+			}
+		}
+	}
+}
+
+/**
+* Doubles the number of slots, moving every entry into
+* a new table. No insertion may be under way.
+**/
+static inline
+void grow_lexema_pool(
+	LexemaPool& pool)
+{
+	LexemaTable* const old_table
+		= pool.table.load(memory_order_relaxed);
+	LexemaTable* const new_table
+		= new LexemaTable({
+			new LexemaEntry[2 * old_table->capacity] { },
+			2 * old_table->capacity,
+			old_table });
+	const size_t mask
+		= new_table->capacity - 1;
+	for (const LexemaEntry* entry = old_table->slots;
+		 entry < old_table->slots + old_table->capacity;
+		 entry++) {
+		const char* const lexeme
+			= entry->lexeme.load(memory_order_relaxed);
+		if (lexeme) {
+			const uint32_t hash
+				= entry->hash.load(memory_order_relaxed);
+			size_t i = (hash >> 1) & mask;
+			while (new_table->slots[i].lexeme.load(memory_order_relaxed)) {
+				i = (i + 1) & mask;
+			}
+			LexemaEntry& moved = new_table->slots[i];
+			moved.hash.store(hash, memory_order_relaxed);
+			moved.length = entry->length;
+			moved.atom   = entry->atom;
+			moved.lexeme.store(lexeme, memory_order_relaxed);
+		}
+	}
+	/* Published whole, so a thread which sees the new
+	   table sees every entry moved into it.        */
+	pool.table.store(new_table, memory_order_release);
+	if (pool.stripes == NULL) {
+		free_retired_lexema_tables(new_table);
+	}
+}
+
+/**
+* Grows a concurrent pool, unless another thread grew
+* it while this one waited for the stripes.
+**/
+static inline
+void grow_concurrent_lexema_pool(
+	LexemaPool& pool)
+{
+	for (size_t s = 0; s < LEXEMA_POOL_NUM_STRIPES; s++) {
+		pool.stripes[s].lock.lock();
+	}
+	const LexemaTable* const table
+		= pool.table.load(memory_order_relaxed);
+	if (2 * (pool.num_entries.load(memory_order_relaxed) + 1)
+		> table->capacity) {
+		grow_lexema_pool(pool);
+	}
+	for (size_t s = 0; s < LEXEMA_POOL_NUM_STRIPES; s++) {
+		pool.stripes[s].lock.unlock();
+	}
+}
+
+static inline 
+LexemaEntry* lookup_lexeme_span_in_pool(
+	LexemaPool  const& pool,
+	const char* const& lexeme_start,
+	size_t      const& length)
+{
+	LexemaEntry* const e = probe_lexema_table(
+		pool.table.load(memory_order_acquire),
+		lexeme_start,
+		(uint32_t) length,
+		hash_lexeme(lexeme_start, length));
+	return e->lexeme.load(memory_order_acquire) ? e : NULL;
+}
+
 static inline 
 LexemaEntry* lookup_lexeme_in_pool(
 	LexemaPool  const& pool,
 	const char* const& lexeme)
 {
-	size_t h = hash_lexeme(lexeme);
-	LexemaEntry* e = (pool.data)[h];
-	while (
-		(e != NULL)
-		&& (strcmp(lexeme, e->lexeme) != 0)) {
-		e = e->next_entry;
+	return lookup_lexeme_span_in_pool(
+		pool,
+		lexeme,
+		strlen(lexeme));
+}
+
+/**
+* Pools a lexeme known not to be in the pool when last
+* looked for. A concurrent pool must have the lexeme's
+* stripe locked, so only this thread can pool it.
+**/
+static inline
+const char* insert_new_lexeme(
+	LexemaPool       & pool,
+	Arena            & strings,
+	const char* const& lexeme_start,
+	size_t      const& length,
+	uint32_t    const& hash)
+{
+	const LexemaTable* table
+		= pool.table.load(memory_order_acquire);
+	size_t from = 0;
+	for (;;) {
+		LexemaEntry* const e = probe_lexema_table(
+			table,
+			lexeme_start,
+			(uint32_t) length,
+			hash,
+			from);
+		const char* const found
+			= e->lexeme.load(memory_order_acquire);
+		if (found) {
+			return found;
+		}
+		/* Claim the empty slot. Another thread may
+		   claim it first for some other lexeme,
+		   in which case probing carries on past it. */
+		uint32_t empty = 0;
+		if (!e->hash.compare_exchange_strong(
+				empty,
+				hash,
+				memory_order_acq_rel)) {
+			from = (e - table->slots) - (hash >> 1) + 1;
+			continue;
+		}
+		/* Copied only now it is known to be new,
+		   after the atom it is numbered by.      */
+		uint32_t* const atom
+			= (uint32_t*) strings.allocate(
+				sizeof(uint32_t) + length + 1,
+				alignof(uint32_t));
+		char* const lexeme
+			= (char*) (atom + 1);
+		memcpy(lexeme, lexeme_start, length);
+		lexeme[length] = '\0';
+		*atom = (uint32_t) pool.num_entries.fetch_add(
+			1,
+			memory_order_relaxed) + 1;
+		e->length = (uint32_t) length;
+		e->atom   = *atom;
+		e->lexeme.store(lexeme, memory_order_release);
+		return lexeme;
+	}
+}
+
+static inline 
+const char* intern_lexeme(
+	LexemaPool       & pool,
+	const char* const& lexeme_start,
+	size_t      const& length)
+{
+	const uint32_t hash
+		= hash_lexeme(lexeme_start, length);
+	const LexemaTable* table
+		= pool.table.load(memory_order_acquire);
+	const char* const found = probe_lexema_table(
+		table,
+		lexeme_start,
+		(uint32_t) length,
+		hash)->lexeme.load(memory_order_acquire);
+	if (found) {
+		return found;
+	}
+
+	if (pool.stripes == NULL) {
+		if (2 * (pool.num_entries.load(memory_order_relaxed) + 1)
+			> table->capacity) {
+			grow_lexema_pool(pool);
+		}
+		return insert_new_lexeme(
+			pool,
+			pool.strings,
+			lexeme_start,
+			length,
+			hash);
+	}
+
+	LexemaPoolStripe& stripe
+		= pool.stripes[(hash >> 1) & (LEXEMA_POOL_NUM_STRIPES - 1)];
+	for (;;) {
+		stripe.lock.lock();
+		table = pool.table.load(memory_order_acquire);
+		if (2 * (pool.num_entries.load(memory_order_relaxed) + 1)
+			<= table->capacity) {
+			break;
+		}
+		stripe.lock.unlock();
+		grow_concurrent_lexema_pool(pool);
 	}
-	return e;
+	const char* const lexeme = insert_new_lexeme(
+		pool,
+		stripe.strings,
+		lexeme_start,
+		length,
+		hash);
+	stripe.lock.unlock();
+	return lexeme;
+}
+
+static inline 
+uint32_t get_lexeme_atom(
+	const char* const& lexeme)
+{
+	return lexeme
+		   ? ((const uint32_t*) lexeme)[-1]
+		   : 0;
 }
 
 static inline 
@@ -143,25 +554,38 @@ bool insert_lexeme_into_pool(
 	LexemaPool       & pool,
 	const char* const& lexeme)
 {
-	LexemaEntry* new_entry = new LexemaEntry;
-	new_entry->lexeme = lexeme;	
-	new_entry->next_entry = NULL;
-
-	size_t h = hash_lexeme(lexeme);
-	LexemaEntry* e = (pool.data)[h];
-	if (e == NULL) {
-		(pool.data)[h] = new_entry;
-	} else {
-		do {
-			if (e->next_entry == NULL) {
-				e->next_entry = new_entry;
-				break;
-			} else {
-				e = e->next_entry;
-			}
-		} while (true);
+	const size_t num_entries
+		= pool.num_entries.load(memory_order_relaxed);
+	intern_lexeme(pool, lexeme, strlen(lexeme));
+	return pool.num_entries.load(memory_order_relaxed) != num_entries;
+}
+
+static inline 
+void reset_lexema_pool(
+	LexemaPool& pool)
+{
+	LexemaTable* const table
+		= pool.table.load(memory_order_relaxed);
+	free_retired_lexema_tables(table);
+	size_t num_entries
+		= pool.num_entries.load(memory_order_relaxed);
+	for (LexemaEntry* e = table->slots;
+		 num_entries > 0
+		 && e < table->slots + table->capacity;
+		 e++) {
+		if (e->hash.load(memory_order_relaxed)) {
+			e->hash.store(0, memory_order_relaxed);
+			e->lexeme.store(NULL, memory_order_relaxed);
+			num_entries--;
+		}
+	}
+	pool.num_entries.store(0, memory_order_relaxed);
+	pool.strings.release();
+	if (pool.stripes != NULL) {
+		for (size_t s = 0; s < LEXEMA_POOL_NUM_STRIPES; s++) {
+			pool.stripes[s].strings.release();
+		}
 	}
-	return true;
 }
 
 #endif
\ No newline at end of file
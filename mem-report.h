@@ -0,0 +1,440 @@
+/* Authored by Charlie Keaney                    */
+/* mem-report.h - Responsible for counting the
+				  allocations made by each
+				  phase of compilation and
+				  reporting them (-fmem-report).
+
+				  Implementation Notes:
+				  The global operator new and
+				  operator delete are replaced
+				  so that every allocation is
+				  seen, whichever module makes
+				  it. Each block carries its
+				  size in a small header, so a
+				  free can be counted too, along
+				  with the ID of the report which
+				  counted it, so that only the
+				  frees of blocks a report saw
+				  allocated are taken from its
+				  live total.
+
+				  The replacements cost every
+				  allocation a header and a
+				  check for a running report, so
+				  they are only built when
+				  KCC_MEM_REPORT is defined.
+				  Without it -fmem-report says
+				  the report is unavailable.
+
+				  Allocations are charged to
+				  whichever phase the time
+				  report says is running, or to
+				  'other' between phases. The
+				  peak of each phase is the
+				  highest the live total reached
+				  while that phase ran. Counts
+				  are kept per thread, so -j
+				  reports each file separately.
+
+				  kcc is a single translation
+				  unit, so the replacements
+				  are defined here once.       */
+
+#ifndef MEM_REPORT_H
+#define MEM_REPORT_H 1
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+#include "time-report.h"
+
+#if defined(KCC_MEM_REPORT)
+#define MEM_REPORT_AVAILABLE true
+#else
+#define MEM_REPORT_AVAILABLE false
+#endif
+
+/* Room for the block header, keeping the block after it
+   aligned for any type.                               */
+#define MEM_REPORT_HEADER_SZ                              \
+	(alignof(max_align_t) >= 16 ? alignof(max_align_t) : 16)
+
+/* The phases, then a final entry for between phases. */
+#define NUM_MEM_REPORT_ENTRIES (NUM_TIME_REPORT_PHASES + 1)
+
+#define MEM_REPORT_BYTES_WIDTH 14
+
+using namespace std;
+
+/*****************************************************//**
+*                      Declarations                      *
+/********************************************************/
+
+struct MemReportEntry {
+	uint64_t num_allocs;
+	uint64_t num_frees;
+	uint64_t bytes_allocated;
+	uint64_t bytes_freed;
+	int64_t  peak_live_bytes;
+};
+
+struct MemReport {
+	/* Never 0, which tags blocks no report counted. */
+	uint64_t          id;
+	const TimeReport* phases_from;
+	int64_t           live_bytes;
+	int64_t           peak_live_bytes;
+	MemReportEntry    entries[NUM_MEM_REPORT_ENTRIES];
+};
+
+/* The report the calling thread is counting into, if any. */
+static thread_local
+MemReport* active_mem_report = NULL;
+
+/**
+* The header in front of each block allocated while
+* the allocators are replaced.
+**/
+struct MemReportBlockHeader {
+	size_t   size;
+	/* The ID of the report which counted the block. */
+	uint64_t counted_by;
+};
+
+static_assert(
+	sizeof(MemReportBlockHeader) <= MEM_REPORT_HEADER_SZ,
+	"the block header must fit before the aligned block");
+
+/**
+* Constructs an empty memory report, which takes its
+* phases from the given time report.
+*
+* @param time_report The time report whose phases to follow.
+* @return Returns the empty memory report.
+**/
+static inline
+MemReport construct_mem_report(
+	const TimeReport* const& time_report);
+
+/**
+* Counts an allocation against the running phase.
+*
+* @param report The report to count into.
+* @param size The number of bytes allocated.
+**/
+static inline
+void record_mem_report_alloc(
+	MemReport    & report,
+	size_t  const& size);
+
+/**
+* Counts a free against the running phase.
+*
+* @param report The report to count into.
+* @param size The number of bytes freed.
+**/
+static inline
+void record_mem_report_free(
+	MemReport    & report,
+	size_t  const& size);
+
+/**
+* Prints a memory report as a table.
+*
+* @param report The report to print.
+* @param out The stream to print to.
+**/
+static inline
+void print_mem_report(
+	MemReport const& report,
+	ostream        & out = cout);
+
+/**
+* Prints a memory report as a single line of JSON.
+*
+* @param report The report to print.
+* @param out The stream to print to.
+**/
+static inline
+void print_mem_report_json(
+	MemReport const& report,
+	ostream        & out = cout);
+
+/*****************************************************//**
+*                         Definitions                    *
+/********************************************************/
+
+static inline
+MemReport construct_mem_report(
+	const TimeReport* const& time_report)
+{
+	static atomic<uint64_t> num_reports(0);
+	MemReport report = MemReport({
+		++num_reports,
+		time_report,
+		0,
+		0,
+		{ } });
+	return report;
+}
+
+static inline
+MemReportEntry& get_running_mem_report_entry(
+	MemReport& report)
+{
+	const int phase
+		= report.phases_from
+		  ? report.phases_from->active_phase
+		  : -1;
+	return report.entries[
+		phase >= 0
+		? phase
+		: NUM_TIME_REPORT_PHASES];
+}
+
+static inline
+void record_mem_report_alloc(
+	MemReport    & report,
+	size_t  const& size)
+{
+	MemReportEntry& entry
+		= get_running_mem_report_entry(report);
+	entry.num_allocs++;
+	entry.bytes_allocated += size;
+	report.live_bytes     += size;
+	if (report.live_bytes > entry.peak_live_bytes) {
+		entry.peak_live_bytes = report.live_bytes;
+	}
+	if (report.live_bytes > report.peak_live_bytes) {
+		report.peak_live_bytes = report.live_bytes;
+	}
+}
+
+static inline
+void record_mem_report_free(
+	MemReport    & report,
+	size_t  const& size)
+{
+	MemReportEntry& entry
+		= get_running_mem_report_entry(report);
+	entry.num_frees++;
+	entry.bytes_freed += size;
+	report.live_bytes -= size;
+}
+
+static inline
+const char* get_mem_report_entry_name(
+	int const& i)
+{
+	return i < NUM_TIME_REPORT_PHASES
+		   ? time_report_phase_string_repr[i]
+		   : "other";
+}
+
+static inline
+void print_mem_report(
+	MemReport const& report,
+	ostream        & out)
+{
+	const ios_base::fmtflags saved_flags
+		= out.flags();
+
+	out << "kcc:mem-report:"
+		<< (report.phases_from
+			? report.phases_from->filename
+			: "")
+		<< endl;
+	out << std::left
+		<< std::setfill(' ')
+		<< std::setw(TIME_REPORT_PHASE_WIDTH) << "Phase"
+		<< std::right
+		<< std::setw(TIME_REPORT_COUNT_WIDTH) << "Allocs"
+		<< std::setw(TIME_REPORT_COUNT_WIDTH) << "Frees"
+		<< std::setw(MEM_REPORT_BYTES_WIDTH)  << "Alloc (KiB)"
+		<< std::setw(MEM_REPORT_BYTES_WIDTH)  << "Freed (KiB)"
+		<< std::setw(MEM_REPORT_BYTES_WIDTH)  << "Peak (KiB)"
+		<< endl;
+
+	MemReportEntry total = MemReportEntry({ 0, 0, 0, 0, 0 });
+	for (int i = 0; i < NUM_MEM_REPORT_ENTRIES; i++) {
+		const MemReportEntry& entry
+			= report.entries[i];
+		total.num_allocs      += entry.num_allocs;
+		total.num_frees       += entry.num_frees;
+		total.bytes_allocated += entry.bytes_allocated;
+		total.bytes_freed     += entry.bytes_freed;
+		out << std::left
+			<< std::setw(TIME_REPORT_PHASE_WIDTH)
+			<< get_mem_report_entry_name(i)
+			<< std::right
+			<< std::fixed
+			<< std::setprecision(1)
+			<< std::setw(TIME_REPORT_COUNT_WIDTH) << entry.num_allocs
+			<< std::setw(TIME_REPORT_COUNT_WIDTH) << entry.num_frees
+			<< std::setw(MEM_REPORT_BYTES_WIDTH)  << entry.bytes_allocated / 1024.0
+			<< std::setw(MEM_REPORT_BYTES_WIDTH)  << entry.bytes_freed / 1024.0
+			<< std::setw(MEM_REPORT_BYTES_WIDTH)  << entry.peak_live_bytes / 1024.0
+			<< endl;
+	}
+	out << std::left
+		<< std::setw(TIME_REPORT_PHASE_WIDTH) << "total"
+		<< std::right
+		<< std::setw(TIME_REPORT_COUNT_WIDTH) << total.num_allocs
+		<< std::setw(TIME_REPORT_COUNT_WIDTH) << total.num_frees
+		<< std::setw(MEM_REPORT_BYTES_WIDTH)  << total.bytes_allocated / 1024.0
+		<< std::setw(MEM_REPORT_BYTES_WIDTH)  << total.bytes_freed / 1024.0
+		<< std::setw(MEM_REPORT_BYTES_WIDTH)  << report.peak_live_bytes / 1024.0
+		<< endl;
+
+	out.flags(saved_flags);
+}
+
+static inline
+void print_mem_report_json(
+	MemReport const& report,
+	ostream        & out)
+{
+	const ios_base::fmtflags saved_flags
+		= out.flags();
+
+	out << "{\"file\":\"";
+	for (const char* c = report.phases_from
+						 ? report.phases_from->filename
+						 : "";
+		 *c;
+		 c++) {
+		if (*c == '"' || *c == '\\') {
+			out << '\\';
+		}
+		out << *c;
+	}
+	out << "\",\"peak_bytes\":" << std::dec << report.peak_live_bytes
+		<< ",\"phases\":[";
+	for (int i = 0; i < NUM_MEM_REPORT_ENTRIES; i++) {
+		const MemReportEntry& entry
+			= report.entries[i];
+		out << (i ? "," : "")
+			<< "{\"name\":\""            << get_mem_report_entry_name(i)
+			<< "\",\"allocs\":"          << entry.num_allocs
+			<< ",\"frees\":"             << entry.num_frees
+			<< ",\"bytes_allocated\":"   << entry.bytes_allocated
+			<< ",\"bytes_freed\":"       << entry.bytes_freed
+			<< ",\"peak_bytes\":"        << entry.peak_live_bytes
+			<< "}";
+	}
+	out << "]}"
+		<< endl;
+
+	out.flags(saved_flags);
+}
+
+/*****************************************************//**
+*                 Replacement Allocators                 *
+/********************************************************/
+
+#if defined(KCC_MEM_REPORT)
+
+void* operator new(
+	size_t size)
+{
+	char* block
+		= (char*) malloc(size + MEM_REPORT_HEADER_SZ);
+	if (block == NULL) {
+		throw bad_alloc();
+	}
+	MemReportBlockHeader* header
+		= (MemReportBlockHeader*) block;
+	header->size       = size;
+	header->counted_by = 0;
+	if (active_mem_report) {
+		header->counted_by = active_mem_report->id;
+		record_mem_report_alloc(*active_mem_report, size);
+	}
+	return block + MEM_REPORT_HEADER_SZ;
+}
+
+void* operator new(
+	size_t          size,
+	nothrow_t const&) noexcept
+{
+	try {
+		return operator new(size);
+	} catch (...) {
+		return NULL;
+	}
+}
+
+void operator delete(
+	void* ptr) noexcept
+{
+	if (ptr == NULL) {
+		return;
+	}
+	char* block
+		= (char*) ptr - MEM_REPORT_HEADER_SZ;
+	const MemReportBlockHeader* header
+		= (const MemReportBlockHeader*) block;
+	if (active_mem_report
+		&& header->counted_by == active_mem_report->id) {
+		record_mem_report_free(*active_mem_report, header->size);
+	}
+	free(block);
+}
+
+void operator delete(
+	void*  ptr,
+	size_t) noexcept
+{
+	operator delete(ptr);
+}
+
+void operator delete(
+	void*           ptr,
+	nothrow_t const&) noexcept
+{
+	operator delete(ptr);
+}
+
+/* Arrays share the same blocks, as some of kcc
+   frees arrays with a plain delete.          */
+void* operator new[](
+	size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new[](
+	size_t          size,
+	nothrow_t const&) noexcept
+{
+	return operator new(size, nothrow);
+}
+
+void operator delete[](
+	void* ptr) noexcept
+{
+	operator delete(ptr);
+}
+
+void operator delete[](
+	void*  ptr,
+	size_t) noexcept
+{
+	operator delete(ptr);
+}
+
+void operator delete[](
+	void*           ptr,
+	nothrow_t const&) noexcept
+{
+	operator delete(ptr);
+}
+
+#endif
+
+#endif
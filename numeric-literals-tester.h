@@ -0,0 +1,213 @@
+/* Authored by Charlie Keaney                           */
+/* numeric-literals-tester.h - Responsible for testing
+							   the conversion of
+							   numeric constants.      */
+
+#ifndef NUMERIC_LITERALS_TESTER_H
+#define NUMERIC_LITERALS_TESTER_H 1
+
+#include <cstdint>
+#include <cstring>
+
+#include "tester-tools.h"
+#include "numeric-literals.h"
+
+#define NUM_NUMERIC_LITERALS_TESTS 2
+
+/**
+* Returns the bits of a converted constant as it holds
+* them: an integer's value, or a float or double's
+* representation.
+**/
+static inline uint64_t get_converted_constant_bits(
+	TokenClassification const& classification)
+{
+	switch (classification.type) {
+		case ConstantType::FLOAT: {
+			uint32_t bits;
+			memcpy(&bits, &classification.value.floatvalue, sizeof(bits));
+			return bits;
+		}
+		case ConstantType::DOUBLE:
+		case ConstantType::LONG_DOUBLE: {
+			uint64_t bits;
+			memcpy(&bits, &classification.value.doublevalue, sizeof(bits));
+			return bits;
+		}
+		default:
+			return classification.value.integervalue;
+	}
+}
+
+//////////////////////////////////////////////////////////////////
+//        Testing for the conversion of integer constants       //
+//////////////////////////////////////////////////////////////////
+
+#define NUM_INTEGER_LITERAL_TESTS 30
+
+struct numeric_literal_test_case {
+	const char*  lexeme;
+	TokenName    name;
+	ConstantType type;
+	uint64_t     bits;
+};
+
+static const
+numeric_literal_test_case
+test_integer_literal_table[NUM_INTEGER_LITERAL_TESTS] = {
+	{ "0",                     TokenName::CONSTANT, ConstantType::INT,                0                     },
+	{ "42",                    TokenName::CONSTANT, ConstantType::INT,                42                    },
+	{ "0777",                  TokenName::CONSTANT, ConstantType::INT,                0777                  },
+	{ "2147483647",            TokenName::CONSTANT, ConstantType::INT,                2147483647            },
+	{ "2147483648",            TokenName::CONSTANT, ConstantType::LONG,               2147483648u           },
+	{ "0x7fffffff",            TokenName::CONSTANT, ConstantType::INT,                0x7fffffff            },
+	{ "0x80000000",            TokenName::CONSTANT, ConstantType::UNSIGNED_INT,       0x80000000u           },
+	{ "0xFFFFFFFF",            TokenName::CONSTANT, ConstantType::UNSIGNED_INT,       0xffffffffu           },
+	{ "0x100000000",           TokenName::CONSTANT, ConstantType::LONG,               0x100000000ull        },
+	{ "4294967295u",           TokenName::CONSTANT, ConstantType::UNSIGNED_INT,       4294967295ull         },
+	{ "4294967296U",           TokenName::CONSTANT, ConstantType::UNSIGNED_LONG,      4294967296ull         },
+	{ "9223372036854775807",   TokenName::CONSTANT, ConstantType::LONG,               9223372036854775807ull },
+	{ "0x8000000000000000",    TokenName::CONSTANT, ConstantType::UNSIGNED_LONG,      0x8000000000000000ull },
+	{ "18446744073709551615u", TokenName::CONSTANT, ConstantType::UNSIGNED_LONG,      18446744073709551615ull },
+	{ "42L",                   TokenName::CONSTANT, ConstantType::LONG,               42                    },
+	{ "42l",                   TokenName::CONSTANT, ConstantType::LONG,               42                    },
+	{ "0x10L",                 TokenName::CONSTANT, ConstantType::LONG,               16                    },
+	{ "7LL",                   TokenName::CONSTANT, ConstantType::LONG_LONG,          7                     },
+	{ "7ll",                   TokenName::CONSTANT, ConstantType::LONG_LONG,          7                     },
+	{ "42uL",                  TokenName::CONSTANT, ConstantType::UNSIGNED_LONG,      42                    },
+	{ "42LU",                  TokenName::CONSTANT, ConstantType::UNSIGNED_LONG,      42                    },
+	{ "42ULL",                 TokenName::CONSTANT, ConstantType::UNSIGNED_LONG_LONG, 42                    },
+	{ "18446744073709551616",  TokenName::ERROR,    ConstantType::NONE,               0                     },
+	{ "08",                    TokenName::ERROR,    ConstantType::NONE,               0                     },
+	{ "0x",                    TokenName::ERROR,    ConstantType::NONE,               0                     },
+	{ "1a",                    TokenName::ERROR,    ConstantType::NONE,               0                     },
+	{ "7lL",                   TokenName::ERROR,    ConstantType::NONE,               0                     },
+	{ "42uu",                  TokenName::ERROR,    ConstantType::NONE,               0                     },
+	{ "42LLL",                 TokenName::ERROR,    ConstantType::NONE,               0                     },
+	{ "42ULU",                 TokenName::ERROR,    ConstantType::NONE,               0                     }
+};
+
+//////////////////////////////////////////////////////////////////
+//       Testing for the conversion of floating constants       //
+//////////////////////////////////////////////////////////////////
+
+#define NUM_FLOATING_LITERAL_TESTS 30
+
+/* The bits expected are those of the correctly rounded
+   value, so cases where a faster conversion rounds
+   differently are included.                        */
+static const
+numeric_literal_test_case
+test_floating_literal_table[NUM_FLOATING_LITERAL_TESTS] = {
+	{ "1.5",                              TokenName::CONSTANT, ConstantType::DOUBLE,      0x3ff8000000000000ull },
+	{ "1.5f",                             TokenName::CONSTANT, ConstantType::FLOAT,       0x3fc00000ull         },
+	{ "1.5L",                             TokenName::CONSTANT, ConstantType::LONG_DOUBLE, 0x3ff8000000000000ull },
+	{ ".5",                               TokenName::CONSTANT, ConstantType::DOUBLE,      0x3fe0000000000000ull },
+	{ "1.",                               TokenName::CONSTANT, ConstantType::DOUBLE,      0x3ff0000000000000ull },
+	{ "0.1",                              TokenName::CONSTANT, ConstantType::DOUBLE,      0x3fb999999999999aull },
+	{ "0.1f",                             TokenName::CONSTANT, ConstantType::FLOAT,       0x3dcccccdull         },
+	{ "0.30000000000000004",              TokenName::CONSTANT, ConstantType::DOUBLE,      0x3fd3333333333334ull },
+	{ "1e23",                             TokenName::CONSTANT, ConstantType::DOUBLE,      0x44b52d02c7e14af6ull },
+	{ "9007199254740993.0",               TokenName::CONSTANT, ConstantType::DOUBLE,      0x4340000000000000ull },
+	{ "123456789012345678901234567890.0", TokenName::CONSTANT, ConstantType::DOUBLE,      0x45f8ee90ff6c373eull },
+	{ "1.7976931348623157e308",           TokenName::CONSTANT, ConstantType::DOUBLE,      0x7fefffffffffffffull },
+	{ "8.98846567431158e307",             TokenName::CONSTANT, ConstantType::DOUBLE,      0x7fe0000000000000ull },
+	{ "2.2250738585072011e-308",          TokenName::CONSTANT, ConstantType::DOUBLE,      0x000fffffffffffffull },
+	{ "4.9e-324",                         TokenName::CONSTANT, ConstantType::DOUBLE,      0x0000000000000001ull },
+	{ "2.4703282292062328e-324",          TokenName::CONSTANT, ConstantType::DOUBLE,      0x0000000000000001ull },
+	{ "2.4703282292062327e-324",          TokenName::CONSTANT, ConstantType::DOUBLE,      0x0000000000000000ull },
+	{ "1e-400",                           TokenName::CONSTANT, ConstantType::DOUBLE,      0x0000000000000000ull },
+	{ "1e400",                            TokenName::CONSTANT, ConstantType::DOUBLE,      0x7ff0000000000000ull },
+	{ "3.4028235e38f",                    TokenName::CONSTANT, ConstantType::FLOAT,       0x7f7fffffull         },
+	{ "16777217.0f",                      TokenName::CONSTANT, ConstantType::FLOAT,       0x4b800000ull         },
+	{ "1e39f",                            TokenName::CONSTANT, ConstantType::FLOAT,       0x7f800000ull         },
+	{ "1e-50f",                           TokenName::CONSTANT, ConstantType::FLOAT,       0x00000000ull         },
+	{ "0x1p-2",                           TokenName::CONSTANT, ConstantType::DOUBLE,      0x3fd0000000000000ull },
+	{ "0x1.8p1",                          TokenName::CONSTANT, ConstantType::DOUBLE,      0x4008000000000000ull },
+	{ "0x.8p0",                           TokenName::CONSTANT, ConstantType::DOUBLE,      0x3fe0000000000000ull },
+	{ "0x10.1p0",                         TokenName::CONSTANT, ConstantType::DOUBLE,      0x4030100000000000ull },
+	{ "0x1.fffffffffffffp1023",           TokenName::CONSTANT, ConstantType::DOUBLE,      0x7fefffffffffffffull },
+	{ "1e",                               TokenName::ERROR,    ConstantType::NONE,        0                     },
+	{ "1.5ff",                            TokenName::ERROR,    ConstantType::NONE,        0                     }
+};
+
+/**
+* Converts each lexeme, expecting its name, type and
+* the bits of its value.
+**/
+static inline TestResult test_numeric_literal_table(
+	const numeric_literal_test_case* const& table,
+	size_t                           const& size,
+	TestResult*                      const& results)
+{
+	bool all_tests_passed = true;
+	for (const numeric_literal_test_case* ntc = table;
+		ntc < table + size;
+		ntc++) {
+		const TokenClassification classification
+			= convert_numeric_literal(ntc->lexeme);
+		const bool success_criteria
+			= classification.name == ntc->name
+			  && (ntc->name != TokenName::CONSTANT
+				  || (classification.type == ntc->type
+					  && get_converted_constant_bits(classification)
+						 == ntc->bits));
+		results[ntc - table]
+			= success_criteria ? TestResult::SUCCESS : TestResult::FAIL;
+		if (!success_criteria) {
+			all_tests_passed = false;
+		}
+	}
+	return all_tests_passed ? TestResult::SUCCESS : TestResult::FAIL;
+}
+
+static inline TestResult test_numeric_literals(
+	TestResult results[NUM_NUMERIC_LITERALS_TESTS],
+	char* &output,
+	int indent = 0)
+{
+	TestResult integer_results[NUM_INTEGER_LITERAL_TESTS];
+	TestResult integer_result = test_numeric_literal_table(
+		test_integer_literal_table,
+		NUM_INTEGER_LITERAL_TESTS,
+		integer_results);
+	results[0] = integer_result;
+
+	TestResult floating_results[NUM_FLOATING_LITERAL_TESTS];
+	TestResult floating_result = test_numeric_literal_table(
+		test_floating_literal_table,
+		NUM_FLOATING_LITERAL_TESTS,
+		floating_results);
+	results[1] = floating_result;
+
+	for (int i = 0; i < indent; i++) print_to_output("\t", output);
+	print_to_output("<-> NumericLiteralsTests", output);
+	print_to_output("\n", output);
+
+	const char* integer_title = "IntegerLiteralTests";
+	present_test_set_synopsis(
+		integer_title,
+		integer_result,
+		integer_results,
+		NUM_INTEGER_LITERAL_TESTS,
+		output,
+		indent + 1
+	);
+
+	const char* floating_title = "FloatingLiteralTests";
+	present_test_set_synopsis(
+		floating_title,
+		floating_result,
+		floating_results,
+		NUM_FLOATING_LITERAL_TESTS,
+		output,
+		indent + 1
+	);
+
+	return (integer_result == TestResult::SUCCESS
+			&& floating_result == TestResult::SUCCESS)
+		   ? TestResult::SUCCESS
+		   : TestResult::FAIL;
+}
+
+#endif
@@ -36,7 +36,7 @@ enum class ParserExitCode {
 static inline
 void parser_report_attempt(
 	const char*  const& module_str,
-	const Token* const& token);
+	TokenRef     const& token);
 
 /**
 * Reports success for the parser.
@@ -49,7 +49,7 @@ static inline
 void parse_report_success(
 	const char*  const& module_str,
 	AstNodeAlt   const& alt,
-	const Token* const& token);
+	TokenRef     const& token);
 
 /**
 * Constructs an Ast node from children.
@@ -77,7 +77,7 @@ AstNode* construct_node_from_children(
 **/
 ParserExitCode parse_primary_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & primary_expression);
 
 /**
@@ -91,7 +91,7 @@ ParserExitCode parse_primary_expression(
 **/
 ParserExitCode parse_postfix_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & postfix_expression);
 
 /**
@@ -105,7 +105,7 @@ ParserExitCode parse_postfix_expression(
 **/
 ParserExitCode parse_type_name(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & type_name);
 
 /**
@@ -119,7 +119,7 @@ ParserExitCode parse_type_name(
 **/
 ParserExitCode parse_unary_operator(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & unary_operator);
 
 /**
@@ -133,7 +133,7 @@ ParserExitCode parse_unary_operator(
 **/
 ParserExitCode parse_cast_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & unary_operator);
 
 /**
@@ -147,7 +147,7 @@ ParserExitCode parse_cast_expression(
 **/
 ParserExitCode parse_unary_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & unary_expression);
 
 /**
@@ -161,7 +161,7 @@ ParserExitCode parse_unary_expression(
 **/
 ParserExitCode parse_multiplicative_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & multiplicative_expression);
 
 /**
@@ -175,7 +175,7 @@ ParserExitCode parse_multiplicative_expression(
 **/
 ParserExitCode parse_additive_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & additive_expression);
 
 /**
@@ -189,7 +189,7 @@ ParserExitCode parse_additive_expression(
 **/
 ParserExitCode parse_shift_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & shift_expression);
 
 /**
@@ -203,7 +203,7 @@ ParserExitCode parse_shift_expression(
 **/
 ParserExitCode parse_relational_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & relational_expression);
 
 /**
@@ -217,7 +217,7 @@ ParserExitCode parse_relational_expression(
 **/
 ParserExitCode parse_equality_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & equality_expression);
 
 /**
@@ -231,7 +231,7 @@ ParserExitCode parse_equality_expression(
 **/
 ParserExitCode parse_and_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & and_expression);
 
 /**
@@ -245,7 +245,7 @@ ParserExitCode parse_and_expression(
 **/
 ParserExitCode parse_exclusive_or_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & exclusive_or_expression);
 
 /**
@@ -259,7 +259,7 @@ ParserExitCode parse_exclusive_or_expression(
 **/
 ParserExitCode parse_inclusive_or_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & inclusive_or_expression);
 
 /**
@@ -273,7 +273,7 @@ ParserExitCode parse_inclusive_or_expression(
 **/
 ParserExitCode parse_logical_and_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & logical_and_expression);
 
 /**
@@ -287,7 +287,7 @@ ParserExitCode parse_logical_and_expression(
 **/
 ParserExitCode parse_logical_or_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & logical_or_expression);
 
 /**
@@ -301,7 +301,7 @@ ParserExitCode parse_logical_or_expression(
 **/
 ParserExitCode parse_assignment_operator(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & assignment_operator);
 
 /**
@@ -315,7 +315,7 @@ ParserExitCode parse_assignment_operator(
 **/
 ParserExitCode parse_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & expression);
 
 /**
@@ -329,7 +329,7 @@ ParserExitCode parse_expression(
 **/
 ParserExitCode parse_conditional_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & conditional_expression);
 
 /**
@@ -343,7 +343,7 @@ ParserExitCode parse_conditional_expression(
 **/
 ParserExitCode parse_assignment_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & assignment_expression);
 
 /**
@@ -357,7 +357,7 @@ ParserExitCode parse_assignment_expression(
 **/
 ParserExitCode parse_constant_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & constant_expression);
 
 /**
@@ -371,7 +371,7 @@ ParserExitCode parse_constant_expression(
 **/
 ParserExitCode parse_declaration(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & declaration);
 
 /**
@@ -385,7 +385,7 @@ ParserExitCode parse_declaration(
 **/
 ParserExitCode parse_declaration_specifiers(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & declaration_specifiers);
 
 /**
@@ -399,7 +399,7 @@ ParserExitCode parse_declaration_specifiers(
 **/
 ParserExitCode parse_init_declarator_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & init_declarator_list);
 
 /**
@@ -413,7 +413,7 @@ ParserExitCode parse_init_declarator_list(
 **/
 ParserExitCode parse_init_declarator(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & init_declarator);
 
 /**
@@ -427,7 +427,7 @@ ParserExitCode parse_init_declarator(
 **/
 ParserExitCode parse_type_specifier(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & type_specifier);
 
 /**
@@ -442,7 +442,7 @@ ParserExitCode parse_type_specifier(
 **/
 ParserExitCode parse_struct_or_union_specifier(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & struct_or_union_specifier);
 
 /**
@@ -456,7 +456,7 @@ ParserExitCode parse_struct_or_union_specifier(
 **/
 ParserExitCode parse_struct_or_union(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & struct_or_union);
 
 /**
@@ -471,7 +471,7 @@ ParserExitCode parse_struct_or_union(
 **/
 ParserExitCode parse_struct_declaration_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & struct_declaration_list);
 
 /**
@@ -485,7 +485,7 @@ ParserExitCode parse_struct_declaration_list(
 **/
 ParserExitCode parse_struct_declaration(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & struct_declaration);
 
 /**
@@ -500,7 +500,7 @@ ParserExitCode parse_struct_declaration(
 **/
 ParserExitCode parse_specifier_qualifier_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & specifier_qualifier_list);
 
 /**
@@ -515,7 +515,7 @@ ParserExitCode parse_specifier_qualifier_list(
 **/
 ParserExitCode parse_struct_declarator_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & struct_declarator_list);
 
 /**
@@ -529,7 +529,7 @@ ParserExitCode parse_struct_declarator_list(
 **/
 ParserExitCode parse_struct_declarator(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & struct_declarator);
 
 /**
@@ -543,7 +543,7 @@ ParserExitCode parse_struct_declarator(
 **/
 ParserExitCode parse_enumerator_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & enumerator_list);
 
 /**
@@ -557,7 +557,7 @@ ParserExitCode parse_enumerator_list(
 **/
 ParserExitCode parse_enumeration_specifier(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & enumeration_specifier);
 
 /**
@@ -571,7 +571,7 @@ ParserExitCode parse_enumeration_specifier(
 **/
 ParserExitCode parse_type_qualifier(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & type_qualifier);
 
 /**
@@ -585,7 +585,7 @@ ParserExitCode parse_type_qualifier(
 **/
 ParserExitCode parse_declarator(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & declarator);
 
 /**
@@ -599,7 +599,7 @@ ParserExitCode parse_declarator(
 **/
 ParserExitCode parse_direct_declarator(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & direct_declarator);
 
 /**
@@ -613,7 +613,7 @@ ParserExitCode parse_direct_declarator(
 **/
 ParserExitCode parse_pointer(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & pointer);
 
 /**
@@ -627,7 +627,7 @@ ParserExitCode parse_pointer(
 **/
 ParserExitCode parse_type_qualifier_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & type_qualifier_list);
 
 /**
@@ -641,7 +641,7 @@ ParserExitCode parse_type_qualifier_list(
 **/
 ParserExitCode parse_parameter_type_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & parameter_type_list);
 
 /**
@@ -655,7 +655,7 @@ ParserExitCode parse_parameter_type_list(
 **/
 ParserExitCode parse_parameter_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & parameter_list);
 
 /**
@@ -669,7 +669,7 @@ ParserExitCode parse_parameter_list(
 **/
 ParserExitCode parse_parameter_declaration(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & parameter_declaration);
 
 /**
@@ -683,7 +683,7 @@ ParserExitCode parse_parameter_declaration(
 **/
 ParserExitCode parse_identifier_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & identifier_list);
 
 /**
@@ -697,7 +697,7 @@ ParserExitCode parse_identifier_list(
 **/
 ParserExitCode parse_abstract_declarator(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & abstract_declarator);
 
 /**
@@ -711,7 +711,7 @@ ParserExitCode parse_abstract_declarator(
 **/
 ParserExitCode parse_direct_abstract_declarator(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & direct_abstract_declarator);
 
 /**
@@ -725,7 +725,7 @@ ParserExitCode parse_direct_abstract_declarator(
 **/
 ParserExitCode parse_initializer(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & initializer);
 
 /**
@@ -739,7 +739,7 @@ ParserExitCode parse_initializer(
 **/
 ParserExitCode parse_initializer_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & initializer_list);
 
 /**
@@ -753,7 +753,7 @@ ParserExitCode parse_initializer_list(
 **/
 ParserExitCode parse_designation(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & designation);
 
 /**
@@ -767,7 +767,7 @@ ParserExitCode parse_designation(
 **/
 ParserExitCode parse_designator_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & designator_list);
 
 /**
@@ -781,7 +781,7 @@ ParserExitCode parse_designator_list(
 **/
 ParserExitCode parse_designator(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & designator);
 
 /**
@@ -795,7 +795,7 @@ ParserExitCode parse_designator(
 **/
 ParserExitCode parse_statement(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & statement);
 
 /**
@@ -809,7 +809,7 @@ ParserExitCode parse_statement(
 **/
 ParserExitCode parse_compound_statement(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & compound_statement);
 
 /**
@@ -823,7 +823,7 @@ ParserExitCode parse_compound_statement(
 **/
 ParserExitCode parse_block_item_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & block_item_list);
 
 /**
@@ -837,7 +837,7 @@ ParserExitCode parse_block_item_list(
 **/
 ParserExitCode parse_block_item(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & block_item);
 
 /**
@@ -851,7 +851,7 @@ ParserExitCode parse_block_item(
 **/
 ParserExitCode parse_expression_statement(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & expression_statement);
 
 /**
@@ -865,7 +865,7 @@ ParserExitCode parse_expression_statement(
 **/
 ParserExitCode parse_selection_statement(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & selection_statement);
 
 /**
@@ -879,7 +879,7 @@ ParserExitCode parse_selection_statement(
 **/
 ParserExitCode parse_iteration_statement(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & iteration_statement);
 
 /**
@@ -893,7 +893,7 @@ ParserExitCode parse_iteration_statement(
 **/
 ParserExitCode parse_jump_statement(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & jump_statement);
 
 /**
@@ -907,7 +907,7 @@ ParserExitCode parse_jump_statement(
 **/
 ParserExitCode parse_translation_unit(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & translation_unit);
 
 /**
@@ -921,7 +921,7 @@ ParserExitCode parse_translation_unit(
 **/
 ParserExitCode parse_external_declaration(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & external_declaration);
 
 /**
@@ -935,7 +935,7 @@ ParserExitCode parse_external_declaration(
 **/
 ParserExitCode parse_function_definition(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & function_definition);
 
 /**
@@ -949,7 +949,7 @@ ParserExitCode parse_function_definition(
 **/
 ParserExitCode parse_declaration_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & declaration_list);
 
 /*****************************************************//**
@@ -959,22 +959,15 @@ ParserExitCode parse_declaration_list(
 static inline
 void parser_report_attempt(
 	const char* const& module_str,
-	const Token* const& token)
+	TokenRef    const& token)
 {
-	const FileLocationDescriptor fld
-		= token->get_file_descriptor();
-	const char* const filename
-		= fld.filename;
-	const unsigned int line_number
-		= fld.line_number;
-	const unsigned int character_number
-		= fld.character_number;
+	const SourceLocation location
+		= token.get_location();
 	const char* const lexeme
-		= token->get_lexeme();
+		= token.get_lexeme();
 	cout << "parser.cpp" << ":"
-		<< filename << ":"
-		<< line_number << ":"
-		<< character_number << ":"
+		<< location.file_id << ":"
+		<< location.offset << ":"
 		<< module_str << ":"
 		<< "attempting to produce tree on lexeme "
 		<< lexeme
@@ -986,26 +979,19 @@ static inline
 void parse_report_success(
 	const char* const& module_str,
 	AstNodeAlt       const& alt,
-	const Token* const& token)
+	TokenRef     const& token)
 {
-	const FileLocationDescriptor fld
-		= token->get_file_descriptor();
-	const const char* const filename
-		= fld.filename;
-	const unsigned int line_number
-		= fld.line_number;
-	const unsigned int character_number
-		= fld.character_number;
+	const SourceLocation location
+		= token.get_location();
 	const char* const lexeme
-		= token->get_lexeme();
+		= token.get_lexeme();
 	const int alt_i
 		= (int)alt;
 	const char* const ast_node_alt_string_repr
 		= ast_node_alt_string_reprs[alt_i];
 	cout << "parser.cpp" << ":"
-		<< filename << ":"
-		<< line_number << ":"
-		<< character_number << ":"
+		<< location.file_id << ":"
+		<< location.offset << ":"
 		<< module_str << ":"
 		<< "produced tree with form "
 		<< ast_node_alt_string_repr
@@ -1035,7 +1021,7 @@ AstNode* construct_node_from_children(
 static inline
 ParserExitCode parse_primary_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & primary_expression)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -1128,7 +1114,7 @@ ParserExitCode parse_primary_expression(
 static inline
 ParserExitCode parse_argument_expression_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*&           argument_expression_list)
 {
 	ParserExitCode exitcode = ParserExitCode::FAIL;
@@ -1218,7 +1204,7 @@ ParserExitCode parse_argument_expression_list(
 static inline
 ParserExitCode parse_postfix_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & postfix_expression)
 {
 	ParserExitCode exitcode 
@@ -1509,7 +1495,7 @@ ParserExitCode parse_postfix_expression(
 static inline
 ParserExitCode parse_type_name(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & type_name)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -1568,7 +1554,7 @@ ParserExitCode parse_type_name(
 static inline
 ParserExitCode parse_unary_operator(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & unary_operator)
 {
 
@@ -1646,7 +1632,7 @@ ParserExitCode parse_unary_operator(
 static inline
 ParserExitCode parse_cast_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & cast_expression)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -1674,9 +1660,9 @@ ParserExitCode parse_cast_expression(
 	bool not_typedef_name
 		= (tokens + 1)->get_name() != TokenName::IDENTIFIER
 		  || (sym->get_entry(
-				(tokens + 1)->get_lexeme())
+				(tokens + 1)->get_atom())
 			  && (sym->get_entry(
-					(tokens + 1)->get_lexeme())->identifier_type 
+					(tokens + 1)->get_atom())->identifier_type 
 				  != IdentifierClassifier::TYPEDEF_NAME));
 
 	if (tokens->get_name() == TokenName::PUNCTUATOR
@@ -1751,7 +1737,7 @@ ParserExitCode parse_cast_expression(
 static inline
 ParserExitCode parse_unary_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & unary_expression)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -1930,7 +1916,7 @@ ParserExitCode parse_unary_expression(
 static inline
 ParserExitCode parse_multiplicative_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & multiplicative_expression)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -2037,7 +2023,7 @@ ParserExitCode parse_multiplicative_expression(
 static inline
 ParserExitCode parse_additive_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & additive_expression)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -2137,7 +2123,7 @@ ParserExitCode parse_additive_expression(
 static inline
 ParserExitCode parse_shift_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & shift_expression)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -2251,7 +2237,7 @@ ParserExitCode parse_shift_expression(
 static inline
 ParserExitCode parse_relational_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & relational_expression)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -2385,7 +2371,7 @@ ParserExitCode parse_relational_expression(
 static inline
 ParserExitCode parse_equality_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & equality_expression)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -2499,7 +2485,7 @@ ParserExitCode parse_equality_expression(
 static inline
 ParserExitCode parse_and_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & and_expression)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -2592,7 +2578,7 @@ ParserExitCode parse_and_expression(
 static inline
 ParserExitCode parse_exclusive_or_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & exclusive_or_expression)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -2684,7 +2670,7 @@ ParserExitCode parse_exclusive_or_expression(
 static inline
 ParserExitCode parse_inclusive_or_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & inclusive_or_expression)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -2777,7 +2763,7 @@ ParserExitCode parse_inclusive_or_expression(
 static inline
 ParserExitCode parse_logical_and_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & logical_and_expression)
 { 
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -2868,7 +2854,7 @@ ParserExitCode parse_logical_and_expression(
 static inline
 ParserExitCode parse_logical_or_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & logical_or_expression)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -2960,7 +2946,7 @@ ParserExitCode parse_logical_or_expression(
 static inline
 ParserExitCode parse_assignment_operator(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & assignment_operator)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -3053,7 +3039,7 @@ ParserExitCode parse_assignment_operator(
 static inline
 ParserExitCode parse_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & expression)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -3142,7 +3128,7 @@ ParserExitCode parse_expression(
 static inline
 ParserExitCode parse_conditional_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & conditional_expression)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -3224,7 +3210,7 @@ ParserExitCode parse_conditional_expression(
 static inline
 ParserExitCode parse_assignment_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & assignment_expression)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -3244,7 +3230,7 @@ ParserExitCode parse_assignment_expression(
 	AstNode* stack[15];
 	int si = 0;
 
-	const Token* backtrack = tokens;
+	TokenCursor backtrack = tokens;
 
 	bool should_generate = false;
 	if (lookup(
@@ -3328,7 +3314,7 @@ ParserExitCode parse_assignment_expression(
 static inline
 ParserExitCode parse_constant_expression(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & constant_expression)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -3378,7 +3364,7 @@ ParserExitCode parse_constant_expression(
 static inline
 ParserExitCode parse_declaration(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & declaration)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -3450,7 +3436,7 @@ ParserExitCode parse_declaration(
 static inline
 ParserExitCode parse_storage_class_specifier(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & storage_class_specifier)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -3521,7 +3507,7 @@ ParserExitCode parse_storage_class_specifier(
 static inline
 ParserExitCode parse_function_specifier(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & function_specifier)
 { 
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -3551,7 +3537,7 @@ ParserExitCode parse_function_specifier(
 static inline
 ParserExitCode parse_declaration_specifiers(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & declaration_specifiers)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -3590,9 +3576,9 @@ ParserExitCode parse_declaration_specifiers(
 				bool is_typedef_name
 					= (tokens->get_name()
 						== TokenName::IDENTIFIER)
-					  && (sym->get_entry(tokens->get_lexeme())
+					  && (sym->get_entry(tokens->get_atom())
 						  && (sym->get_entry(
-							      tokens->get_lexeme())->identifier_type
+							      tokens->get_atom())->identifier_type
 							  != IdentifierClassifier::TYPEDEF_NAME));
 
 				if (!is_typedef_name) {
@@ -3624,8 +3610,8 @@ ParserExitCode parse_declaration_specifiers(
 			const bool is_typedef_name
 				= (tokens->get_name()
 				   != TokenName::IDENTIFIER)
-				   || (sym->get_entry(tokens->get_lexeme()))
-				       && (sym->get_entry(tokens->get_lexeme())->identifier_type
+				   || (sym->get_entry(tokens->get_atom()))
+				       && (sym->get_entry(tokens->get_atom())->identifier_type
 					       != IdentifierClassifier::TYPEDEF_NAME);
 
 			if (is_typedef_name) {
@@ -3661,9 +3647,9 @@ ParserExitCode parse_declaration_specifiers(
 			bool is_typedef_name
 				= (tokens->get_name() 
 				   == TokenName::IDENTIFIER)
-				  && (sym->get_entry(tokens->get_lexeme())
+				  && (sym->get_entry(tokens->get_atom())
 					  && (sym->get_entry(
-							tokens->get_lexeme())->identifier_type) 
+							tokens->get_atom())->identifier_type) 
 					      != IdentifierClassifier::TYPEDEF_NAME);
 
 			AstNode* declaration_specifiers;
@@ -3696,9 +3682,9 @@ ParserExitCode parse_declaration_specifiers(
 			bool is_typedef_name
 				= (tokens->get_name() 
 				   == TokenName::IDENTIFIER)
-				  && (sym->get_entry(tokens->get_lexeme())
+				  && (sym->get_entry(tokens->get_atom())
 					  && (sym->get_entry(
-						      tokens->get_lexeme())->identifier_type) 
+						      tokens->get_atom())->identifier_type) 
 					      != IdentifierClassifier::TYPEDEF_NAME);
 
 			if (!is_typedef_name) {
@@ -3733,9 +3719,9 @@ ParserExitCode parse_declaration_specifiers(
 			bool is_typedef_name
 				= tokens->get_name() 
 				  == TokenName::IDENTIFIER
-				&& (sym->get_entry(tokens->get_lexeme())
+				&& (sym->get_entry(tokens->get_atom())
 					&& (sym->get_entry(
-						    tokens->get_lexeme())->identifier_type) 
+						    tokens->get_atom())->identifier_type) 
 					    != IdentifierClassifier::TYPEDEF_NAME);
 
 			if (!is_typedef_name
@@ -3770,7 +3756,7 @@ ParserExitCode parse_declaration_specifiers(
 static inline
 ParserExitCode parse_init_declarator_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & init_declarator_list)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -3859,7 +3845,7 @@ ParserExitCode parse_init_declarator_list(
 static inline
 ParserExitCode parse_init_declarator(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & init_declarator)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -3927,7 +3913,7 @@ ParserExitCode parse_init_declarator(
 static inline
 ParserExitCode parse_enum_specifier(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & enum_specifier)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -4063,7 +4049,7 @@ ParserExitCode parse_enum_specifier(
 static inline
 ParserExitCode parse_typedef_name(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & typedef_name)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -4088,7 +4074,7 @@ ParserExitCode parse_typedef_name(
 static inline
 ParserExitCode parse_type_specifier(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & type_specifier)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -4233,7 +4219,7 @@ ParserExitCode parse_type_specifier(
 static inline
 ParserExitCode parse_struct_or_union_specifier(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & struct_or_union_specifier)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -4351,7 +4337,7 @@ ParserExitCode parse_struct_or_union_specifier(
 static inline
 ParserExitCode parse_struct_or_union(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & struct_or_union)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -4409,7 +4395,7 @@ ParserExitCode parse_struct_or_union(
 static inline
 ParserExitCode parse_struct_declaration_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & struct_declaration_list)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -4504,7 +4490,7 @@ ParserExitCode parse_struct_declaration_list(
 static inline
 ParserExitCode parse_struct_declaration(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & struct_declaration)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -4566,7 +4552,7 @@ ParserExitCode parse_struct_declaration(
 static inline
 ParserExitCode parse_specifier_qualifier_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & specifier_qualifier_list)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -4653,7 +4639,7 @@ ParserExitCode parse_specifier_qualifier_list(
 static inline
 ParserExitCode parse_struct_declarator_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & struct_declarator_list)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -4747,7 +4733,7 @@ ParserExitCode parse_struct_declarator_list(
 static inline
 ParserExitCode parse_struct_declarator(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & struct_declarator)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -4821,7 +4807,7 @@ ParserExitCode parse_struct_declarator(
 static inline
 ParserExitCode parse_enumeration_constant(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & enumeration_constant)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -4855,7 +4841,7 @@ ParserExitCode parse_enumeration_constant(
 static inline
 ParserExitCode parse_enumerator(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & enumerator)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -4939,7 +4925,7 @@ ParserExitCode parse_enumerator(
 static inline
 ParserExitCode parse_enumerator_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & enumerator_list)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -5026,7 +5012,7 @@ ParserExitCode parse_enumerator_list(
 static inline
 ParserExitCode parse_enumeration_specifier(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & enumeration_specifier)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -5109,7 +5095,7 @@ ParserExitCode parse_enumeration_specifier(
 static inline
 ParserExitCode parse_type_qualifier(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & type_qualifier)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -5172,7 +5158,7 @@ ParserExitCode parse_type_qualifier(
 static inline
 ParserExitCode parse_parameter_type_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & parameter_type_list)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -5237,7 +5223,7 @@ ParserExitCode parse_parameter_type_list(
 static inline
 ParserExitCode parse_direct_declarator(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & direct_declarator)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -5495,7 +5481,7 @@ ParserExitCode parse_direct_declarator(
 static inline
 ParserExitCode parse_declarator(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & declarator)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -5558,7 +5544,7 @@ ParserExitCode parse_declarator(
 static inline
 ParserExitCode parse_type_qualifier_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & type_qualifier_list)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -5654,7 +5640,7 @@ ParserExitCode parse_type_qualifier_list(
 static inline
 ParserExitCode parse_pointer(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & pointer)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -5753,7 +5739,7 @@ ParserExitCode parse_pointer(
 static inline
 ParserExitCode parse_parameter_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & parameter_list)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -5845,7 +5831,7 @@ ParserExitCode parse_parameter_list(
 static inline
 ParserExitCode parse_parameter_declaration(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & parameter_declaration)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -5922,7 +5908,7 @@ ParserExitCode parse_parameter_declaration(
 static inline
 ParserExitCode parse_identifier_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & identifier_list)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -6006,7 +5992,7 @@ ParserExitCode parse_identifier_list(
 static inline
 ParserExitCode parse_abstract_declarator(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & abstract_declarator)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -6093,7 +6079,7 @@ ParserExitCode parse_abstract_declarator(
 static inline
 ParserExitCode parse_direct_abstract_declarator(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & direct_abstract_declarator)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -6334,7 +6320,7 @@ ParserExitCode parse_direct_abstract_declarator(
 static inline
 ParserExitCode parse_initializer(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & initializer)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -6427,7 +6413,7 @@ ParserExitCode parse_initializer(
 static inline
 ParserExitCode parse_initializer_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & initializer_list)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -6555,7 +6541,7 @@ ParserExitCode parse_initializer_list(
 static inline
 ParserExitCode parse_designation(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & designation)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -6610,7 +6596,7 @@ ParserExitCode parse_designation(
 static inline
 ParserExitCode parse_designator_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & designator_list)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -6694,7 +6680,7 @@ ParserExitCode parse_designator_list(
 static inline
 ParserExitCode parse_designator(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & designator) {
 
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -6770,7 +6756,7 @@ ParserExitCode parse_designator(
 static inline
 ParserExitCode parse_labeled_statement(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & labeled_statement)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -6889,7 +6875,7 @@ ParserExitCode parse_labeled_statement(
 static inline
 ParserExitCode parse_statement(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & statement)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -6911,8 +6897,8 @@ ParserExitCode parse_statement(
 	
 	bool not_typedefed_id 
 		= (tokens->get_name() != TokenName::IDENTIFIER
-		   || (sym->get_entry(tokens->get_lexeme())
-			   && (sym->get_entry(tokens->get_lexeme())->identifier_type) 
+		   || (sym->get_entry(tokens->get_atom())
+			   && (sym->get_entry(tokens->get_atom())->identifier_type) 
 			       != IdentifierClassifier::TYPEDEF_NAME));
 
 	if (lookup(
@@ -7040,7 +7026,7 @@ ParserExitCode parse_statement(
 static inline
 ParserExitCode parse_compound_statement(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & compound_statement)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -7108,7 +7094,7 @@ ParserExitCode parse_compound_statement(
 static inline
 ParserExitCode parse_block_item_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & block_item_list)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -7193,7 +7179,7 @@ ParserExitCode parse_block_item_list(
 static inline
 ParserExitCode parse_block_item(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & block_item)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -7213,7 +7199,7 @@ ParserExitCode parse_block_item(
 
 	bool should_generate = false;
 
-	const Token* backtrack_ptr = tokens;
+	TokenCursor backtrack_ptr = tokens;
 
 	if (lookup(
 		first_of_declaration,
@@ -7286,7 +7272,7 @@ ParserExitCode parse_block_item(
 static inline
 ParserExitCode parse_expression_statement(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & expression_statement)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -7349,7 +7335,7 @@ ParserExitCode parse_expression_statement(
 static inline
 ParserExitCode parse_selection_statement(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & selection_statement)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -7503,7 +7489,7 @@ ParserExitCode parse_selection_statement(
 static inline
 ParserExitCode parse_iteration_statement(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & iteration_statement)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -7824,7 +7810,7 @@ ParserExitCode parse_iteration_statement(
 static inline
 ParserExitCode parse_jump_statement(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & jump_statement)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -7974,7 +7960,7 @@ ParserExitCode parse_jump_statement(
 static inline
 ParserExitCode parse_translation_unit(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & translation_unit)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -8060,7 +8046,7 @@ ParserExitCode parse_translation_unit(
 static inline
 ParserExitCode parse_function_definition(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & function_definition)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -8157,7 +8143,7 @@ ParserExitCode parse_function_definition(
 static inline
 ParserExitCode parse_declaration_list(
 	SymbolTable* const& sym,
-	const Token*      & tokens,
+	TokenCursor       & tokens,
 	AstNode*          & declaration_list)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -8240,7 +8226,7 @@ ParserExitCode parse_declaration_list(
 
 static inline
 ParserExitCode parse_external_declaration(
-	const Token* & tokens,
+	TokenCursor  & tokens,
 	AstNode*     & external_declaration)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -8252,14 +8238,14 @@ ParserExitCode parse_external_declaration(
 	ParserExitCode exitcode 
 		= ParserExitCode::FAIL;
 
-	SymbolTable* sym = new SymbolTable();
+	SymbolTable* sym = construct_symbol_table();
 
 	enum ParsingState {
 		START,
 		DECLARATION_LIST
 	};
 
-	const Token* backtrack_ptr = tokens;
+	TokenCursor backtrack_ptr = tokens;
 	
 	AstNode* stack[16];
 	int si = 0;
@@ -8336,7 +8322,7 @@ ParserExitCode parse_external_declaration(
 
 static inline
 ParserExitCode parse_translation_unit(
-	const Token* & tokens,
+	TokenCursor  & tokens,
 	AstNode*     & translation_unit)
 {
 	if (DEBUG_PARSER_SHOW_ATTEMPTS) {
@@ -8348,14 +8334,14 @@ ParserExitCode parse_translation_unit(
 	ParserExitCode exitcode 
 		= ParserExitCode::FAIL;
 
-	SymbolTable* sym = new SymbolTable();
+	SymbolTable* sym = construct_symbol_table();
 
 	enum ParsingState {
 		START,
 		TRANSLATION_UNIT
 	};
 
-	const Token* tokens_ptr = tokens;
+	TokenCursor tokens_ptr = tokens;
 
 	ParsingState state = START;
 	while (true) {
@@ -8377,6 +8363,10 @@ ParserExitCode parse_translation_unit(
 							NULL);
 					translation_unit->add_child(
 						external_declaration);
+					/* Nothing backtracks into an external
+					   declaration once it is parsed, so
+					   the tokens behind it are let go.   */
+					tokens_ptr.release_before();
 
 					state = TRANSLATION_UNIT;
 					exitcode = ParserExitCode::SUCCESS;
@@ -8409,6 +8399,7 @@ ParserExitCode parse_translation_unit(
 						external_declaration);
 					translation_unit =
 						higher_translation_unit;
+					tokens_ptr.release_before();
 
 					continue;
 
@@ -8420,7 +8411,10 @@ ParserExitCode parse_translation_unit(
 						= construct_error_book(
 							ErrorCode::ERR_PARSER_INVALID_TRANSLATION_UNIT,
 							"Invalid translation unit. Expected an external declaration here.",
-							tokens_ptr->get_file_descriptor());
+							tokens_ptr->get_location(),
+							tokens_ptr->get_lexeme() != NULL
+							? (unsigned int) strlen(tokens_ptr->get_lexeme())
+							: 0);
 					/* Enter Panic Mode. */
 					/*bool in_panic_mode = true;
 					do {
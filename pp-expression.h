@@ -0,0 +1,742 @@
+/* Authored by Charlie Keaney                      */
+/* pp-expression.h - Responsible for evaluating the
+					 constant expressions that
+					 control #if and #elif
+					 directives.
+
+					 Implementation Notes:
+					 The expression is evaluated
+					 straight from its pp-tokens by
+					 precedence climbing, building
+					 no tree. As C11 6.10.1 asks,
+					 every value is an intmax_t or
+					 a uintmax_t; each carries which
+					 it is, and an operation is
+					 unsigned if either operand is.
+
+					 Macros are expanded before the
+					 tokens reach the evaluator, so
+					 an identifier it meets names no
+					 macro and evaluates to 0. Only
+					 defined asks after macros, by
+					 the lookup it is given.
+
+					 Operands that are never used,
+					 such as the right of 0 && x,
+					 are still parsed, but errors
+					 like division by zero are not
+					 reported within them.         */
+
+#ifndef PP_EXPRESSION_H
+#define PP_EXPRESSION_H 1
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "preprocessing-token.h"
+#include "numeric-literals.h"
+#include "error.h"
+
+/* The precedence of an operator that is not binary. */
+#define PP_PRECEDENCE_NONE   0
+/* The precedence of ||, the lowest binary operator. */
+#define PP_PRECEDENCE_LOWEST 1
+
+using namespace std;
+
+/*****************************************************//**
+*                      Declarations                      *
+/********************************************************/
+
+enum class PpExpressionExitCode {
+	SUCCESS,
+	FAILURE
+};
+
+/**
+* The value of a preprocessor expression, as the bits
+* of an intmax_t or a uintmax_t.
+**/
+struct PpValue {
+	uintmax_t bits;
+	bool      is_unsigned;
+};
+
+/**
+* Says whether the identifier names a macro.
+**/
+typedef bool (*PpMacroLookup)(
+	const PreprocessingToken* const& identifier,
+	void*                     const& context);
+
+struct PpExpressionState {
+	const PreprocessingToken* const* tokens;
+	size_t                           num_tokens;
+	size_t                           position;
+	PpMacroLookup                    is_defined;
+	void*                            lookup_context;
+	/* Above 0 within an operand whose value is not
+	   used, where errors are not reported.        */
+	unsigned int                     unevaluated_depth;
+	bool                             failed;
+	AlertList*                       bkl;
+};
+
+/**
+* Evaluates the controlling expression of an #if or
+* #elif directive.
+*
+* @param tokens The expression's pp-tokens, with its
+*				macros expanded.
+* @param num_tokens The number of pp-tokens.
+* @param is_defined The lookup defined asks of.
+* @param context Passed on to the lookup.
+* @param bkl The location to send alerts to.
+* @param value Set to the value of the expression.
+* @return Returns FAILURE if the tokens are not a
+*		  valid expression, with an error sent to bkl.
+**/
+static inline
+PpExpressionExitCode evaluate_pp_expression(
+	const PreprocessingToken* const* const& tokens,
+	size_t                           const& num_tokens,
+	PpMacroLookup                    const& is_defined,
+	void*                            const& context,
+	AlertList                             & bkl,
+	PpValue                               & value);
+
+/**
+* Returns the precedence of a binary operator, higher
+* binding tighter.
+*
+* @param token The pp-token to look up, or NULL.
+* @return Returns PP_PRECEDENCE_NONE if the pp-token
+*		  is not a binary operator.
+**/
+static inline
+int get_pp_binary_precedence(
+	const PreprocessingToken* const& token);
+
+/**
+* Returns the value of a character constant, which is
+* an int.
+*
+* @param lexeme The NUL terminated character constant.
+* @return Returns the value, sign extended.
+**/
+static inline
+uintmax_t get_pp_character_constant_value(
+	const char* const& lexeme);
+
+static inline
+void report_pp_expression_error(
+	PpExpressionState              & state,
+	const PreprocessingToken* const& token,
+	const char*               const& message);
+
+static inline
+void evaluate_pp_conditional(
+	PpExpressionState& state,
+	PpValue          & value);
+
+static inline
+void evaluate_pp_binary(
+	PpExpressionState& state,
+	int         const& min_precedence,
+	PpValue          & value);
+
+static inline
+void evaluate_pp_unary(
+	PpExpressionState& state,
+	PpValue          & value);
+
+static inline
+void evaluate_pp_primary(
+	PpExpressionState& state,
+	PpValue          & value);
+
+static inline
+void apply_pp_binary_operator(
+	PpExpressionState             & state,
+	const PreprocessingToken* const& op,
+	PpValue                   const& lhs,
+	PpValue                   const& rhs,
+	PpValue                        & result);
+
+/*****************************************************//**
+*                         Definitions                    *
+/********************************************************/
+
+static inline
+const PreprocessingToken* peek_pp_expression_token(
+	PpExpressionState const& state)
+{
+	return state.position < state.num_tokens
+		   ? state.tokens[state.position]
+		   : NULL;
+}
+
+static inline
+bool is_pp_punctuator(
+	const PreprocessingToken* const& token,
+	PreprocessingTokenForm    const& form)
+{
+	return token != NULL
+		   && token->get_name() == PreprocessingTokenName::PUNCTUATOR
+		   && token->get_form() == form;
+}
+
+static inline
+PpValue construct_pp_value(
+	uintmax_t const& bits,
+	bool      const& is_unsigned = false)
+{
+	PpValue value = {
+		bits,
+		is_unsigned
+	};
+	return value;
+}
+
+static inline
+PpExpressionExitCode evaluate_pp_expression(
+	const PreprocessingToken* const* const& tokens,
+	size_t                           const& num_tokens,
+	PpMacroLookup                    const& is_defined,
+	void*                            const& context,
+	AlertList                             & bkl,
+	PpValue                               & value)
+{
+	PpExpressionState state = {
+		tokens,
+		num_tokens,
+		0,
+		is_defined,
+		context,
+		0,
+		false,
+		&bkl
+	};
+	value = construct_pp_value(0);
+	evaluate_pp_conditional(state, value);
+	if (!state.failed
+		&& state.position < state.num_tokens) {
+		report_pp_expression_error(
+			state,
+			peek_pp_expression_token(state),
+			"Expected the end of the expression here.");
+	}
+	return state.failed
+		   ? PpExpressionExitCode::FAILURE
+		   : PpExpressionExitCode::SUCCESS;
+}
+
+static inline
+int get_pp_binary_precedence(
+	const PreprocessingToken* const& token)
+{
+	if (token == NULL
+		|| token->get_name() != PreprocessingTokenName::PUNCTUATOR) {
+		return PP_PRECEDENCE_NONE;
+	}
+	switch (token->get_form()) {
+		case PreprocessingTokenForm::DOUBLE_OR:          return 1;
+		case PreprocessingTokenForm::DOUBLE_AMPERSAND:   return 2;
+		case PreprocessingTokenForm::OR:                 return 3;
+		case PreprocessingTokenForm::XOR:                return 4;
+		case PreprocessingTokenForm::AMPERSAND:          return 5;
+		case PreprocessingTokenForm::EQUAL:
+		case PreprocessingTokenForm::NOT_EQUAL:          return 6;
+		case PreprocessingTokenForm::LESS_THAN:
+		case PreprocessingTokenForm::GREATER_THAN:
+		case PreprocessingTokenForm::LESS_THAN_EQUAL:
+		case PreprocessingTokenForm::GREATER_THAN_EQUAL: return 7;
+		case PreprocessingTokenForm::LEFT_SHIFT:
+		case PreprocessingTokenForm::RIGHT_SHIFT:        return 8;
+		case PreprocessingTokenForm::PLUS:
+		case PreprocessingTokenForm::MINUS:              return 9;
+		case PreprocessingTokenForm::ASTERIX:
+		case PreprocessingTokenForm::FORWARD_SLASH:
+		case PreprocessingTokenForm::MODULO:             return 10;
+		default:                                         return PP_PRECEDENCE_NONE;
+	}
+}
+
+static inline
+uintmax_t get_pp_character_constant_value(
+	const char* const& lexeme)
+{
+	const char* chr = lexeme;
+	const bool is_wide = *chr == 'L';
+	if (is_wide) {
+		chr++;
+	}
+	/* Skip the opening quote. */
+	chr++;
+	uint32_t value = 0;
+	int num_chars = 0;
+	while (*chr != '\0' && *chr != '\'') {
+		uint32_t c;
+		if (*chr != '\\') {
+			c = (unsigned char) *chr++;
+		} else {
+			chr++;
+			switch (*chr) {
+				case 'a': c = '\a'; chr++; break;
+				case 'b': c = '\b'; chr++; break;
+				case 'f': c = '\f'; chr++; break;
+				case 'n': c = '\n'; chr++; break;
+				case 'r': c = '\r'; chr++; break;
+				case 't': c = '\t'; chr++; break;
+				case 'v': c = '\v'; chr++; break;
+
+				case 'x':
+					c = 0;
+					chr++;
+					while (get_digit_value(*chr) >= 0) {
+						c = c * 16 + get_digit_value(*chr++);
+					}
+					break;
+
+				case '0': case '1': case '2': case '3':
+				case '4': case '5': case '6': case '7':
+					c = 0;
+					for (int i = 0;
+						 i < 3 && *chr >= '0' && *chr <= '7';
+						 i++) {
+						c = c * 8 + (*chr++ - '0');
+					}
+					break;
+
+				default:
+					/* \\, \', \" and \? stand for themselves. */
+					c = (unsigned char) *chr++;
+					break;
+			}
+		}
+		value = is_wide
+				? c
+				: (value << 8) | (c & 0xFF);
+		num_chars++;
+	}
+	/* A plain char is signed, so one alone is sign
+	   extended from a char, and several from an int. */
+	if (!is_wide && num_chars == 1) {
+		return (uintmax_t) (intmax_t) (signed char) value;
+	}
+	return (uintmax_t) (intmax_t) (int32_t) value;
+}
+
+static inline
+void report_pp_expression_error(
+	PpExpressionState              & state,
+	const PreprocessingToken* const& token,
+	const char*               const& message)
+{
+	/* Only the first error of an expression is sent. */
+	if (state.failed) {
+		return;
+	}
+	state.failed = true;
+	const PreprocessingToken* const at
+		= token != NULL
+		  ? token
+		  : (state.num_tokens > 0
+			 ? state.tokens[state.num_tokens - 1]
+			 : NULL);
+	Error* error
+		= construct_error_book(
+			ErrorCode::ERR_PP_INVALID_CONSTANT_EXPRESSION,
+			message,
+			at != NULL
+			? at->get_location()
+			: construct_source_location(),
+			at != NULL
+			? (unsigned int) strlen(at->get_lexeme())
+			: 0);
+	state.bkl->add_error(error);
+}
+
+static inline
+void evaluate_pp_conditional(
+	PpExpressionState& state,
+	PpValue          & value)
+{
+	evaluate_pp_binary(state, PP_PRECEDENCE_LOWEST, value);
+	if (state.failed
+		|| !is_pp_punctuator(
+			   peek_pp_expression_token(state),
+			   PreprocessingTokenForm::QUESTION_MARK)) {
+		return;
+	}
+	state.position++;
+	const bool condition = value.bits != 0;
+
+	PpValue if_true;
+	if (!condition) {
+		state.unevaluated_depth++;
+	}
+	evaluate_pp_conditional(state, if_true);
+	if (!condition) {
+		state.unevaluated_depth--;
+	}
+	if (state.failed) {
+		return;
+	}
+	if (!is_pp_punctuator(
+			peek_pp_expression_token(state),
+			PreprocessingTokenForm::COLON)) {
+		report_pp_expression_error(
+			state,
+			peek_pp_expression_token(state),
+			"Expected a ':' here.");
+		return;
+	}
+	state.position++;
+
+	PpValue if_false;
+	if (condition) {
+		state.unevaluated_depth++;
+	}
+	evaluate_pp_conditional(state, if_false);
+	if (condition) {
+		state.unevaluated_depth--;
+	}
+	value = construct_pp_value(
+		condition ? if_true.bits : if_false.bits,
+		if_true.is_unsigned || if_false.is_unsigned);
+}
+
+static inline
+void evaluate_pp_binary(
+	PpExpressionState& state,
+	int         const& min_precedence,
+	PpValue          & value)
+{
+	evaluate_pp_unary(state, value);
+	while (!state.failed) {
+		const PreprocessingToken* const op
+			= peek_pp_expression_token(state);
+		const int precedence
+			= get_pp_binary_precedence(op);
+		if (precedence == PP_PRECEDENCE_NONE
+			|| precedence < min_precedence) {
+			break;
+		}
+		state.position++;
+		/* The right of && and || is not used once the
+		   left has decided the result.              */
+		const bool is_decided
+			= (op->get_form() == PreprocessingTokenForm::DOUBLE_AMPERSAND
+			   && value.bits == 0)
+			  || (op->get_form() == PreprocessingTokenForm::DOUBLE_OR
+				  && value.bits != 0);
+		if (is_decided) {
+			state.unevaluated_depth++;
+		}
+		PpValue rhs;
+		evaluate_pp_binary(state, precedence + 1, rhs);
+		if (is_decided) {
+			state.unevaluated_depth--;
+		}
+		if (state.failed) {
+			break;
+		}
+		apply_pp_binary_operator(state, op, value, rhs, value);
+	}
+}
+
+static inline
+void evaluate_pp_unary(
+	PpExpressionState& state,
+	PpValue          & value)
+{
+	const PreprocessingToken* const token
+		= peek_pp_expression_token(state);
+	if (token == NULL
+		|| token->get_name() != PreprocessingTokenName::PUNCTUATOR) {
+		evaluate_pp_primary(state, value);
+		return;
+	}
+	switch (token->get_form()) {
+
+		case PreprocessingTokenForm::PLUS:
+			state.position++;
+			evaluate_pp_unary(state, value);
+			break;
+
+		case PreprocessingTokenForm::MINUS:
+			state.position++;
+			evaluate_pp_unary(state, value);
+			value.bits = 0 - value.bits;
+			break;
+
+		case PreprocessingTokenForm::TILDE:
+			state.position++;
+			evaluate_pp_unary(state, value);
+			value.bits = ~value.bits;
+			break;
+
+		case PreprocessingTokenForm::EXCLAMATION_MARK:
+			state.position++;
+			evaluate_pp_unary(state, value);
+			value = construct_pp_value(value.bits == 0);
+			break;
+
+		case PreprocessingTokenForm::OPEN_PAREN:
+			state.position++;
+			evaluate_pp_conditional(state, value);
+			if (state.failed) {
+				break;
+			}
+			if (!is_pp_punctuator(
+					peek_pp_expression_token(state),
+					PreprocessingTokenForm::CLOSE_PAREN)) {
+				report_pp_expression_error(
+					state,
+					peek_pp_expression_token(state),
+					"Expected a ')' here.");
+				break;
+			}
+			state.position++;
+			break;
+
+		default:
+			evaluate_pp_primary(state, value);
+			break;
+	}
+}
+
+static inline
+void evaluate_pp_primary(
+	PpExpressionState& state,
+	PpValue          & value)
+{
+	const PreprocessingToken* const token
+		= peek_pp_expression_token(state);
+	value = construct_pp_value(0);
+	if (token == NULL) {
+		report_pp_expression_error(
+			state,
+			NULL,
+			"Expected an expression here.");
+		return;
+	}
+	state.position++;
+
+	switch (token->get_name()) {
+
+		case PreprocessingTokenName::IDENTIFIER:
+		{
+			if (strcmp(token->get_lexeme(), "defined") != 0) {
+				/* Any macro has been expanded already. */
+				break;
+			}
+			const bool is_parenthesised
+				= is_pp_punctuator(
+					  peek_pp_expression_token(state),
+					  PreprocessingTokenForm::OPEN_PAREN);
+			if (is_parenthesised) {
+				state.position++;
+			}
+			const PreprocessingToken* const identifier
+				= peek_pp_expression_token(state);
+			if (identifier == NULL
+				|| identifier->get_name()
+				   != PreprocessingTokenName::IDENTIFIER) {
+				report_pp_expression_error(
+					state,
+					identifier,
+					"Expected a macro name after defined.");
+				break;
+			}
+			state.position++;
+			if (is_parenthesised) {
+				if (!is_pp_punctuator(
+						peek_pp_expression_token(state),
+						PreprocessingTokenForm::CLOSE_PAREN)) {
+					report_pp_expression_error(
+						state,
+						peek_pp_expression_token(state),
+						"Expected a ')' here.");
+					break;
+				}
+				state.position++;
+			}
+			value = construct_pp_value(
+				state.is_defined(identifier, state.lookup_context));
+			break;
+		}
+
+		case PreprocessingTokenName::PP_NUMBER:
+		{
+			TokenClassification const& classification
+				= token->get_classification();
+			if (classification.name != TokenName::CONSTANT
+				|| classification.type == ConstantType::NONE
+				|| classification.type == ConstantType::FLOAT
+				|| classification.type == ConstantType::DOUBLE
+				|| classification.type == ConstantType::LONG_DOUBLE) {
+				report_pp_expression_error(
+					state,
+					token,
+					"Expected an integer constant here.");
+				break;
+			}
+			value = construct_pp_value(
+				classification.value.integervalue,
+				is_unsigned_constant_type(classification.type));
+			break;
+		}
+
+		case PreprocessingTokenName::CHARACTER_CONSTANT:
+			value = construct_pp_value(
+				get_pp_character_constant_value(token->get_lexeme()));
+			break;
+
+		default:
+			report_pp_expression_error(
+				state,
+				token,
+				"This token cannot appear in an #if expression.");
+			break;
+	}
+}
+
+static inline
+void apply_pp_binary_operator(
+	PpExpressionState             & state,
+	const PreprocessingToken* const& op,
+	PpValue                   const& lhs,
+	PpValue                   const& rhs,
+	PpValue                        & result)
+{
+	const bool is_unsigned
+		= lhs.is_unsigned || rhs.is_unsigned;
+	const intmax_t l = (intmax_t) lhs.bits;
+	const intmax_t r = (intmax_t) rhs.bits;
+	/* Shifting by the width or more, or by a negative
+	   amount, shifts every bit out.                 */
+	const bool is_shifted_out
+		= rhs.bits >= sizeof(uintmax_t) * CHAR_BIT;
+
+	switch (op->get_form()) {
+
+		case PreprocessingTokenForm::ASTERIX:
+			result = construct_pp_value(lhs.bits * rhs.bits, is_unsigned);
+			break;
+
+		case PreprocessingTokenForm::FORWARD_SLASH:
+		case PreprocessingTokenForm::MODULO:
+		{
+			const bool is_division
+				= op->get_form() == PreprocessingTokenForm::FORWARD_SLASH;
+			if (rhs.bits == 0) {
+				if (state.unevaluated_depth == 0) {
+					report_pp_expression_error(
+						state,
+						op,
+						"Division by zero in an #if expression.");
+				}
+				result = construct_pp_value(0, is_unsigned);
+			} else if (is_unsigned) {
+				result = construct_pp_value(
+					is_division
+					? lhs.bits / rhs.bits
+					: lhs.bits % rhs.bits,
+					true);
+			} else if (l == INTMAX_MIN && r == -1) {
+				/* The one quotient that overflows wraps. */
+				result = construct_pp_value(
+					is_division ? lhs.bits : 0);
+			} else {
+				result = construct_pp_value(
+					(uintmax_t) (is_division ? l / r : l % r));
+			}
+			break;
+		}
+
+		case PreprocessingTokenForm::PLUS:
+			result = construct_pp_value(lhs.bits + rhs.bits, is_unsigned);
+			break;
+
+		case PreprocessingTokenForm::MINUS:
+			result = construct_pp_value(lhs.bits - rhs.bits, is_unsigned);
+			break;
+
+		case PreprocessingTokenForm::LEFT_SHIFT:
+			/* A shift takes the type of its left operand. */
+			result = construct_pp_value(
+				is_shifted_out ? 0 : lhs.bits << rhs.bits,
+				lhs.is_unsigned);
+			break;
+
+		case PreprocessingTokenForm::RIGHT_SHIFT:
+			if (lhs.is_unsigned) {
+				result = construct_pp_value(
+					is_shifted_out ? 0 : lhs.bits >> rhs.bits,
+					true);
+			} else {
+				result = construct_pp_value(
+					(uintmax_t) (is_shifted_out
+								 ? (l < 0 ? -1 : 0)
+								 : l >> rhs.bits));
+			}
+			break;
+
+		case PreprocessingTokenForm::LESS_THAN:
+			result = construct_pp_value(
+				is_unsigned ? lhs.bits < rhs.bits : l < r);
+			break;
+
+		case PreprocessingTokenForm::GREATER_THAN:
+			result = construct_pp_value(
+				is_unsigned ? lhs.bits > rhs.bits : l > r);
+			break;
+
+		case PreprocessingTokenForm::LESS_THAN_EQUAL:
+			result = construct_pp_value(
+				is_unsigned ? lhs.bits <= rhs.bits : l <= r);
+			break;
+
+		case PreprocessingTokenForm::GREATER_THAN_EQUAL:
+			result = construct_pp_value(
+				is_unsigned ? lhs.bits >= rhs.bits : l >= r);
+			break;
+
+		case PreprocessingTokenForm::EQUAL:
+			result = construct_pp_value(lhs.bits == rhs.bits);
+			break;
+
+		case PreprocessingTokenForm::NOT_EQUAL:
+			result = construct_pp_value(lhs.bits != rhs.bits);
+			break;
+
+		case PreprocessingTokenForm::AMPERSAND:
+			result = construct_pp_value(lhs.bits & rhs.bits, is_unsigned);
+			break;
+
+		case PreprocessingTokenForm::XOR:
+			result = construct_pp_value(lhs.bits ^ rhs.bits, is_unsigned);
+			break;
+
+		case PreprocessingTokenForm::OR:
+			result = construct_pp_value(lhs.bits | rhs.bits, is_unsigned);
+			break;
+
+		case PreprocessingTokenForm::DOUBLE_AMPERSAND:
+			result = construct_pp_value(lhs.bits != 0 && rhs.bits != 0);
+			break;
+
+		case PreprocessingTokenForm::DOUBLE_OR:
+			result = construct_pp_value(lhs.bits != 0 || rhs.bits != 0);
+			break;
+
+		default:
+			break;
+	}
+}
+
+#endif
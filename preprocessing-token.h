@@ -15,17 +15,28 @@
 #define PPT_TABLE_ENTRY_CHAR_WIDTH   6
 #define PPT_TABLE_ENTRY_LEN_WIDTH    6
 
+/* How many preprocessing tokens may wait between the
+   preprocessor and the lexer.                       */
+#define PPT_RING_SZ 256
+
+#include <cstdint>
+#include <cstring>
 #include <iomanip>
 
 #include <iostream>
 
+#include "segmented-buffer.h"
+#include "arena.h"
+#include "file-location.h"
+#include "token.h"
+
 using namespace std;
 
 /*****************************************************//**
 *                      Declarations                      *
 /********************************************************/
 
-enum class PreprocessingTokenName {
+enum class PreprocessingTokenName : uint8_t {
 	ERROR,
 	HEADER_NAME,
 	IDENTIFIER,
@@ -51,7 +62,7 @@ const char* preprocessing_token_name_string_repr[] {
 	"EOF"
 };
 
-enum class PreprocessingTokenForm {
+enum class PreprocessingTokenForm : uint8_t {
 	/* Mark as no specific form */
 	UNDEFINED,
 	/* HEADER_NAME */
@@ -210,138 +221,173 @@ static const char* preprocessing_token_form_string_repr[]{
 	"BIGRAPH_DOUBLE_HASHTAG"
 };
 
-struct FileLocationDescriptor {
-	const char*  filename;
-	unsigned int line_number;
-	unsigned int character_number;
-	unsigned int lexeme_length;
-};
-
 class PreprocessingToken {
 private:
 	const char* lexeme;
+	SourceLocation location;
 	PreprocessingTokenName name;
-	FileLocationDescriptor file_descriptor;
 	PreprocessingTokenForm form;
+	uint32_t atom;
+	TokenClassification classification;
 public:
 	const char* get_lexeme() const {
 		return lexeme;
 	}
 
+	/**
+	* Returns the atom of the lexeme in its lexema pool,
+	* or 0 if the lexeme is not pooled.
+	**/
+	inline uint32_t get_atom() const {
+		return atom;
+	}
+
 	inline PreprocessingTokenName get_name() const {
 		return name;
 	}
 
-	inline FileLocationDescriptor get_file_descriptor() const {
-		return file_descriptor;
+	inline SourceLocation get_location() const {
+		return location;
 	}
 
 	inline PreprocessingTokenForm get_form() const {
 		return form;
 	}
 
+	/**
+	* Returns the token this pp-token lexes to, or one
+	* named ERROR if it must be lexed from its lexeme.
+	**/
+	inline TokenClassification const& get_classification() const {
+		return classification;
+	}
+
 	inline PreprocessingToken()
 		: lexeme(0),
+		location(construct_source_location()),
 		name(PreprocessingTokenName::ERROR),
-		file_descriptor(FileLocationDescriptor()),
-		form(PreprocessingTokenForm::UNDEFINED) {
+		form(PreprocessingTokenForm::UNDEFINED),
+		atom(0),
+		classification(construct_token_classification()) {
 	};
 
 	inline PreprocessingToken(
 		const char* const& l,
 		PreprocessingTokenName const& n,
-		FileLocationDescriptor const& filedesc,
-		PreprocessingTokenForm const& f)
+		SourceLocation const& loc,
+		PreprocessingTokenForm const& f,
+		uint32_t const& a = 0,
+		TokenClassification const& c = construct_token_classification())
 		: lexeme(l),
+		location(loc),
 		name(n),
-		file_descriptor(filedesc),
-		form(f) {
+		form(f),
+		atom(a),
+		classification(c) {
 	};
 
+	ARENA_ALLOCATED(PreprocessingToken)
+
 	inline ~PreprocessingToken() {
 		/* PreprocessingToken does not 'own' lexeme
 		   so no need to delete it. */
 	};
 
-	inline void print() {
-		cout << "<PreprocessingToken={\""
+	inline void print(
+		ostream& out = cout) const {
+		out << "<PreprocessingToken={\""
 			<< lexeme << "\","
 			<< preprocessing_token_name_string_repr[(int)name] << ","
 			<< preprocessing_token_form_string_repr[(int)form] << "}>";
 	}
 };
 
-static inline
-FileLocationDescriptor construct_file_location_descriptor();
+typedef SegmentedBuffer<PreprocessingToken>         PreprocessingTokenBuffer;
+typedef SegmentedBufferCursor<PreprocessingToken>   PreprocessingTokenCursor;
+typedef SegmentedBufferAppender<PreprocessingToken> PreprocessingTokenAppender;
 
-static inline
-FileLocationDescriptor construct_file_location_descriptor(
-	const char* const& filen,
-	int         const& line,
-	int         const& character,
-	int         const& lexeme_len);
+/**
+* A queue of at most PPT_RING_SZ preprocessing tokens,
+* held by value, which the preprocessor fills and the
+* lexer empties, so that neither holds more of the file
+* than that at once.
+**/
+class PreprocessingTokenRing {
+private:
+	PreprocessingToken tokens[PPT_RING_SZ];
+	size_t             head;
+	size_t             count;
+public:
+	inline PreprocessingTokenRing()
+		: head(0),
+		  count(0) {
+	};
 
-static inline
-void print_file_location_descriptor(
-	FileLocationDescriptor const& fld);
+	PreprocessingTokenRing(const PreprocessingTokenRing&) = delete;
+	PreprocessingTokenRing& operator=(const PreprocessingTokenRing&) = delete;
+
+	inline bool is_empty() const
+	{
+		return count == 0;
+	}
+
+	inline bool is_full() const
+	{
+		return count == PPT_RING_SZ;
+	}
+
+	inline size_t get_count() const
+	{
+		return count;
+	}
+
+	/**
+	* Adds a token to the back of a ring not yet full.
+	**/
+	inline void push(
+		PreprocessingToken const& token)
+	{
+		tokens[(head + count) % PPT_RING_SZ] = token;
+		count++;
+	}
+
+	/**
+	* Returns the token at the front of a ring not
+	* empty.
+	**/
+	inline PreprocessingToken const& front() const
+	{
+		return tokens[head];
+	}
+
+	inline void pop()
+	{
+		head = (head + 1) % PPT_RING_SZ;
+		count--;
+	}
+};
 
 static inline
 void print_preprocessing_token_table_entry(
-	const PreprocessingToken* const& ppt);
+	const PreprocessingToken* const& ppt,
+	SourceMap                      & sources,
+	ostream                        & out = cout);
 
 static inline
 void print_preprocessing_token_table(
-	const PreprocessingToken* const& ppts,
-	int						  const& count);
+	PreprocessingTokenBuffer const& ppts,
+	SourceMap                     & sources,
+	ostream                       & out = cout);
 
 /*****************************************************//**
 *                         Definitions                    *
 /********************************************************/
 
-static inline
-FileLocationDescriptor construct_file_location_descriptor() 
-{
-	FileLocationDescriptor fld = {
-		NULL,
-		0,
-		0,
-		0
-	};
-	return fld;
-}
-
-static inline
-FileLocationDescriptor construct_file_location_descriptor(
-	const char* const& filen,
-	int         const& line,
-	int         const& character,
-	int         const& lexeme_len) 
-{
-	FileLocationDescriptor fld = {
-		filen,
-		line,
-		character,
-		lexeme_len
-	};
-	return fld;
-}
-
-static inline
-void print_file_location_descriptor(
-	FileLocationDescriptor const& fld) 
-{
-	cout << "<FileLocationDescriptor={"
-		 << fld.filename
-		 << ","
-		 << fld.line_number
-		 << ","
-		 << fld.character_number
-		 << "}>";
-}
-
 static inline
 void print_preprocessing_token_table_entry(
-	const PreprocessingToken* const& ppt) 
+	const PreprocessingToken* const& ppt,
+	SourceMap                      & sources,
+	ostream                        & out) 
 {
 	const int name_i         
 		= (int) ppt->get_name();
@@ -352,76 +398,79 @@ void print_preprocessing_token_table_entry(
 	const char* const form_s 
 		= preprocessing_token_form_string_repr[form_i];
 	const FileLocationDescriptor fld 
-		= ppt->get_file_descriptor();
-	cout << std::left
-		 << std::setw(PPT_TABLE_ENTRY_LEXEME_WIDTH)
-         << std::setfill(' ')
-		 << ppt->get_lexeme() ;
-	cout << std::left
-         << std::setw(PPT_TABLE_ENTRY_NAME_WIDTH)
-		 << std::setfill(' ')
-		 << name_s;
-	cout << std::left
-		 << std::setw(PPT_TABLE_ENTRY_FORM_WIDTH)
-		 << std::setfill(' ')
-		 << form_s;
-	cout << std::left
-		 << std::setw(PPT_TABLE_ENTRY_FILE_WIDTH)
-		 << std::setfill(' ')
-		 << fld.filename;
-	cout << std::left
-		 << std::setw(PPT_TABLE_ENTRY_LINE_WIDTH)
-		 << std::setfill(' ')
-		 << fld.line_number;
-	cout << std::left
-		 << std::setw(PPT_TABLE_ENTRY_CHAR_WIDTH)
-		 << std::setfill(' ')
-		 << fld.character_number;
-	cout << std::left
-		 << std::setw(PPT_TABLE_ENTRY_LEN_WIDTH)
-		 << std::setfill(' ')
-		 << fld.lexeme_length
-		 << endl;
+		= sources.resolve(
+			ppt->get_location(),
+			(unsigned int) strlen(ppt->get_lexeme()));
+	out << std::left
+		<< std::setw(PPT_TABLE_ENTRY_LEXEME_WIDTH)
+		<< std::setfill(' ')
+		<< ppt->get_lexeme() ;
+	out << std::left
+		<< std::setw(PPT_TABLE_ENTRY_NAME_WIDTH)
+		<< std::setfill(' ')
+		<< name_s;
+	out << std::left
+		<< std::setw(PPT_TABLE_ENTRY_FORM_WIDTH)
+		<< std::setfill(' ')
+		<< form_s;
+	out << std::left
+		<< std::setw(PPT_TABLE_ENTRY_FILE_WIDTH)
+		<< std::setfill(' ')
+		<< fld.filename;
+	out << std::left
+		<< std::setw(PPT_TABLE_ENTRY_LINE_WIDTH)
+		<< std::setfill(' ')
+		<< fld.line_number;
+	out << std::left
+		<< std::setw(PPT_TABLE_ENTRY_CHAR_WIDTH)
+		<< std::setfill(' ')
+		<< fld.character_number;
+	out << std::left
+		<< std::setw(PPT_TABLE_ENTRY_LEN_WIDTH)
+		<< std::setfill(' ')
+		<< fld.lexeme_length
+		<< endl;
 }
 
 static inline
 void print_preprocessing_token_table(
-	const PreprocessingToken* const& ppts,
-	int						  const& count) 
+	PreprocessingTokenBuffer const& ppts,
+	SourceMap                     & sources,
+	ostream                       & out) 
 {	
-	cout << std::left
-		 << std::setw(PPT_TABLE_ENTRY_LEXEME_WIDTH) 
-         << std::setfill(' ')
-		 << "Lexeme" ;
-	cout  << std::left
-		 << std::setw(PPT_TABLE_ENTRY_NAME_WIDTH)   
-		 << std::setfill(' ')
-		 << "Name";
-	cout << std::left
-		 << std::setw(PPT_TABLE_ENTRY_FORM_WIDTH)  
-		 << std::setfill(' ')
-		 << "Form";
-	cout << std::left
-		 << std::setw(PPT_TABLE_ENTRY_FILE_WIDTH)   
-		 << std::setfill(' ')
-		 << "File";
-	cout << std::left
-		 << std::setw(PPT_TABLE_ENTRY_LINE_WIDTH)   
-		 << std::setfill(' ') 
-		 << "Line";
-	cout << std::left
-		 << std::setw(PPT_TABLE_ENTRY_CHAR_WIDTH)
-		 << std::setfill(' ')
-		 << "Char";
-	cout << std::left
-		 << std::setw(PPT_TABLE_ENTRY_LEN_WIDTH)
-		 << std::setfill(' ')
-		 << "Len"
-		 << endl;
-	for (const PreprocessingToken* p = ppts; 
-		 p < ppts + count; 
+	out << std::left
+		<< std::setw(PPT_TABLE_ENTRY_LEXEME_WIDTH) 
+		<< std::setfill(' ')
+		<< "Lexeme" ;
+	out  << std::left
+		<< std::setw(PPT_TABLE_ENTRY_NAME_WIDTH)   
+		<< std::setfill(' ')
+		<< "Name";
+	out << std::left
+		<< std::setw(PPT_TABLE_ENTRY_FORM_WIDTH)  
+		<< std::setfill(' ')
+		<< "Form";
+	out << std::left
+		<< std::setw(PPT_TABLE_ENTRY_FILE_WIDTH)   
+		<< std::setfill(' ')
+		<< "File";
+	out << std::left
+		<< std::setw(PPT_TABLE_ENTRY_LINE_WIDTH)   
+		<< std::setfill(' ') 
+		<< "Line";
+	out << std::left
+		<< std::setw(PPT_TABLE_ENTRY_CHAR_WIDTH)
+		<< std::setfill(' ')
+		<< "Char";
+	out << std::left
+		<< std::setw(PPT_TABLE_ENTRY_LEN_WIDTH)
+		<< std::setfill(' ')
+		<< "Len"
+		<< endl;
+	for (PreprocessingTokenCursor p = ppts.begin(); 
+		 p != ppts.end(); 
 		 p++) {
-		print_preprocessing_token_table_entry(p);
+		print_preprocessing_token_table_entry(&*p, sources, out);
 	}
 }
 #endif
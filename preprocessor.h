@@ -6,29 +6,62 @@
 					Implementation Notes: 
 					The preprocessor has an internal
 					ast tree to represent directives
-					etc.                             */
+					etc.
+
+					The groups of an if-section are
+					not parsed with the rest of the
+					file. The parser skips each one,
+					reading only the lines starting
+					with '#', and leaves a deferred
+					group holding where it starts.
+					Only a group whose condition
+					holds is parsed, as it is
+					executed, so the contents of
+					false groups are never
+					tokenised.
+
+					Preprocessing is streamed. Each
+					file and group being read is a
+					frame on a stack, and a single
+					group-part is parsed from the
+					innermost and carried out, its
+					tokens handed on if it is a text
+					line, before the next is parsed.
+					Each group-part is parsed into an
+					arena reset before the next, and
+					only #define copies anything out,
+					so the memory held depends on the
+					longest group-part and how deeply
+					files and groups nest, not on how
+					long the file is.                */
 
 #ifndef PREPROCESSOR_H
 #define PREPROCESSOR_H 1
 
+#include <algorithm>
+#include <cctype>
+#include <cstring>
 #include <iostream>
+#include <vector>
 
+#include "char-scan.h"
 #include "lexema-pool.h"
 #include "preprocessing-token.h"
+#include "punctuators.h"
 #include "error.h"
-
-/* All of the following used for constant-expressions. */
-#include "token.h"
 #include "lexer.h"
-#include "ast-node.h"
-#include "parser.h"
-#include "annotated-ast-node.h"
-#include "semantic-annotator.h"
+#include "symbol-table.h"
+#include "pp-expression.h"
+#include "include-table.h"
 
 using namespace std;
 
 #define DEBUG_ENABLE_PREPROCESSOR_REPORT 0
 
+/* Longer than any directive name a skipped group is
+   scanned for.                                      */
+#define PP_SKIPPED_DIRECTIVE_NAME_SZ 8
+
 #define preprocessor_report_failure( s, f, l )				\
 		if (DEBUG_ENABLE_PREPROCESSOR_REPORT) {				\
 			cout << "lexer.cpp:" s ":"						\
@@ -148,6 +181,8 @@ enum class PreprocessingAstNodeAlt {
 	PREPROCESSING_FILE_1,
 	GROUP_1,
 	GROUP_2,
+	/* A group not parsed until it is executed. */
+	GROUP_3,
 	GROUP_PART_1,
 	GROUP_PART_2,
 	GROUP_PART_3,
@@ -196,6 +231,7 @@ const char* preprocessing_ast_form_string_reprs[] {
 	"PREPROCESSING_FILE_1",
 	"GROUP_1",
 	"GROUP_2",
+	"GROUP_3",
 	"GROUP_PART_1",
 	"GROUP_PART_2",
 	"GROUP_PART_3",
@@ -283,6 +319,8 @@ public:
 		sibling(NULL) {
 	}
 
+	ARENA_ALLOCATED(PreprocessingAstNode)
+
 	inline
 	PreprocessingAstNodeName get_name() const
 	{
@@ -416,19 +454,6 @@ PreprocessingAstNode* construct_node_from_children(
 	PreprocessingAstNode**   const& children,
 	int                      const& count);
 
-/**
-* Constructs a lexeme from a section of a string.
-* i.e. Creates a new string from a given substring.
-* 
-* @param lexeme_start Pointer to the start of the data.
-* @param lexeme_end Pointer to the end of the data.
-* @return The lexema constructed.
-**/
-static inline
-const char* construct_lexeme(
-	const char* const& lexeme_start,
-	const char* const& lexeme_end);
-
 struct LexemaPool;
 
 /**
@@ -448,7 +473,7 @@ static inline void ensure_lexeme_substring_in_pool(
 * Used to lexically preprocess a header name.
 * 
 * @param input The input from which to preprocess.
-* @param fld The input's file location descriptor.
+* @param source The file the input is from.
 * @param header_name The produced pp-number header_name.
 * @return Returns an exitcode for success or failure.
 **/
@@ -456,14 +481,14 @@ static inline
 PreprocessorExitCode pp_lex_header_name(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & fld,
+	SourceMapFile     const& source,
 	PreprocessingToken*    & header_name);
 
 /**
 * Used to lexically preprocess an identifier.
 * 
 * @param input The input from which to preprocess.
-* @param fld The input's file location descriptor.
+* @param source The file the input is from.
 * @param pp_number The produced pp-number pptoken.
 * @return Returns an exitcode for success or failure.
 **/
@@ -471,7 +496,7 @@ static inline
 PreprocessorExitCode pp_lex_identifier_name(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & fld,
+	SourceMapFile     const& source,
 	PreprocessingToken*    & identifier_name,
 	AlertList              & bkl);
 
@@ -479,7 +504,7 @@ PreprocessorExitCode pp_lex_identifier_name(
 * Used to lexically preprocess a pp-number.
 * 
 * @param input The input from which to preprocess.
-* @param fld The input's file location descriptor.
+* @param source The file the input is from.
 * @param pp_number The produced pp-number pptoken.
 * @return Returns an exit code describing how the parse went.
 **/
@@ -487,7 +512,7 @@ static inline
  PreprocessorExitCode pp_lex_pp_number(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & fld,
+	SourceMapFile     const& source,
 	PreprocessingToken*    & pp_number,
 	AlertList              & bkl);
 
@@ -495,7 +520,7 @@ static inline
 * Used to lexically preprocess a character-constant.
 * 
 * @param input The input from which to preprocess.
-* @param fld The file location descriptor for the input.
+* @param source The file the input is from.
 * @param character_constant The reference to where to place
 *        the produced character_constant pptoken.
 * @param bkl The location to send error alerts to.
@@ -505,7 +530,7 @@ static inline
 PreprocessorExitCode pp_lex_character_constant(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & fld,
+	SourceMapFile     const& source,
 	PreprocessingToken*    & identifier_output,
 	AlertList              & bkl);
 
@@ -513,7 +538,7 @@ PreprocessorExitCode pp_lex_character_constant(
 * Used to lexically preprocess a string-literal.
 * 
 * @param input The input from which to preprocess.
-* @param fld The file location descriptor for the input.
+* @param source The file the input is from.
 * @param string_literal The reference to where to place
 *        the produced string-literal pptoken.
 * @return Returns an exit code describing how the parse went.
@@ -522,7 +547,7 @@ static inline
 PreprocessorExitCode pp_lex_string_literal(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & fld,
+	SourceMapFile     const& source,
 	PreprocessingToken*    & string_literal,
 	AlertList              & bkl);
 
@@ -530,7 +555,7 @@ PreprocessorExitCode pp_lex_string_literal(
 * Used to lexically preprocess a punctuator.
 * 
 * @param input The input from which to preprocess.
-* @param fld The file location descriptor for the input.
+* @param source The file the input is from.
 * @param punctuator The reference to where to place
 *        the produced punctuator pptoken.
 * @param bkl The location to send alerts to.
@@ -540,7 +565,7 @@ static inline
  PreprocessorExitCode pp_lex_punctuator(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-    FileLocationDescriptor & fld,
+    SourceMapFile     const& source,
 	PreprocessingToken*    & punctuator,
 	AlertList              & bkl);
 
@@ -548,7 +573,7 @@ static inline
 * Used to preprocess a character string (char*) input.
 * 
 * @param input The input from which to preprocess.
-* @param fld The file location descriptor for the input.
+* @param source The file the input is from.
 * @param punctuator The reference to where to place
 *					the produced pptokens.
 * @return Returns an exit code describing how the parse went.
@@ -557,7 +582,7 @@ static inline
 PreprocessorExitCode pp_parse_pp_tokens(
 	const char*                 & input,
 	LexemaPool                  & lexema_pool,
-	FileLocationDescriptor      & file_location_descriptor,
+	SourceMapFile          const& source,
 	PreprocessingAstNode*       & pp_tokens,
 	AlertList                   & bkl,
 	bool			       const& in_directive);
@@ -568,27 +593,45 @@ PreprocessorExitCode pp_parse_pp_tokens(
 * 
 * @param input The input from which to preprocess.
 * @param lexema_pool The pool where lexema are allocated.
-* @param fld The file location descriptor for the input.
+* @param source The file the input is from.
 * @param preprocessing_file Reference to where to store
 *                           the produced preprocessing-file
 * 							preprocessing ast node.
-* @return Returns an exit code describing how the parse went.
+* @return Returns an exit code describing how the parse went,
+*		  failing if a whole line could not be parsed.
 **/
 static inline
 PreprocessorExitCode pp_parse_preprocessing_file(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & preprocessing_file);
 
+/**
+* Used to check that the group of a preprocessing-file
+* ended at the end of the file, rather than at a line
+* that could not be parsed.
+* 
+* @param input Where the group of the file ended.
+* @param source The file the input is from.
+* @param bkl The location to send alerts to.
+* @return Returns an exit code describing how the check
+*         went, failing if a line was left unparsed.
+**/
+static inline
+PreprocessorExitCode pp_check_end_of_file(
+	const char*       const& input,
+	SourceMapFile     const& source,
+	AlertList              & bkl);
+
 /**
 * Used to performing a preprocessing parse on a
 * group.
 * 
 * @param input The input from which to preprocess.
 * @param lexema_pool The pool where lexema are allocated.
-* @param fld The file location descriptor for the input.
+* @param source The file the input is from.
 * @param group Reference to where to store the
 *              produced group preprocessing ast node.
 * @return Returns an exit code describing how the parse went.
@@ -597,17 +640,118 @@ static inline
 PreprocessorExitCode pp_parse_group(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & group);
 
+/**
+* Used to skip over a group without parsing it, as is
+* done for the groups of an if-section until one of
+* them is executed. Only lines starting with '#' or
+* '%:' are looked into, so that the if-sections nested
+* within are passed over whole. Comments and line
+* splices are passed over wherever white-space may be,
+* and within directive names.
+* 
+* @param input The start of the line the group starts
+*              on.
+* @return Returns the start of the line of the #elif,
+*         #else or #endif ending the group, or the NUL
+*         ending the input if there is none.
+**/
+static inline
+const char* pp_skip_group(
+	const char* const& input);
+
+/**
+* Says whether the name of a directive, which is not
+* NUL terminated, is the one given.
+* 
+* @param name The first character of the name.
+* @param length The length of the name.
+* @param directive The directive to compare against.
+* @return Returns true if they are the same.
+**/
+static inline
+bool is_directive_name(
+	const char* const& name,
+	size_t      const& length,
+	const char* const& directive);
+
+/**
+* Used to skip the white-space within a line being
+* skipped: spaces, tabs, comments and line splices.
+* 
+* @param chr The first character to look at.
+* @return Returns the first character which is none of
+*         those, or the new-line or NUL ending the line.
+**/
+static inline
+const char* pp_skip_skipped_line_space(
+	const char* const& chr);
+
+/**
+* Says how many characters the line splice starting at
+* a character takes up, if one does.
+* 
+* @param chr The character to look at.
+* @return Returns 0 if no line splice starts there.
+**/
+static inline
+size_t get_line_splice_length(
+	const char* const& chr);
+
+/**
+* Says whether a line ends in a line splice, and so
+* carries on to the next.
+* 
+* @param line The first character of the line.
+* @param line_end The new-line ending the line.
+* @return Returns true if the line carries on.
+**/
+static inline
+bool is_line_spliced(
+	const char* const& line,
+	const char* const& line_end);
+
+/**
+* Used to find the end of a line being skipped. Block
+* comments opened on the line are skipped whole, as
+* the lines they cover are not the starts of lines,
+* and so are lines joined to it by line splices.
+* 
+* @param line The first character of the line to read.
+* @return Returns the new-line ending the line, or NUL.
+**/
+static inline
+const char* pp_find_skipped_line_end(
+	const char* const& line);
+
+/**
+* Used to skip over the group of an if-section at 
+* parse time, leaving a group that is only parsed if
+* and when it is executed.
+* 
+* @param input The input from which to preprocess.
+* @param source The file the input is from.
+* @param group Reference to where to store the
+*              produced deferred group.
+* @return Returns an exit code describing how the parse 
+*         went, failing if the group is empty.
+**/
+static inline
+PreprocessorExitCode pp_parse_deferred_group(
+	const char*            & input,
+	SourceMapFile     const& source,
+	PreprocessingAstNode*  & group);
+
 /**
 * Used to performing a preprocessing parse on a
 * group-part.
 * 
 * @param input The input from which to preprocess.
 * @param lexema_pool The pool where lexema are allocated.
-* @param fld The file location descriptor for the input.
+* @param source The file the input is from.
 * @param group_part Reference to where to store the
 *                   produced group-part preprocessing
 *                   ast node.
@@ -617,7 +761,7 @@ static inline
 PreprocessorExitCode pp_parse_group_part(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & group_part);
 
@@ -627,7 +771,7 @@ PreprocessorExitCode pp_parse_group_part(
 * 
 * @param input The input from which to preprocess.
 * @param lexema_pool The pool where lexema are allocated.
-* @param fld The file location descriptor for the input.
+* @param source The file the input is from.
 * @param if_section Reference to where to store the
 *                   produced if-section preprocessing
 *                    ast node.
@@ -637,7 +781,7 @@ static inline
 PreprocessorExitCode pp_parse_if_section(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & if_section);
 
@@ -647,7 +791,7 @@ PreprocessorExitCode pp_parse_if_section(
 * 
 * @param input The input from which to preprocess.
 * @param lexema_pool The pool where lexema are allocated.
-* @param fld The file location descriptor for the input.
+* @param source The file the input is from.
 * @param if_group Reference to where to store the
 *                 produced if-group preprocessing
 *                    ast node.
@@ -657,7 +801,7 @@ static inline
 PreprocessorExitCode pp_parse_if_group(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & if_group);
 
@@ -667,7 +811,7 @@ PreprocessorExitCode pp_parse_if_group(
 * 
 * @param input The input from which to preprocess.
 * @param lexema_pool The pool where lexema are allocated.
-* @param fld The file location descriptor for the input.
+* @param source The file the input is from.
 * @param elif_groups Reference to where to store the
 *                    produced elif-groups preprocessing
 *                    ast node.
@@ -677,7 +821,7 @@ static inline
 PreprocessorExitCode pp_parse_elif_groups(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & elif_groups);
 
@@ -687,7 +831,7 @@ PreprocessorExitCode pp_parse_elif_groups(
 * 
 * @param input The input from which to preprocess.
 * @param lexema_pool The pool where lexema are allocated.
-* @param fld The file location descriptor for the input.
+* @param source The file the input is from.
 * @param constant_expression Reference to where to store the
 *                            produced constant-expression 
 *                            preprocessing ast node.
@@ -697,7 +841,7 @@ static inline
 PreprocessorExitCode pp_parse_constant_expression(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & constant_expression);
 
@@ -707,7 +851,7 @@ PreprocessorExitCode pp_parse_constant_expression(
 * 
 * @param input The input from which to preprocess.
 * @param lexema_pool The pool where lexema are allocated.
-* @param fld The file location descriptor for the input.
+* @param source The file the input is from.
 * @param bkl The location to send alerts to.
 * @param elif_group Reference to where to store the
 *                   produced elif-group preprocessing 
@@ -718,7 +862,7 @@ static inline
 PreprocessorExitCode pp_parse_elif_group(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & elif_group);
 
@@ -727,7 +871,7 @@ PreprocessorExitCode pp_parse_elif_group(
 * else-group.
 * @param input The input from which to preprocess.
 * @param lexema_pool The pool where lexema are allocated.
-* @param fld The file location descriptor for the input.
+* @param source The file the input is from.
 * @param bkl The location to send alerts to.
 * @param else_group Reference to where to store the
 *                   produced else-group preprocessing
@@ -738,7 +882,7 @@ static inline
 PreprocessorExitCode pp_parse_else_group(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & else_group);
 
@@ -747,7 +891,7 @@ PreprocessorExitCode pp_parse_else_group(
 * endif-line.
 * @param input The input from which to preprocess.
 * @param lexema_pool The pool where lexema are allocated.
-* @param fld The file location descriptor for the input.
+* @param source The file the input is from.
 * @param bkl The location to send alerts to.
 * @param endif_line Reference to where to store the
 *                   produced endif-line preprocessing
@@ -758,7 +902,7 @@ static inline
 PreprocessorExitCode pp_parse_endif_line(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & endif_line);
 
@@ -767,7 +911,7 @@ PreprocessorExitCode pp_parse_endif_line(
 * control-line.
 * @param input The input from which to preprocess.
 * @param lexema_pool The pool where lexema are allocated.
-* @param fld The file location descriptor for the input.
+* @param source The file the input is from.
 * @param bkl The location to send alerts to.
 * @param control_line Reference to where to store the
 *                     produced control-line preprocessing
@@ -778,7 +922,7 @@ static inline
 PreprocessorExitCode pp_parse_control_line(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & control_line);
 
@@ -787,7 +931,7 @@ PreprocessorExitCode pp_parse_control_line(
 * text-line.
 * @param input The input from which to preprocess.
 * @param lexema_pool The pool where lexema are allocated.
-* @param fld The file location descriptor for the input.
+* @param source The file the input is from.
 * @param bkl The location to send alerts to.
 * @param text_line Reference to where to store the
 *                  produced control-line preprocessing
@@ -798,7 +942,7 @@ static inline
 PreprocessorExitCode pp_parse_text_line(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & text_line);
 
@@ -807,7 +951,7 @@ PreprocessorExitCode pp_parse_text_line(
 * new-line.
 * @param input The input from which to preprocess.
 * @param lexema_pool The pool where lexema are allocated.
-* @param fld The file location descriptor for the input.
+* @param source The file the input is from.
 * @param bkl The location to send alerts to.
 * @param new_line Reference to where to store the
 *                 produced control-line preprocessing
@@ -818,7 +962,7 @@ static inline
 PreprocessorExitCode pp_parse_new_line(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & new_line);
 
@@ -827,7 +971,7 @@ PreprocessorExitCode pp_parse_new_line(
 * non-directive.
 * @param input The input from which to preprocess.
 * @param lexema_pool The pool where lexema are allocated.
-* @param fld The file location descriptor for the input.
+* @param source The file the input is from.
 * @param bkl The location to send alerts to.
 * @param non_directive Reference to where to store the
 *                      produced non-directive preprocessing
@@ -838,7 +982,7 @@ static inline
 PreprocessorExitCode pp_parse_non_directive(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & non_directive);
 
@@ -847,7 +991,7 @@ PreprocessorExitCode pp_parse_non_directive(
 * lparen.
 * @param input The input from which to preprocess.
 * @param lexema_pool The pool where lexema are allocated.
-* @param fld The file location descriptor for the input.
+* @param source The file the input is from.
 * @param bkl The location to send alerts to.
 * @param lparen Reference to where to store the
 *               produced lparenpreprocessing ast node.
@@ -857,7 +1001,7 @@ static inline
 PreprocessorExitCode pp_parse_lparen(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & lparen);
 
@@ -866,7 +1010,7 @@ PreprocessorExitCode pp_parse_lparen(
 * replacement-list.
 * @param input The input from which to preprocess.
 * @param lexema_pool The pool where lexema are allocated.
-* @param fld The file location descriptor for the input.
+* @param source The file the input is from.
 * @param bkl The location to send alerts to.
 * @param replacement_list Reference to where to store the
 *                         produced replacement-list 
@@ -877,76 +1021,21 @@ static inline
 PreprocessorExitCode pp_parse_replacement_list(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & replacement_list);
 
 /**
-* Used to execute directives and invocate macros within
-* a preprocessing-file preprocessing ast node.
-* This will change the contents of this preprocessing-ast
-* so that when preprocessing-tokens are generated from it,
-* the relevant directives etc will have been performed.
-* @param preprocessing_file The preprocessing-file 
-*							preprocessing ast node to 
-*                           execute.
-* @param lexema_pool The pool in which lexema are allocated.
-* @param bkl The location to send alerts to.
-* @return Returns an exit code for how the execution went.
-**/
-static inline
-PreprocessorExitCode pp_execute_preprocessing_file(
-	PreprocessingAstNode* & preprocessing_file,
-	AlertList             & bkl,
-	PreprocessingAstNode* & executed_preprocessing_file);
-
-/**
-* Used to execute directives and invocate macros within
-* a group preprocessing ast node.
-* This will change the contents of this group so that when 
-* preprocessing-tokens are generated from it, the relevant 
-* directives etc will have been performed.
-* @param group The group preprocessing ast node to execute.
-* @param lexema_pool The pool in which lexema are allocated.
-* @param bkl The location to send alerts to.
-* @return Returns an exit code for how the execution went.
-**/
-static inline
-PreprocessorExitCode pp_execute_group(
-	PreprocessingAstNode* & group,
-	AlertList             & bkl,
-	SymbolTable           & symtab,
-	PreprocessingAstNode* & executed_group);
-
-/**
-* Used to execute directives and invocate macros within
-* a group-part preprocessing ast node.
-* This will change the contents of this group-part so that 
-* when preprocessing-tokens are generated from it, the 
-* relevant directives etc will have been performed.
-* 
-* @param group The group preprocessing ast node to execute.
-* @param lexema_pool The pool in which lexema are allocated.
-* @param bkl The location to send alerts to.
-* @return Returns an exit code for how the execution went.
-**/
-static inline
-PreprocessorExitCode pp_execute_group_part(
-	PreprocessingAstNode* & group_part,
-	AlertList             & bkl,
-	SymbolTable           & symtab,
-	PreprocessingAstNode* & executed_group_part);
-
-/**
-* Used to execute directives and invocate macros within
-* a group-part preprocessing ast node.
-* This will change the contents of this group-part so that
-* when preprocessing-tokens are generated from it, the
-* relevant directives etc will have been performed.
+* Used to execute an if-section, by evaluating the
+* conditions of its groups in turn.
 * 
-* @param group The group preprocessing ast node to execute.
-* @param lexema_pool The pool in which lexema are allocated.
+* @param if_section The if-section preprocessing ast
+*                   node to execute.
 * @param bkl The location to send alerts to.
+* @param symtab The symbol table of macros.
+* @param selected_group Set to the deferred group of the
+*                       first condition that holds, or
+*                       NULL if none does or it is empty.
 * @return Returns an exit code for how the execution went.
 **/
 static inline
@@ -954,19 +1043,20 @@ PreprocessorExitCode pp_execute_if_section(
 	PreprocessingAstNode* & if_section,
 	AlertList             & bkl,
 	SymbolTable           & symtab,
-	PreprocessingAstNode* & executed_group_part);
+	PreprocessingAstNode* & selected_group);
 
 /**
-* Used to execute directives and invocate macros within
-* an if-group preprocessing ast node.
-* This will change the contents of this if-group so that
-* when preprocessing-tokens are generated from it, the
-* relevant directives etc will have been performed.
+* Used to execute an if-group, by evaluating its
+* condition.
 * 
 * @param if_group The if-group preprocessing ast node 
 *                 to execute.
-* @param lexema_pool The pool in which lexema are allocated.
 * @param bkl The location to send alerts to.
+* @param symtab The symbol table of macros.
+* @param is_taken Set if the condition holds, so that
+*                 the group is the one selected.
+* @param selected_group Set to the deferred group if
+*                       the condition holds.
 * @return Returns an exit code for how the execution went.
 **/
 static inline
@@ -974,26 +1064,29 @@ PreprocessorExitCode pp_execute_if_group(
 	PreprocessingAstNode* & if_group,
 	AlertList             & bkl,
 	SymbolTable           & symtab,
-	PreprocessingAstNode* & executed_group_part);
+	bool                  & is_taken,
+	PreprocessingAstNode* & selected_group);
 
 /**
-* Used to execute directives and invocate macros within
-* an elif-groups preprocessing ast node.
-* This will change the contents of this elif-groups so that
-* when preprocessing-tokens are generated from it, the
-* relevant directives etc will have been performed.
+* Used to execute elif-groups, by evaluating the
+* condition of each until one holds.
 * 
 * @param elif_groups The elif-groups preprocessing ast node
 *                    to execute.
-* @param lexema_pool The pool in which lexema are allocated.
 * @param bkl The location to send alerts to.
+* @param symtab The symbol table of macros.
+* @param is_taken Whether an earlier group was selected,
+*                 set once one is.
+* @param selected_group Set to the selected deferred group.
 * @return Returns an exit code for how the execution went.
 **/
 static inline
 PreprocessorExitCode pp_execute_elif_groups(
 	PreprocessingAstNode* & elif_groups,
 	AlertList             & bkl,
-	SymbolTable           & symtab);
+	SymbolTable           & symtab,
+	bool                  & is_taken,
+	PreprocessingAstNode* & selected_group);
 
 /**
 * Used to execute directives and invocate macros within
@@ -1015,62 +1108,107 @@ PreprocessorExitCode pp_execute_identifier_list(
 	SymbolTable           & symtab);
 
 /**
-* Used to execute directives and invocate macros within
-* an constant-expression preprocessing ast node.
-* This will change the contents of this identifier-list
-* so that when preprocessing-tokens are generated from it,
-* the relevant directives etc will have been performed.
+* Used to evaluate the constant-expression of an #if
+* or #elif directive, once its macros are expanded.
 * 
 * @param constant_expression The constant-expression 
 *                            preprocessing ast node 
-*							 to execute.
-* @param lexema_pool The pool in which lexema are allocated.
+*							 to evaluate.
 * @param bkl The location to send alerts to.
-* @return Returns an exit code for how the execution went.
+* @param value Set to whether the expression is nonzero.
+* @return Returns an exit code for how the evaluation went.
 **/
 static inline
 PreprocessorExitCode pp_execute_constant_expression(
 	PreprocessingAstNode* & constant_expression,
 	AlertList             & bkl,
-	SymbolTable           & symtab);
+	SymbolTable           & symtab,
+	bool                  & value);
 
 /**
-* Used to execute directives and invocate macros within
-* an elif-group preprocessing ast node.
-* This will change the contents of this elif-group
-* so that when preprocessing-tokens are generated from it,
-* the relevant directives etc will have been performed.
+* Says whether an identifier names a macro, as the
+* lookup a constant-expression's defined asks of.
+* 
+* @param identifier The identifier to look up.
+* @param context The symbol table of macros.
+* @return Returns true if the identifier is a macro.
+**/
+static inline
+bool pp_is_macro_defined(
+	const PreprocessingToken* const& identifier,
+	void*                     const& context);
+
+/**
+* Used to gather the preprocessing-tokens beneath a
+* preprocessing ast node, in order.
+* 
+* @param pp_tokens The preprocessing ast node, or NULL.
+* @param tokens The location to add the tokens to.
+**/
+static inline
+void pp_gather_pp_tokens(
+	const PreprocessingAstNode*         const& pp_tokens,
+	vector<const PreprocessingToken*>        & tokens);
+
+/**
+* Used to replace the object-like macros of a 
+* constant-expression by their replacement lists,
+* leaving the operands of defined as they are.
+* 
+* @param tokens The tokens to expand.
+* @param symtab The symbol table of macros.
+* @param expanding The macros being expanded, which
+*                  are not expanded again within.
+* @param expanded The location to add the result to.
+**/
+static inline
+void pp_expand_constant_expression(
+	vector<const PreprocessingToken*> const& tokens,
+	SymbolTable                            & symtab,
+	vector<uint32_t>                       & expanding,
+	vector<const PreprocessingToken*>      & expanded);
+
+/**
+* Used to execute an elif-group, by evaluating its
+* condition unless an earlier group was selected.
 * 
 * @param elif_group The elif-group preprocessing ast node
 *				    to execute.
-* @param lexema_pool The pool in which lexema are allocated.
 * @param bkl The location to send alerts to.
+* @param symtab The symbol table of macros.
+* @param is_taken Whether an earlier group was selected,
+*                 set once one is.
+* @param selected_group Set to the selected deferred group.
 * @return Returns an exit code for how the execution went.
 **/
 static inline
 PreprocessorExitCode pp_execute_elif_group(
 	PreprocessingAstNode* & elif_group,
 	AlertList             & bkl,
-	SymbolTable           & symtab);
+	SymbolTable           & symtab,
+	bool                  & is_taken,
+	PreprocessingAstNode* & selected_group);
 
 /**
-* Used to execute directives and invocate macros within
-* an else-group preprocessing ast node.
-* This will change the contents of this else-group
-* so that when preprocessing-tokens are generated from it,
-* the relevant directives etc will have been performed.
+* Used to execute an else-group, which is selected
+* unless an earlier group was.
 * 
 * @param else_group The else-group preprocessing ast node
 *				    to execute.
-* @param lexema_pool The pool in which lexema are allocated.
 * @param bkl The location to send alerts to.
+* @param symtab The symbol table of macros.
+* @param is_taken Whether an earlier group was selected,
+*                 set if not.
+* @param selected_group Set to the selected deferred group.
 * @return Returns an exit code for how the execution went.
 **/
 static inline
 PreprocessorExitCode pp_execute_else_group(
 	PreprocessingAstNode* & else_group,
 	AlertList             & bkl,
-	SymbolTable           & symtab);
+	SymbolTable           & symtab,
+	bool                  & is_taken,
+	PreprocessingAstNode* & selected_group);
 
 /**
 * Used to execute directives and invocate macros within
@@ -1092,24 +1230,84 @@ PreprocessorExitCode pp_execute_endif_line(
 	SymbolTable           & symtab);
 
 /**
-* Used to execute directives and invocate macros within
-* a control-line with alternative 1 (CONTROL_LINE_1).
-* This will change the contents of this control-line
-* so that when preprocessing-tokens are generated from it,
-* the relevant directives etc will have been performed.
+* Used to find the file an #include names, as the
+* contents of a string-literal or the text between
+* '<' and '>', expanding any macros first if it is
+* neither.
+* 
+* @param pp_tokens The pp-tokens of the #include.
+* @param sources The files of the compilation.
+* @param symtab The symbol table of macros.
+* @param spelling Set to the name of the file.
+* @param is_angled Set if the name is within '<' '>'.
+* @return Returns true if a name was found.
+**/
+static inline
+bool pp_find_header_name(
+	const PreprocessingAstNode* const& pp_tokens,
+	SourceMap                        & sources,
+	SymbolTable                      & symtab,
+	string                           & spelling,
+	bool                             & is_angled);
+
+/**
+* Used to follow, a group-part at a time, whether all
+* of a preprocessing-file lies within an #ifndef, as a
+* guard against it being included twice, with nothing
+* outside but blank lines.
+* 
+* @param group_part The next group-part of the file.
+* @param has_if_section Whether the file's if-section
+*                       has been seen, set once it is.
+* @param guard Set to the atom of the guard macro.
+* @return Returns false once the file is seen not to
+*         be guarded.
+**/
+static inline
+bool pp_find_include_guard(
+	const PreprocessingAstNode* const& group_part,
+	bool                             & has_if_section,
+	uint32_t                         & guard);
+
+/**
+* Used to copy a preprocessing ast node, and the nodes
+* and preprocessing tokens beneath it, into the active
+* arena. Node values are not copied, so it suits
+* replacement lists but not deferred groups.
+* 
+* @param node The node to copy, or NULL.
+* @return Returns the copy, or NULL.
+**/
+static inline
+PreprocessingAstNode* pp_copy_tree(
+	const PreprocessingAstNode* const& node);
+
+/**
+* Used to execute a control-line with alternative 1
+* (CONTROL_LINE_1), an #include, by finding the file
+* it names and entering it, to be read in its place.
+* A file marked #pragma once, or whose guard macro is
+* defined, is skipped without being read again.
 * 
 * @param control_line The control-line preprocessing 
 *                     ast node to execute.
-* @param lexema_pool The pool in which lexema are allocated.
+* @param sources The files of the compilation.
+* @param includes The files included so far.
 * @param bkl The location to send alerts to.
+* @param symtab The symbol table of macros.
+* @param entered_file Set to the file entered, which is
+*                     to be left once it is read, or
+*                     NULL if it is skipped.
 * @return Returns an exit code for how the execution went.
 **/
 static inline
 PreprocessorExitCode pp_execute_control_line_1(
 	PreprocessingAstNode* & control_line,
-	PreprocessingAstNode* & preprocessing_file,
+	SourceMap             & sources,
+	IncludeTable          & includes,
 	AlertList             & bkl,
-	SymbolTable           & symtab);
+	SymbolTable           & symtab,
+	IncludedFile*         & entered_file);
 
 /**
 * Used to execute directives and invocate macros within
@@ -1253,16 +1451,21 @@ PreprocessorExitCode pp_execute_control_line_8(
 * 
 * @param control_line The control-line preprocessing ast 
 *                     node to execute.
-* @param lexema_pool The pool in which lexema are allocated.
+* @param sources The files of the compilation.
+* @param includes The files included so far.
 * @param bkl The location to send alerts to.
+* @param entered_file Set to the file an #include
+*                     enters, or NULL.
 * @return Returns an exit code for how the execution went.
 **/
 static inline
 PreprocessorExitCode pp_execute_control_line(
 	PreprocessingAstNode* & control_line,
-	PreprocessingAstNode* & group_part,
+	SourceMap             & sources,
+	IncludeTable          & includes,
 	AlertList             & bkl,
-	SymbolTable           & symtab);
+	SymbolTable           & symtab,
+	IncludedFile*         & entered_file);
 
 /**
 * Used to execute directives and invocate macros 
@@ -1388,172 +1591,104 @@ PreprocessorExitCode pp_execute_pp_tokens(
 	SymbolTable           & symtab);
 
 /**
-* Generates a list of preprocessing tokens from
-* a given preprocessing-file.
-* Essentially 'flattens' the tree.
-* Useful as it allows you to convert back to 
-* preprocessing-tokens after performing directive
-* executions and macro invocations.
-* 
-* @param preprocessing_file The preprocessing-file
-*						    from which to generate
-*							preprocessing-tokens.
-* @param output The location to place the preprocessing
-*               tokens into.
-* @param bkl The location to send alerts to.
-* @param symtab The symbol table to use to detect macros etc.
-* @return Returns an exit code for how the generation went.
-**/
-static inline
-PreprocessorExitCode pp_gen_preprocessing_file(
-	PreprocessingAstNode* const& preprocessing_file,
-	PreprocessingToken*        & output,
-	AlertList                  & bkl,
-	SymbolTable                & symtab);
-
-/**
-* Generates a list of preprocessing tokens from
-* a given group.
-* Essentially 'flattens' the tree.
-* Useful as it allows you to convert back to
-* preprocessing-tokens after performing directive
-* executions and macro invocations.
-* 
-* @param group The group from which to generate
-*			   preprocessing-tokens.
-* @param output The location to place the preprocessing
-*               tokens into.
-* @param bkl The location to send alerts to.
-* @param symtab The symbol table to use to detect macros etc.
-* @return Returns an exit code for how the generation went.
-**/
-static inline
-PreprocessorExitCode pp_gen_group(
-	PreprocessingAstNode* const& group,
-	PreprocessingToken*        & output,
-	AlertList                  & bkl,
-	SymbolTable                & symtab);
-
-/**
-* Generates a list of preprocessing tokens from
-* a given group-part.
-* Essentially 'flattens' the tree.
-* Useful as it allows you to convert back to
-* preprocessing-tokens after performing directive
-* executions and macro invocations.
-* 
-* @param group_part The group-part from which to generate
-*			   preprocessing-tokens.
-* @param output The location to place the preprocessing
-*               tokens into.
-* @param bkl The location to send alerts to.
-* @param symtab The symbol table to use to detect macros etc.
-* @return Returns an exit code for how the generation went.
-**/
-static inline
-PreprocessorExitCode pp_gen_group_part(
-	PreprocessingAstNode* const& group_part,
-	PreprocessingToken*        & output,
-	AlertList                  & bkl,
-	SymbolTable                & symtab);
-
-/**
-* Generates a list of preprocessing tokens from
-* a given text-line preprocessing ast node.
-* Essentially 'flattens' the tree.
-* Useful as it allows you to convert back to
-* preprocessing-tokens after performing directive
-* executions and macro invocations.
-* 
-* @param text_line The text-line from which to 
-*                  generate preprocessing-tokens.
-* @param output The location to place the 
-*               preprocessing tokens into.
-* @param bkl The location to send alerts to.
-* @param symtab The symbol table to use to detect
-*               macros etc.
-* @return Returns an exit code for how the 
-*         generation went.
+* A file, or a group of an if-section, which the
+* preprocessor is part way through reading.
 **/
-static inline
-PreprocessorExitCode pp_gen_text_line(
-	PreprocessingAstNode* const& text_line,
-	PreprocessingToken*        & output,
-	AlertList                  & bkl,
-	SymbolTable                & symtab);
+struct PreprocessorFrame {
+	const char*          input;
+	const SourceMapFile* source;
+	/* The file an #include entered, to be left at its
+	   end, or NULL for the main file and for groups. */
+	IncludedFile*        file;
+	bool                 is_group;
+	/* Whether the file may yet lie wholly within the
+	   #ifndef of the macro with atom guard.         */
+	bool                 is_guarded;
+	bool                 has_if_section;
+	uint32_t             guard;
+};
 
 /**
-* Generates a list of preprocessing tokens from
-* a given non-directive ast node.
-* Essentially 'flattens' the tree.
-* Useful as it allows you to convert back to
-* preprocessing-tokens after performing directive
-* executions and macro invocations.
-* 
-* @param non_directive The non-directive from 
-*                      which to generate 
-*                      preprocessing-tokens.
-* @param output The location to place the 
-*               preprocessing tokens into.
-* @param bkl The location to send alerts to.
-* @param symtab The symbol table to use to 
-*               detect macros etc.
-* @return Returns an exit code for how the 
-*         generation went.
+* Preprocesses input a group-part at a time, as its
+* preprocessing tokens are asked for, into a ring.
 **/
-static inline
-PreprocessorExitCode pp_gen_non_directive(
-	PreprocessingAstNode* const& preprocessing_file,
-	PreprocessingToken*        & output,
-	AlertList                  & bkl,
-	SymbolTable                & symtab);
+class PreprocessorStream {
+private:
+	LexemaPool*                       lexema_pool;
+	SourceMap*                        sources;
+	IncludeTable*                     includes;
+	AlertList*                        bkl;
+	SymbolTable                       symtab;
+	/* The files and groups being read, innermost last. */
+	vector<PreprocessorFrame>         frames;
+	/* The group-part being read, freed before the next. */
+	Arena                             line_arena;
+	vector<const PreprocessingToken*> line_tokens;
+	size_t                            next_line_token;
+	size_t                            num_pp_tokens;
+	PreprocessorExitCode              exitcode;
+
+	inline void push_frame(
+		const char*          const& input,
+		const SourceMapFile* const& source,
+		IncludedFile*        const& file,
+		bool                 const& is_group);
+
+	inline void pop_frame(
+		const char* const& input);
+
+	inline void step();
+
+	inline void execute_group_part(
+		PreprocessingAstNode* const& group_part);
+
+	inline void fail();
+
+	inline void leave_frames();
 
-/**
-* Generates a list of preprocessing tokens from
-* a given pp-tokens ast node.
-* Essentially 'flattens' the tree.
-* Useful as it allows you to convert back to
-* preprocessing-tokens after performing directive
-* executions and macro invocations.
-* 
-* @param pp_tokens The pp-tokens from which to generate
-*                  preprocessing-tokens.
-* @param output The location to place the preprocessing
-*               tokens into.
-* @param bkl The location to send alerts to.
-* @param symtab The symbol table to use to detect macros etc.
-* @return Returns an exit code for how the generation went.
-**/
-static inline
-PreprocessorExitCode pp_gen_pp_tokens(
-	PreprocessingAstNode* const& pp_tokens,
-	PreprocessingToken*        & output,
-	AlertList                  & bkl,
-	SymbolTable                & symtab);
+public:
+	/**
+	* @param input The input from which to preprocess.
+	* @param lexema_pool The pool where lexema will be allocated. 
+	* @param filename The input file name.
+	* @param sources The files of the compilation, to
+	*		 which the input is added.
+	* @param includes The files included so far.
+	* @param bkl The location to send alerts to.
+	**/
+	inline PreprocessorStream(
+		const char*  const& input,
+		LexemaPool        & lexema_pool,
+		const char*  const& filename,
+		SourceMap         & sources,
+		IncludeTable      & includes,
+		AlertList         & bkl);
+
+	PreprocessorStream(const PreprocessorStream&) = delete;
+	PreprocessorStream& operator=(const PreprocessorStream&) = delete;
+
+	inline ~PreprocessorStream();
+
+	/**
+	* Preprocesses until the ring is full or the input
+	* has ended.
+	*
+	* @param ring The ring to add preprocessing tokens to.
+	* @return Returns false once nothing is left to add.
+	**/
+	inline bool fill(
+		PreprocessingTokenRing& ring);
+
+	inline PreprocessorExitCode get_exitcode() const
+	{
+		return exitcode;
+	}
 
-/**
-* Generates a list of preprocessing tokens from
-* a given preprocessing-token ast node.
-* Essentially 'flattens' the tree.
-* Useful as it allows you to convert back to
-* preprocessing-tokens after performing directive
-* executions and macro invocations.
-* 
-* @param preprocessing_token The preprocessing-token from 
-*                            which to generate 
-*							 preprocessing-tokens.
-* @param output The location to place the preprocessing
-*               tokens into.
-* @param bkl The location to send alerts to.
-* @param symtab The symbol table to use to detect macros etc.
-* @return Returns an exit code for how the generation went.
-**/
-static inline
-PreprocessorExitCode pp_gen_preprocessing_token(
-	PreprocessingAstNode* const& preprocessing_token,
-	PreprocessingToken*        & output,
-	AlertList                  & bkl,
-	SymbolTable                & symtab);
+	inline size_t get_num_pp_tokens() const
+	{
+		return num_pp_tokens;
+	}
+};
 
 /**
 * Used to preprocess input.
@@ -1561,16 +1696,21 @@ PreprocessorExitCode pp_gen_preprocessing_token(
 * @param input The input from which to preprocess.
 * @param lexema_pool The pool where lexema will be allocated. 
 * @param filename The input file name.
+* @param sources The files of the compilation, to
+*		 which the input is added.
+* @param includes The files included so far.
 * @param bkl The location to send alerts to.
 * @return An exitcode describing how preprocessing went.
 **/
 static inline
 PreprocessorExitCode preprocess(
-	const char*              & input,
-	LexemaPool               & lexema_pool,
-	const char*         const& filename,
-	AlertList                & bkl,
-	PreprocessingToken*      & output);
+	const char*                & input,
+	LexemaPool                 & lexema_pool,
+	const char*           const& filename,
+	SourceMap                  & sources,
+	IncludeTable               & includes,
+	AlertList                  & bkl,
+	PreprocessingTokenAppender & output);
 
 /*****************************************************//**
 *                         Definitions                    *
@@ -1594,40 +1734,22 @@ PreprocessingAstNode* construct_node_from_children(
 	return node;
 }
 
-static inline
-const char* construct_lexeme(
-	const char* const& lexeme_start,
-	const char* const& lexeme_end)
-{
-	char* lexeme = new char[lexeme_end - lexeme_start + 1];
-	for (int i = 0; 
-		 i < lexeme_end - lexeme_start + 1; 
-		 i++) {
-		*(lexeme + i) = *(lexeme_start + i);
-	}
-	*(lexeme + (lexeme_end - lexeme_start)) = NULL;
-	return lexeme;
-}
-
 static inline void ensure_lexeme_substring_in_pool(
 	LexemaPool       & lexema_pool,
 	const char* const& lexeme_start,
 	const char* const& lexeme_end)
 {
-	const char* lexeme
-		= construct_lexeme(lexeme_start, lexeme_end);
-	if (lookup_lexeme_in_pool(lexema_pool, lexeme)) {
-		delete lexeme;
-	} else {
-		insert_lexeme_into_pool(lexema_pool, lexeme);
-	}
+	intern_lexeme(
+		lexema_pool,
+		lexeme_start,
+		lexeme_end - lexeme_start);
 }
 
 static inline
 PreprocessorExitCode pp_lex_header_name(
 	const char*            & input, 
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & fld,
+	SourceMapFile     const& source,
 	PreprocessingToken*    & header_name)
 {
 	enum PreprocessingState {
@@ -1714,33 +1836,22 @@ PreprocessorExitCode pp_lex_header_name(
 			case END_SUCCESS:
 			{
 				const char* lexeme
-					= construct_lexeme(
-						  input, 
-						  chr);
-
-				LexemaEntry* e
-					= lookup_lexeme_in_pool(
+					= intern_lexeme(
 						lexema_pool,
-						lexeme);
-					if (e) {
-						delete lexeme;
-						lexeme = e->lexeme;
-					} else {
-						insert_lexeme_into_pool(lexema_pool, lexeme);
-					}
+						input,
+						chr - input);
 
 				preprocessor_report_success(
 					"preprocess_header_name",
 					form,
 					lexeme);
 
-				fld.lexeme_length = chr - input;
 				*header_name = PreprocessingToken(
 					lexeme,
 					PreprocessingTokenName::HEADER_NAME,
-					fld,
-					form);
-				fld.character_number += (chr - input);
+					locate_in_source_file(source, input),
+					form,
+					get_lexeme_atom(lexeme));
 
 				exitcode = PreprocessorExitCode::SUCCESS;
 				conclusive = true;
@@ -1763,12 +1874,12 @@ PreprocessorExitCode pp_lex_header_name(
 					form,
 					lexeme);
 
-				fld.lexeme_length = chr - input;
 				*header_name = PreprocessingToken(
 					lexeme,
 					PreprocessingTokenName::ERROR,
-					fld,
-					form);
+					locate_in_source_file(source, input),
+					form,
+					0);
 				const char* const err_msg 
 					= "This header name could not be recognised. "
 					  "Did you mispell it?";
@@ -1776,8 +1887,8 @@ PreprocessorExitCode pp_lex_header_name(
 					= construct_error_book(
 						ErrorCode::ERR_PP_INVALID_HEADER,
 						err_msg,
-						fld);
-				fld.character_number += (chr - input);
+						locate_in_source_file(source, input),
+						(unsigned int) (chr - input));
 
 				exitcode = PreprocessorExitCode::FAILURE;
 				conclusive = true;
@@ -1792,7 +1903,7 @@ static inline
 PreprocessorExitCode pp_lex_identifier_name(
 	const char*            & input, 
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & fld,
+	SourceMapFile     const& source,
 	PreprocessingToken*    & identifier_name,
 	AlertList              & bkl)
 {
@@ -1801,182 +1912,72 @@ PreprocessorExitCode pp_lex_identifier_name(
 
 	const char* lexeme_start = input;
 
-	enum PreprocessingState {
-		START,
-
-		IDENTIFIER,
-		IDENTIFIER_NONDIGIT,
-
-		END_FAIL,
-		END_SUCCESS
-	};
-
-	PreprocessingState state
-		= PreprocessingState::START;
-
 	PreprocessingTokenForm form
 		= PreprocessingTokenForm::UNDEFINED;
 
 	bool preprocessed_identifier = false;
 
-	while (true) {
+	if ((*input >= 'a' && *input <= 'z')
+		|| (*input >= 'A' && *input <= 'Z')
+		|| *input == '_') {
+		/* The rest of the identifier is found in one scan,
+		   its form then following from how it ends.      */
+		input = skip_char_class(
+			input + 1,
+			CharClass::IDENTIFIER);
+		const char last = *(input - 1);
+		form = input - lexeme_start == 1
+			   ? PreprocessingTokenForm::IDENTIFIER_1
+			   : last >= '0' && last <= '9'
+			   ? PreprocessingTokenForm::IDENTIFIER_3
+			   : PreprocessingTokenForm::IDENTIFIER_2;
+		preprocessed_identifier = true;
+	}
 
-		switch (state) {
+	if (preprocessed_identifier) {
 
-			case START:
+		const char* lexeme
+			= intern_lexeme(
+				lexema_pool,
+				lexeme_start,
+				input - lexeme_start);
 
-				switch (*input) {
+		preprocessor_report_success(
+			"preprocess_identifier_name",
+			form,
+			lexeme);
 
-					case '_':
-
-					case 'a': case 'b': case 'c':
-					case 'd': case 'e': case 'f':
-					case 'g': case 'h': case 'i':
-					case 'j': case 'k': case 'l':
-					case 'm': case 'n': case 'o':
-					case 'p': case 'q': case 'r':
-					case 's': case 't': case 'u':
-					case 'v': case 'w': case 'x':
-					case 'y': case 'z':
-					
-					case 'A': case 'B': case 'C':
-					case 'D': case 'E': case 'F':
-					case 'G': case 'H': case 'I':
-					case 'J': case 'K': case 'L':
-					case 'M': case 'N': case 'O':
-					case 'P': case 'Q': case 'R':
-					case 'S': case 'T': case 'U':
-					case 'V': case 'W': case 'X':
-					case 'Y': case 'Z':
-						input++;
-						form = PreprocessingTokenForm::IDENTIFIER_1;
-						state = IDENTIFIER_NONDIGIT;
-						continue;
-
-					default:
-						break;
-				}
-				preprocessed_identifier = false;
-				break;
-
-			case IDENTIFIER_NONDIGIT:
-
-				switch (*input) {
-
-					case '_':
-
-					case 'a': case 'b': case 'c':
-					case 'd': case 'e': case 'f':
-					case 'g': case 'h': case 'i':
-					case 'j': case 'k': case 'l':
-					case 'm': case 'n': case 'o':
-					case 'p': case 'q': case 'r':
-					case 's': case 't': case 'u':
-					case 'v': case 'w': case 'x':
-					case 'y': case 'z':
-
-					case 'A': case 'B': case 'C':
-					case 'D': case 'E': case 'F':
-					case 'G': case 'H': case 'I':
-					case 'J': case 'K': case 'L':
-					case 'M': case 'N': case 'O':
-					case 'P': case 'Q': case 'R':
-					case 'S': case 'T': case 'U':
-					case 'V': case 'W': case 'X':
-					case 'Y': case 'Z':
-						form = PreprocessingTokenForm::IDENTIFIER_2;
-						input++;
-						continue;
-
-					case '1': case '2': case '3':
-					case '4': case '5': case '6':
-					case '7': case '8': case '9':
-					case '0':
-						// TODO: UNIVERSAL-CHARACTER-NAME
-						form = PreprocessingTokenForm::IDENTIFIER_3;
-						input++;
-						continue;
-
-					default: 
-						break;
-
-				}
-				preprocessed_identifier = true;
-				break;
-
-			default:
-				break;
-
-		}
-		break;
-	}
-
-	if (preprocessed_identifier) {
-
-		const char* lexeme
-			= construct_lexeme(
-				lexeme_start,
-				input);
-
-		LexemaEntry* e
-			= lookup_lexeme_in_pool(
-				lexema_pool,
-				lexeme);
-		if (e) {
-			delete lexeme;
-			lexeme = e->lexeme;
-		} else {
-			insert_lexeme_into_pool(lexema_pool, lexeme);
-		}
-
-		preprocessor_report_success(
-			"preprocess_identifier_name",
-			form,
-			lexeme);
-
-		fld.lexeme_length 
-			= input - lexeme_start;
 
 		*identifier_name 
 			= PreprocessingToken(
 			      lexeme,
 				  PreprocessingTokenName::IDENTIFIER,
-				  fld,
-				  form);
+				  locate_in_source_file(source, lexeme_start),
+				  form,
+				  get_lexeme_atom(lexeme),
+				  classify_identifier(lexeme));
 
-		fld.character_number 
-			+= (input - lexeme_start);
 
 
 		exitcode = PreprocessorExitCode::SUCCESS;
 	} else {
 		const char* lexeme
-			= construct_lexeme(
-				lexeme_start, 
-				input);
-
-		LexemaEntry* e
-			= lookup_lexeme_in_pool(
+			= intern_lexeme(
 				lexema_pool,
-				lexeme);
-		if (e) {
-			delete lexeme;
-			lexeme = e->lexeme;
-		} else {
-			insert_lexeme_into_pool(lexema_pool, lexeme);
-		}
+				lexeme_start,
+				input - lexeme_start);
 
 		preprocessor_report_failure(
 			"preprocess_identifier_name",
 			form,
 			lexeme);
 
-		fld.lexeme_length = input - lexeme_start;
 		*identifier_name = PreprocessingToken(
 			lexeme,
 			PreprocessingTokenName::ERROR,
-			fld,
-			form);
+			locate_in_source_file(source, lexeme_start),
+			form,
+			get_lexeme_atom(lexeme));
 		const char* const err_msg
 			= "This identifier could not be recognised. "
 			  "Did you mispell it?";
@@ -1984,8 +1985,8 @@ PreprocessorExitCode pp_lex_identifier_name(
 			= construct_error_book(
 				ErrorCode::ERR_PP_INVALID_IDENTIFIER,
 				err_msg,
-				fld);
-		fld.character_number += (input - lexeme_start);
+				locate_in_source_file(source, lexeme_start),
+				(unsigned int) (input - lexeme_start));
 
 		exitcode = PreprocessorExitCode::FAILURE;
 	}
@@ -1996,7 +1997,7 @@ static inline
 PreprocessorExitCode pp_lex_pp_number(
 	const char*            & input, 
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & fld,
+	SourceMapFile     const& source,
 	PreprocessingToken*    & pp_number,
 	AlertList              & bkl)
 {
@@ -2054,7 +2055,9 @@ PreprocessorExitCode pp_lex_pp_number(
 					case '7': case '8': case '9':
 					case '0':
 						form = PreprocessingTokenForm::PP_NUMBER_3;
-						input++;
+						input = skip_char_class(
+							input,
+							CharClass::DECIMAL_DIGIT);
 						continue;
 
 					case '_':
@@ -2070,7 +2073,7 @@ PreprocessorExitCode pp_lex_pp_number(
 					case 'A': case 'B': case 'C':
 					case 'D': case 'F':
 					case 'G': case 'H': case 'I':
-					case 'J': case 'K':
+					case 'J': case 'K': case 'L':
 					case 'M': case 'N': case 'O':
 					case 'Q': case 'R':
 					case 'S': case 'T': case 'U':
@@ -2131,35 +2134,23 @@ PreprocessorExitCode pp_lex_pp_number(
 			case END_SUCCESS:
 			{
 				const char* lexeme
-					= construct_lexeme(
-						lexeme_start,
-						input);
-
-				LexemaEntry* e
-					= lookup_lexeme_in_pool(
+					= intern_lexeme(
 						lexema_pool,
-						lexeme);
-				if (e) {
-					delete lexeme;
-					lexeme = e->lexeme;
-				} else {
-					insert_lexeme_into_pool(lexema_pool, lexeme);
-				}
+						lexeme_start,
+						input - lexeme_start);
 
 				preprocessor_report_success(
 					"preprocess_pp_number",
 					form,
 					lexeme);
 
-				fld.lexeme_length 
-					= input - lexeme_start;
 				*pp_number = PreprocessingToken(
 					lexeme,
 					PreprocessingTokenName::PP_NUMBER,
-					fld,
-					form);
-				fld.character_number 
-					+= (input - lexeme_start);
+					locate_in_source_file(source, lexeme_start),
+					form,
+					get_lexeme_atom(lexeme),
+					classify_constant(lexeme));
 
 				exitcode = PreprocessorExitCode::SUCCESS;
 				conclusive = true;
@@ -2171,41 +2162,29 @@ PreprocessorExitCode pp_lex_pp_number(
 			{
 
 				const char* lexeme
-					= construct_lexeme(
-						lexeme_start,
-						input);
-
-				LexemaEntry* e
-					= lookup_lexeme_in_pool(
+					= intern_lexeme(
 						lexema_pool,
-						lexeme);
-				if (e) {
-					delete lexeme;
-					lexeme = e->lexeme;
-				} else {
-					insert_lexeme_into_pool(lexema_pool, lexeme);
-				}
+						lexeme_start,
+						input - lexeme_start);
 
 				preprocessor_report_failure(
 					"preprocess_pp_number",
 					form,
 					lexeme);
 
-				fld.lexeme_length  
-					= input - lexeme_start;
 				*pp_number 
 					= PreprocessingToken(
 					      lexeme,
 						  PreprocessingTokenName::ERROR,
-						  fld,
-						form);
+						  locate_in_source_file(source, lexeme_start),
+						form,
+						get_lexeme_atom(lexeme));
 				Error* error
 					= construct_error_book(
 						ErrorCode::ERR_PP_INVALID_PP_NUMBER,
 						"This number could not be recognised. Did you mispell it?",
-						fld);
-				fld.character_number 
-					+= (input - lexeme_start);
+						locate_in_source_file(source, lexeme_start),
+						(unsigned int) (input - lexeme_start));
 
 				exitcode = PreprocessorExitCode::FAILURE;
 				conclusive = true;
@@ -2225,7 +2204,7 @@ static inline
 PreprocessorExitCode pp_lex_character_constant(
 	const char*            & input, 
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & fld,
+	SourceMapFile     const& source,
 	PreprocessingToken*    & character_constant,
 	AlertList              & bkl)
 {
@@ -2333,20 +2312,10 @@ PreprocessorExitCode pp_lex_character_constant(
 	if (found_preprocess) {
 
 		const char* lexeme
-			= construct_lexeme(
-				lexeme_start,
-				input);
-
-		LexemaEntry* e
-			= lookup_lexeme_in_pool(
+			= intern_lexeme(
 				lexema_pool,
-				lexeme);
-		if (e) {
-			delete lexeme;
-			lexeme = e->lexeme;
-		} else {
-			insert_lexeme_into_pool(lexema_pool, lexeme);
-		}
+				lexeme_start,
+				input - lexeme_start);
 
 		PreprocessingTokenForm form
 			= encountered_l
@@ -2358,57 +2327,43 @@ PreprocessorExitCode pp_lex_character_constant(
 			form,
 			lexeme);
 
-		fld.lexeme_length 
-			= input - lexeme_start;
 		*character_constant
 			= PreprocessingToken(
 			      lexeme,
 			      PreprocessingTokenName::CHARACTER_CONSTANT,
-			      fld,
-			      form);
-		fld.character_number 
-			+= (input - lexeme_start);
+			      locate_in_source_file(source, lexeme_start),
+			      form,
+			      get_lexeme_atom(lexeme),
+			      classify_constant(lexeme));
 
 		exitcode = PreprocessorExitCode::SUCCESS;
 
 	} else {
 
 		const char* lexeme
-			= construct_lexeme(
-				lexeme_start,
-				input);
-
-		LexemaEntry* e
-			= lookup_lexeme_in_pool(
+			= intern_lexeme(
 				lexema_pool,
-				lexeme);
-		if (e) {
-			delete lexeme;
-			lexeme = e->lexeme;
-		} else {
-			insert_lexeme_into_pool(lexema_pool, lexeme);
-		}
+				lexeme_start,
+				input - lexeme_start);
 		 
 		preprocessor_report_failure(
 			"preprocess_pp_number",
 			PreprocessingTokenForm::UNDEFINED,
 			lexeme);
 
-		fld.lexeme_length 
-			= input - lexeme_start;
 		*character_constant
 			= PreprocessingToken(
 			      lexeme,
 			      PreprocessingTokenName::ERROR,
-			      fld,
-			      PreprocessingTokenForm::UNDEFINED);
+			      locate_in_source_file(source, lexeme_start),
+			      PreprocessingTokenForm::UNDEFINED,
+			      get_lexeme_atom(lexeme));
 		Error* error
 			= construct_error_book(
 				ErrorCode::ERR_PP_INVALID_CONSTANT,
 				"This header name could not be recognised. Did you mispell it?",
-				fld);
-		fld.character_number 
-			+= (input - lexeme_start);
+				locate_in_source_file(source, lexeme_start),
+				(unsigned int) (input - lexeme_start));
 
 		exitcode = PreprocessorExitCode::FAILURE;
 	}
@@ -2419,7 +2374,7 @@ static inline
 PreprocessorExitCode pp_lex_string_literal(
 	const char*            & input, 
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & fld,
+	SourceMapFile     const& source,
 	PreprocessingToken*    & string_literal,
 	AlertList              & bkl)
 {
@@ -2522,20 +2477,10 @@ PreprocessorExitCode pp_lex_string_literal(
 	if (found_preprocess) {
 
 		const char* lexeme
-			= construct_lexeme(
-				lexeme_start,
-				input);
-
-		LexemaEntry* e
-			= lookup_lexeme_in_pool(
+			= intern_lexeme(
 				lexema_pool,
-				lexeme);
-		if (e) {
-			delete lexeme;
-			lexeme = e->lexeme;
-		} else {
-			insert_lexeme_into_pool(lexema_pool, lexeme);
-		}
+				lexeme_start,
+				input - lexeme_start);
 
 		PreprocessingTokenForm form
 			= encountered_l
@@ -2547,56 +2492,41 @@ PreprocessorExitCode pp_lex_string_literal(
 			form,
 			lexeme);
 
-		fld.lexeme_length 
-			= input 
-			  - lexeme_start;
 		*string_literal = PreprocessingToken(
 			lexeme,
 			PreprocessingTokenName::STRING_LITERAL,
-			fld,
-			form);
-		fld.character_number 
-			+= (input - lexeme_start);
+			locate_in_source_file(source, lexeme_start),
+			form,
+			get_lexeme_atom(lexeme),
+			classify_string_literal());
 
 		exitcode = PreprocessorExitCode::SUCCESS;
 
 	} else {
 
 		const char* lexeme
-			= construct_lexeme(
-				lexeme_start,
-				input);
-
-		LexemaEntry* e
-			= lookup_lexeme_in_pool(
+			= intern_lexeme(
 				lexema_pool,
-				lexeme);
-		if (e) {
-			delete lexeme;
-			lexeme = e->lexeme;
-		} else {
-			insert_lexeme_into_pool(lexema_pool, lexeme);
-		}
+				lexeme_start,
+				input - lexeme_start);
 
 		preprocessor_report_failure(
 			"preprocess_pp_number",
 			PreprocessingTokenForm::UNDEFINED,
 			lexeme);
 
-		fld.lexeme_length 
-			= input - lexeme_start;
 		*string_literal = PreprocessingToken(
 			lexeme,
 			PreprocessingTokenName::ERROR,
-			fld,
-			PreprocessingTokenForm::UNDEFINED);
+			locate_in_source_file(source, lexeme_start),
+			PreprocessingTokenForm::UNDEFINED,
+			get_lexeme_atom(lexeme));
 		Error* error
 			= construct_error_book(
 				ErrorCode::ERR_PP_INVALID_STRING_LITERAL,
 				"This string literal could not be recognised. Did you mispell it?",
-				fld);
-		fld.character_number 
-			+= (input - lexeme_start);
+				locate_in_source_file(source, lexeme_start),
+				(unsigned int) (input - lexeme_start));
 
 		exitcode = PreprocessorExitCode::FAILURE;
 	}
@@ -2607,7 +2537,7 @@ static inline
 PreprocessorExitCode pp_lex_punctuator(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & fld,
+	SourceMapFile     const& source,
 	PreprocessingToken*    & punctuator,
 	AlertList              & bkl)
 {
@@ -2623,386 +2553,57 @@ PreprocessorExitCode pp_lex_punctuator(
 	const char* lexeme_start 
 		= input;
 
-	switch (*input++) {
-		
-		case '[':
-			form = PreprocessingTokenForm::OPEN_BRACKET;
-			found_punctuator = true;
-			break;
-
-		case ']':
-			form = PreprocessingTokenForm::CLOSE_BRACKET;
-			found_punctuator = true;
-			break;
-
-		case '(':
-			form = PreprocessingTokenForm::OPEN_PAREN;
-			found_punctuator = true;
-			break;
-
-		case ')':
-			form = PreprocessingTokenForm::CLOSE_PAREN;
-			found_punctuator = true;
-			break;
-
-		case '{':
-			form = PreprocessingTokenForm::OPEN_CURLY_BRACKET;
-			found_punctuator = true;
-			break;
-
-		case '}':
-			form = PreprocessingTokenForm::CLOSE_CURLY_BRACKET;
-			found_punctuator = true;
-			break;
-
-		case '.':
-			if (*input == '.' 
-				&& *(input + 1) == '.') {
-				input += 2;
-				form = PreprocessingTokenForm::TRIPLE_DOT;
-				found_punctuator = true;
-
-			} else {
-				form = PreprocessingTokenForm::DOT;
-				found_punctuator = true;
-			} 
-			break;
-
-		case '&':
-			if (*input == '&') {
-				input++;
-				form = PreprocessingTokenForm::DOUBLE_AMPERSAND;
-				found_punctuator = true;
-				
-			} else if (*input == '=') {
-				input++;
-				form = PreprocessingTokenForm::AMPERSAND_EQUAL;
-				found_punctuator = true;
-
-			} else {
-				form = PreprocessingTokenForm::AMPERSAND;
-				found_punctuator = true;
-				break;
-			}
-			break;
-
-		case '*':
-			if (*input == '=') {
-				input++;
-				form = PreprocessingTokenForm::MULTIPLY_EQUAL;
-				found_punctuator = true;
-
-			} else {
-				form = PreprocessingTokenForm::ASTERIX;
-				found_punctuator = true;
-			}
-			break;
-
-		case '+':
-			if (*input == '+') {
-				input++;
-				form = PreprocessingTokenForm::INCREMENT;
-				found_punctuator = true;
-
-			} else if (*input == '=') {
-				input++;
-				form = PreprocessingTokenForm::PLUS_EQUALS;
-				found_punctuator = true;
-
-			} else {
-				form = PreprocessingTokenForm::PLUS;
-				found_punctuator = true;
-			} 
-			break;
-
-		case '-':
-			if (*input == '-') {
-				input++;
-				form = PreprocessingTokenForm::DECREMENT;
-				found_punctuator = true;
-
-			} else if (*input == '>') {
-				input++;
-				form = PreprocessingTokenForm::RIGHT_ARROW;
-				found_punctuator = true;
-
-			} else if (*input == '=') {
-				input++;
-				form = PreprocessingTokenForm::MINUS_EQUALS;
-				found_punctuator = true;
-
-			} else {
-				form = PreprocessingTokenForm::MINUS;
-				found_punctuator = true;
-			} 
-			break;
-
-		case '~':
-			form = PreprocessingTokenForm::TILDE;
-			found_punctuator = true;
-			break;
-
-		case '!':
-			if (*input == '=') {
-				input++;
-				form = PreprocessingTokenForm::NOT_EQUAL;
-				found_punctuator = true;
-
-			} else {
-				form = PreprocessingTokenForm::EXCLAMATION_MARK;
-				found_punctuator = true;
-			}
-			break;
-
-		case '/':
-			if (*input == '=') {
-				input++;
-				form = PreprocessingTokenForm::DIVIDE_EQUALS;
-				found_punctuator = true;
-
-			} else {
-				form = PreprocessingTokenForm::FORWARD_SLASH;
-				found_punctuator = true;
-			}
-			break;
-
-		case '#':
-			if (*input == '#') {
-				input++;
-				form = PreprocessingTokenForm::DOUBLE_HASHTAG;
-				found_punctuator = true;
-
-			} else {
-				form = PreprocessingTokenForm::HASHTAG;
-				found_punctuator = true;
-			}
-			break;
-
-		case '%':
-			if (*input == '>' ) {
-				input++;
-				form = PreprocessingTokenForm::BIGRAPH_CLOSE_CURLY_BRACKET;
-				found_punctuator = true;
-
-			} else if (*input == '=') {
-				input++;
-				form = PreprocessingTokenForm::MODULO_EQUALS;
-				found_punctuator = true;
-
-			} else if (*input == ':') {
-				input++;
-				if (*input == '%'
-					&& *(input + 1) == ':') {
-					input += 2;
-					form = PreprocessingTokenForm::BIGRAPH_DOUBLE_HASHTAG;
-					found_punctuator = true;
-
-				} else {
-					form = PreprocessingTokenForm::BIGRAPH_HASHTAG;
-					found_punctuator = true;
-				}
-
-			} else {
-				form = PreprocessingTokenForm::MODULO;
-				found_punctuator = true;
-			}
-			break;
-
-		case '<':
-			if (*input == '<') {
-				input++;
-				if (*input == '=') {
-					input++;
-					form = PreprocessingTokenForm::LEFT_SHIFT_EQUALS;
-					found_punctuator = true;
-
-				} else {
-					form = PreprocessingTokenForm::LEFT_SHIFT;
-					found_punctuator = true;
-				}
-
-			} else if (*input == '=') {
-				input++;
-				form = PreprocessingTokenForm::LESS_THAN_EQUAL;
-				found_punctuator = true;
-
-			} else if (*input == ':') {
-				input++;
-				form = PreprocessingTokenForm::BIGRAPH_OPEN_BRACKET;
-				found_punctuator = true;
-
-			} else if (*input == '%') {
-				input++;
-				form = PreprocessingTokenForm::BIGRAPH_OPEN_CURLY_BRACKET;
-				found_punctuator = true;
-
-			} else {
-				form = PreprocessingTokenForm::LESS_THAN;
-				found_punctuator = true;
-			} 
-			break;
-
-		case '>':
-			if (*input == '>') {
-				input++;
-
-				if (*input == '=') {
-					input++;
-					form = PreprocessingTokenForm::RIGHT_SHIFT_EQUALS;
-					found_punctuator = true;
-
-				} else {
-					form = PreprocessingTokenForm::RIGHT_SHIFT;
-					found_punctuator = true;
-				}
-
-			} else if (*input == '=') {
-				input++;
-				form = PreprocessingTokenForm::GREATER_THAN_EQUAL;
-				found_punctuator = true;
-
-			} else {
-				form = PreprocessingTokenForm::GREATER_THAN;
-				found_punctuator = true;
-			} 
-			break;
-
-		case '^':
-			if (*input == '=') {
-				input++;
-				form = PreprocessingTokenForm::XOR_EQUAL;
-				found_punctuator = true;
-
-			} else {
-				form = PreprocessingTokenForm::XOR;
-				found_punctuator = true;
-			}
-			break;
-
-		case '|':
-			if (*input == '|') {
-				input++;
-				form = PreprocessingTokenForm::DOUBLE_OR;
-				found_punctuator = true;
-
-			} else if (*input == '=') {
-				input++;
-				form = PreprocessingTokenForm::OR_EQUAL;
-				found_punctuator = true;
-
-			} else {
-				form = PreprocessingTokenForm::OR;
-				found_punctuator = true;
-			}
-			break;
-
-		case '?':
-			form = PreprocessingTokenForm::QUESTION_MARK;
-			found_punctuator = true;
-			break;
-
-		case ':':
-			if (*input == '>') {
-				input++;
-				form = PreprocessingTokenForm::BIGRAPH_CLOSE_BRACKET;
-				found_punctuator = true;
-
-			} else {
-				form = PreprocessingTokenForm::COLON;
-				found_punctuator = true;
-			} 
-			break;
-
-		case ';':
-			form = PreprocessingTokenForm::SEMI_COLON;
-			found_punctuator = true;
-			break;
-
-		case '=':
-			if (*input == '=') {
-				input++;
-				form = PreprocessingTokenForm::EQUAL;
-				found_punctuator = true;
-
-			} else {
-				form = PreprocessingTokenForm::ASSIGN;
-				found_punctuator = true;
-			}
-			break;
-
-		case ',':
-			form = PreprocessingTokenForm::COMMA;
-			found_punctuator = true;
-			break;
+	const char* const punctuator_end
+		= match_punctuator(input, form);
+	found_punctuator 
+		= form != PreprocessingTokenForm::UNDEFINED;
+	/* An unrecognised character is reported alone. */
+	input = found_punctuator
+			? punctuator_end
+			: input + 1;
 
-		default:
-			break;
-	};
 	if (found_punctuator) {
 
 		const char* lexeme
-			= construct_lexeme(
-				lexeme_start,
-				input);
-
-		LexemaEntry* e
-			= lookup_lexeme_in_pool(
+			= intern_lexeme(
 				lexema_pool,
-				lexeme);
-		if (e) {
-			delete lexeme;
-			lexeme = e->lexeme;
-		} else {
-			insert_lexeme_into_pool(lexema_pool, lexeme);
-		}
+				lexeme_start,
+				input - lexeme_start);
 
 		preprocessor_report_success(
 			"preprocess_punctuator",
 			form,
 			lexeme);
 
-		fld.lexeme_length 
-			= input - lexeme_start;
 		*punctuator = PreprocessingToken(
 			lexeme,
 			PreprocessingTokenName::PUNCTUATOR,
-			fld,
-			form);
-		fld.character_number 
-			+= (input - lexeme_start);
+			locate_in_source_file(source, lexeme_start),
+			form,
+			get_lexeme_atom(lexeme),
+			classify_punctuator(form));
 
 		exitcode = PreprocessorExitCode::SUCCESS;
 
 	} else {
 
 		const char* lexeme
-			= construct_lexeme(
-				lexeme_start,
-				input);
-
-		LexemaEntry* e
-			= lookup_lexeme_in_pool(
+			= intern_lexeme(
 				lexema_pool,
-				lexeme);
-		if (e) {
-			delete lexeme;
-			lexeme = e->lexeme;
-		} else {
-			insert_lexeme_into_pool(lexema_pool, lexeme);
-		}
+				lexeme_start,
+				input - lexeme_start);
 
 		preprocessor_report_failure(
 			"preprocess_punctuator",
 			form,
 			lexeme);
 
-		fld.lexeme_length 
-			= input - lexeme_start;
 		*punctuator = PreprocessingToken(
 			lexeme,
 			PreprocessingTokenName::ERROR,
-			fld,
-			form);
+			locate_in_source_file(source, lexeme_start),
+			form,
+			get_lexeme_atom(lexeme));
 		const char* const error_msg
 			= "This punctuator could not be recognised."
 			  "Did you mispell it?";
@@ -3010,9 +2611,8 @@ PreprocessorExitCode pp_lex_punctuator(
 			= construct_error_book(
 				ErrorCode::ERR_PP_INVALID_PUNCTUATOR,
 				error_msg,
-				fld);
-		fld.character_number 
-			+= (input - lexeme_start);
+				locate_in_source_file(source, lexeme_start),
+				(unsigned int) (input - lexeme_start));
 
 		exitcode = PreprocessorExitCode::FAILURE;
 	}
@@ -3022,7 +2622,7 @@ PreprocessorExitCode pp_lex_punctuator(
 /**
 * Used to perform a preprocessing parse on a token.
 * @param input The input from which to preprocess.
-* @param fld The file location descriptor for the input.
+* @param source The file the input is from.
 * @param punctuator The reference to where to place
 *					the produced pptokens.
 * @param bkl The location to send alerts to.
@@ -3032,7 +2632,7 @@ static inline
 PreprocessorExitCode pp_parse_preprocessing_token(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & preprocessing_token)
 {
@@ -3046,6 +2646,12 @@ PreprocessorExitCode pp_parse_preprocessing_token(
 	PreprocessingAstNodeAlt form
 		= PreprocessingAstNodeAlt::ERROR;
 
+	/* The tokens of a directive may be separated by
+	   spaces and tabs. */
+	while (*input == ' ' || *input == '\t') {
+		input++;
+	}
+
 	bool finished_preprocessed_word = false;
 	while (!finished_preprocessed_word) {
 		switch (*input) {
@@ -3072,7 +2678,7 @@ PreprocessorExitCode pp_parse_preprocessing_token(
 				if (pp_lex_identifier_name(
 					input,
 					lexema_pool,
-					file_location_descriptor,
+					source,
 					token,
 					bkl)
 					== PreprocessorExitCode::SUCCESS) {
@@ -3087,7 +2693,7 @@ PreprocessorExitCode pp_parse_preprocessing_token(
 					if (pp_lex_identifier_name(
 						input,
 						lexema_pool,
-						file_location_descriptor,
+						source,
 						token,
 						bkl) 
 						== PreprocessorExitCode::SUCCESS) {
@@ -3099,7 +2705,7 @@ PreprocessorExitCode pp_parse_preprocessing_token(
 					if (pp_lex_string_literal(
 						input,
 						lexema_pool,
-						file_location_descriptor,
+						source,
 						token,
 						bkl) 
 						== PreprocessorExitCode::SUCCESS) {
@@ -3117,7 +2723,7 @@ PreprocessorExitCode pp_parse_preprocessing_token(
 				if (pp_lex_pp_number(
 					input,
 					lexema_pool,
-					file_location_descriptor,
+					source,
 					token,
 					bkl) 
 					== PreprocessorExitCode::SUCCESS) {
@@ -3131,7 +2737,7 @@ PreprocessorExitCode pp_parse_preprocessing_token(
 				if (pp_lex_character_constant(
 					input,
 					lexema_pool,
-					file_location_descriptor,
+					source,
 					token,
 					bkl) 
 					== PreprocessorExitCode::SUCCESS) {
@@ -3145,7 +2751,7 @@ PreprocessorExitCode pp_parse_preprocessing_token(
 				if (pp_lex_string_literal(
 					input,
 					lexema_pool,
-					file_location_descriptor,
+					source,
 					token,
 					bkl) 
 					== PreprocessorExitCode::SUCCESS) {
@@ -3159,7 +2765,7 @@ PreprocessorExitCode pp_parse_preprocessing_token(
 				if (pp_lex_punctuator(
 					input,
 					lexema_pool,
-					file_location_descriptor,
+					source,
 					token,
 					bkl) 
 					== PreprocessorExitCode::SUCCESS) {
@@ -3182,7 +2788,7 @@ PreprocessorExitCode pp_parse_preprocessing_token(
 				if (pp_lex_punctuator(
 					input,
 					lexema_pool,
-					file_location_descriptor,
+					source,
 					token,
 					bkl) 
 					== PreprocessorExitCode::SUCCESS) {
@@ -3197,7 +2803,7 @@ PreprocessorExitCode pp_parse_preprocessing_token(
 				*token = PreprocessingToken(
 					_strdup(""),
 					PreprocessingTokenName::END_OF_FILE,
-					file_location_descriptor,
+					locate_in_source_file(source, input),
 					PreprocessingTokenForm::UNDEFINED);				
 				finished_preprocessed_word = true;
 				break;
@@ -3222,7 +2828,7 @@ static inline
 PreprocessorExitCode pp_parse_pp_tokens(
 	const char*                 & input,
 	LexemaPool                  & lexema_pool,
-	FileLocationDescriptor      & file_location_descriptor,
+	SourceMapFile          const& source,
 	PreprocessingAstNode*       & pp_tokens,
 	AlertList                   & bkl,
 	bool				   const& within_directive)
@@ -3257,56 +2863,40 @@ PreprocessorExitCode pp_parse_pp_tokens(
 							break;
 
 						case ' ':
-							file_location_descriptor.character_number++;
-							input++;
+							input = skip_char_class(input, CharClass::SPACE);
 							break;
 
 						case '\t':
-							file_location_descriptor.character_number 
-								+= file_location_descriptor.character_number
-								   % 4;
 							input++;
 							break;
 
 						case '\r':
-							file_location_descriptor.character_number = 0;
 							input++;
 							break;
 
 						case '/':
 							if (*(input + 1) == '*') {
-								input += 2;
-								file_location_descriptor.character_number += 2;
-
-								while ((*input != '*')
-									|| (*(input + 1) != '/')) {
-									input++;
-									file_location_descriptor.character_number++;
-
+								input = find_block_comment_end(input + 2);
+								if (*input != '\0') {
+									input += 2;
 								}
-								input += 2;								
-								file_location_descriptor.character_number += 2;
-
-							} else if (*(input + 1) == '/') {
-								input += 2;
-								file_location_descriptor.character_number += 2;
 
-								while (*input != '\n') {
-									input++;
-									file_location_descriptor.character_number++;
+								break;
 
-								}
+							} else if (*(input + 1) == '/') {
+								input = find_line_end(input + 2);
 								continue;
 							
 							}
-							break;
+							/* Otherwise it is a division punctuator. */
+							/* Fall through. */
 
 						default:
 							PreprocessingAstNode* preprocessing_token;
 							if (pp_parse_preprocessing_token(
 								input,
 								lexema_pool,
-								file_location_descriptor,
+								source,
 								bkl,
 								preprocessing_token)
 								== PreprocessorExitCode::SUCCESS) {
@@ -3339,55 +2929,41 @@ PreprocessorExitCode pp_parse_pp_tokens(
 						break;
 
 					case ' ':
-						file_location_descriptor.character_number++;
-						input++;
+						input = skip_char_class(input, CharClass::SPACE);
 						continue;
 
 					case '\t':
-						file_location_descriptor.character_number += 4;
 						input++;
 						continue;
 
 					case '\r':
-						file_location_descriptor.character_number = 0;
 						input++;
 						continue;
 
 					case '/':
 						if (*(input + 1) == '*') {
-							input += 2;
-							file_location_descriptor.character_number += 2;
-
-							while ((*input != '*')
-								|| (*(input + 1) != '/')) {
-								input++;
-								file_location_descriptor.character_number++;
-
+							input = find_block_comment_end(input + 2);
+							if (*input != '\0') {
+								input += 2;
 							}
-							input += 2;
-							file_location_descriptor.character_number += 2;
+
+							break;
 
 						}
 						else if (*(input + 1) == '/') {
-							input += 2;
-							file_location_descriptor.character_number += 2;
-
-							while (*input != '\n') {
-								input++;
-								file_location_descriptor.character_number++;
-
-							}
+							input = find_line_end(input + 2);
 							continue;
 
 						}
-						break;
+						/* Otherwise it is a division punctuator. */
+						/* Fall through. */
 
 					default:
 						PreprocessingAstNode* preprocessing_token;
 						if (pp_parse_preprocessing_token(
 							input,
 							lexema_pool,
-							file_location_descriptor,
+							source,
 							bkl,
 							preprocessing_token)
 							== PreprocessorExitCode::SUCCESS) {
@@ -3425,7 +3001,7 @@ static inline
 PreprocessorExitCode pp_parse_preprocessing_file(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & preprocessing_file)
 {
@@ -3441,7 +3017,7 @@ PreprocessorExitCode pp_parse_preprocessing_file(
 	if (pp_parse_group(
 		input,
 		lexema_pool,
-		file_location_descriptor,
+		source,
 		bkl,
 		group)
 		== PreprocessorExitCode::SUCCESS) {
@@ -3449,7 +3025,37 @@ PreprocessorExitCode pp_parse_preprocessing_file(
 			group);
 	}
 
-	exitcode = PreprocessorExitCode::SUCCESS;
+	exitcode = pp_check_end_of_file(
+		input,
+		source,
+		bkl);
+	return exitcode;
+}
+
+static inline
+PreprocessorExitCode pp_check_end_of_file(
+	const char*       const& input,
+	SourceMapFile     const& source,
+	AlertList              & bkl)
+{
+	PreprocessorExitCode exitcode 
+		= PreprocessorExitCode::SUCCESS;
+
+	/* The group ends at the first line that is neither
+	   text nor a directive it knows, such as an #endif
+	   with no #if, so the lines after it would be lost
+	   unseen. A last line with no new-line is left to
+	   be dropped, as it always has been.             */
+	const char* const line_end
+		= find_line_end(input);
+	if (*line_end == '\n') {
+		bkl.add_error(construct_error_book(
+			ErrorCode::ERR_PP_INVALID_LINE,
+			"Expected a line of text or a directive.",
+			locate_in_source_file(source, input),
+			(unsigned int) (line_end - input)));
+		exitcode = PreprocessorExitCode::FAILURE;
+	}
 	return exitcode;
 }
 
@@ -3457,7 +3063,7 @@ static inline
 PreprocessorExitCode pp_parse_group(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & group)
 {
@@ -3485,7 +3091,7 @@ PreprocessorExitCode pp_parse_group(
 				if (pp_parse_group_part(
 					input,
 					lexema_pool,
-					file_location_descriptor,
+					source,
 					bkl,
 					group_part)
 					== PreprocessorExitCode::SUCCESS) {
@@ -3510,7 +3116,7 @@ PreprocessorExitCode pp_parse_group(
 				if (pp_parse_group_part(
 					input,
 					lexema_pool,
-					file_location_descriptor,
+					source,
 					bkl,
 					group_part)
 					== PreprocessorExitCode::SUCCESS) {
@@ -3542,11 +3148,248 @@ PreprocessorExitCode pp_parse_group(
 	return exitcode;
 }
 
+static inline
+bool is_directive_name(
+	const char* const& name,
+	size_t      const& length,
+	const char* const& directive)
+{
+	return strncmp(name, directive, length) == 0
+		   && directive[length] == '\0';
+}
+
+static inline
+size_t get_line_splice_length(
+	const char* const& chr)
+{
+	if (*chr != '\\') {
+		return 0;
+	}
+	if (*(chr + 1) == '\n') {
+		return 2;
+	}
+	if (*(chr + 1) == '\r' && *(chr + 2) == '\n') {
+		return 3;
+	}
+	return 0;
+}
+
+static inline
+bool is_line_spliced(
+	const char* const& line,
+	const char* const& line_end)
+{
+	if (*line_end != '\n' || line_end == line) {
+		return false;
+	}
+	const char* last
+		= line_end - 1;
+	if (*last == '\r' && last > line) {
+		last--;
+	}
+	return *last == '\\';
+}
+
+static inline
+const char* pp_skip_skipped_line_space(
+	const char* const& chr)
+{
+	const char* c
+		= chr;
+	while (true) {
+		if (*c == ' ' || *c == '\t') {
+			c++;
+		} else if (get_line_splice_length(c) > 0) {
+			c += get_line_splice_length(c);
+		} else if (*c == '/' && *(c + 1) == '*') {
+			c = find_block_comment_end(c + 2);
+			if (*c != '\0') {
+				c += 2;
+			}
+		} else if (*c == '/' && *(c + 1) == '/') {
+			return pp_find_skipped_line_end(c);
+		} else {
+			return c;
+		}
+	}
+}
+
+static inline
+const char* pp_skip_group(
+	const char* const& input)
+{
+	const char* line 
+		= input;
+	unsigned int depth 
+		= 0;
+
+	while (*line != '\0') {
+		const char* chr 
+			= pp_skip_skipped_line_space(line);
+		if (*chr == '#'
+			|| (*chr == '%' && *(chr + 1) == ':')) {
+			chr = pp_skip_skipped_line_space(
+				chr + (*chr == '#' ? 1 : 2));
+			/* The name is gathered without the splices
+			   within it. None of the directives looked
+			   for is longer than the buffer.          */
+			char name[PP_SKIPPED_DIRECTIVE_NAME_SZ];
+			size_t length
+				= 0;
+			while (true) {
+				if (get_line_splice_length(chr) > 0) {
+					chr += get_line_splice_length(chr);
+				} else if (isalnum((unsigned char) *chr) 
+						   || *chr == '_') {
+					if (length < PP_SKIPPED_DIRECTIVE_NAME_SZ) {
+						name[length] = *chr;
+					}
+					length++;
+					chr++;
+				} else {
+					break;
+				}
+			}
+			if (length > PP_SKIPPED_DIRECTIVE_NAME_SZ) {
+				length = 0;
+			}
+
+			if (is_directive_name(name, length, "if")
+				|| is_directive_name(name, length, "ifdef")
+				|| is_directive_name(name, length, "ifndef")) {
+				depth++;
+
+			} else if (is_directive_name(name, length, "endif")) {
+				if (depth == 0) {
+					return line;
+				}
+				depth--;
+
+			} else if ((is_directive_name(name, length, "elif")
+						|| is_directive_name(name, length, "else"))
+					   && depth == 0) {
+				return line;
+			}
+		}
+		const char* const line_end
+			= pp_find_skipped_line_end(chr);
+		line = *line_end == '\0'
+			   ? line_end
+			   : line_end + 1;
+	}
+	return line;
+}
+
+static inline
+const char* pp_find_skipped_line_end(
+	const char* const& line)
+{
+	const char* line_end 
+		= find_line_end(line);
+	/* Comments can only start on a line with a '/',
+	   and a line only continues past a backslash, so
+	   most lines need no more than the search.     */
+	if (!is_line_spliced(line, line_end)
+		&& memchr(line, '/', line_end - line) == NULL) {
+		return line_end;
+	}
+
+	const char* chr
+		= line;
+	while (*chr != '\n' && *chr != '\0') {
+		switch (*chr) {
+
+			case '"':
+			case '\'':
+			{
+				/* Quotes hide what looks like a comment. */
+				const char quote = *chr++;
+				while (*chr != quote 
+					   && *chr != '\n' 
+					   && *chr != '\0') {
+					if (*chr == '\\' && *(chr + 1) != '\0') {
+						chr++;
+					}
+					chr++;
+				}
+				if (*chr == quote) {
+					chr++;
+				}
+				break;
+			}
+
+			case '/':
+				if (*(chr + 1) == '*') {
+					chr = find_block_comment_end(chr + 2);
+					if (*chr != '\0') {
+						chr += 2;
+					}
+
+				} else if (*(chr + 1) == '/') {
+					/* A splice carries the comment on. */
+					const char* comment
+						= chr;
+					line_end = find_line_end(comment);
+					while (is_line_spliced(comment, line_end)) {
+						comment  = line_end + 1;
+						line_end = find_line_end(comment);
+					}
+					return line_end;
+
+				} else {
+					chr++;
+				}
+				break;
+
+			case '\\':
+				chr += get_line_splice_length(chr) > 0
+					   ? get_line_splice_length(chr)
+					   : 1;
+				break;
+
+			default:
+				chr++;
+				break;
+		}
+	}
+	return chr;
+}
+
+static inline
+PreprocessorExitCode pp_parse_deferred_group(
+	const char*            & input,
+	SourceMapFile     const& source,
+	PreprocessingAstNode*  & group)
+{
+	PreprocessorExitCode exitcode 
+		= PreprocessorExitCode::FAILURE;
+
+	const char* const group_start
+		= input;
+	input = pp_skip_group(input);
+
+	if (input != group_start) {
+		/* The group is found again from where it
+		   starts, kept in the node's value. */
+		const SourceLocation location
+			= locate_in_source_file(source, group_start);
+		group = new PreprocessingAstNode(
+			PreprocessingAstNodeName::GROUP,
+			PreprocessingAstNodeAlt::GROUP_3,
+			NULL);
+		group->set_val(
+			((uint64_t) location.file_id << 32) 
+			| location.offset);
+		exitcode = PreprocessorExitCode::SUCCESS;
+	}
+	return exitcode;
+}
+
 static inline
 PreprocessorExitCode pp_parse_group_part(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & group_part)
 {
@@ -3572,7 +3415,7 @@ PreprocessorExitCode pp_parse_group_part(
 		if (pp_parse_if_section(
 				input, 
 				lexema_pool,
-				file_location_descriptor,
+				source,
 				bkl,
 				if_section)
 			== PreprocessorExitCode::SUCCESS) {
@@ -3584,7 +3427,7 @@ PreprocessorExitCode pp_parse_group_part(
 		} else if (pp_parse_control_line(
 			           input,
 			           lexema_pool,
-			           file_location_descriptor,
+			           source,
 			           bkl, 
 			           control_line)
 			       == PreprocessorExitCode::SUCCESS) {
@@ -3596,7 +3439,7 @@ PreprocessorExitCode pp_parse_group_part(
 		} else if (pp_parse_preprocessing_token(
 			           input,
 			           lexema_pool,
-			           file_location_descriptor,
+			           source,
 			           bkl, 
 			           pp_token)
 			       == PreprocessorExitCode::SUCCESS) {
@@ -3609,7 +3452,7 @@ PreprocessorExitCode pp_parse_group_part(
 				if (pp_parse_non_directive(
 					input,
 					lexema_pool,
-					file_location_descriptor,
+					source,
 					bkl,
 					non_directive)
 					== PreprocessorExitCode::SUCCESS) {
@@ -3627,7 +3470,7 @@ PreprocessorExitCode pp_parse_group_part(
 		if (pp_parse_text_line(
 				input,
 				lexema_pool,
-				file_location_descriptor,
+				source,
 				bkl, 
 				text_line)
 				== PreprocessorExitCode::SUCCESS) {
@@ -3657,7 +3500,7 @@ static inline
 PreprocessorExitCode pp_parse_if_section(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & if_section)
 {
@@ -3672,7 +3515,7 @@ PreprocessorExitCode pp_parse_if_section(
 	if (pp_parse_if_group(
 		input, 
 		lexema_pool,
-		file_location_descriptor,
+		source,
 		bkl, 
 		if_group)
 		== PreprocessorExitCode::SUCCESS) {
@@ -3682,7 +3525,7 @@ PreprocessorExitCode pp_parse_if_section(
 		if (pp_parse_elif_groups(
 			input,
 			lexema_pool,
-			file_location_descriptor,
+			source,
 			bkl, 
 			elif_groups)
 			== PreprocessorExitCode::SUCCESS) {
@@ -3693,7 +3536,7 @@ PreprocessorExitCode pp_parse_if_section(
 		if (pp_parse_else_group(
 			input,
 			lexema_pool,
-			file_location_descriptor,
+			source,
 			bkl, 
 			else_group)
 			== PreprocessorExitCode::SUCCESS) {
@@ -3704,7 +3547,7 @@ PreprocessorExitCode pp_parse_if_section(
 		if (pp_parse_endif_line(
 			input,
 			lexema_pool,
-			file_location_descriptor,
+			source,
 			bkl, 
 			endif_line)
 			== PreprocessorExitCode::SUCCESS) {
@@ -3730,7 +3573,7 @@ static inline
 PreprocessorExitCode pp_parse_if_group(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & if_group)
 {
@@ -3748,7 +3591,7 @@ PreprocessorExitCode pp_parse_if_group(
 	if (pp_parse_preprocessing_token(
 			input, 
 			lexema_pool, 
-			file_location_descriptor, 
+			source, 
 			bkl, 
 			preprocessing_token_1) 
 		== PreprocessorExitCode::SUCCESS
@@ -3761,7 +3604,7 @@ PreprocessorExitCode pp_parse_if_group(
 		if (pp_parse_preprocessing_token(
 			input,
 			lexema_pool,
-			file_location_descriptor,
+			source,
 			bkl,
 			preprocessing_token_2) == PreprocessorExitCode::SUCCESS
 			&& preprocessing_token_2->get_terminal()
@@ -3776,7 +3619,7 @@ PreprocessorExitCode pp_parse_if_group(
 				if (pp_parse_constant_expression(
 						input, 
 						lexema_pool,
-						file_location_descriptor,
+						source,
 						bkl,
 						constant_expression)
 					== PreprocessorExitCode::SUCCESS) {
@@ -3786,18 +3629,16 @@ PreprocessorExitCode pp_parse_if_group(
 					if (pp_parse_new_line(
 							input,
 							lexema_pool,
-							file_location_descriptor,
+							source,
 							bkl, 
 							new_line) 
 						== PreprocessorExitCode::SUCCESS) {
 						stack[si++] = new_line;
 
 						PreprocessingAstNode* group;
-						if (pp_parse_group(
+						if (pp_parse_deferred_group(
 								input,
-								lexema_pool,
-								file_location_descriptor,
-								bkl, 
+								source,
 								group)
 							== PreprocessorExitCode::SUCCESS) {
 							stack[si++] = group;
@@ -3812,28 +3653,26 @@ PreprocessorExitCode pp_parse_if_group(
 				PreprocessingAstNode* preprocessing_token;
 				if (pp_parse_preprocessing_token(input,
 						lexema_pool,
-						file_location_descriptor,
+						source,
 						bkl,
 						preprocessing_token) 
 					== PreprocessorExitCode::SUCCESS) {
-					stack[si++];
+					stack[si++] = preprocessing_token;
 
 					PreprocessingAstNode* new_line;
 					if (pp_parse_new_line(
 							input,
 							lexema_pool,
-							file_location_descriptor,
+							source,
 							bkl, 
 							new_line) 
 						== PreprocessorExitCode::SUCCESS) {
 						stack[si++] = new_line;
 
 						PreprocessingAstNode* group;
-						if (pp_parse_group(
+						if (pp_parse_deferred_group(
 							input,
-							lexema_pool,
-							file_location_descriptor,
-							bkl, 
+							source,
 							group) 
 							== PreprocessorExitCode::SUCCESS) {
 							stack[si++] = group;
@@ -3849,31 +3688,29 @@ PreprocessorExitCode pp_parse_if_group(
 				if (pp_parse_preprocessing_token(
 						input,
 						lexema_pool,
-						file_location_descriptor,
+						source,
 						bkl, 
 						preprocessing_token) 
 					== PreprocessorExitCode::SUCCESS
 					&& (preprocessing_token->get_terminal()
 					                       ->get_name() 
 					   == PreprocessingTokenName::IDENTIFIER)) {
-					stack[si++];
+					stack[si++] = preprocessing_token;
 
 					PreprocessingAstNode* new_line;
 					if (pp_parse_new_line(
 							input,
 							lexema_pool,
-							file_location_descriptor,
+							source,
 							bkl, 
 							new_line) 
 						== PreprocessorExitCode::SUCCESS) {
 						stack[si++] = new_line;
 
 						PreprocessingAstNode* group;
-						if (pp_parse_group(
+						if (pp_parse_deferred_group(
 								input,
-								lexema_pool,
-								file_location_descriptor,
-								bkl, 
+								source,
 								group) 
 							== PreprocessorExitCode::SUCCESS) {
 							stack[si++] = group;
@@ -3907,7 +3744,7 @@ static inline
 PreprocessorExitCode pp_parse_elif_groups(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & elif_groups)
 {
@@ -3937,7 +3774,7 @@ PreprocessorExitCode pp_parse_elif_groups(
 				if (pp_parse_elif_group(
 						input,
 						lexema_pool,
-						file_location_descriptor,
+						source,
 						bkl,
 						elif_group)
 					== PreprocessorExitCode::SUCCESS) {
@@ -3962,7 +3799,7 @@ PreprocessorExitCode pp_parse_elif_groups(
 				if (pp_parse_elif_group(
 						input,
 						lexema_pool,
-						file_location_descriptor,
+						source,
 						bkl,
 						elif_group)
 					== PreprocessorExitCode::SUCCESS) {
@@ -3996,7 +3833,7 @@ static inline
 PreprocessorExitCode pp_parse_identifier_list(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & identifier_list)
 {
@@ -4019,7 +3856,7 @@ PreprocessorExitCode pp_parse_identifier_list(
 				if (pp_parse_preprocessing_token(
 						input,
 						lexema_pool,
-						file_location_descriptor,
+						source,
 						bkl,
 						preprocessing_token) 
 					== PreprocessorExitCode::SUCCESS) {
@@ -4045,7 +3882,7 @@ PreprocessorExitCode pp_parse_identifier_list(
 				if (pp_parse_preprocessing_token(
 						input,
 						lexema_pool,
-						file_location_descriptor,
+						source,
 						bkl,
 						preprocessing_token)
 					== PreprocessorExitCode::SUCCESS) {
@@ -4054,7 +3891,7 @@ PreprocessorExitCode pp_parse_identifier_list(
 					if (pp_parse_preprocessing_token(
 							input,
 							lexema_pool,
-							file_location_descriptor,
+							source,
 							bkl,
 							preprocessing_token)
 						== PreprocessorExitCode::SUCCESS) {
@@ -4090,7 +3927,7 @@ static inline
 PreprocessorExitCode pp_parse_constant_expression(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & constant_expression)
 {
@@ -4109,7 +3946,7 @@ PreprocessorExitCode pp_parse_constant_expression(
 	if (pp_parse_pp_tokens(
 			input,
 			lexema_pool,
-			file_location_descriptor,
+			source,
 			pp_ast_pp_tokens,
 			bkl,
 			true) 
@@ -4131,7 +3968,7 @@ static inline
 PreprocessorExitCode pp_parse_elif_group(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & elif_group)
 {
@@ -4150,7 +3987,7 @@ PreprocessorExitCode pp_parse_elif_group(
 	if (pp_parse_preprocessing_token(
 		input,
 		lexema_pool,
-		file_location_descriptor,
+		source,
 		bkl,
 		preprocessing_token_1) 
 		== PreprocessorExitCode::SUCCESS
@@ -4164,7 +4001,7 @@ PreprocessorExitCode pp_parse_elif_group(
 		if (pp_parse_preprocessing_token(
 				input,
 				lexema_pool,
-				file_location_descriptor,
+				source,
 				bkl,
 				preprocessing_token_2) 
 			== PreprocessorExitCode::SUCCESS
@@ -4185,7 +4022,7 @@ PreprocessorExitCode pp_parse_elif_group(
 				if (pp_parse_constant_expression(
 						input, 
 						lexema_pool,
-						file_location_descriptor,
+						source,
 						bkl, 
 						constant_expression)
 					== PreprocessorExitCode::SUCCESS) {
@@ -4195,17 +4032,15 @@ PreprocessorExitCode pp_parse_elif_group(
 					if (pp_parse_new_line(
 						input, 
 						lexema_pool,
-						file_location_descriptor,
+						source,
 						bkl, 
 						new_line) == PreprocessorExitCode::SUCCESS) {
 						stack[si++] = new_line;
 
 						PreprocessingAstNode* group;
-						if (pp_parse_group(
-							input, 
-							lexema_pool,
-							file_location_descriptor,
-							bkl, 
+						if (pp_parse_deferred_group(
+							input,
+							source,
 							group)
 							== PreprocessorExitCode::SUCCESS) {
 							stack[si++] = group;
@@ -4236,7 +4071,7 @@ static inline
 PreprocessorExitCode pp_parse_else_group(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & else_group)
 {
@@ -4256,7 +4091,7 @@ PreprocessorExitCode pp_parse_else_group(
 	if (pp_parse_preprocessing_token(
 			input,
 			lexema_pool,
-			file_location_descriptor,
+			source,
 			bkl,
 			preprocessing_token_1) 
 		== PreprocessorExitCode::SUCCESS
@@ -4270,7 +4105,7 @@ PreprocessorExitCode pp_parse_else_group(
 		if (pp_parse_preprocessing_token(
 				input,
 				lexema_pool,
-				file_location_descriptor,
+				source,
 				bkl,
 				preprocessing_token_2) 
 			== PreprocessorExitCode::SUCCESS
@@ -4290,18 +4125,16 @@ PreprocessorExitCode pp_parse_else_group(
 				if (pp_parse_new_line(
 						input, 
 						lexema_pool,
-						file_location_descriptor,
+						source,
 						bkl, 
 						new_line) 
 					== PreprocessorExitCode::SUCCESS) {
 					stack[si++] = new_line;
 
 					PreprocessingAstNode* group;
-					if (pp_parse_group(
-							input, 
-							lexema_pool,
-							file_location_descriptor,
-							bkl, 
+					if (pp_parse_deferred_group(
+							input,
+							source,
 							group)
 						== PreprocessorExitCode::SUCCESS) {
 						stack[si++] = group;
@@ -4330,7 +4163,7 @@ static inline
 PreprocessorExitCode pp_parse_endif_line(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & endif_line)
 {
@@ -4346,7 +4179,7 @@ PreprocessorExitCode pp_parse_endif_line(
 	if (pp_parse_preprocessing_token(
 		input,
 		lexema_pool,
-		file_location_descriptor,
+		source,
 		bkl,
 		preprocessing_token_1) 
 		== PreprocessorExitCode::SUCCESS
@@ -4360,7 +4193,7 @@ PreprocessorExitCode pp_parse_endif_line(
 		if (pp_parse_preprocessing_token(
 			input,
 			lexema_pool,
-			file_location_descriptor,
+			source,
 			bkl,
 			preprocessing_token_2) 
 			== PreprocessorExitCode::SUCCESS
@@ -4380,7 +4213,7 @@ PreprocessorExitCode pp_parse_endif_line(
 				if (pp_parse_new_line(
 					input, 
 					lexema_pool,
-					file_location_descriptor,
+					source,
 					bkl, 
 					new_line) 
 					== PreprocessorExitCode::SUCCESS) {
@@ -4403,7 +4236,7 @@ static inline
 PreprocessorExitCode pp_parse_control_line(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & control_line)
 {	
@@ -4424,7 +4257,7 @@ PreprocessorExitCode pp_parse_control_line(
 	if (pp_parse_preprocessing_token(
 			input, 
 			lexema_pool, 
-			file_location_descriptor, 
+			source, 
 			bkl, 
 			preprocessing_token) 
 		== PreprocessorExitCode::SUCCESS) {
@@ -4437,7 +4270,7 @@ PreprocessorExitCode pp_parse_control_line(
 		if (pp_parse_preprocessing_token(
 				input,
 				lexema_pool,
-				file_location_descriptor,
+				source,
 				bkl,
 				preprocessing_token_2) 
 			== PreprocessorExitCode::SUCCESS
@@ -4456,7 +4289,7 @@ PreprocessorExitCode pp_parse_control_line(
 				if (pp_parse_pp_tokens(
 						input,
 						lexema_pool,
-						file_location_descriptor,
+						source,
 						pp_tokens,
 						bkl,
 						true)
@@ -4467,7 +4300,7 @@ PreprocessorExitCode pp_parse_control_line(
 					if (pp_parse_new_line(
 							input,
 							lexema_pool,
-							file_location_descriptor,
+							source,
 							bkl,
 							new_line) 
 						== PreprocessorExitCode::SUCCESS) {
@@ -4484,7 +4317,7 @@ PreprocessorExitCode pp_parse_control_line(
 				if (pp_parse_preprocessing_token(
 						input,
 						lexema_pool,
-						file_location_descriptor,
+						source,
 						bkl,
 						identifier)
 					== PreprocessorExitCode::SUCCESS) {
@@ -4495,7 +4328,7 @@ PreprocessorExitCode pp_parse_control_line(
 					if (pp_parse_replacement_list(
 							input,
 							lexema_pool,
-							file_location_descriptor,
+							source,
 							bkl,
 							replacement_list)
 						== PreprocessorExitCode::SUCCESS) {
@@ -4505,7 +4338,7 @@ PreprocessorExitCode pp_parse_control_line(
 						if (pp_parse_new_line(
 								input,
 								lexema_pool,
-								file_location_descriptor,
+								source,
 								bkl, 
 								new_line)
 							== PreprocessorExitCode::SUCCESS) {
@@ -4518,7 +4351,7 @@ PreprocessorExitCode pp_parse_control_line(
 					} else if (pp_parse_lparen(
 							       input,
 								   lexema_pool,
-								   file_location_descriptor,
+								   source,
 								   bkl,
 								   lparen)
 						== PreprocessorExitCode::SUCCESS) {
@@ -4528,7 +4361,7 @@ PreprocessorExitCode pp_parse_control_line(
 						if (pp_parse_identifier_list(
 								input,
 								lexema_pool,
-								file_location_descriptor,
+								source,
 								bkl, 
 								identifier_list)
 							== PreprocessorExitCode::SUCCESS) {
@@ -4544,7 +4377,7 @@ PreprocessorExitCode pp_parse_control_line(
 								if (pp_parse_replacement_list(
 										input,
 										lexema_pool,
-										file_location_descriptor,
+										source,
 										bkl, 
 										replacement_list)
 									== PreprocessorExitCode::SUCCESS) {
@@ -4553,7 +4386,7 @@ PreprocessorExitCode pp_parse_control_line(
 									PreprocessingAstNode* new_line;
 									if (pp_parse_new_line(input,
 											lexema_pool,
-											file_location_descriptor,
+											source,
 											bkl,
 											new_line) 
 										== PreprocessorExitCode::SUCCESS) {
@@ -4570,7 +4403,7 @@ PreprocessorExitCode pp_parse_control_line(
 								if (pp_parse_replacement_list(
 										input,
 										lexema_pool,
-										file_location_descriptor,
+										source,
 										bkl, 
 										replacement_list)
 									== PreprocessorExitCode::SUCCESS) {
@@ -4580,7 +4413,7 @@ PreprocessorExitCode pp_parse_control_line(
 									if (pp_parse_new_line(
 											input,
 											lexema_pool,
-											file_location_descriptor,
+											source,
 											bkl, 
 											new_line) 
 										== PreprocessorExitCode::SUCCESS) {
@@ -4604,7 +4437,7 @@ PreprocessorExitCode pp_parse_control_line(
 								if (pp_parse_replacement_list(
 										input,
 										lexema_pool,
-										file_location_descriptor,
+										source,
 										bkl, 
 										replacement_list)
 									== PreprocessorExitCode::SUCCESS) {
@@ -4614,7 +4447,7 @@ PreprocessorExitCode pp_parse_control_line(
 									if (pp_parse_new_line(
 											input,
 											lexema_pool,
-											file_location_descriptor,
+											source,
 											bkl,
 											new_line) 
 										== PreprocessorExitCode::SUCCESS) {
@@ -4632,7 +4465,7 @@ PreprocessorExitCode pp_parse_control_line(
 								if (pp_parse_replacement_list(
 										input,
 										lexema_pool, 
-										file_location_descriptor,
+										source,
 										bkl,
 										replacement_list)
 									== PreprocessorExitCode::SUCCESS) {
@@ -4642,7 +4475,7 @@ PreprocessorExitCode pp_parse_control_line(
 									if (pp_parse_new_line(
 											input,
 											lexema_pool,
-											file_location_descriptor,
+											source,
 											bkl,
 											new_line)
 										== PreprocessorExitCode::FAILURE) {
@@ -4657,7 +4490,7 @@ PreprocessorExitCode pp_parse_control_line(
 						PreprocessingAstNode* replacement_list;
 						if (pp_parse_replacement_list(input,
 								lexema_pool,
-								file_location_descriptor,
+								source,
 								bkl,
 								replacement_list)
 							== PreprocessorExitCode::SUCCESS) {
@@ -4667,7 +4500,7 @@ PreprocessorExitCode pp_parse_control_line(
 							if (pp_parse_new_line(
 									input,
 									lexema_pool,
-									file_location_descriptor,
+									source,
 									bkl,
 									new_line)
 								== PreprocessorExitCode::SUCCESS) {
@@ -4688,7 +4521,7 @@ PreprocessorExitCode pp_parse_control_line(
 				if (pp_parse_preprocessing_token(
 						input, 
 						lexema_pool,
-						file_location_descriptor,
+						source,
 						bkl, 
 						preprocessing_token)
 					== PreprocessorExitCode::SUCCESS
@@ -4700,7 +4533,7 @@ PreprocessorExitCode pp_parse_control_line(
 					if (pp_parse_new_line(
 							input, 
 							lexema_pool,
-							file_location_descriptor,
+							source,
 							bkl,
 							new_line)
 						== PreprocessorExitCode::SUCCESS) {
@@ -4717,7 +4550,7 @@ PreprocessorExitCode pp_parse_control_line(
 				if (pp_parse_pp_tokens(
 						input, 
 						lexema_pool,
-						file_location_descriptor,
+						source,
 						pp_tokens,
 						bkl,
 						true)
@@ -4728,7 +4561,7 @@ PreprocessorExitCode pp_parse_control_line(
 					if (pp_parse_new_line(
 							input, 
 							lexema_pool,
-							file_location_descriptor,
+							source,
 							bkl, 
 							new_line)
 						== PreprocessorExitCode::SUCCESS) {
@@ -4745,7 +4578,7 @@ PreprocessorExitCode pp_parse_control_line(
 				if (pp_parse_pp_tokens(
 						input, 
 						lexema_pool,
-						file_location_descriptor,
+						source,
 						pp_tokens,
 						bkl,
 						true)
@@ -4756,7 +4589,7 @@ PreprocessorExitCode pp_parse_control_line(
 				if (pp_parse_new_line(
 						input,
 						lexema_pool,
-						file_location_descriptor,
+						source,
 						bkl, 
 						new_line)
 					== PreprocessorExitCode::SUCCESS) {
@@ -4772,7 +4605,7 @@ PreprocessorExitCode pp_parse_control_line(
 				if (pp_parse_pp_tokens(
 						input,
 						lexema_pool,
-						file_location_descriptor,
+						source,
 						pp_tokens,
 						bkl,
 						true)
@@ -4783,7 +4616,7 @@ PreprocessorExitCode pp_parse_control_line(
 				if (pp_parse_new_line(
 						input, 
 						lexema_pool,
-						file_location_descriptor,
+						source,
 						bkl, 
 						new_line)
 					== PreprocessorExitCode::SUCCESS) {
@@ -4795,7 +4628,7 @@ PreprocessorExitCode pp_parse_control_line(
 		} else if (pp_parse_new_line(
 				       input,
 					   lexema_pool,
-					   file_location_descriptor,
+					   source,
 					   bkl,
 					   new_line)
 				   == PreprocessorExitCode::SUCCESS) { 
@@ -4824,7 +4657,7 @@ static inline
 PreprocessorExitCode pp_parse_text_line(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & text_line)
 {
@@ -4838,7 +4671,7 @@ PreprocessorExitCode pp_parse_text_line(
 	if (pp_parse_pp_tokens(
 			input,
 			lexema_pool,
-			file_location_descriptor,
+			source,
 			pp_tokens,
 			bkl,
 			false)
@@ -4849,7 +4682,7 @@ PreprocessorExitCode pp_parse_text_line(
 	if (pp_parse_new_line(
 			input,
 			lexema_pool,
-			file_location_descriptor,
+			source,
 			bkl,
 			new_line)
 		== PreprocessorExitCode::SUCCESS) {
@@ -4874,7 +4707,7 @@ static inline
 PreprocessorExitCode pp_parse_new_line(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & new_line)
 {
@@ -4886,8 +4719,6 @@ PreprocessorExitCode pp_parse_new_line(
 			PreprocessingAstNodeName::NEW_LINE,
 			PreprocessingAstNodeAlt::NEW_LINE_1,
 			NULL);
-		file_location_descriptor.line_number++;
-		file_location_descriptor.character_number = 0;
 		input++;
 		exitcode = PreprocessorExitCode::SUCCESS;
 	}
@@ -5034,7 +4865,7 @@ static inline
 PreprocessorExitCode pp_parse_non_directive(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & non_directive)
 {
@@ -5053,7 +4884,7 @@ PreprocessorExitCode pp_parse_non_directive(
 		&& pp_parse_pp_tokens(
 		       input,
 		       lexema_pool,
-		       file_location_descriptor,
+		       source,
 		       pp_tokens,
 		       bkl,
 		       false)
@@ -5064,7 +4895,7 @@ PreprocessorExitCode pp_parse_non_directive(
 		if (pp_parse_new_line(
 			input,
 			lexema_pool,
-			file_location_descriptor,
+			source,
 			bkl,
 			new_line)
 			== PreprocessorExitCode::SUCCESS) {
@@ -5091,7 +4922,7 @@ static inline
 PreprocessorExitCode pp_parse_lparen(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & lparen)
 {
@@ -5101,7 +4932,7 @@ PreprocessorExitCode pp_parse_lparen(
 	PreprocessingAstNode* preprocessing_token;
 	if (pp_parse_preprocessing_token(input,
 		lexema_pool,
-		file_location_descriptor,
+		source,
 		bkl,
 		preprocessing_token)
 		== PreprocessorExitCode::SUCCESS) {
@@ -5120,7 +4951,7 @@ static inline
 PreprocessorExitCode pp_parse_replacement_list(
 	const char*            & input,
 	LexemaPool             & lexema_pool,
-	FileLocationDescriptor & file_location_descriptor,
+	SourceMapFile     const& source,
 	AlertList              & bkl,
 	PreprocessingAstNode*  & replacement_list)
 {
@@ -5135,7 +4966,7 @@ PreprocessorExitCode pp_parse_replacement_list(
 	if (pp_parse_pp_tokens(
 		input,
 		lexema_pool,
-		file_location_descriptor,
+		source,
 		pp_tokens,		
 		bkl,
 		false)
@@ -5149,487 +4980,272 @@ PreprocessorExitCode pp_parse_replacement_list(
 }
 
 static inline
-PreprocessorExitCode pp_execute_preprocessing_file(
-	PreprocessingAstNode* & preprocessing_file,
-	AlertList             & bkl,
-	PreprocessingAstNode* & executed_preprocessing_file)
+PreprocessorExitCode pp_execute_if_section(
+	PreprocessingAstNode*       & if_section,
+	AlertList                   & bkl,
+	SymbolTable                 & symtab,	
+	PreprocessingAstNode*       & selected_group)
 {
 	PreprocessorExitCode exitcode 
-		= PreprocessorExitCode::SUCCESS;
+		= PreprocessorExitCode::FAILURE;
 
-	PreprocessingAstNode* group
-		= preprocessing_file->get_child();
-	SymbolTable symtab
-		= SymbolTable();
+	PreprocessingAstNode* if_group
+		= if_section->get_child();
+	PreprocessingAstNode* if_group_sibling
+		= if_group->get_sibling();
+	PreprocessingAstNode* elif_groups
+		= (if_group_sibling->get_name()
+		   == PreprocessingAstNodeName::ELIF_GROUPS)
+		  ? if_group_sibling
+		  : NULL;
+	PreprocessingAstNode* else_group
+		= elif_groups
+		  ? ((elif_groups->get_sibling()->get_name()
+		      == PreprocessingAstNodeName::ELSE_GROUP)
+		     ? elif_groups->get_sibling()
+		     : NULL)
+		  : ((if_group_sibling->get_name()
+		      == PreprocessingAstNodeName::ELSE_GROUP)
+		     ? if_group_sibling
+			 : NULL);
+	PreprocessingAstNode* endif_line
+		= else_group
+		  ? else_group->get_sibling()
+		  : (elif_groups 
+		     ? elif_groups->get_sibling()
+		     : if_group->get_sibling());
 
-	executed_preprocessing_file = new PreprocessingAstNode(
-		PreprocessingAstNodeName::PREPROCESSING_FILE,
-		PreprocessingAstNodeAlt::PREPROCESSING_FILE_1,
-		NULL);
+	/* Only the first group whose condition holds is
+	   selected; the rest are left out. */
+	bool is_taken
+		= false;
+	selected_group
+		= NULL;
 
-	if (group) {
-		PreprocessingAstNode* executed_group;
-		pp_execute_group(
-			group,
+	if (pp_execute_if_group(
+			if_group,
 			bkl,
 			symtab,
-			executed_group);
-		executed_preprocessing_file->add_child(executed_group);
-
+			is_taken,
+			selected_group)
+		!= PreprocessorExitCode::SUCCESS) {
+		return exitcode;
+	}
+	if (elif_groups
+		&& pp_execute_elif_groups(
+			   elif_groups,
+			   bkl,
+			   symtab,
+			   is_taken,
+			   selected_group)
+		   != PreprocessorExitCode::SUCCESS) {
+		return exitcode;
+	}
+	if (else_group
+		&& pp_execute_else_group(
+			   else_group,
+			   bkl,
+			   symtab,
+			   is_taken,
+			   selected_group)
+		   != PreprocessorExitCode::SUCCESS) {
+		return exitcode;
 	}
+	pp_execute_endif_line(
+		endif_line,
+		bkl,
+		symtab);
+
+	exitcode = PreprocessorExitCode::SUCCESS;
 
 	return exitcode;
 }
 
 static inline
-PreprocessorExitCode pp_insert_group_into_group(
-	PreprocessingAstNode* & former_group,
-	PreprocessingAstNode* & latter_group,
-	SymbolTable           & symtab)
+bool pp_is_macro_defined(
+	const PreprocessingToken* const& identifier,
+	void*                     const& context)
 {
-	PreprocessorExitCode exitcode
+	const SymbolTable* const symtab
+		= (const SymbolTable*) context;
+	const SymbolTableEntry* const entry
+		= symtab->get_entry(identifier->get_atom());
+	return entry != NULL
+		   && entry->identifier_type 
+		      == IdentifierClassifier::MACRO_NAME;
+}
+
+static inline
+void pp_gather_pp_tokens(
+	const PreprocessingAstNode*         const& pp_tokens,
+	vector<const PreprocessingToken*>        & tokens)
+{
+	if (pp_tokens == NULL) {
+		return;
+	}
+	if (pp_tokens->get_name() 
+		== PreprocessingAstNodeName::PREPROCESSING_TOKEN) {
+		tokens.push_back(pp_tokens->get_terminal());
+		return;
+	}
+	for (const PreprocessingAstNode* child = pp_tokens->get_child();
+		 child != NULL;
+		 child = child->get_sibling()) {
+		pp_gather_pp_tokens(child, tokens);
+	}
+}
+
+static inline
+void pp_expand_constant_expression(
+	vector<const PreprocessingToken*> const& tokens,
+	SymbolTable                            & symtab,
+	vector<uint32_t>                       & expanding,
+	vector<const PreprocessingToken*>      & expanded)
+{
+	for (size_t i = 0; i < tokens.size(); i++) {
+		const PreprocessingToken* const token
+			= tokens[i];
+		if (token->get_name() != PreprocessingTokenName::IDENTIFIER) {
+			expanded.push_back(token);
+			continue;
+		}
+		if (strcmp(token->get_lexeme(), "defined") == 0) {
+			/* The operand of defined is not expanded, so
+			   defined and what follows it up to the macro
+			   name are copied across as they are. */
+			expanded.push_back(token);
+			size_t num_operand_tokens = 1;
+			if (i + 1 < tokens.size()
+				&& tokens[i + 1]->get_form() 
+				   == PreprocessingTokenForm::OPEN_PAREN) {
+				num_operand_tokens = 2;
+			}
+			for (size_t j = 0; 
+				 j < num_operand_tokens && i + 1 < tokens.size();
+				 j++) {
+				expanded.push_back(tokens[++i]);
+			}
+			continue;
+		}
+		const SymbolTableEntry* const entry
+			= symtab.get_entry(token->get_atom());
+		const bool is_expanding
+			= find(expanding.begin(), expanding.end(), token->get_atom())
+			  != expanding.end();
+		if (entry == NULL
+			|| entry->identifier_type != IdentifierClassifier::MACRO_NAME
+			|| is_expanding) {
+			expanded.push_back(token);
+			continue;
+		}
+		vector<const PreprocessingToken*> replacement;
+		pp_gather_pp_tokens(entry->replacement_list, replacement);
+		expanding.push_back(token->get_atom());
+		pp_expand_constant_expression(
+			replacement,
+			symtab,
+			expanding,
+			expanded);
+		expanding.pop_back();
+	}
+}
+
+static inline
+PreprocessorExitCode pp_execute_if_group(
+	PreprocessingAstNode*       & if_group,
+	AlertList                   & bkl,
+	SymbolTable                 & symtab,
+	bool                        & is_taken,
+	PreprocessingAstNode*       & selected_group)
+{
+	PreprocessorExitCode exitcode 
 		= PreprocessorExitCode::FAILURE;
 
-	switch (latter_group->get_alt()) {
+	bool condition 
+		= false;
+	PreprocessingAstNode* lower_group
+		= NULL;
+
+	switch (if_group->get_alt()) {
 
-		case PreprocessingAstNodeAlt::GROUP_1:
+		case PreprocessingAstNodeAlt::IF_GROUP_1:
 		{
-			PreprocessingAstNode* latter_group_group_part
-				= latter_group->get_child();
-			PreprocessingAstNode* higher_group
-				= new PreprocessingAstNode(
-					PreprocessingAstNodeName::GROUP,
-					PreprocessingAstNodeAlt::GROUP_2,
-					NULL);
-			higher_group->add_child(
-				former_group);
-			higher_group->add_child(
-				latter_group_group_part);
-			former_group
-				= higher_group;
-			exitcode
-				= PreprocessorExitCode::SUCCESS;
+			PreprocessingAstNode* constant_expression
+				= if_group->get_child();
+			PreprocessingAstNode* new_line
+				= constant_expression->get_sibling();
+			lower_group
+				= new_line->get_sibling();
+
+			if (pp_execute_constant_expression(
+					constant_expression,
+					bkl,
+					symtab,
+					condition)
+				!= PreprocessorExitCode::SUCCESS) {
+				return exitcode;
+			}
 			break;
 		}
 
-		case PreprocessingAstNodeAlt::PP_TOKENS_2:
-		{
-			PreprocessingAstNode* latter_group_group
-				= latter_group->get_child();
-			PreprocessingAstNode* latter_group_group_part
-				= latter_group_group->get_sibling();
-
-			pp_insert_group_into_group(
-				former_group,
-				latter_group_group,
-				symtab);
-			PreprocessingAstNode* higher_group
-				= new PreprocessingAstNode(
-					PreprocessingAstNodeName::GROUP,
-					PreprocessingAstNodeAlt::GROUP_2,
-					NULL);
-			higher_group->add_child(
-				former_group);
-			higher_group->add_child(
-				latter_group_group_part);
-			former_group
-				= higher_group;
-			exitcode
-				= PreprocessorExitCode::SUCCESS;
+		case PreprocessingAstNodeAlt::IF_GROUP_2:
+		case PreprocessingAstNodeAlt::IF_GROUP_3:
+		{	
+			PreprocessingAstNode* identifier
+				= if_group->get_child();
+			PreprocessingAstNode* new_line
+				= identifier->get_sibling();
+			lower_group
+				= new_line->get_sibling();
+
+			condition 
+				= pp_is_macro_defined(
+					identifier->get_terminal(),
+					&symtab);
+			if (if_group->get_alt() 
+				== PreprocessingAstNodeAlt::IF_GROUP_3) {
+				condition = !condition;
+			}
 			break;
 		}
 
 		default:
-			break;
+			return exitcode;
+
+	}
+
+	if (condition) {
+		is_taken = true;
+		selected_group = lower_group;
 	}
+	exitcode = PreprocessorExitCode::SUCCESS;
 
 	return exitcode;
 }
 
 static inline
-PreprocessorExitCode pp_execute_group(
-	PreprocessingAstNode* & group,
+PreprocessorExitCode pp_execute_elif_groups(
+	PreprocessingAstNode* & elif_groups,
 	AlertList             & bkl,
 	SymbolTable           & symtab,
-	PreprocessingAstNode* & executed_group)
+	bool                  & is_taken,
+	PreprocessingAstNode* & selected_group)
 {
 	PreprocessorExitCode exitcode 
 		= PreprocessorExitCode::FAILURE;
 
-	switch (group->get_alt()) {
-	
-		case PreprocessingAstNodeAlt::GROUP_1:
-		{	
-			PreprocessingAstNode* group_part			
-				= group->get_child();			
-			PreprocessingAstNode* executed_group_part
-				= NULL;
+	switch (elif_groups->get_alt()) {
 
-			if (pp_execute_group_part(
-					group_part,
+		case PreprocessingAstNodeAlt::ELIF_GROUPS_1:
+		{
+			PreprocessingAstNode* elif_group
+				= elif_groups->get_child();
+			if (pp_execute_elif_group(
+					elif_group,
 					bkl,
 					symtab,
-					executed_group_part)
-				!= PreprocessorExitCode::SUCCESS) {
-				break;
-			}
-			if (executed_group_part) {
-				executed_group
-					= new PreprocessingAstNode(
-						PreprocessingAstNodeName::GROUP,
-						PreprocessingAstNodeAlt::GROUP_1,
-						NULL);
-				executed_group->add_child(executed_group_part);
-			
-			} else {
-				executed_group = NULL;
-			}
-
-			exitcode 
-				= PreprocessorExitCode::SUCCESS;
-			break;
-		}
-
-		case PreprocessingAstNodeAlt::GROUP_2:
-		{
-			PreprocessingAstNode* lower_group
-				= group->get_child();
-			PreprocessingAstNode* group_part
-				= lower_group->get_sibling();
-
-			PreprocessingAstNode* executed_former_group;
-			if (pp_execute_group(
-					lower_group,
-					bkl,
-					symtab,
-					executed_former_group)
-				!= PreprocessorExitCode::SUCCESS) {
-				break;
-			}
-			PreprocessingAstNode* executed_latter_group;
-			if (pp_execute_group_part(
-					group_part,
-					bkl,
-				 	symtab,
-					executed_latter_group)
-				!= PreprocessorExitCode::SUCCESS) {
-				break;
-			}
-
-			if (executed_former_group) {
-
-				if (executed_latter_group) {
-					pp_insert_group_into_group(
-						executed_former_group,
-						executed_latter_group,
-						symtab);
-				} 
-
-				executed_group 
-					= executed_former_group;
-
-			} else if (executed_latter_group) {
-				executed_group
-					= executed_latter_group;
-
-			} else {
-				executed_group 
-					= NULL;
-			}
-
-			exitcode 
-				= PreprocessorExitCode::SUCCESS;
-			break;
-		}
-
-		default:
-			break;
-
-	}
-
-	return exitcode;
-}
-
-static inline
-PreprocessorExitCode pp_execute_group_part(
-	PreprocessingAstNode*       & group_part,
-	AlertList                   & bkl,
-	SymbolTable                 & symtab,
-	PreprocessingAstNode*       & executed_group_part)
-{
-	PreprocessorExitCode exitcode 
-		= PreprocessorExitCode::FAILURE;
-
-	switch (group_part->get_alt()) {
-
-		case PreprocessingAstNodeAlt::GROUP_PART_1:
-		{
-			PreprocessingAstNode* if_section
-				= group_part->get_child();
-			if (pp_execute_if_section(
-					if_section,
-					bkl,
-					symtab,
-					executed_group_part
-				)
-				== PreprocessorExitCode::FAILURE) {
-				break;
-			}
-			exitcode = PreprocessorExitCode::SUCCESS;
-			break;
-		}
-
-		case PreprocessingAstNodeAlt::GROUP_PART_2:
-		{
-			PreprocessingAstNode* control_line
-				= group_part->get_child();
-			if (pp_execute_control_line(
-					control_line, 
-					group_part,
-					bkl, 
-					symtab)
-				== PreprocessorExitCode::FAILURE) {
-				break;
-			}
-			exitcode = PreprocessorExitCode::SUCCESS;
-			break;
-		}
-
-		case PreprocessingAstNodeAlt::GROUP_PART_3:
-		{
-			PreprocessingAstNode* text_line
-				= group_part->get_child();
-			if (pp_execute_text_line(
-					text_line,
-					bkl,
-					symtab) 
-				!= PreprocessorExitCode::SUCCESS) {
-				break;
-			}
-			executed_group_part = group_part;
-			exitcode = PreprocessorExitCode::SUCCESS;
-			break;
-		}
-
-		case PreprocessingAstNodeAlt::GROUP_PART_4:
-		{
-			PreprocessingAstNode* non_directive
-				= group_part->get_child();
-			if (pp_execute_non_directive(
-					non_directive,
-					bkl,
-					symtab)
-				== PreprocessorExitCode::SUCCESS) {
-				break;
-			}
-			exitcode = PreprocessorExitCode::SUCCESS;
-			break;
-		}
-
-		default:
-			break;
-	}
-
-	return exitcode;
-}
-
-static inline
-PreprocessorExitCode pp_execute_if_section(
-	PreprocessingAstNode*       & if_section,
-	AlertList                   & bkl,
-	SymbolTable                 & symtab,	
-	PreprocessingAstNode*       & executed_group)
-{
-	PreprocessorExitCode exitcode 
-		= PreprocessorExitCode::FAILURE;
-
-	PreprocessingAstNode* if_group
-		= if_section->get_child();
-	PreprocessingAstNode* if_group_sibling
-		= if_group->get_sibling();
-	PreprocessingAstNode* elif_groups
-		= (if_group_sibling->get_name()
-		   == PreprocessingAstNodeName::ELIF_GROUPS)
-		  ? if_group_sibling
-		  : NULL;
-	PreprocessingAstNode* else_group
-		= elif_groups
-		  ? ((elif_groups->get_sibling()->get_name()
-		      == PreprocessingAstNodeName::ELIF_GROUPS)
-		     ? elif_groups->get_sibling()
-		     : NULL)
-		  : ((if_group_sibling->get_name()
-		      == PreprocessingAstNodeName::ELSE_GROUP)
-		     ? if_group_sibling
-			 : NULL);
-	PreprocessingAstNode* endif_line
-		= else_group
-		  ? else_group->get_sibling()
-		  : (elif_groups 
-		     ? elif_groups->get_sibling()
-		     : if_group->get_sibling());
-
-	pp_execute_if_group(
-		if_group,
-		bkl,
-		symtab,
-		executed_group);
-	if (elif_groups) {
-		pp_execute_elif_groups(
-			elif_groups,
-			bkl,
-			symtab);
-	}
-	if (else_group) {
-		pp_execute_else_group(
-			else_group,
-			bkl,
-			symtab);
-	}
-	pp_execute_endif_line(
-		endif_line,
-		bkl,
-		symtab);
-
-	exitcode = PreprocessorExitCode::SUCCESS;
-
-	return exitcode;
-}
-
-static inline
-PreprocessorExitCode pp_execute_if_group(
-	PreprocessingAstNode*       & if_group,
-	AlertList                   & bkl,
-	SymbolTable                 & symtab,
-	PreprocessingAstNode*       & executed_group)
-{
-	PreprocessorExitCode exitcode 
-		= PreprocessorExitCode::FAILURE;
-
-	switch (if_group->get_alt()) {
-
-		case PreprocessingAstNodeAlt::IF_GROUP_1:
-		{
-			PreprocessingAstNode* constant_expression
-				= if_group->get_child();
-			PreprocessingAstNode* new_line
-				= constant_expression->get_sibling();
-			PreprocessingAstNode* lower_group
-				= new_line->get_sibling();
-
-			PreprocessingToken preprocessing_tokens[16]
-				= { };
-			PreprocessingToken* preprocessing_tokens_ptr
-				= preprocessing_tokens;
-
-			/* Get the Tokens within the conditional expression. */
-			pp_gen_pp_tokens(
-				constant_expression->get_child(),
-				preprocessing_tokens_ptr,
-				bkl,
-				symtab);
-			int num_preprocessing_tokens
-				= preprocessing_tokens_ptr 
-				  - preprocessing_tokens;
-
-			preprocessing_tokens_ptr
-				= preprocessing_tokens;
-			Token tokens[16]
-				= { };
-			Token* tokens_ptr
-				= tokens;
-
-			lex(
-				preprocessing_tokens_ptr,
-				tokens_ptr,
-				num_preprocessing_tokens,
-				bkl);
-
-			/* Get the Abstract Syntax Tree associated
-				with the conditional expression. */
-			const Token* new_tokens_ptr
-				= tokens;
-			AstNode* ast_constant_expression;
-			parse_constant_expression(
-				NULL,
-				new_tokens_ptr,
-				ast_constant_expression);
-
-			/* Annotate the abstract syntax tree associated
-				with the conditional expression. */
-			AnnotatedAstNode* anno_ast_constant_expression;
-			construct_unatrributed_annotated_ast(
-				ast_constant_expression,
-				anno_ast_constant_expression);
-			SymbolTable* symtab = new SymbolTable();
-			visit_constant_expression(
-				anno_ast_constant_expression,
-				symtab);
-
-			uint64_t constant_expression_val
-				= 0;
-
-			constant_expression_val
-				= anno_ast_constant_expression->get_constant_val()
-				  != 0;
-
-			if (constant_expression_val) {
-				executed_group = lower_group;
-			}
-			exitcode = PreprocessorExitCode::SUCCESS;
-			break;
-		}
-
-		case PreprocessingAstNodeAlt::IF_GROUP_2:
-		{	
-			PreprocessingAstNode* identifier
-				= if_group->get_child();
-			PreprocessingAstNode* new_line
-				= identifier->get_sibling();
-			PreprocessingAstNode* group
-				= new_line->get_sibling();
-			break;
-		}
-		
-		case PreprocessingAstNodeAlt::IF_GROUP_3:
-		{
-			PreprocessingAstNode* identifier
-				= if_group->get_child();
-			PreprocessingAstNode* new_line
-				= identifier->get_sibling();
-			PreprocessingAstNode* group
-				= new_line->get_sibling();
-
-			break;
-		}
-
-		default:
-			break;
-
-	}
-
-	return exitcode;
-}
-
-static inline
-PreprocessorExitCode pp_execute_elif_groups(
-	PreprocessingAstNode* & elif_groups,
-	AlertList             & bkl,
-	SymbolTable           & symtab)
-{
-	PreprocessorExitCode exitcode 
-		= PreprocessorExitCode::FAILURE;
-
-	switch (elif_groups->get_alt()) {
-
-		case PreprocessingAstNodeAlt::ELIF_GROUPS_1:
-		{
-			PreprocessingAstNode* elif_group
-				= elif_groups->get_child();
-			if (pp_execute_elif_group(
-					elif_group,
-					bkl,
-					symtab)
+					is_taken,
+					selected_group)
 				== PreprocessorExitCode::FAILURE) {
 				break;
 			}
@@ -5647,14 +5263,18 @@ PreprocessorExitCode pp_execute_elif_groups(
 			if (pp_execute_elif_groups(
 					lesser_elif_groups,
 					bkl,
-					symtab)
+					symtab,
+					is_taken,
+					selected_group)
 				== PreprocessorExitCode::FAILURE) {
 				break;
 			}
 			if (pp_execute_elif_group(
 					elif_group,
 					bkl,
-					symtab)
+					symtab,
+					is_taken,
+					selected_group)
 				== PreprocessorExitCode::FAILURE) {
 				break;
 			}
@@ -5686,11 +5306,39 @@ static inline
 PreprocessorExitCode pp_execute_constant_expression(
 	PreprocessingAstNode* & constant_expression,
 	AlertList             & bkl,
-	SymbolTable           & symtab)
+	SymbolTable           & symtab,
+	bool                  & value)
 {
 	PreprocessorExitCode exitcode 
 		= PreprocessorExitCode::FAILURE;
 
+	vector<const PreprocessingToken*> tokens;
+	pp_gather_pp_tokens(
+		constant_expression,
+		tokens);
+
+	vector<const PreprocessingToken*> expanded_tokens;
+	vector<uint32_t> expanding;
+	pp_expand_constant_expression(
+		tokens,
+		symtab,
+		expanding,
+		expanded_tokens);
+
+	PpValue expression_value;
+	if (evaluate_pp_expression(
+			expanded_tokens.data(),
+			expanded_tokens.size(),
+			pp_is_macro_defined,
+			&symtab,
+			bkl,
+			expression_value)
+		!= PpExpressionExitCode::SUCCESS) {
+		return exitcode;
+	}
+	value = expression_value.bits != 0;
+	exitcode = PreprocessorExitCode::SUCCESS;
+
 	return exitcode;
 }
 
@@ -5698,10 +5346,46 @@ static inline
 PreprocessorExitCode pp_execute_elif_group(
 	PreprocessingAstNode* & elif_group,
 	AlertList             & bkl,
-	SymbolTable           & symtab)
+	SymbolTable           & symtab,
+	bool                  & is_taken,
+	PreprocessingAstNode* & selected_group)
 {
 	PreprocessorExitCode exitcode 
 		= PreprocessorExitCode::FAILURE;
+
+	/* An #elif after the group taken is not evaluated. */
+	if (is_taken) {
+		exitcode = PreprocessorExitCode::SUCCESS;
+		return exitcode;
+	}
+
+	PreprocessingAstNode* hashtag
+		= elif_group->get_child();
+	PreprocessingAstNode* elif
+		= hashtag->get_sibling();
+	PreprocessingAstNode* constant_expression
+		= elif->get_sibling();
+	PreprocessingAstNode* new_line
+		= constant_expression->get_sibling();
+	PreprocessingAstNode* lower_group
+		= new_line->get_sibling();
+
+	bool condition
+		= false;
+	if (pp_execute_constant_expression(
+			constant_expression,
+			bkl,
+			symtab,
+			condition)
+		!= PreprocessorExitCode::SUCCESS) {
+		return exitcode;
+	}
+	if (condition) {
+		is_taken = true;
+		selected_group = lower_group;
+	}
+	exitcode = PreprocessorExitCode::SUCCESS;
+
 	return exitcode;
 }
 
@@ -5709,10 +5393,29 @@ static inline
 PreprocessorExitCode pp_execute_else_group(
 	PreprocessingAstNode* & else_group,
 	AlertList             & bkl,
-	SymbolTable           & symtab)
+	SymbolTable           & symtab,
+	bool                  & is_taken,
+	PreprocessingAstNode* & selected_group)
 {
 	PreprocessorExitCode exitcode 
-		= PreprocessorExitCode::FAILURE;
+		= PreprocessorExitCode::SUCCESS;
+
+	if (is_taken) {
+		return exitcode;
+	}
+
+	PreprocessingAstNode* hashtag
+		= else_group->get_child();
+	PreprocessingAstNode* else_token
+		= hashtag->get_sibling();
+	PreprocessingAstNode* new_line
+		= else_token->get_sibling();
+	PreprocessingAstNode* lower_group
+		= new_line->get_sibling();
+
+	is_taken = true;
+	selected_group = lower_group;
+
 	return exitcode;
 }
 
@@ -5727,16 +5430,192 @@ PreprocessorExitCode pp_execute_endif_line(
 	return exitcode;
 }
 
+static inline
+bool pp_find_header_name(
+	const PreprocessingAstNode* const& pp_tokens,
+	SourceMap                        & sources,
+	SymbolTable                      & symtab,
+	string                           & spelling,
+	bool                             & is_angled)
+{
+	vector<const PreprocessingToken*> tokens;
+	pp_gather_pp_tokens(pp_tokens, tokens);
+	if (!tokens.empty()
+		&& tokens[0]->get_name() == PreprocessingTokenName::IDENTIFIER) {
+		vector<uint32_t> expanding;
+		vector<const PreprocessingToken*> expanded;
+		pp_expand_constant_expression(
+			tokens,
+			symtab,
+			expanding,
+			expanded);
+		tokens = expanded;
+	}
+	if (tokens.size() == 1
+		&& tokens[0]->get_name() == PreprocessingTokenName::STRING_LITERAL
+		&& tokens[0]->get_lexeme()[0] == '"') {
+		const char* const lexeme
+			= tokens[0]->get_lexeme();
+		spelling.assign(lexeme + 1, strlen(lexeme) - 2);
+		is_angled = false;
+		return true;
+	}
+	if (tokens.size() >= 2
+		&& is_pp_punctuator(tokens.front(), PreprocessingTokenForm::LESS_THAN)
+		&& is_pp_punctuator(tokens.back(), PreprocessingTokenForm::GREATER_THAN)) {
+		/* The name is spelt as it is written between the
+		   delimiters, whatever tokens it was split into. */
+		const SourceLocation start
+			= tokens.front()->get_location();
+		const SourceLocation end
+			= tokens.back()->get_location();
+		const SourceMapFile* const file
+			= sources.get_file(start.file_id);
+		if (file == NULL
+			|| end.file_id != start.file_id) {
+			return false;
+		}
+		spelling.assign(
+			file->input + start.offset + 1,
+			end.offset - start.offset - 1);
+		is_angled = true;
+		return true;
+	}
+	return false;
+}
+
+static inline
+bool pp_find_include_guard(
+	const PreprocessingAstNode* const& group_part,
+	bool                             & has_if_section,
+	uint32_t                         & guard)
+{
+	switch (group_part->get_alt()) {
+
+		case PreprocessingAstNodeAlt::GROUP_PART_1:
+		{
+			if (has_if_section) {
+				return false;
+			}
+			has_if_section = true;
+			const PreprocessingAstNode* const if_group
+				= group_part->get_child()->get_child();
+			if (if_group->get_alt() != PreprocessingAstNodeAlt::IF_GROUP_3
+				|| if_group->get_sibling() == NULL
+				|| if_group->get_sibling()->get_name()
+				   != PreprocessingAstNodeName::ENDIF_LINE) {
+				return false;
+			}
+			guard = if_group->get_child()->get_terminal()->get_atom();
+			return true;
+		}
+
+		case PreprocessingAstNodeAlt::GROUP_PART_2:
+			return group_part->get_child()->get_alt()
+				   == PreprocessingAstNodeAlt::CONTROL_LINE_10;
+
+		case PreprocessingAstNodeAlt::GROUP_PART_3:
+			return group_part->get_child()->get_child()->get_name()
+				   == PreprocessingAstNodeName::NEW_LINE;
+
+		default:
+			return false;
+	}
+}
+
+static inline
+PreprocessingAstNode* pp_copy_tree(
+	const PreprocessingAstNode* const& node)
+{
+	if (node == NULL) {
+		return NULL;
+	}
+	PreprocessingAstNode* const copy
+		= new PreprocessingAstNode(
+			node->get_name(),
+			node->get_alt(),
+			node->get_terminal() != NULL
+			? new PreprocessingToken(*node->get_terminal())
+			: NULL);
+	for (const PreprocessingAstNode* child = node->get_child();
+		 child != NULL;
+		 child = child->get_sibling()) {
+		copy->add_child(pp_copy_tree(child));
+	}
+	return copy;
+}
+
 static inline
 PreprocessorExitCode pp_execute_control_line_1(
 	PreprocessingAstNode* & control_line,
-	PreprocessingAstNode* & group_part,
+	SourceMap             & sources,
+	IncludeTable          & includes,
 	AlertList             & bkl,
-	SymbolTable           & symtab)
+	SymbolTable           & symtab,
+	IncludedFile*         & entered_file)
 {
 	PreprocessorExitCode exitcode 
 		= PreprocessorExitCode::FAILURE;
-	/* TODO; */
+	entered_file = NULL;
+
+	const PreprocessingToken* const hash
+		= control_line->get_child()->get_terminal();
+	const PreprocessingAstNode* const pp_tokens
+		= control_line->get_child()->get_sibling()->get_sibling();
+
+	string spelling;
+	bool is_angled;
+	if (!pp_find_header_name(
+			pp_tokens,
+			sources,
+			symtab,
+			spelling,
+			is_angled)) {
+		bkl.add_error(construct_error_book(
+			ErrorCode::ERR_PP_INVALID_INCLUDE,
+			"#include expects \"FILENAME\" or <FILENAME>.",
+			hash->get_location(),
+			(unsigned int) strlen(hash->get_lexeme())));
+		return exitcode;
+	}
+
+	IncludedFile* file;
+	if (includes.find(
+			spelling,
+			is_angled,
+			sources.get_file(hash->get_location().file_id)->filename,
+			sources,
+			file)
+		!= IncludeTableExitCode::SUCCESS) {
+		bkl.add_error(construct_error_book(
+			ErrorCode::ERR_PP_INCLUDE_NOT_FOUND,
+			"The file to #include could not be found.",
+			hash->get_location(),
+			(unsigned int) strlen(hash->get_lexeme())));
+		return exitcode;
+	}
+
+	/* A file that would leave nothing behind if
+	   included again is not looked at again. */
+	if (file->is_once
+		|| (file->has_guard
+			&& symtab.get_entry(file->guard) != NULL
+			&& symtab.get_entry(file->guard)->identifier_type
+			   == IdentifierClassifier::MACRO_NAME)) {
+		exitcode = PreprocessorExitCode::SUCCESS;
+		return exitcode;
+	}
+
+	if (!includes.enter()) {
+		bkl.add_error(construct_error_book(
+			ErrorCode::ERR_PP_INVALID_INCLUDE,
+			"#include nested too deeply.",
+			hash->get_location(),
+			(unsigned int) strlen(hash->get_lexeme())));
+		return exitcode;
+	}
+	entered_file = file;
+	exitcode = PreprocessorExitCode::SUCCESS;
 	return exitcode;
 }
 
@@ -5749,10 +5628,20 @@ PreprocessorExitCode pp_execute_control_line_2(
 	PreprocessorExitCode exitcode 
 		= PreprocessorExitCode::FAILURE;
 
-	PreprocessingAstNode* identifier
+	PreprocessingAstNode* hashtag
 		= control_line->get_child();
+	PreprocessingAstNode* define
+		= hashtag->get_sibling();
+	PreprocessingAstNode* identifier
+		= define->get_sibling();
 	PreprocessingAstNode* replacement_list
 		= identifier->get_sibling();
+	/* An empty replacement list is followed straight
+	   by the new-line. */
+	if (replacement_list->get_name() 
+		!= PreprocessingAstNodeName::PP_TOKENS) {
+		replacement_list = NULL;
+	}
 
 	PreprocessingToken* terminal
 		= identifier->get_terminal();
@@ -5765,8 +5654,10 @@ PreprocessorExitCode pp_execute_control_line_2(
 		= symtab.get_entry(lexeme);
 	entry->identifier_type  
 		= IdentifierClassifier::MACRO_NAME;
+	/* The line is freed once it is read, so the list
+	   is copied to outlast it. */
 	entry->replacement_list 
-		= replacement_list;
+		= pp_copy_tree(replacement_list);
 
 	return exitcode;
 }
@@ -5855,13 +5746,28 @@ PreprocessorExitCode pp_execute_control_line_8(
 static inline
 PreprocessorExitCode pp_execute_control_line_9(
 	PreprocessingAstNode* & control_line,
+	IncludeTable          & includes,
 	AlertList             & bkl,
 	SymbolTable           & symtab)
 {
 	PreprocessorExitCode exitcode 
-		= PreprocessorExitCode::FAILURE;
-	switch (control_line->get_alt()) {
+		= PreprocessorExitCode::SUCCESS;
 
+	const PreprocessingToken* const hash
+		= control_line->get_child()->get_terminal();
+	vector<const PreprocessingToken*> tokens;
+	pp_gather_pp_tokens(
+		control_line->get_child()->get_sibling()->get_sibling(),
+		tokens);
+	/* Pragmas other than once are ignored. */
+	if (tokens.size() == 1
+		&& tokens[0]->get_name() == PreprocessingTokenName::IDENTIFIER
+		&& strcmp(tokens[0]->get_lexeme(), "once") == 0) {
+		IncludedFile* const file
+			= includes.get_file(hash->get_location().file_id);
+		if (file != NULL) {
+			file->is_once = true;
+		}
 	}
 	return exitcode;
 }
@@ -5869,20 +5775,25 @@ PreprocessorExitCode pp_execute_control_line_9(
 static inline
 PreprocessorExitCode pp_execute_control_line(
 	PreprocessingAstNode* & control_line,
-	PreprocessingAstNode* & group_part,
+	SourceMap             & sources,
+	IncludeTable          & includes,
 	AlertList             & bkl,
-	SymbolTable           & symtab)
+	SymbolTable           & symtab,
+	IncludedFile*         & entered_file)
 {
 	PreprocessorExitCode exitcode = PreprocessorExitCode::FAILURE;
+	entered_file = NULL;
 	switch (control_line->get_alt()) {
 
 		case PreprocessingAstNodeAlt::CONTROL_LINE_1:
 		{
-			pp_execute_control_line_1(
+			exitcode = pp_execute_control_line_1(
 				control_line,
-				group_part,
+				sources,
+				includes,
 				bkl,
-				symtab);
+				symtab,
+				entered_file);
 			break;
 		}
 
@@ -5950,8 +5861,9 @@ PreprocessorExitCode pp_execute_control_line(
 
 		case PreprocessingAstNodeAlt::CONTROL_LINE_9:
 		{
-			pp_execute_control_line_9(
+			exitcode = pp_execute_control_line_9(
 				control_line,
+				includes,
 				bkl,
 				symtab);
 			break;
@@ -6100,10 +6012,8 @@ PreprocessorExitCode pp_execute_pp_tokens(
 			if (terminal->get_name()
 				== PreprocessingTokenName::IDENTIFIER) {
 
-				const char* lexeme
-					= terminal->get_lexeme();
 				SymbolTableEntry* entry
-					= symtab.get_entry(lexeme);
+					= symtab.get_entry(terminal->get_atom());
 				if (entry != NULL
 					&& (entry->identifier_type 
 					    == IdentifierClassifier::MACRO_NAME)) {
@@ -6132,10 +6042,8 @@ PreprocessorExitCode pp_execute_pp_tokens(
 			if (terminal->get_name()
 				== PreprocessingTokenName::IDENTIFIER) {
 
-				const char* lexeme
-					= terminal->get_lexeme();
 				SymbolTableEntry* entry
-					= symtab.get_entry(lexeme);
+					= symtab.get_entry(terminal->get_atom());
 				if (entry != NULL
 					&& (entry->identifier_type
 						== IdentifierClassifier::MACRO_NAME)) {
@@ -6159,321 +6067,255 @@ PreprocessorExitCode pp_execute_pp_tokens(
 	return exitcode;
 }
 
-static inline
-PreprocessorExitCode pp_gen_preprocessing_file(
-	PreprocessingAstNode* const& preprocessing_file,
-	PreprocessingToken*        & output,
-	AlertList                  & bkl,
-	SymbolTable                & symtab)
+inline PreprocessorStream::PreprocessorStream(
+	const char*  const& input,
+	LexemaPool        & l,
+	const char*  const& filename,
+	SourceMap         & s,
+	IncludeTable      & i,
+	AlertList         & b)
+	: lexema_pool(&l),
+	  sources(&s),
+	  includes(&i),
+	  bkl(&b),
+	  symtab(),
+	  next_line_token(0),
+	  num_pp_tokens(0),
+	  exitcode(PreprocessorExitCode::SUCCESS)
 {
-	PreprocessorExitCode exitcode 
-		= PreprocessorExitCode::SUCCESS;
-	
-	symtab = SymbolTable();
+	const SourceMapFile* const source
+		= sources->add_file(filename, input);
+	push_frame(input, source, NULL, false);
+}
 
-	PreprocessingAstNode* group 
-		= preprocessing_file->get_child();
-	if (group) {
+inline PreprocessorStream::~PreprocessorStream()
+{
+	/* A stream may be dropped before its end. */
+	leave_frames();
+}
 
-		if (pp_gen_group(
-				group,
-				output,
-				bkl, 
-				symtab)
-			== PreprocessorExitCode::SUCCESS) {
-			exitcode 
-				= PreprocessorExitCode::SUCCESS;
+inline bool PreprocessorStream::fill(
+	PreprocessingTokenRing& ring)
+{
+	const size_t initial_count
+		= ring.get_count();
+	while (!ring.is_full()) {
+		if (next_line_token < line_tokens.size()) {
+			ring.push(*line_tokens[next_line_token++]);
+			num_pp_tokens++;
+		} else if (!frames.empty()) {
+			step();
+		} else {
+			break;
 		}
-
-	} else {
-		exitcode 
-			= PreprocessorExitCode::SUCCESS;
 	}
-
-	return exitcode;
+	return ring.get_count() > initial_count;
 }
 
-static inline
-PreprocessorExitCode pp_gen_group(
-	PreprocessingAstNode* const& group,
-	PreprocessingToken*        & output,
-	AlertList                  & bkl,
-	SymbolTable                & symtab)
+inline void PreprocessorStream::push_frame(
+	const char*          const& input,
+	const SourceMapFile* const& source,
+	IncludedFile*        const& file,
+	bool                 const& is_group)
 {
-	PreprocessorExitCode exitcode 
-		= PreprocessorExitCode::SUCCESS;
-
-	switch (group->get_alt()) {
+	frames.push_back(PreprocessorFrame({
+		input,
+		source,
+		file,
+		is_group,
+		!is_group,
+		false,
+		0 }));
+}
 
-		case PreprocessingAstNodeAlt::GROUP_1:
-		{
-			PreprocessingAstNode* group_part
-				= group->get_child();
-			if (pp_gen_group_part(
-					group_part,
-					output,
-					bkl,
-					symtab)
-				!= PreprocessorExitCode::SUCCESS) {
-				break;
-			}
-			break;
+inline void PreprocessorStream::pop_frame(
+	const char* const& input)
+{
+	PreprocessorFrame& frame
+		= frames.back();
+	if (!frame.is_group) {
+		if (pp_check_end_of_file(
+				input,
+				*frame.source,
+				*bkl)
+			!= PreprocessorExitCode::SUCCESS) {
+			fail();
+			return;
 		}
-
-		case PreprocessingAstNodeAlt::GROUP_2:
-		{
-			PreprocessingAstNode* lesser_group
-				= group->get_child();
-			PreprocessingAstNode* group_part
-				= lesser_group->get_sibling();
-			if (pp_gen_group(
-					lesser_group,
-					output,
-					bkl,
-					symtab)
-				!= PreprocessorExitCode::SUCCESS) {
-				break;
-			}
-			if (pp_gen_group_part(
-					group_part,
-					output,
-					bkl,
-					symtab)
-				!= PreprocessorExitCode::SUCCESS) {
-				break;
-			}
-			break;
+		if (frame.file != NULL) {
+			frame.file->has_guard
+				= frame.is_guarded && frame.has_if_section;
+			frame.file->guard
+				= frame.guard;
+			includes->leave();
 		}
+	}
+	frames.pop_back();
+}
 
-		default:
-			break;
+inline void PreprocessorStream::step()
+{
+	/* Whatever the last group-part left in the line
+	   arena has been read by now.                  */
+	line_tokens.clear();
+	next_line_token = 0;
+	line_arena.reset();
+
+	PreprocessorFrame& frame
+		= frames.back();
+	const char* input
+		= frame.input;
+	PreprocessingAstNode* group_part
+		= NULL;
+	Arena* const arena
+		= active_arena;
+	active_arena = &line_arena;
+	const PreprocessorExitCode parse_exitcode
+		= pp_parse_group_part(
+			input,
+			*lexema_pool,
+			*frame.source,
+			*bkl,
+			group_part);
+	active_arena = arena;
+
+	if (parse_exitcode != PreprocessorExitCode::SUCCESS) {
+		/* The file or group has ended. */
+		pop_frame(input);
+		return;
 	}
-	return exitcode;
+	frame.input = input;
+	if (frame.is_guarded) {
+		frame.is_guarded = pp_find_include_guard(
+			group_part,
+			frame.has_if_section,
+			frame.guard);
+	}
+	execute_group_part(group_part);
 }
 
-static inline
-PreprocessorExitCode pp_gen_group_part(
-	PreprocessingAstNode* const& group_part,
-	PreprocessingToken*        & output,
-	AlertList                  & bkl,
-	SymbolTable                & symtab)
+inline void PreprocessorStream::execute_group_part(
+	PreprocessingAstNode* const& group_part)
 {
-	PreprocessorExitCode exitcode 
-		= PreprocessorExitCode::FAILURE;
+	PreprocessingAstNode* child
+		= group_part->get_child();
 
 	switch (group_part->get_alt()) {
 
 		case PreprocessingAstNodeAlt::GROUP_PART_1:
 		{
-			/* Cannot generate tokens from
-			   an if-section, it is a directive 
-			   not text. */
+			PreprocessingAstNode* selected_group
+				= NULL;
+			if (pp_execute_if_section(
+					child,
+					*bkl,
+					symtab,
+					selected_group)
+				!= PreprocessorExitCode::SUCCESS) {
+				fail();
+				break;
+			}
+			if (selected_group != NULL) {
+				/* The group is read from where it starts,
+				   kept in the node's value. */
+				const uint64_t location
+					= selected_group->get_val();
+				const SourceMapFile* const source
+					= sources->get_file((uint32_t) (location >> 32));
+				push_frame(
+					source->input + (uint32_t) location,
+					source,
+					NULL,
+					true);
+			}
 			break;
 		}
 
 		case PreprocessingAstNodeAlt::GROUP_PART_2:
 		{
-			/* Cannot generate tokens from
-			   a control-line, it is a directive
-			   not text. */
-			break;
-		}
-
-		case PreprocessingAstNodeAlt::GROUP_PART_3:
-		{
-			PreprocessingAstNode* text_line
-				= group_part->get_child();
-			if (pp_gen_text_line(
-				text_line,
-				output,
-				bkl,
-				symtab)
-				!= PreprocessorExitCode::SUCCESS) {
+			/* Only the failure of an #include fails the
+			   file; the other control lines are not all
+			   carried out yet. */
+			IncludedFile* entered_file
+				= NULL;
+			if (pp_execute_control_line(
+					child,
+					*sources,
+					*includes,
+					*bkl,
+					symtab,
+					entered_file)
+				!= PreprocessorExitCode::SUCCESS
+				&& child->get_alt()
+				   == PreprocessingAstNodeAlt::CONTROL_LINE_1) {
+				fail();
 				break;
 			}
-			exitcode
-				= PreprocessorExitCode::SUCCESS;
+			if (entered_file != NULL) {
+				push_frame(
+					entered_file->source->input,
+					entered_file->source,
+					entered_file,
+					false);
+			}
 			break;
 		}
 
-		case PreprocessingAstNodeAlt::GROUP_PART_4:
+		case PreprocessingAstNodeAlt::GROUP_PART_3:
 		{
-			PreprocessingAstNode* non_directive
-				= group_part->get_child();
-			pp_gen_non_directive(
-				non_directive,
-				output,
-				bkl,
-				symtab);
-			exitcode
-				= PreprocessorExitCode::SUCCESS;
+			pp_gather_pp_tokens(
+				child,
+				line_tokens);
 			break;
 		}
 
 		default:
+			/* Non-directives are ignored. */
 			break;
-
-	}
-
-	return exitcode;
-}
-
-static inline
-PreprocessorExitCode pp_gen_text_line(
-	PreprocessingAstNode* const& text_line,
-	PreprocessingToken*        & output,
-	AlertList                  & bkl,
-	SymbolTable                & symtab)
-{
-	PreprocessorExitCode exitcode 
-		= PreprocessorExitCode::SUCCESS;
-
-	PreprocessingAstNode* pp_tokens
-		= text_line->get_child();
-	if (pp_tokens
-		&& pp_gen_pp_tokens(
-		       pp_tokens,
-			   output,
-			   bkl,
-			   symtab)
-			== PreprocessorExitCode::SUCCESS) {
-		exitcode 
-			= PreprocessorExitCode::SUCCESS;
-	} else {
-		exitcode
-			= PreprocessorExitCode::SUCCESS;
 	}
-
-	return exitcode;
 }
 
-static inline
-PreprocessorExitCode pp_gen_non_directive(
-	PreprocessingAstNode* const& non_directive,
-	PreprocessingToken*        & output,
-	AlertList                  & bkl,
-	SymbolTable                & symtab)
+inline void PreprocessorStream::fail()
 {
-	PreprocessorExitCode exitcode 
-		= PreprocessorExitCode::SUCCESS;
-	/* Do not need to do anything in this case, 
-	   much like a comment it is ignored. */
-	return exitcode;
+	exitcode = PreprocessorExitCode::FAILURE;
+	leave_frames();
 }
 
-static inline
-PreprocessorExitCode pp_gen_pp_tokens(
-	PreprocessingAstNode* const& pp_tokens,
-	PreprocessingToken*        & output,
-	AlertList                  & bkl,
-	SymbolTable                & symtab)
+inline void PreprocessorStream::leave_frames()
 {
-	PreprocessorExitCode exitcode 
-		= PreprocessorExitCode::FAILURE;
-
-	switch (pp_tokens->get_alt()) {
-
-		case PreprocessingAstNodeAlt::PP_TOKENS_1:
-		{
-			PreprocessingAstNode* preprocessing_token
-				= pp_tokens->get_child();
-			if (pp_gen_preprocessing_token(
-					preprocessing_token,
-					output,
-					bkl,
-					symtab) 
-				!= PreprocessorExitCode::SUCCESS) {
-				break;
-			}
-			exitcode 
-				= PreprocessorExitCode::SUCCESS;
-			break;
-		}
-
-		case PreprocessingAstNodeAlt::PP_TOKENS_2:
-		{
-			PreprocessingAstNode* lesser_pp_tokens
-				= pp_tokens->get_child();
-			PreprocessingAstNode* preprocessing_token
-				= lesser_pp_tokens->get_sibling();
-			if (pp_gen_pp_tokens(
-					lesser_pp_tokens,
-					output,
-					bkl,
-					symtab)
-				!= PreprocessorExitCode::SUCCESS) {
-				break;
-			}
-			if (pp_gen_preprocessing_token(
-					preprocessing_token,
-					output,
-					bkl,
-					symtab)
-				!= PreprocessorExitCode::SUCCESS) {
-				break;
-			}
-			exitcode 
-				= PreprocessorExitCode::SUCCESS;
-			break;
+	while (!frames.empty()) {
+		if (frames.back().file != NULL) {
+			includes->leave();
 		}
-
-		default:
-			break;
+		frames.pop_back();
 	}
-
-	return exitcode;
-}
-
-static inline
-PreprocessorExitCode pp_gen_preprocessing_token(
-	PreprocessingAstNode* const& preprocessing_token,
-	PreprocessingToken*        & output,
-	AlertList                  & bkl,
-	SymbolTable                & symtab)
-{
-	*output++ = *(preprocessing_token->get_terminal());
-	return PreprocessorExitCode::SUCCESS;
 }
 
 static inline
 PreprocessorExitCode preprocess(
-	const char*              & input,
-	LexemaPool               & lexema_pool,
-	const char*         const& filename,
-	AlertList                & bkl,
-	PreprocessingToken*      & pp_tokens)
+	const char*                & input,
+	LexemaPool                 & lexema_pool,
+	const char*           const& filename,
+	SourceMap                  & sources,
+	IncludeTable               & includes,
+	AlertList                  & bkl,
+	PreprocessingTokenAppender & pp_tokens)
 {
-	PreprocessorExitCode exitcode 
-		= PreprocessorExitCode::SUCCESS;
-	FileLocationDescriptor file_location_descriptor
-		= FileLocationDescriptor( 
-			  { filename, 0, 0, 0 } );
-	/* Parse the Preprocessing File */
-	PreprocessingAstNode* preprocessing_file;
-	SymbolTable symtab;
-	pp_parse_preprocessing_file(
+	PreprocessorStream stream(
 		input,
 		lexema_pool,
-		file_location_descriptor,
-		bkl,
-		preprocessing_file);
-	/* Execute the preprocessing file, 
-	   acting on given directives. */
-	PreprocessingAstNode* executed_preprocessing_file;
-	pp_execute_preprocessing_file(
-		preprocessing_file,
-		bkl,
-		executed_preprocessing_file);
-	/* Convert the directed preprocessing ast node 
-	   tree back into a series of preprocessing 
-	   tokens suitable for input into the lexer.   */
-	pp_gen_preprocessing_file(
-		executed_preprocessing_file,
-		pp_tokens,
-		bkl,
-		symtab);
-
-	return exitcode;
+		filename,
+		sources,
+		includes,
+		bkl);
+	PreprocessingTokenRing ring;
+	while (stream.fill(ring)) {
+		while (!ring.is_empty()) {
+			*pp_tokens++ = ring.front();
+			ring.pop();
+		}
+	}
+	return stream.get_exitcode();
 }
 
 #endif
\ No newline at end of file
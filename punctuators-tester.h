@@ -0,0 +1,201 @@
+/* Authored by Charlie Keaney                      */
+/* punctuators-tester.h - Responsible for testing
+						  the recognition of
+						  punctuators.            */
+
+#ifndef PUNCTUATORS_TESTER_H
+#define PUNCTUATORS_TESTER_H 1
+
+#include "tester-tools.h"
+#include "punctuators.h"
+
+#define NUM_PUNCTUATORS_TESTS 2
+
+//////////////////////////////////////////////////////////////////
+//      Testing for the longest match of a punctuator           //
+//////////////////////////////////////////////////////////////////
+
+#define NUM_PUNCTUATOR_MATCH_TESTS 30
+
+struct punctuator_match_test_case {
+	const char*            input;
+	size_t                 length;
+	PreprocessingTokenForm form;
+};
+
+static const
+punctuator_match_test_case
+test_punctuator_match_table[NUM_PUNCTUATOR_MATCH_TESTS] = {
+	{ "",      0, PreprocessingTokenForm::UNDEFINED                   },
+	{ "a",     0, PreprocessingTokenForm::UNDEFINED                   },
+	{ "@",     0, PreprocessingTokenForm::UNDEFINED                   },
+	{ " +",    0, PreprocessingTokenForm::UNDEFINED                   },
+	{ "+",     1, PreprocessingTokenForm::PLUS                        },
+	{ "+a",    1, PreprocessingTokenForm::PLUS                        },
+	{ "++",    2, PreprocessingTokenForm::INCREMENT                   },
+	{ "+++",   2, PreprocessingTokenForm::INCREMENT                   },
+	{ "+=",    2, PreprocessingTokenForm::PLUS_EQUALS                 },
+	{ "-=>",   2, PreprocessingTokenForm::MINUS_EQUALS                },
+	{ "->>",   2, PreprocessingTokenForm::RIGHT_ARROW                 },
+	{ "<",     1, PreprocessingTokenForm::LESS_THAN                   },
+	{ "<<",    2, PreprocessingTokenForm::LEFT_SHIFT                  },
+	{ "<<=x",  3, PreprocessingTokenForm::LEFT_SHIFT_EQUALS           },
+	{ ">>=",   3, PreprocessingTokenForm::RIGHT_SHIFT_EQUALS          },
+	{ "!==",   2, PreprocessingTokenForm::NOT_EQUAL                   },
+	{ "|||",   2, PreprocessingTokenForm::DOUBLE_OR                   },
+	{ "&&=",   2, PreprocessingTokenForm::DOUBLE_AMPERSAND            },
+	{ "::",    1, PreprocessingTokenForm::COLON                       },
+	{ ".",     1, PreprocessingTokenForm::DOT                         },
+	{ "..x",   1, PreprocessingTokenForm::DOT                         },
+	{ "...",   3, PreprocessingTokenForm::TRIPLE_DOT                  },
+	{ "....",  3, PreprocessingTokenForm::TRIPLE_DOT                  },
+	{ "#",     1, PreprocessingTokenForm::HASHTAG                     },
+	{ "###",   2, PreprocessingTokenForm::DOUBLE_HASHTAG              },
+	{ "<:",    2, PreprocessingTokenForm::BIGRAPH_OPEN_BRACKET        },
+	{ ":>",    2, PreprocessingTokenForm::BIGRAPH_CLOSE_BRACKET       },
+	{ "%:%>",  2, PreprocessingTokenForm::BIGRAPH_HASHTAG             },
+	{ "%:%",   2, PreprocessingTokenForm::BIGRAPH_HASHTAG             },
+	{ "%:%:%", 4, PreprocessingTokenForm::BIGRAPH_DOUBLE_HASHTAG      }
+};
+
+/**
+* Matches the longest punctuator at the start of each
+* input, expecting its form and where it ends, even
+* where a longer punctuator was begun but not
+* finished.
+**/
+static inline TestResult test_punctuator_match(
+	TestResult results[NUM_PUNCTUATOR_MATCH_TESTS])
+{
+	bool all_tests_passed = true;
+	for (const punctuator_match_test_case* ptc
+			= test_punctuator_match_table;
+		ptc < test_punctuator_match_table + NUM_PUNCTUATOR_MATCH_TESTS;
+		ptc++) {
+		PreprocessingTokenForm form;
+		const char* const end
+			= match_punctuator(ptc->input, form);
+		const bool success_criteria
+			= end == ptc->input + ptc->length
+			  && form == ptc->form;
+		results[ptc - test_punctuator_match_table]
+			= success_criteria ? TestResult::SUCCESS : TestResult::FAIL;
+		if (!success_criteria) {
+			all_tests_passed = false;
+		}
+	}
+	return all_tests_passed ? TestResult::SUCCESS : TestResult::FAIL;
+}
+
+//////////////////////////////////////////////////////////////////
+//       Testing for the lookup of a whole punctuator           //
+//////////////////////////////////////////////////////////////////
+
+#define NUM_PUNCTUATOR_LOOKUP_TESTS 20
+
+struct punctuator_lookup_test_case {
+	const char*            lexeme;
+	PreprocessingTokenForm form;
+	TokenForm              token_form;
+};
+
+static const
+punctuator_lookup_test_case
+test_punctuator_lookup_table[NUM_PUNCTUATOR_LOOKUP_TESTS] = {
+	{ "[",    PreprocessingTokenForm::OPEN_BRACKET,           TokenForm::OPEN_BRACKET           },
+	{ "+",    PreprocessingTokenForm::PLUS,                   TokenForm::PLUS                   },
+	{ "->",   PreprocessingTokenForm::RIGHT_ARROW,            TokenForm::RIGHT_ARROW            },
+	{ "<<=",  PreprocessingTokenForm::LEFT_SHIFT_EQUALS,      TokenForm::LEFT_SHIFT_EQUALS      },
+	{ "!=",   PreprocessingTokenForm::NOT_EQUAL,              TokenForm::NOT_EQUAL              },
+	{ "||",   PreprocessingTokenForm::DOUBLE_OR,              TokenForm::DOUBLE_OR              },
+	{ "...",  PreprocessingTokenForm::TRIPLE_DOT,             TokenForm::TRIPLE_DOT             },
+	{ "#",    PreprocessingTokenForm::HASHTAG,                TokenForm::HASHTAG                },
+	{ "%:",   PreprocessingTokenForm::BIGRAPH_HASHTAG,        TokenForm::BIGRAPH_HASHTAG        },
+	{ "%:%:", PreprocessingTokenForm::BIGRAPH_DOUBLE_HASHTAG, TokenForm::BIGRAPH_DOUBLE_HASHTAG },
+	{ "",     PreprocessingTokenForm::UNDEFINED,              TokenForm::SIMPLE                 },
+	{ "..",   PreprocessingTokenForm::UNDEFINED,              TokenForm::SIMPLE                 },
+	{ "%:%",  PreprocessingTokenForm::UNDEFINED,              TokenForm::SIMPLE                 },
+	{ "<<<",  PreprocessingTokenForm::UNDEFINED,              TokenForm::SIMPLE                 },
+	{ "++=",  PreprocessingTokenForm::UNDEFINED,              TokenForm::SIMPLE                 },
+	{ "+ ",   PreprocessingTokenForm::UNDEFINED,              TokenForm::SIMPLE                 },
+	{ " +",   PreprocessingTokenForm::UNDEFINED,              TokenForm::SIMPLE                 },
+	{ "=>",   PreprocessingTokenForm::UNDEFINED,              TokenForm::SIMPLE                 },
+	{ "+a",   PreprocessingTokenForm::UNDEFINED,              TokenForm::SIMPLE                 },
+	{ "a",    PreprocessingTokenForm::UNDEFINED,              TokenForm::SIMPLE                 }
+};
+
+/**
+* Looks up each lexeme as a whole punctuator, which it
+* must spell exactly, expecting the form of its
+* pp-token and, for a punctuator, of its token.
+**/
+static inline TestResult test_punctuator_lookup(
+	TestResult results[NUM_PUNCTUATOR_LOOKUP_TESTS])
+{
+	bool all_tests_passed = true;
+	for (const punctuator_lookup_test_case* ptc
+			= test_punctuator_lookup_table;
+		ptc < test_punctuator_lookup_table + NUM_PUNCTUATOR_LOOKUP_TESTS;
+		ptc++) {
+		const PreprocessingTokenForm form
+			= lookup_punctuator(ptc->lexeme);
+		const bool success_criteria
+			= form == ptc->form
+			  && (form == PreprocessingTokenForm::UNDEFINED
+				  || get_punctuator_token_form(form)
+					 == ptc->token_form);
+		results[ptc - test_punctuator_lookup_table]
+			= success_criteria ? TestResult::SUCCESS : TestResult::FAIL;
+		if (!success_criteria) {
+			all_tests_passed = false;
+		}
+	}
+	return all_tests_passed ? TestResult::SUCCESS : TestResult::FAIL;
+}
+
+static inline TestResult test_punctuators(
+	TestResult results[NUM_PUNCTUATORS_TESTS],
+	char* &output,
+	int indent = 0)
+{
+	TestResult match_results[NUM_PUNCTUATOR_MATCH_TESTS];
+	TestResult match_result
+		= test_punctuator_match(match_results);
+	results[0] = match_result;
+
+	TestResult lookup_results[NUM_PUNCTUATOR_LOOKUP_TESTS];
+	TestResult lookup_result
+		= test_punctuator_lookup(lookup_results);
+	results[1] = lookup_result;
+
+	for (int i = 0; i < indent; i++) print_to_output("\t", output);
+	print_to_output("<-> PunctuatorsTests", output);
+	print_to_output("\n", output);
+
+	const char* match_title = "PunctuatorMatchTests";
+	present_test_set_synopsis(
+		match_title,
+		match_result,
+		match_results,
+		NUM_PUNCTUATOR_MATCH_TESTS,
+		output,
+		indent + 1
+	);
+
+	const char* lookup_title = "PunctuatorLookupTests";
+	present_test_set_synopsis(
+		lookup_title,
+		lookup_result,
+		lookup_results,
+		NUM_PUNCTUATOR_LOOKUP_TESTS,
+		output,
+		indent + 1
+	);
+
+	return (match_result == TestResult::SUCCESS
+			&& lookup_result == TestResult::SUCCESS)
+		   ? TestResult::SUCCESS
+		   : TestResult::FAIL;
+}
+
+#endif
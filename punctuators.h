@@ -0,0 +1,272 @@
+/* Authored by Charlie Keaney                     */
+/* punctuators.h - Responsible for recognising the
+				   punctuators of C, digraphs
+				   included, for both the
+				   preprocessor and the lexer.
+
+				   Implementation Notes:
+				   The punctuators are recognised
+				   by a DFA built at compile time
+				   from their spellings, as the
+				   trie of those spellings. Bytes
+				   are first mapped to a class,
+				   one for each character some
+				   punctuator uses and one for
+				   every other, so the table is
+				   states by classes rather than
+				   states by bytes. State 0 is
+				   dead and state 1 is the start.
+
+				   The preprocessor takes the
+				   longest punctuator at the
+				   start of its input, the lexer
+				   only a lexeme spelling one
+				   punctuator exactly.          */
+
+#ifndef PUNCTUATORS_H
+#define PUNCTUATORS_H 1
+
+#include <cstddef>
+#include <cstdint>
+
+#include "preprocessing-token.h"
+#include "token.h"
+
+#define NUM_PUNCTUATORS 54
+
+#define PUNCTUATOR_DFA_MAX_STATES  128
+#define PUNCTUATOR_DFA_MAX_CLASSES 32
+
+#define PUNCTUATOR_DFA_DEAD  0
+#define PUNCTUATOR_DFA_START 1
+
+using namespace std;
+
+/*****************************************************//**
+*                      Declarations                      *
+/********************************************************/
+
+struct Punctuator {
+	const char*            spelling;
+	PreprocessingTokenForm form;
+};
+
+/**
+* The DFA recognising punctuators. A state accepts if
+* its form is not UNDEFINED.
+**/
+struct PunctuatorDfa {
+	size_t                 num_states;
+	size_t                 num_classes;
+	uint8_t                byte_class[256];
+	uint8_t                transitions[PUNCTUATOR_DFA_MAX_STATES]
+									  [PUNCTUATOR_DFA_MAX_CLASSES];
+	PreprocessingTokenForm accepts[PUNCTUATOR_DFA_MAX_STATES];
+};
+
+static constexpr Punctuator punctuators[NUM_PUNCTUATORS] = {
+	{ "[",    PreprocessingTokenForm::OPEN_BRACKET                },
+	{ "]",    PreprocessingTokenForm::CLOSE_BRACKET               },
+	{ "(",    PreprocessingTokenForm::OPEN_PAREN                  },
+	{ ")",    PreprocessingTokenForm::CLOSE_PAREN                 },
+	{ "{",    PreprocessingTokenForm::OPEN_CURLY_BRACKET          },
+	{ "}",    PreprocessingTokenForm::CLOSE_CURLY_BRACKET         },
+	{ ".",    PreprocessingTokenForm::DOT                         },
+	{ "&",    PreprocessingTokenForm::AMPERSAND                   },
+	{ "*",    PreprocessingTokenForm::ASTERIX                     },
+	{ "+",    PreprocessingTokenForm::PLUS                        },
+	{ "-",    PreprocessingTokenForm::MINUS                       },
+	{ "~",    PreprocessingTokenForm::TILDE                       },
+	{ "!",    PreprocessingTokenForm::EXCLAMATION_MARK            },
+	{ "/",    PreprocessingTokenForm::FORWARD_SLASH               },
+	{ "%",    PreprocessingTokenForm::MODULO                      },
+	{ "++",   PreprocessingTokenForm::INCREMENT                   },
+	{ "--",   PreprocessingTokenForm::DECREMENT                   },
+	{ "->",   PreprocessingTokenForm::RIGHT_ARROW                 },
+	{ "<<",   PreprocessingTokenForm::LEFT_SHIFT                  },
+	{ "<",    PreprocessingTokenForm::LESS_THAN                   },
+	{ ">",    PreprocessingTokenForm::GREATER_THAN                },
+	{ "<=",   PreprocessingTokenForm::LESS_THAN_EQUAL             },
+	{ ">=",   PreprocessingTokenForm::GREATER_THAN_EQUAL          },
+	{ "==",   PreprocessingTokenForm::EQUAL                       },
+	{ "!=",   PreprocessingTokenForm::NOT_EQUAL                   },
+	{ "^",    PreprocessingTokenForm::XOR                         },
+	{ "|",    PreprocessingTokenForm::OR                          },
+	{ "&&",   PreprocessingTokenForm::DOUBLE_AMPERSAND            },
+	{ "||",   PreprocessingTokenForm::DOUBLE_OR                   },
+	{ "?",    PreprocessingTokenForm::QUESTION_MARK               },
+	{ ":",    PreprocessingTokenForm::COLON                       },
+	{ ";",    PreprocessingTokenForm::SEMI_COLON                  },
+	{ "...",  PreprocessingTokenForm::TRIPLE_DOT                  },
+	{ "=",    PreprocessingTokenForm::ASSIGN                      },
+	{ "*=",   PreprocessingTokenForm::MULTIPLY_EQUAL              },
+	{ "/=",   PreprocessingTokenForm::DIVIDE_EQUALS               },
+	{ "%=",   PreprocessingTokenForm::MODULO_EQUALS               },
+	{ "+=",   PreprocessingTokenForm::PLUS_EQUALS                 },
+	{ "-=",   PreprocessingTokenForm::MINUS_EQUALS                },
+	{ "<<=",  PreprocessingTokenForm::LEFT_SHIFT_EQUALS           },
+	{ ">>",   PreprocessingTokenForm::RIGHT_SHIFT                 },
+	{ ">>=",  PreprocessingTokenForm::RIGHT_SHIFT_EQUALS          },
+	{ "&=",   PreprocessingTokenForm::AMPERSAND_EQUAL             },
+	{ "^=",   PreprocessingTokenForm::XOR_EQUAL                   },
+	{ "|=",   PreprocessingTokenForm::OR_EQUAL                    },
+	{ ",",    PreprocessingTokenForm::COMMA                       },
+	{ "#",    PreprocessingTokenForm::HASHTAG                     },
+	{ "##",   PreprocessingTokenForm::DOUBLE_HASHTAG              },
+	{ "<:",   PreprocessingTokenForm::BIGRAPH_OPEN_BRACKET        },
+	{ ":>",   PreprocessingTokenForm::BIGRAPH_CLOSE_BRACKET       },
+	{ "<%",   PreprocessingTokenForm::BIGRAPH_OPEN_CURLY_BRACKET  },
+	{ "%>",   PreprocessingTokenForm::BIGRAPH_CLOSE_CURLY_BRACKET },
+	{ "%:",   PreprocessingTokenForm::BIGRAPH_HASHTAG             },
+	{ "%:%:", PreprocessingTokenForm::BIGRAPH_DOUBLE_HASHTAG      }
+};
+
+/* The lexer's punctuator forms follow the same order
+   as the preprocessor's, so one converts to the other
+   by an offset.                                     */
+static_assert(
+	(int) TokenForm::BIGRAPH_DOUBLE_HASHTAG
+	- (int) TokenForm::OPEN_BRACKET
+	== (int) PreprocessingTokenForm::BIGRAPH_DOUBLE_HASHTAG
+	   - (int) PreprocessingTokenForm::OPEN_BRACKET,
+	"punctuator forms differ between tokens and pp-tokens");
+
+/**
+* Builds the punctuator DFA from the spellings of the
+* punctuators.
+*
+* @return Returns the DFA.
+**/
+static constexpr inline
+PunctuatorDfa construct_punctuator_dfa();
+
+/**
+* Finds the longest punctuator at the start of the
+* input.
+*
+* @param input The input to match against.
+* @param form Set to the punctuator's form, or to
+*		 UNDEFINED if the input starts with none.
+* @return Returns the end of the punctuator, or the
+*		  input itself if there is none.
+**/
+static inline
+const char* match_punctuator(
+	const char*            const& input,
+	PreprocessingTokenForm      & form);
+
+/**
+* Returns the form of punctuator the given lexeme
+* spells, all of it.
+*
+* @param lexeme The NUL terminated lexeme.
+* @return Returns the form, or UNDEFINED if the lexeme
+*		  is not exactly one punctuator.
+**/
+static inline
+PreprocessingTokenForm lookup_punctuator(
+	const char* const& lexeme);
+
+/**
+* Converts the form of a punctuator pp-token into the
+* form of its token.
+*
+* @param form A punctuator form of pp-token.
+* @return Returns the matching form of token.
+**/
+static inline
+TokenForm get_punctuator_token_form(
+	PreprocessingTokenForm const& form);
+
+/*****************************************************//**
+*                         Definitions                    *
+/********************************************************/
+
+static constexpr inline
+PunctuatorDfa construct_punctuator_dfa()
+{
+	PunctuatorDfa dfa = { };
+	/* Class 0 holds every byte no punctuator uses. */
+	dfa.num_classes = 1;
+	dfa.num_states  = PUNCTUATOR_DFA_START + 1;
+	for (size_t p = 0; p < NUM_PUNCTUATORS; p++) {
+		size_t state = PUNCTUATOR_DFA_START;
+		for (const char* c = punctuators[p].spelling; *c; c++) {
+			uint8_t& cls
+				= dfa.byte_class[(unsigned char) *c];
+			if (cls == 0) {
+				if (dfa.num_classes == PUNCTUATOR_DFA_MAX_CLASSES) {
+					return PunctuatorDfa({ });
+				}
+				cls = (uint8_t) dfa.num_classes++;
+			}
+			uint8_t& next
+				= dfa.transitions[state][cls];
+			if (next == PUNCTUATOR_DFA_DEAD) {
+				if (dfa.num_states == PUNCTUATOR_DFA_MAX_STATES) {
+					return PunctuatorDfa({ });
+				}
+				next = (uint8_t) dfa.num_states++;
+			}
+			state = next;
+		}
+		dfa.accepts[state] = punctuators[p].form;
+	}
+	return dfa;
+}
+
+static constexpr PunctuatorDfa punctuator_dfa
+	= construct_punctuator_dfa();
+
+static_assert(
+	punctuator_dfa.num_states != 0,
+	"the punctuator DFA outgrew its table");
+
+static inline
+const char* match_punctuator(
+	const char*            const& input,
+	PreprocessingTokenForm      & form)
+{
+	const char* end = input;
+	form = PreprocessingTokenForm::UNDEFINED;
+	size_t state = PUNCTUATOR_DFA_START;
+	for (const char* c = input; ; c++) {
+		state = punctuator_dfa.transitions[state][
+			punctuator_dfa.byte_class[(unsigned char) *c]];
+		if (state == PUNCTUATOR_DFA_DEAD) {
+			return end;
+		}
+		if (punctuator_dfa.accepts[state]
+			!= PreprocessingTokenForm::UNDEFINED) {
+			form = punctuator_dfa.accepts[state];
+			end  = c + 1;
+		}
+	}
+}
+
+static inline
+PreprocessingTokenForm lookup_punctuator(
+	const char* const& lexeme)
+{
+	size_t state = PUNCTUATOR_DFA_START;
+	for (const char* c = lexeme; *c; c++) {
+		state = punctuator_dfa.transitions[state][
+			punctuator_dfa.byte_class[(unsigned char) *c]];
+		if (state == PUNCTUATOR_DFA_DEAD) {
+			return PreprocessingTokenForm::UNDEFINED;
+		}
+	}
+	return punctuator_dfa.accepts[state];
+}
+
+static inline
+TokenForm get_punctuator_token_form(
+	PreprocessingTokenForm const& form)
+{
+	return (TokenForm) (
+		(int) TokenForm::OPEN_BRACKET
+		+ (int) form
+		- (int) PreprocessingTokenForm::OPEN_BRACKET);
+}
+
+#endif
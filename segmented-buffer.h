@@ -0,0 +1,378 @@
+/* Authored by Charlie Keaney                          */
+/* segmented-buffer.h - Responsible for storing the
+						growing sequences produced by
+						each phase of the compiler
+						(pp-tokens, tokens and x86 ir).
+
+						Implementation Notes:
+						Elements are appended into
+						fixed-size chunks which are
+						linked together. A full chunk
+						is never reallocated, so a
+						pointer to an element stays
+						valid for the life of the
+						buffer and every append is
+						O(1).
+
+						A buffer may be given a source,
+						in which case a cursor that
+						runs off the end asks the
+						source to append more elements
+						before giving up, so a buffer
+						can be filled on demand as it
+						is read.                      */
+
+#ifndef SEGMENTED_BUFFER_H
+#define SEGMENTED_BUFFER_H 1
+
+#include <cstddef>
+
+#define SEGMENTED_BUFFER_CHUNK_BYTES (1 << 16)
+
+/*****************************************************//**
+*                      Declarations                      *
+/********************************************************/
+
+/**
+* A single fixed-size block of elements within a
+* segmented buffer.
+**/
+template <typename T>
+struct SegmentedBufferChunk {
+	SegmentedBufferChunk<T>* next_chunk;
+	size_t                   count;
+	size_t                   capacity;
+	T*                       data;
+};
+
+/**
+* Appends more elements onto a segmented buffer when
+* a cursor reaches its end.
+*
+* @param context The context given with the source.
+* @return Returns false once there is nothing left
+*		  to append.
+**/
+typedef bool (*SegmentedBufferSource)(
+	void* const& context);
+
+template <typename T>
+class SegmentedBufferCursor;
+
+template <typename T>
+class SegmentedBufferAppender;
+
+/**
+* An append-only sequence of elements which grows
+* one chunk at a time without moving what it holds.
+**/
+template <typename T>
+class SegmentedBuffer {
+private:
+	SegmentedBufferChunk<T>* first_chunk;
+	SegmentedBufferChunk<T>* last_chunk;
+	size_t                   size;
+	SegmentedBufferSource    source;
+	void*                    source_context;
+
+	inline SegmentedBufferChunk<T>* construct_chunk()
+	{
+		size_t capacity
+			= SEGMENTED_BUFFER_CHUNK_BYTES / sizeof(T);
+		if (capacity == 0) {
+			capacity = 1;
+		}
+		SegmentedBufferChunk<T>* chunk
+			= new SegmentedBufferChunk<T>();
+		chunk->next_chunk = NULL;
+		chunk->count      = 0;
+		chunk->capacity   = capacity;
+		chunk->data       = new T[capacity] { };
+		return chunk;
+	}
+
+public:
+	inline SegmentedBuffer()
+		: first_chunk(NULL),
+		  last_chunk(NULL),
+		  size(0),
+		  source(NULL),
+		  source_context(NULL) {
+		first_chunk = construct_chunk();
+		last_chunk  = first_chunk;
+	};
+
+	SegmentedBuffer(const SegmentedBuffer<T>&) = delete;
+	SegmentedBuffer<T>& operator=(const SegmentedBuffer<T>&) = delete;
+
+	inline ~SegmentedBuffer() {
+		SegmentedBufferChunk<T>* chunk = first_chunk;
+		while (chunk != NULL) {
+			SegmentedBufferChunk<T>* next_chunk
+				= chunk->next_chunk;
+			delete[] chunk->data;
+			delete chunk;
+			chunk = next_chunk;
+		}
+	};
+
+	/**
+	* Returns the slot the next appended element will
+	* occupy, opening a new chunk if the last is full.
+	* The slot is not counted until it is committed.
+	**/
+	inline T* reserve()
+	{
+		if (last_chunk->count == last_chunk->capacity) {
+			SegmentedBufferChunk<T>* chunk
+				= construct_chunk();
+			last_chunk->next_chunk = chunk;
+			last_chunk = chunk;
+		}
+		return last_chunk->data + last_chunk->count;
+	}
+
+	/**
+	* Counts the most recently reserved slot as part
+	* of the buffer.
+	**/
+	inline void commit()
+	{
+		last_chunk->count++;
+		size++;
+	}
+
+	inline void push_back(
+		T const& element)
+	{
+		*reserve() = element;
+		commit();
+	}
+
+	inline size_t get_size() const
+	{
+		return size;
+	}
+
+	/**
+	* Sets the source asked for more elements when a
+	* cursor reaches the end of the buffer.
+	**/
+	inline void set_source(
+		SegmentedBufferSource const& s,
+		void*                 const& context)
+	{
+		source         = s;
+		source_context = context;
+	}
+
+	/**
+	* Asks the source for more elements.
+	*
+	* @return Returns false if there is no source or
+	*		  the source has nothing left to append.
+	**/
+	inline bool pull() const
+	{
+		return source != NULL
+			   && source(source_context);
+	}
+
+	inline const SegmentedBufferChunk<T>* get_first_chunk() const
+	{
+		return first_chunk;
+	}
+
+	inline SegmentedBufferCursor<T> begin() const
+	{
+		return SegmentedBufferCursor<T>(first_chunk, 0, this);
+	}
+
+	/**
+	* Returns a cursor one past the elements appended so
+	* far. The source is not consulted.
+	**/
+	inline SegmentedBufferCursor<T> end() const
+	{
+		return SegmentedBufferCursor<T>(
+			last_chunk,
+			last_chunk->count,
+			NULL);
+	}
+
+	inline SegmentedBufferAppender<T> appender()
+	{
+		return SegmentedBufferAppender<T>(this);
+	}
+};
+
+/**
+* Reads through a segmented buffer in order. Behaves
+* like a const pointer into a contiguous array, so
+* it may be incremented, offset and dereferenced.
+**/
+template <typename T>
+class SegmentedBufferCursor {
+private:
+	const SegmentedBufferChunk<T>* chunk;
+	size_t                         index;
+	const SegmentedBuffer<T>*      buffer;
+
+	inline void normalise()
+	{
+		while (index >= chunk->count) {
+			if (chunk->next_chunk != NULL) {
+				chunk = chunk->next_chunk;
+				index = 0;
+			} else if (buffer == NULL
+					   || !buffer->pull()) {
+				break;
+			}
+		}
+	}
+
+public:
+	inline SegmentedBufferCursor()
+		: chunk(NULL),
+		  index(0),
+		  buffer(NULL) {
+	};
+
+	inline SegmentedBufferCursor(
+		const SegmentedBufferChunk<T>* const& c,
+		size_t                         const& i,
+		const SegmentedBuffer<T>*      const& b)
+		: chunk(c),
+		  index(i),
+		  buffer(b) {
+		normalise();
+	};
+
+	inline const T& operator*() const
+	{
+		return chunk->data[index];
+	}
+
+	inline const T* operator->() const
+	{
+		return chunk->data + index;
+	}
+
+
+	inline SegmentedBufferCursor<T>& operator++()
+	{
+		index++;
+		normalise();
+		return *this;
+	}
+
+	inline SegmentedBufferCursor<T> operator++(int)
+	{
+		SegmentedBufferCursor<T> previous = *this;
+		++(*this);
+		return previous;
+	}
+
+	/**
+	* Advances by n elements, a whole chunk at a time
+	* where it can.
+	**/
+	inline SegmentedBufferCursor<T>& operator+=(
+		size_t const& n)
+	{
+		size_t remaining = n;
+		while (remaining > 0) {
+			if (index >= chunk->count) {
+				/* Past the end, with nothing more to
+				   pull, just as ++ leaves it.        */
+				index += remaining;
+				break;
+			}
+			const size_t available
+				= chunk->count - index;
+			if (remaining < available) {
+				index += remaining;
+				break;
+			}
+			remaining -= available;
+			index = chunk->count;
+			normalise();
+		}
+		return *this;
+	}
+
+	inline SegmentedBufferCursor<T> operator+(
+		size_t const& n) const
+	{
+		SegmentedBufferCursor<T> result = *this;
+		result += n;
+		return result;
+	}
+
+	inline bool operator==(
+		SegmentedBufferCursor<T> const& other) const
+	{
+		return chunk == other.chunk
+			   && index == other.index;
+	}
+
+	inline bool operator!=(
+		SegmentedBufferCursor<T> const& other) const
+	{
+		return !(*this == other);
+	}
+};
+
+/**
+* Writes onto the end of a segmented buffer. Behaves
+* like an output pointer, so '*out++ = element'
+* appends an element.
+**/
+template <typename T>
+class SegmentedBufferAppender {
+private:
+	SegmentedBuffer<T>* buffer;
+	T*                  slot;
+public:
+	inline SegmentedBufferAppender()
+		: buffer(NULL),
+		  slot(NULL) {
+	};
+
+	inline SegmentedBufferAppender(
+		SegmentedBuffer<T>* const& b)
+		: buffer(b),
+		  slot(b->reserve()) {
+	};
+
+	inline T& operator*() const
+	{
+		return *slot;
+	}
+
+	inline T* operator->() const
+	{
+		return slot;
+	}
+
+	inline SegmentedBufferAppender<T>& operator++()
+	{
+		buffer->commit();
+		slot = buffer->reserve();
+		return *this;
+	}
+
+	inline SegmentedBufferAppender<T> operator++(int)
+	{
+		SegmentedBufferAppender<T> previous = *this;
+		++(*this);
+		return previous;
+	}
+
+	inline SegmentedBuffer<T>* get_buffer() const
+	{
+		return buffer;
+	}
+};
+
+#endif
@@ -10,6 +10,7 @@
 #include "annotated-ast-node.h"
 #include "semantics.h"
 #include "symbol-table.h"
+#include "numeric-literals.h"
 
 #define DEBUG_SEMANTIC_ANNOTATOR_SHOW_VISIT		    0
 #define DEBUG_SEMANTIC_ANNOTATOR_SHOW_TREE_ON_VISIT 0
@@ -1359,10 +1360,14 @@ SemanticAnnotatorExitCode visit_primary_expression(
 
 		case AstNodeAlt::PRIMARY_EXPRESSION_2:
 		{
-			const TokenValue val 
+			const TokenRef* const constant
 				= primary_expression->get_child()
-				                    ->get_terminal()
-				                    ->get_constant_val();
+				                    ->get_terminal();
+
+			const uint64_t val 
+				= get_constant_bits(
+					constant->get_constant_type(),
+					constant->get_constant_val());
 
 			const char* const symbol 
 				= primary_expression->get_child()
@@ -1377,7 +1382,7 @@ SemanticAnnotatorExitCode visit_primary_expression(
 				file->add_entry(symbol);
 				symbol_entry = file->get_entry(symbol);
 
-				symbol_entry->value = val.intvalue;
+				symbol_entry->value = val;
 				symbol_entry->is_literal = true;
 				
 				TokenForm form 
@@ -1424,7 +1429,7 @@ SemanticAnnotatorExitCode visit_primary_expression(
 			primary_expression->set_is_constant_evaluation(
 				true);
 			primary_expression->set_constant_val(
-				val.intvalue);
+				val);
 
 			exitcode = SemanticAnnotatorExitCode::SUCCESS;
 			break;
@@ -4981,7 +4986,7 @@ SemanticAnnotatorExitCode visit_direct_declarator(
 				AnnotatedAstNode* identifier
 					= node->get_child();
 
-				const Token* identifier_terminal
+				const TokenRef* identifier_terminal
 					= identifier->get_terminal();
 				const char* identifier_lexeme
 					= identifier_terminal->get_lexeme();
@@ -5934,7 +5939,7 @@ SemanticAnnotatorExitCode visit_direct_abstract_declarator(
 					direct_abstract_declarator_type);
 			}
 
-			SymbolTable* new_scope = new SymbolTable();
+			SymbolTable* new_scope = construct_symbol_table();
 			if (parameter_type_list) {
 				visit_parameter_type_list(
 					parameter_type_list,
@@ -6386,7 +6391,7 @@ SemanticAnnotatorExitCode visit_compound_statement(
 			<< endl;
 	}
 
-	node->set_symbol_table(new SymbolTable());
+	node->set_symbol_table(construct_symbol_table());
 
 	switch (node->get_alt()) {
 
@@ -6623,7 +6628,7 @@ SemanticAnnotatorExitCode visit_iteration_statement(
 
 	report_visit("visit_iteration_statement_1");
 
-	SymbolTable* scope = new SymbolTable();
+	SymbolTable* scope = construct_symbol_table();
 	node->set_symbol_table(scope);
 	switch (node->get_alt()) {
 
@@ -6795,7 +6800,7 @@ SemanticAnnotatorExitCode visit_translation_unit(
 	}
 
 	if (file == NULL) {
-		file = new SymbolTable();
+		file = construct_symbol_table();
 		node->set_symbol_table(file);
 	}
 
@@ -6816,9 +6821,14 @@ SemanticAnnotatorExitCode visit_translation_unit(
 
 		case AstNodeAlt::TRANSLATION_UNIT_2:
 		{
-			AnnotatedAstNode* external_declaration
+			AnnotatedAstNode* translation_unit
 				= node->get_child();
+			AnnotatedAstNode* external_declaration
+				= translation_unit->get_sibling();
 
+			visit_translation_unit(
+				translation_unit,
+				file);
 			visit_external_declaration(
 				external_declaration,
 				file);
@@ -6951,7 +6961,7 @@ SemanticAnnotatorExitCode visit_function_definition(
 			 << endl;
 	}
 
-	SymbolTable* function = new SymbolTable();
+	SymbolTable* function = construct_symbol_table();
 	node->set_symbol_table(function);
 
 	switch (node->get_alt()) {
@@ -7040,7 +7050,8 @@ SemanticAnnotatorExitCode visit_function_definition(
 
 			/* For each parameter */		
 			SymbolTable* sym = node->get_symbol_table();
-			SymbolTableEntry* entries[1028] = { 0 };
+			SymbolTableEntry** entries 
+				= new SymbolTableEntry*[sym->get_num_entries() + 1] { };
 			sym->get_entries(entries);			
 			int number_formal_parameters = 0;
 
@@ -7063,9 +7074,11 @@ SemanticAnnotatorExitCode visit_function_definition(
 				= number_formal_parameters;
 
 			/* For each variable */
-			SymbolTableEntry* var_entries[1028] = { 0 };
-			compound_statement->get_symbol_table()
-				              ->get_entries(var_entries);
+			SymbolTable* var_sym
+				= compound_statement->get_symbol_table();
+			SymbolTableEntry** var_entries 
+				= new SymbolTableEntry*[var_sym->get_num_entries() + 1] { };
+			var_sym->get_entries(var_entries);
 	
 			for (SymbolTableEntry** e = var_entries; *e != NULL; e++) {
 				(*e)->base_pointer_offset = base_ptr;
@@ -7078,6 +7091,8 @@ SemanticAnnotatorExitCode visit_function_definition(
 				(*e)->function_ptr 
 					= file->get_entry(declarator->get_symbol());
 			}		
+			delete[] entries;
+			delete[] var_entries;
 
 			return exitcode;
 		}
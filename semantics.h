@@ -5,6 +5,8 @@
 #ifndef SEMANTICS_H
 #define SEMANTICS_H 1
 
+#include "arena.h"
+
 /*****************************************************//**
 *                      Declarations                      *
 /********************************************************/
@@ -192,6 +194,8 @@ struct Parameter {
 	const Type*      parameter_type;
 	const char*      parameter_name;
 	const Parameter* next_parameter;
+
+	ARENA_ALLOCATED(Parameter)
 };
 
 struct FunctionType {
@@ -214,6 +218,8 @@ struct Type {
 		FunctionType   function_type;	/* FUNCTION		*/
 		IncompleteType incomplete_type; /* INCOMPLETE   */
 	};
+
+	ARENA_ALLOCATED(Type)
 };
 
 static inline
@@ -277,47 +283,58 @@ Type* construct_derived_pointer_type(
 
 static inline
 void print_union_type(
-	const UnionType* const& t);
+	const UnionType* const& t,
+	ostream               & out = cout);
 
 static inline
 void print_basic_type(
-	const BasicType* const& t);
+	const BasicType* const& t,
+	ostream               & out = cout);
 
 static inline
 void print_parameter(
-	const Parameter* const& t);
+	const Parameter* const& t,
+	ostream               & out = cout);
 
 static inline
 void print_function_type(
-	const FunctionType* const& t);
+	const FunctionType* const& t,
+	ostream                  & out = cout);
 
 static inline
 void print_pointer_type(
-	const PointerType* const& t);
+	const PointerType* const& t,
+	ostream                 & out = cout);
 
 static inline
 void print_object_type(
-	const ObjectType* const& t);
+	const ObjectType* const& t,
+	ostream                & out = cout);
 
 static inline
 void print_incomplete_type(
-	const IncompleteType* const& t);
+	const IncompleteType* const& t,
+	ostream                    & out = cout);
 
 static inline
 void print_array_type(
-	const ArrayType* const& t);
+	const ArrayType* const& t,
+	ostream               & out = cout);
 
 static inline
 void print_member_object(
-	const MemberObject* const& t);
+	const MemberObject* const& t,
+	ostream                  & out = cout);
 
 static inline
 void print_structure_type(
-	const StructureType* const& t);
+	const StructureType* const& t,
+	ostream                   & out = cout);
 
 static inline
 void print_type(
-	const Type* const& t);
+	const Type* const& t,
+	ostream          & out = cout);
 
 static inline
 const int get_sizeof_basic_type(
@@ -407,8 +424,8 @@ static const char* type_qualifier_string_repr[] {
 	"undefined type qualifier"
 };
 
-#define print_type_qualifier(q)							\
-			cout << type_qualifier_string_repr[(int) q]
+#define print_type_qualifier(q, o)						\
+			o << type_qualifier_string_repr[(int) q]
 
 static const char* basic_type_string_repr[]{
 	"undefined type",
@@ -812,85 +829,91 @@ Type* construct_derived_pointer_type(
 
 static inline
 void print_union_type(
-	const UnionType* const& t)
+	const UnionType* const& t,
+	ostream               & out)
 {
-	print_type_qualifier(t->qualifier);
-	cout << "UNION "
-		 << "{ ";
-	print_member_object(t->member_object_list);
-	cout << " }";
+	print_type_qualifier(t->qualifier, out);
+	out << "UNION "
+		<< "{ ";
+	print_member_object(t->member_object_list, out);
+	out << " }";
 }
 
 static inline
 void print_basic_type(
-	const BasicType* const& t)
+	const BasicType* const& t,
+	ostream               & out)
 {
-	print_type_qualifier(t->qualifier);
-	cout << basic_type_string_repr[(int)t->name];
+	print_type_qualifier(t->qualifier, out);
+	out << basic_type_string_repr[(int)t->name];
 }
 
 static inline
 void print_parameter(
-	const Parameter* const& t) 
+	const Parameter* const& t,
+	ostream               & out) 
 {
-	print_type(t->parameter_type);
-	cout << " ";
-	// cout << t->parameter_name;
+	print_type(t->parameter_type, out);
+	out << " ";
+	// out << t->parameter_name;
 	if (t->next_parameter != NULL) {
-		cout << ", ";
-		print_parameter(t->next_parameter);
+		out << ", ";
+		print_parameter(t->next_parameter, out);
 	}
 }
 
 static inline
 void print_function_type(
-	const FunctionType* const& t)
+	const FunctionType* const& t,
+	ostream                  & out)
 {
-	print_type(t->return_type);
-	cout << " ( ";
-	print_parameter(t->parameter_list);
-	cout << " )";
+	print_type(t->return_type, out);
+	out << " ( ";
+	print_parameter(t->parameter_list, out);
+	out << " )";
 }
 
 static inline
 void print_pointer_type(
-	const PointerType* const& t)
+	const PointerType* const& t,
+	ostream                 & out)
 {
-	print_type_qualifier(t->qualifier);
-	cout << " ";
-	print_type(t->referenced_type);
-	cout << "*";
+	print_type_qualifier(t->qualifier, out);
+	out << " ";
+	print_type(t->referenced_type, out);
+	out << "*";
 
 }
 
 static inline
 void print_object_type(
-	const ObjectType* const& t)
+	const ObjectType* const& t,
+	ostream                & out)
 {
 	switch (t->object_type_name) {
 
 		case ObjectTypeName::UNDEFINED:
-			cout << "UNDEFINED";
+			out << "UNDEFINED";
 			break;
 
 		case ObjectTypeName::BASIC_TYPE:
-			print_basic_type(&t->basic_type);
+			print_basic_type(&t->basic_type, out);
 			break;
 
 		case ObjectTypeName::ARRAY:
-			print_array_type(&t->array_type);
+			print_array_type(&t->array_type, out);
 			break;
 
 		case ObjectTypeName::STRUCTURE:
-			print_structure_type(&t->structure_type);
+			print_structure_type(&t->structure_type, out);
 			break;
 
 		case ObjectTypeName::UNION:
-			print_union_type(&t->union_type);
+			print_union_type(&t->union_type, out);
 			break;
 
 		case ObjectTypeName::POINTER:
-			print_pointer_type(&t->pointer_type);
+			print_pointer_type(&t->pointer_type, out);
 			break;
 
 		default:
@@ -901,66 +924,71 @@ void print_object_type(
 
 static inline
 void print_incomplete_type(
-	const IncompleteType* const& t)
+	const IncompleteType* const& t,
+	ostream                    & out)
 {
 	// TODO;
 }
 
 static inline
 void print_array_type(
-	const ArrayType* const& t)
+	const ArrayType* const& t,
+	ostream               & out)
 {
-	cout << type_qualifier_string_repr[(int)t->qualifier]
-		 << "ARRAY OF ";
-	print_type(t->element_type);
-	cout << " x "
-		 << t->number_of_elements;
+	out << type_qualifier_string_repr[(int)t->qualifier]
+		<< "ARRAY OF ";
+	print_type(t->element_type, out);
+	out << " x "
+		<< t->number_of_elements;
 }
 
 static inline
 void print_member_object(
-	const MemberObject* const& t)
+	const MemberObject* const& t,
+	ostream                  & out)
 {
-	print_object_type(t->object_type);
-	cout << " " 
-		 << t->name;
+	print_object_type(t->object_type, out);
+	out << " " 
+		<< t->name;
 	if (t->next_member) {
-		cout << ", ";
-		print_member_object(t->next_member);
+		out << ", ";
+		print_member_object(t->next_member, out);
 	}
 }
 
 static inline
 void print_structure_type(
-	const StructureType* const& t)
+	const StructureType* const& t,
+	ostream                   & out)
 {
-	print_type_qualifier(t->qualifier);
-	cout << "struct "
-		 << "{ ";
-	print_member_object(t->member_object_list);
-	cout << " }";
+	print_type_qualifier(t->qualifier, out);
+	out << "struct "
+		<< "{ ";
+	print_member_object(t->member_object_list, out);
+	out << " }";
 }
 
 static inline
 void print_type(
-	const Type* const& t)
+	const Type* const& t,
+	ostream          & out)
 {
 	switch (t->classifier) {
 
 		case TypeClassifier::UNDEFINED:
-			cout << "undefined type";
+			out << "undefined type";
 			break;
 
 		case TypeClassifier::OBJECT:
-			print_object_type(&t->object_type);
+			print_object_type(&t->object_type, out);
 			break;
 
 		case TypeClassifier::FUNCTION:
-			print_function_type(&t->function_type);
+			print_function_type(&t->function_type, out);
 			break;
 
 		case TypeClassifier::INCOMPLETE:
-			print_incomplete_type(&t->incomplete_type);
+			print_incomplete_type(&t->incomplete_type, out);
 			break;
 
 		default:
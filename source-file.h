@@ -0,0 +1,243 @@
+/* Authored by Charlie Keaney                        */
+/* source-file.h - Responsible for bringing a source
+				   file into memory so that the
+				   preprocessor can read it directly.
+
+				   Implementation Notes:
+				   On POSIX systems the file is mapped
+				   read-only with mmap. The preprocessor
+				   reads until it meets a NUL and peeks
+				   several characters ahead, so every
+				   mapping is guaranteed to be followed
+				   by at least SOURCE_FILE_SENTINEL_SZ
+				   zero bytes.                       */
+
+#ifndef SOURCE_FILE_H
+#define SOURCE_FILE_H 1
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define SOURCE_FILE_SENTINEL_SZ 16
+
+/*****************************************************//**
+*                      Declarations                      *
+/********************************************************/
+
+enum class SourceFileExitCode {
+	SUCCESS,
+	FAILURE
+};
+
+/**
+* Represents a source file held in memory, either
+* mapped from disk or copied into a heap buffer.
+**/
+struct SourceFile {
+	const char* filename;
+	const char* data;
+	size_t      size;
+	void*       mapping;
+	size_t      mapping_size;
+	bool        is_mapped;
+};
+
+/**
+* Opens the file at the given path and makes its
+* contents available, NUL terminated, in source.data.
+*
+* @param filename The path of the file to open.
+* @param source The source file to fill in.
+* @return Returns an exitcode for success or failure.
+**/
+static inline
+SourceFileExitCode open_source_file(
+	const char* const& filename,
+	SourceFile       & source);
+
+/**
+* Releases the memory held by a source file.
+*
+* @param source The source file to release.
+**/
+static inline
+void close_source_file(
+	SourceFile& source);
+
+/*****************************************************//**
+*                         Definitions                    *
+/********************************************************/
+
+#if defined(_WIN32)
+
+static inline
+SourceFileExitCode open_source_file(
+	const char* const& filename,
+	SourceFile       & source)
+{
+	source = SourceFile({
+		filename,
+		NULL,
+		0,
+		NULL,
+		0,
+		false
+	});
+
+	FILE* file = NULL;
+	if (fopen_s(&file, filename, "rb") != 0
+		|| file == NULL) {
+		return SourceFileExitCode::FAILURE;
+	}
+	fseek(file, 0, SEEK_END);
+	const long size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	char* buffer
+		= new char[size + SOURCE_FILE_SENTINEL_SZ] { };
+	const size_t read
+		= fread(buffer, 1, size, file);
+	fclose(file);
+
+	source.data         = buffer;
+	source.size         = read;
+	source.mapping      = buffer;
+	source.mapping_size = size + SOURCE_FILE_SENTINEL_SZ;
+	source.is_mapped    = false;
+	return SourceFileExitCode::SUCCESS;
+}
+
+#else
+
+static inline
+SourceFileExitCode open_source_file(
+	const char* const& filename,
+	SourceFile       & source)
+{
+	source = SourceFile({
+		filename,
+		NULL,
+		0,
+		NULL,
+		0,
+		false
+	});
+
+	const int fd = open(filename, O_RDONLY);
+	if (fd < 0) {
+		return SourceFileExitCode::FAILURE;
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0) {
+		close(fd);
+		return SourceFileExitCode::FAILURE;
+	}
+	const size_t size
+		= (size_t) st.st_size;
+
+	if (size == 0) {
+		/* Nothing to map, an empty buffer will do. */
+		close(fd);
+		char* buffer
+			= new char[SOURCE_FILE_SENTINEL_SZ] { };
+		source.data         = buffer;
+		source.mapping      = buffer;
+		source.mapping_size = SOURCE_FILE_SENTINEL_SZ;
+		source.is_mapped    = false;
+		return SourceFileExitCode::SUCCESS;
+	}
+
+	const size_t page_sz
+		= (size_t) sysconf(_SC_PAGESIZE);
+	const size_t mapped_pages_sz
+		= (size + page_sz - 1)
+		  & ~(page_sz - 1);
+
+	void* mapping = MAP_FAILED;
+	size_t mapping_size = 0;
+
+	if (mapped_pages_sz - size >= SOURCE_FILE_SENTINEL_SZ) {
+		/* The remainder of the last page is zero
+		   filled by the kernel, which is our sentinel. */
+		mapping_size = size;
+		mapping = mmap(
+			NULL,
+			mapping_size,
+			PROT_READ,
+			MAP_PRIVATE,
+			fd,
+			0);
+
+	} else {
+		/* The file ends at (or just before) a page
+		   boundary. Reserve an extra zeroed page
+		   and map the file over the start of it.   */
+		mapping_size = mapped_pages_sz + page_sz;
+		void* reserved = mmap(
+			NULL,
+			mapping_size,
+			PROT_READ,
+			MAP_PRIVATE | MAP_ANONYMOUS,
+			-1,
+			0);
+		if (reserved != MAP_FAILED) {
+			mapping = mmap(
+				reserved,
+				size,
+				PROT_READ,
+				MAP_PRIVATE | MAP_FIXED,
+				fd,
+				0);
+			if (mapping == MAP_FAILED) {
+				munmap(reserved, mapping_size);
+			}
+		}
+	}
+	close(fd);
+
+	if (mapping == MAP_FAILED) {
+		return SourceFileExitCode::FAILURE;
+	}
+	madvise(mapping, size, MADV_SEQUENTIAL);
+
+	source.data         = (const char*) mapping;
+	source.size         = size;
+	source.mapping      = mapping;
+	source.mapping_size = mapping_size;
+	source.is_mapped    = true;
+	return SourceFileExitCode::SUCCESS;
+}
+
+#endif
+
+static inline
+void close_source_file(
+	SourceFile& source)
+{
+	if (source.mapping == NULL) {
+		return;
+	}
+#if !defined(_WIN32)
+	if (source.is_mapped) {
+		munmap(source.mapping, source.mapping_size);
+	} else {
+		delete[] (char*) source.mapping;
+	}
+#else
+	delete[] (char*) source.mapping;
+#endif
+	source.data         = NULL;
+	source.mapping      = NULL;
+	source.mapping_size = 0;
+}
+
+#endif
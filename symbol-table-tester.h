@@ -0,0 +1,129 @@
+/* Authored by Charlie Keaney                       */
+/* symbol-table-tester.h - Responsible for testing
+						   symbol tables.         */
+
+#ifndef SYMBOL_TABLE_TESTER_H
+#define SYMBOL_TABLE_TESTER_H 1
+
+#include <cstdio>
+#include <cstring>
+
+#include "tester-tools.h"
+#include "preprocessor.h"
+#include "symbol-table.h"
+
+#define NUM_SYMBOL_TABLE_TESTS 1
+
+//////////////////////////////////////////////////////////////////
+//          Testing for the lookup of symbols by atom           //
+//////////////////////////////////////////////////////////////////
+
+#define NUM_SYMBOL_TABLE_ATOM_TESTS 6
+
+struct symbol_table_atom_test_case {
+	const char* symbol;
+	uint32_t    atom;
+	bool        is_added;
+};
+
+/* Atoms a multiple of NUM_SYMBOL_TABLE_ENTRIES apart
+   share a bucket.                                  */
+static const
+symbol_table_atom_test_case
+test_symbol_table_atom_table[NUM_SYMBOL_TABLE_ATOM_TESTS] = {
+	{ "x",          1,                                true  },
+	{ "y",          2,                                false },
+	{ "x_collider", NUM_SYMBOL_TABLE_ENTRIES + 1,     true  },
+	{ "y_collider", NUM_SYMBOL_TABLE_ENTRIES + 2,     true  },
+	{ "z",          2 * NUM_SYMBOL_TABLE_ENTRIES + 1, true  },
+	{ "w",          2 * NUM_SYMBOL_TABLE_ENTRIES + 2, false }
+};
+
+/**
+* Pools each symbol as the given atom, pooling other
+* lexema before it to make up the number, and adds
+* those marked to a table. Each symbol must then be
+* found, by its atom, if and only if it was added.
+**/
+static inline TestResult test_symbol_table_atom(
+	TestResult results[NUM_SYMBOL_TABLE_ATOM_TESTS])
+{
+	bool all_tests_passed = true;
+	LexemaPool pool;
+	SymbolTable symtab;
+	const char* pooled[NUM_SYMBOL_TABLE_ATOM_TESTS];
+	char filler[32];
+	for (const symbol_table_atom_test_case* stc
+			= test_symbol_table_atom_table;
+		stc < test_symbol_table_atom_table + NUM_SYMBOL_TABLE_ATOM_TESTS;
+		stc++) {
+		while (pool.num_entries.load() + 1 < stc->atom) {
+			snprintf(
+				filler,
+				sizeof(filler),
+				"filler_%zu",
+				pool.num_entries.load());
+			intern_lexeme(pool, filler, strlen(filler));
+		}
+		const char* const symbol = intern_lexeme(
+			pool,
+			stc->symbol,
+			strlen(stc->symbol));
+		pooled[stc - test_symbol_table_atom_table] = symbol;
+		if (stc->is_added) {
+			symtab.add_entry(symbol);
+		}
+	}
+	for (const symbol_table_atom_test_case* stc
+			= test_symbol_table_atom_table;
+		stc < test_symbol_table_atom_table + NUM_SYMBOL_TABLE_ATOM_TESTS;
+		stc++) {
+		const char* const symbol
+			= pooled[stc - test_symbol_table_atom_table];
+		const SymbolTableEntry* const entry
+			= symtab.get_entry(symbol);
+		const bool success_criteria
+			= get_lexeme_atom(symbol) == stc->atom
+			  && (stc->is_added
+				  ? entry != NULL
+					&& entry->symbol == symbol
+					&& entry->atom == stc->atom
+				  : entry == NULL);
+		results[stc - test_symbol_table_atom_table]
+			= success_criteria ? TestResult::SUCCESS : TestResult::FAIL;
+		if (!success_criteria) {
+			all_tests_passed = false;
+		}
+	}
+	symtab.reset();
+	return all_tests_passed ? TestResult::SUCCESS : TestResult::FAIL;
+}
+
+static inline TestResult test_symbol_table(
+	TestResult results[NUM_SYMBOL_TABLE_TESTS],
+	char* &output,
+	int indent = 0)
+{
+	TestResult atom_results[NUM_SYMBOL_TABLE_ATOM_TESTS];
+	TestResult atom_result
+		= test_symbol_table_atom(atom_results);
+	results[0] = atom_result;
+
+	for (int i = 0; i < indent; i++) print_to_output("\t", output);
+	print_to_output("<-> SymbolTableTests", output);
+	print_to_output("\n", output);
+
+	const char* atom_title = "SymbolTableAtomTests";
+	present_test_set_synopsis(
+		atom_title,
+		atom_result,
+		atom_results,
+		NUM_SYMBOL_TABLE_ATOM_TESTS,
+		output,
+		indent + 1
+	);
+
+	return atom_result;
+}
+
+#endif
@@ -6,11 +6,13 @@
 #ifndef SYMBOL_TABLE_H
 #define SYMBOL_TABLE_H 1
 
+#include <algorithm>
 #include <string>
 
 #include <iostream>
 #include <iomanip>
 
+#include "lexema-pool.h"
 #include "preprocessor.h"
 #include "semantics.h"
 
@@ -40,6 +42,8 @@ class PreprocessingAstNode;
 struct SymbolTableEntry {
 	/*     Key data.          */
 	const char*           symbol;
+	uint32_t              atom;
+	unsigned int          listing_order;
 	SymbolTableEntry*     next_entry;
 	/*   General Attributes.           */
 	IdentifierClassifier  identifier_type;
@@ -54,73 +58,109 @@ struct SymbolTableEntry {
 	PreprocessingAstNode* replacement_list;
 	/* Attributes added during code generation.   */
 	const char*           literal_constant_ptr_label;
+	/* Every entry of the table, most recent first. */
+	SymbolTableEntry*     next_added_entry;
+
+	ARENA_ALLOCATED(SymbolTableEntry)
 };
 
 static inline
 SymbolTableEntry construct_symbol_table_entry(
 	const char* const& symbol);
 
+/**
+* Returns where a symbol is listed among the entries
+* of a table. Frame offsets are laid out in this order,
+* so it is kept apart from how entries are found.
+*
+* @param symbol The symbol to order.
+* @return Returns the position to list the symbol at.
+**/
+static inline
+unsigned int get_symbol_listing_order(
+	const char* const& symbol);
+
 static inline
-void print_symbol_table_entry_header();
+void print_symbol_table_entry_header(
+	ostream& out = cout);
 
 static inline
 void print_symbol_table_entry_content(
-	const SymbolTableEntry* const& entry);
+	const SymbolTableEntry* const& entry,
+	ostream                      & out = cout);
 
 class SymbolTable {
 private:
 	SymbolTableEntry* entries[NUM_SYMBOL_TABLE_ENTRIES] = { };
+	size_t            num_entries = 0;
+	SymbolTableEntry* added_entries = NULL;
 
-	unsigned int hash(const char* const& x) const
+	/* Atoms are handed out in order, so they spread
+	   evenly over the buckets as they are.         */
+	unsigned int hash(const uint32_t& atom) const
 	{
-		long long string_val = 0;
-		for (const char* c = x; *c; c++) {
-			string_val += 256 * *c;
-		}
-		const unsigned int h 
-			= (string_val * 12289) 
-			  % 6151;
-		return h;
+		return atom % NUM_SYMBOL_TABLE_ENTRIES;
 	}
 public:
 	inline SymbolTable() { }
 
+	/**
+	* Returns the entry of the symbol with the given
+	* atom, or NULL if the table has none.
+	**/
 	inline SymbolTableEntry* get_entry(
-		const char* const& symbol) const
+		uint32_t const& atom) const
 	{
-		const unsigned int h 
-			= hash(symbol);
 		SymbolTableEntry* entry 
-			= *(entries + h);
-		if (entry != NULL) {
-			while (entry != NULL) {
-				if (strcmp(
-						entry->symbol, 
-						symbol) 
-					!= 0) {
-					entry = entry->next_entry;
-				} else {
-					break;
-				}
-			}
+			= *(entries + hash(atom));
+		while (entry != NULL
+			   && entry->atom != atom) {
+			entry = entry->next_entry;
 		}
 		return entry;
 	}
 
+	/**
+	* Returns the entry of the given symbol, which must
+	* be a lexeme from the lexema pool.
+	**/
+	inline SymbolTableEntry* get_entry(
+		const char* const& symbol) const
+	{
+		return get_entry(
+			get_lexeme_atom(symbol));
+	}
+
+	/**
+	* Returns the number of entries in the table, which
+	* is how many get_entries will write out.
+	**/
+	inline size_t get_num_entries() const
+	{
+		return num_entries;
+	}
+
+	/**
+	* Writes out every entry in listing order, the most
+	* recently added first among those listed together.
+	**/
 	inline void get_entries(
 		SymbolTableEntry** returned_entries) const
 	{
-		for (SymbolTableEntry *const * e = entries;
-			e < entries + NUM_SYMBOL_TABLE_ENTRIES;
-			e++) {
-
-			for (SymbolTableEntry * f = *e;
-				f != NULL;
-				f = f->next_entry) {
+		SymbolTableEntry** e = returned_entries;
+		for (SymbolTableEntry* f = added_entries;
+			f != NULL;
+			f = f->next_added_entry) {
 
-				*returned_entries++ = f;
-			}
+			*e++ = f;
 		}
+		stable_sort(
+			returned_entries,
+			e,
+			[](const SymbolTableEntry* a,
+			   const SymbolTableEntry* b) {
+				return a->listing_order < b->listing_order;
+			});
 		return;
 	}
 
@@ -130,9 +170,12 @@ public:
 		SymbolTableEntry* data = new SymbolTableEntry(
 			construct_symbol_table_entry(symbol));
 
-		unsigned int h = hash(symbol);
+		unsigned int h = hash(data->atom);
 		SymbolTableEntry** entry_addr 
 			= entries + h;
+		num_entries++;
+		data->next_added_entry = added_entries;
+		added_entries = data;
 		if (*entry_addr != NULL) {
 			SymbolTableEntry* old_entry = *entry_addr;
 			*entry_addr = data;
@@ -145,9 +188,12 @@ public:
 	inline void add_entry(
 		SymbolTableEntry* const& data)
 	{
-		unsigned int h = hash(data->symbol);
+		unsigned int h = hash(data->atom);
 		SymbolTableEntry** entry_addr
 			= entries + h;
+		num_entries++;
+		data->next_added_entry = added_entries;
+		added_entries = data;
 		if (*entry_addr != NULL) {
 			SymbolTableEntry* old_entry = *entry_addr;
 			*entry_addr = data;
@@ -158,149 +204,290 @@ public:
 		}
 	}
 
+	/**
+	* Empties the table, freeing its entries. Only the
+	* buckets that were used are cleared, so this costs
+	* as much as the number of entries, not the size
+	* of the table.
+	**/
+	inline void reset()
+	{
+		SymbolTableEntry* entry = added_entries;
+		while (entry != NULL) {
+			SymbolTableEntry* next_entry
+				= entry->next_added_entry;
+			entries[hash(entry->atom)] = NULL;
+			delete entry;
+			entry = next_entry;
+		}
+		added_entries = NULL;
+		num_entries   = 0;
+	}
+
 	inline void print(
-		string const& prefix = "") const
+		string const& prefix = "",
+		ostream     & out    = cout) const
 	{
-		cout << prefix;
+		out << prefix;
 		for (int i = 0; i < 16 * 9; i++) {
-			cout << "-";
+			out << "-";
 		}
-		cout << endl;
+		out << endl;
 
-		cout << prefix;
-		print_symbol_table_entry_header();
-		cout << endl;
+		out << prefix;
+		print_symbol_table_entry_header(out);
+		out << endl;
 
-		cout << prefix;
+		out << prefix;
 		for (int i = 0; i < 16 * 9; i++) {
-			cout << "-";
+			out << "-";
 		}
-		cout << endl;
-
-		for (const SymbolTableEntry *const * e = entries;
-			e < entries + NUM_SYMBOL_TABLE_ENTRIES;
-			e++) {
+		out << endl;
+
+		SymbolTableEntry** listed
+			= new SymbolTableEntry*[num_entries + 1] { };
+		get_entries(listed);
+		for (size_t i = 0; i < num_entries; i++) {
+			out << prefix;
+			print_symbol_table_entry_content(listed[i], out);
+			out << endl;
+		}
+		delete[] listed;
 
-			for (const SymbolTableEntry* f = *e;
-				f != NULL;
-				f = f->next_entry) {
+		out << prefix;
+		for (int i = 0; i < 16 * 9; i++) {
+			out << "-";
+		}
+		out << endl;
+	}
+};
 
-				cout << prefix;
-				print_symbol_table_entry_content(f);
-				cout << endl;
-			}		
+/**
+* Hands out symbol tables which are kept between
+* compilations and reset, rather than reallocated.
+**/
+class SymbolTablePool {
+private:
+	SymbolTable** tables;
+	size_t        num_tables;
+	size_t        capacity;
+	size_t        num_acquired;
+public:
+	inline SymbolTablePool()
+		: tables(NULL),
+		  num_tables(0),
+		  capacity(0),
+		  num_acquired(0) {
+	};
+
+	SymbolTablePool(const SymbolTablePool&) = delete;
+	SymbolTablePool& operator=(const SymbolTablePool&) = delete;
+
+	inline ~SymbolTablePool() {
+		for (size_t i = 0; i < num_tables; i++) {
+			delete tables[i];
 		}
+		delete[] tables;
+	};
+
+	/**
+	* Returns an empty table, reusing a previously
+	* released one where possible.
+	**/
+	inline SymbolTable* acquire()
+	{
+		if (num_acquired == num_tables) {
+			if (num_tables == capacity) {
+				capacity = capacity ? 2 * capacity : 64;
+				SymbolTable** grown_tables
+					= new SymbolTable*[capacity];
+				for (size_t i = 0; i < num_tables; i++) {
+					grown_tables[i] = tables[i];
+				}
+				delete[] tables;
+				tables = grown_tables;
+			}
+			tables[num_tables++] = new SymbolTable();
+		}
+		return tables[num_acquired++];
+	}
 
-		cout << prefix;
-		for (int i = 0; i < 16 * 9; i++) {
-			cout << "-";
+	/**
+	* Resets every table handed out, making them all
+	* available again. Any table acquired from the pool
+	* must no longer be in use.
+	**/
+	inline void reset()
+	{
+		for (size_t i = 0; i < num_acquired; i++) {
+			tables[i]->reset();
 		}
-		cout << endl;
+		num_acquired = 0;
 	}
 };
 
+/* The pool symbol tables are taken from on this thread,
+   or NULL if they are to be allocated individually.   */
+static thread_local
+SymbolTablePool* active_symbol_table_pool = NULL;
+
+/**
+* Constructs an empty symbol table, taken from the
+* active pool if there is one.
+*
+* @return Returns the empty symbol table.
+**/
+static inline
+SymbolTable* construct_symbol_table();
+
 /*****************************************************//**
 *                         Definitions                    *
 /********************************************************/
 
+static inline
+SymbolTable* construct_symbol_table()
+{
+	if (active_symbol_table_pool != NULL) {
+		return active_symbol_table_pool->acquire();
+	}
+	if (active_arena != NULL) {
+		return new (active_arena->allocate(
+			sizeof(SymbolTable),
+			alignof(SymbolTable))) SymbolTable();
+	}
+	return new SymbolTable();
+}
+
 static inline
 SymbolTableEntry construct_symbol_table_entry(
 	const char* const& symbol)
 {
-	SymbolTableEntry result = { symbol };
+	SymbolTableEntry result = { 
+		symbol, 
+		get_lexeme_atom(symbol),
+		get_symbol_listing_order(symbol),
+		NULL,
+		IdentifierClassifier::UNDEFINED,
+		false,
+		0,
+		0,
+		NULL,
+		0,
+		NULL,
+		0,
+		Scope::UNDEFINED,
+		NULL,
+		NULL,
+		NULL };
 	return result;
 }
 
 static inline
-void print_symbol_table_entry_header()
+unsigned int get_symbol_listing_order(
+	const char* const& symbol)
+{
+	long long string_val = 0;
+	for (const char* c = symbol; *c; c++) {
+		string_val += 256 * *c;
+	}
+	const unsigned int h 
+		= (string_val * 12289) 
+		  % 6151;
+	return h;
+}
+
+static inline
+void print_symbol_table_entry_header(
+	ostream& out)
 {
-	cout << ": symbol       "
-		 << ": identifier type "
-		 << ": is literal? "
-		 << ": value      "
-		 << ": offset     "
-		 << ": function ptr "
-		 << ": num_params "		
-		 << ": scope type "
-		 << ": frame size "
-		 << ": type         ";
+	out << ": symbol       "
+		<< ": identifier type "
+		<< ": is literal? "
+		<< ": value      "
+		<< ": offset     "
+		<< ": function ptr "
+		<< ": num_params "		
+		<< ": scope type "
+		<< ": frame size "
+		<< ": type         ";
 }
 
 static inline
 void print_symbol_table_entry_content(
-	const SymbolTableEntry* const& entry)
+	const SymbolTableEntry* const& entry,
+	ostream                      & out)
 {
-	cout << ": "
-		 << std::left
-		 << std::setw(13)
-		 << std::setfill(' ')
-		 << entry->symbol;
+	out << ": "
+		<< std::left
+		<< std::setw(13)
+		<< std::setfill(' ')
+		<< entry->symbol;
 
 	const int i_entry_id_t
 		= (int) entry->identifier_type;
-	cout << ": "
-		 << std::left
-		 << std::setw(16)
-		 << std::setfill(' ')
-		 << identifier_classifier_string_repr[
+	out << ": "
+		<< std::left
+		<< std::setw(16)
+		<< std::setfill(' ')
+		<< identifier_classifier_string_repr[
 			 i_entry_id_t];
 
-	cout << ": "
-		 << std::left
-		 << std::setw(12)
-		 << std::setfill(' ')
-		 << (entry->is_literal 
+	out << ": "
+		<< std::left
+		<< std::setw(12)
+		<< std::setfill(' ')
+		<< (entry->is_literal 
 			 ? "true" 
 			 : "false");
 
-	cout << ": 0x"
-		 << std::right
-		 << std::hex
-		 << std::setw(8)
-		 << std::setfill('0')
-		 << entry->value
-		 << " ";
-
-	cout << ": 0x"
-		 << std::right
-		 << std::hex
-		 << std::setw(8)
-		 << std::setfill('0')
-		 << entry->base_pointer_offset
-		 << " ";
+	out << ": 0x"
+		<< std::right
+		<< std::hex
+		<< std::setw(8)
+		<< std::setfill('0')
+		<< entry->value
+		<< " ";
+
+	out << ": 0x"
+		<< std::right
+		<< std::hex
+		<< std::setw(8)
+		<< std::setfill('0')
+		<< entry->base_pointer_offset
+		<< " ";
 
 	const char* id = entry->function_ptr 
 					 ? entry->function_ptr->symbol 
 					 : "N/A";
-	cout << ": "
-		 << std::left
-		 << std::setw(13)
-		 << std::setfill(' ')
-		 << id;
-
-	cout << ": "
-		 << std::left
-		 << std::setw(11)
-		 << std::setfill(' ')
-		 << entry->number_formal_parameters;
-
-	cout << ": "
-		 << std::left
-		 << std::setw(11)
-		 << std::setfill(' ')
-		 << scope_string_repr[(int)entry->scope];
-
-	cout << ": "
-		 << std::left
-		 << std::setw(11)
-		 << std::setfill(' ')
-		 << entry->function_frame_size;
-
-	cout << ": ";
+	out << ": "
+		<< std::left
+		<< std::setw(13)
+		<< std::setfill(' ')
+		<< id;
+
+	out << ": "
+		<< std::left
+		<< std::setw(11)
+		<< std::setfill(' ')
+		<< entry->number_formal_parameters;
+
+	out << ": "
+		<< std::left
+		<< std::setw(11)
+		<< std::setfill(' ')
+		<< scope_string_repr[(int)entry->scope];
+
+	out << ": "
+		<< std::left
+		<< std::setw(11)
+		<< std::setfill(' ')
+		<< entry->function_frame_size;
+
+	out << ": ";
 	if (entry->type != NULL) {
-		print_type(entry->type);
+		print_type(entry->type, out);
 	} else {
-		cout << "N/A";
+		out << "N/A";
 	}
 }
 
@@ -17,7 +17,7 @@ inline void print_to_output(
 	char*            & output) 
 {
 	for (const char* c = val_to_print; 
-		 *c != NULL; 
+		 *c != '\0'; 
 		 ) {
 		*output++ = *c++;
 	}
@@ -51,7 +51,7 @@ void present_test_set_synopsis(
 	print_to_output("\n", output);
 
 	if (!(test_set_result == TestResult::SUCCESS)) {
-		for (int i = 0; i < size; i++) {
+		for (size_t i = 0; i < size; i++) {
 			for (int j = 0; j < indent + 2; j++) print_to_output("\t", output);
 				print_to_output("<+> Test ", output);
 				// cout << i + 1
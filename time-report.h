@@ -0,0 +1,433 @@
+/* Authored by Charlie Keaney                     */
+/* time-report.h - Responsible for timing each
+				   phase of compilation and
+				   reporting where the time
+				   went (-ftime-report).
+
+				   Implementation Notes:
+				   Wall time is read from the
+				   steady clock. CPU time is
+				   read per thread, so that the
+				   report stays accurate when
+				   several files are compiled
+				   at once with -j.
+
+				   Phases may nest, in which
+				   case time is charged to the
+				   innermost phase only, so a
+				   parser that lexes on demand
+				   does not count lexing as
+				   parsing.                    */
+
+#ifndef TIME_REPORT_H
+#define TIME_REPORT_H 1
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "ast-node.h"
+#include "annotated-ast-node.h"
+
+#define NUM_TIME_REPORT_PHASES 5
+
+#define TIME_REPORT_PHASE_WIDTH 12
+#define TIME_REPORT_TIME_WIDTH  12
+#define TIME_REPORT_COUNT_WIDTH 10
+#define TIME_REPORT_UNIT_WIDTH  11
+#define TIME_REPORT_RATE_WIDTH  14
+
+using namespace std;
+
+/*****************************************************//**
+*                      Declarations                      *
+/********************************************************/
+
+enum class TimeReportPhase {
+	PREPROCESS,
+	LEX,
+	PARSE,
+	ANNOTATE,
+	GEN
+};
+
+static
+const char* time_report_phase_string_repr[] = {
+	"preprocess",
+	"lex",
+	"parse",
+	"annotate",
+	"gen"
+};
+
+/* What each phase counts in its report. */
+static
+const char* time_report_unit_string_repr[] = {
+	"pp-tokens",
+	"tokens",
+	"ast-nodes",
+	"ast-nodes",
+	"instrs"
+};
+
+struct TimeReportEntry {
+	bool     ran;
+	int      parent_phase;
+	uint64_t wall_start_ns;
+	uint64_t cpu_start_ns;
+	uint64_t wall_ns;
+	uint64_t cpu_ns;
+	uint64_t count;
+};
+
+struct TimeReport {
+	const char*     filename;
+	int             active_phase;
+	TimeReportEntry phases[NUM_TIME_REPORT_PHASES];
+};
+
+/**
+* Returns the time in nanoseconds on a monotonic clock.
+**/
+static inline
+uint64_t get_wall_time_ns();
+
+/**
+* Returns the CPU time in nanoseconds used so far by
+* the calling thread.
+**/
+static inline
+uint64_t get_thread_cpu_time_ns();
+
+/**
+* Counts the nodes of an abstract syntax tree.
+*
+* @param node The root of the tree to count.
+* @return Returns the number of nodes in the tree.
+**/
+static inline
+size_t count_ast_nodes(
+	const AstNode* const& node);
+
+/**
+* Counts the nodes of an annotated abstract syntax tree.
+*
+* @param node The root of the tree to count.
+* @return Returns the number of nodes in the tree.
+**/
+static inline
+size_t count_annotated_ast_nodes(
+	const AnnotatedAstNode* const& node);
+
+/**
+* Constructs an empty time report for a file.
+*
+* @param filename The file being compiled.
+* @return Returns the empty time report.
+**/
+static inline
+TimeReport construct_time_report(
+	const char* const& filename);
+
+/**
+* Marks the start of a phase, pausing the phase
+* already running (if any) until this one finishes.
+*
+* @param report The report to record into.
+* @param phase The phase which is starting.
+**/
+static inline
+void start_time_report_phase(
+	TimeReport           & report,
+	TimeReportPhase const& phase);
+
+/**
+* Marks the end of a phase, adding the time since it
+* started to its total and recording how much it has
+* produced so far. A phase may be started and
+* finished any number of times.
+*
+* @param report The report to record into.
+* @param phase The phase which has finished.
+* @param count The number of items the phase produced.
+**/
+static inline
+void finish_time_report_phase(
+	TimeReport           & report,
+	TimeReportPhase const& phase,
+	uint64_t        const& count);
+
+/**
+* Prints a time report as a table.
+*
+* @param report The report to print.
+* @param out The stream to print to.
+**/
+static inline
+void print_time_report(
+	TimeReport const& report,
+	ostream         & out = cout);
+
+/**
+* Prints a time report as a single line of JSON.
+*
+* @param report The report to print.
+* @param out The stream to print to.
+**/
+static inline
+void print_time_report_json(
+	TimeReport const& report,
+	ostream         & out = cout);
+
+/*****************************************************//**
+*                         Definitions                    *
+/********************************************************/
+
+static inline
+uint64_t get_wall_time_ns()
+{
+	return (uint64_t) chrono::duration_cast<chrono::nanoseconds>(
+		chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#if defined(_WIN32)
+
+static inline
+uint64_t get_thread_cpu_time_ns()
+{
+	FILETIME creation_time;
+	FILETIME exit_time;
+	FILETIME kernel_time;
+	FILETIME user_time;
+	GetThreadTimes(
+		GetCurrentThread(),
+		&creation_time,
+		&exit_time,
+		&kernel_time,
+		&user_time);
+	const uint64_t kernel_100ns
+		= ((uint64_t) kernel_time.dwHighDateTime << 32)
+		  | kernel_time.dwLowDateTime;
+	const uint64_t user_100ns
+		= ((uint64_t) user_time.dwHighDateTime << 32)
+		  | user_time.dwLowDateTime;
+	return (kernel_100ns + user_100ns) * 100;
+}
+
+#else
+
+static inline
+uint64_t get_thread_cpu_time_ns()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000ull
+		   + (uint64_t) ts.tv_nsec;
+}
+
+#endif
+
+static inline
+size_t count_ast_nodes(
+	const AstNode* const& node)
+{
+	size_t count = 0;
+	for (const AstNode* n = node;
+		 n != NULL;
+		 n = n->get_sibling()) {
+		count += 1 + count_ast_nodes(n->get_child());
+	}
+	return count;
+}
+
+static inline
+size_t count_annotated_ast_nodes(
+	const AnnotatedAstNode* const& node)
+{
+	size_t count = 0;
+	for (const AnnotatedAstNode* n = node;
+		 n != NULL;
+		 n = n->get_sibling()) {
+		count += 1 + count_annotated_ast_nodes(n->get_child());
+	}
+	return count;
+}
+
+static inline
+TimeReport construct_time_report(
+	const char* const& filename)
+{
+	TimeReport report = TimeReport({ filename, -1, { } });
+	return report;
+}
+
+static inline
+void start_time_report_phase(
+	TimeReport           & report,
+	TimeReportPhase const& phase)
+{
+	const uint64_t wall_now_ns
+		= get_wall_time_ns();
+	const uint64_t cpu_now_ns
+		= get_thread_cpu_time_ns();
+	if (report.active_phase >= 0) {
+		TimeReportEntry& parent
+			= report.phases[report.active_phase];
+		parent.wall_ns += wall_now_ns - parent.wall_start_ns;
+		parent.cpu_ns  += cpu_now_ns - parent.cpu_start_ns;
+	}
+	TimeReportEntry& entry
+		= report.phases[(int) phase];
+	entry.parent_phase  = report.active_phase;
+	entry.wall_start_ns = wall_now_ns;
+	entry.cpu_start_ns  = cpu_now_ns;
+	report.active_phase = (int) phase;
+}
+
+static inline
+void finish_time_report_phase(
+	TimeReport           & report,
+	TimeReportPhase const& phase,
+	uint64_t        const& count)
+{
+	const uint64_t wall_now_ns
+		= get_wall_time_ns();
+	const uint64_t cpu_now_ns
+		= get_thread_cpu_time_ns();
+	TimeReportEntry& entry
+		= report.phases[(int) phase];
+	entry.ran      = true;
+	entry.wall_ns += wall_now_ns - entry.wall_start_ns;
+	entry.cpu_ns  += cpu_now_ns - entry.cpu_start_ns;
+	entry.count    = count;
+
+	/* Resume the phase this one interrupted. */
+	report.active_phase = entry.parent_phase;
+	if (report.active_phase >= 0) {
+		TimeReportEntry& parent
+			= report.phases[report.active_phase];
+		parent.wall_start_ns = wall_now_ns;
+		parent.cpu_start_ns  = cpu_now_ns;
+	}
+}
+
+static inline
+void print_time_report(
+	TimeReport const& report,
+	ostream         & out)
+{
+	const ios_base::fmtflags saved_flags
+		= out.flags();
+
+	out << "kcc:time-report:"
+		<< report.filename
+		<< endl;
+	out << std::left
+		<< std::setfill(' ')
+		<< std::setw(TIME_REPORT_PHASE_WIDTH) << "Phase"
+		<< std::right
+		<< std::setw(TIME_REPORT_TIME_WIDTH)  << "Wall (ms)"
+		<< std::setw(TIME_REPORT_TIME_WIDTH)  << "CPU (ms)"
+		<< std::setw(TIME_REPORT_COUNT_WIDTH) << "Count"
+		<< "  "
+		<< std::left
+		<< std::setw(TIME_REPORT_UNIT_WIDTH)  << "Unit"
+		<< std::right
+		<< std::setw(TIME_REPORT_RATE_WIDTH)  << "Count/s"
+		<< endl;
+
+	uint64_t total_wall_ns = 0;
+	uint64_t total_cpu_ns  = 0;
+	for (int i = 0; i < NUM_TIME_REPORT_PHASES; i++) {
+		const TimeReportEntry& entry
+			= report.phases[i];
+		out << std::left
+			<< std::setw(TIME_REPORT_PHASE_WIDTH)
+			<< time_report_phase_string_repr[i]
+			<< std::right;
+		if (!entry.ran) {
+			out << std::setw(TIME_REPORT_TIME_WIDTH) << "-"
+				<< std::setw(TIME_REPORT_TIME_WIDTH) << "-"
+				<< std::setw(TIME_REPORT_COUNT_WIDTH) << "-"
+				<< endl;
+			continue;
+		}
+		total_wall_ns += entry.wall_ns;
+		total_cpu_ns  += entry.cpu_ns;
+
+		const double rate
+			= entry.wall_ns
+			  ? entry.count * 1e9 / entry.wall_ns
+			  : 0.0;
+		out << std::fixed
+			<< std::setprecision(3)
+			<< std::setw(TIME_REPORT_TIME_WIDTH) << entry.wall_ns / 1e6
+			<< std::setw(TIME_REPORT_TIME_WIDTH) << entry.cpu_ns / 1e6
+			<< std::setw(TIME_REPORT_COUNT_WIDTH) << entry.count
+			<< "  "
+			<< std::left
+			<< std::setw(TIME_REPORT_UNIT_WIDTH)
+			<< time_report_unit_string_repr[i]
+			<< std::right
+			<< std::setprecision(0)
+			<< std::setw(TIME_REPORT_RATE_WIDTH) << rate
+			<< endl;
+	}
+	out << std::left
+		<< std::setw(TIME_REPORT_PHASE_WIDTH) << "total"
+		<< std::right
+		<< std::fixed
+		<< std::setprecision(3)
+		<< std::setw(TIME_REPORT_TIME_WIDTH) << total_wall_ns / 1e6
+		<< std::setw(TIME_REPORT_TIME_WIDTH) << total_cpu_ns / 1e6
+		<< endl;
+
+	out.flags(saved_flags);
+}
+
+static inline
+void print_time_report_json(
+	TimeReport const& report,
+	ostream         & out)
+{
+	const ios_base::fmtflags saved_flags
+		= out.flags();
+
+	out << "{\"file\":\"";
+	for (const char* c = report.filename; *c; c++) {
+		if (*c == '"' || *c == '\\') {
+			out << '\\';
+		}
+		out << *c;
+	}
+	out << "\",\"phases\":[";
+	bool first = true;
+	for (int i = 0; i < NUM_TIME_REPORT_PHASES; i++) {
+		const TimeReportEntry& entry
+			= report.phases[i];
+		if (!entry.ran) {
+			continue;
+		}
+		out << (first ? "" : ",")
+			<< "{\"name\":\""  << time_report_phase_string_repr[i]
+			<< "\",\"wall_ns\":" << std::dec << entry.wall_ns
+			<< ",\"cpu_ns\":"  << entry.cpu_ns
+			<< ",\"count\":"   << entry.count
+			<< ",\"unit\":\""  << time_report_unit_string_repr[i]
+			<< "\"}";
+		first = false;
+	}
+	out << "]}"
+		<< endl;
+
+	out.flags(saved_flags);
+}
+
+#endif
@@ -0,0 +1,611 @@
+/* Authored by Charlie Keaney                     */
+/* token-store.h - Responsible for storing the
+				   tokens of a compilation field
+				   by field, and reading them back
+				   for the parser.
+
+				   Implementation Notes:
+				   Tokens are stored as a structure
+				   of arrays. Each chunk holds the
+				   names and forms of its tokens a
+				   byte apiece in arrays of their
+				   own, followed by their constant
+				   types, their constant values and
+				   their locations. The parser's
+				   lookahead reads only names and
+				   forms, so a cache line of each
+				   covers 64 tokens, where a line
+				   of whole tokens covered fewer
+				   than two.
+
+				   The lexer still writes whole
+				   Tokens; the appender scatters
+				   each into the arrays.
+
+				   A token is referred to by a
+				   TokenRef, its chunk and index,
+				   which reads the token's fields
+				   from the arrays as they are
+				   asked for. Chunks never move, so
+				   a TokenRef stays valid until its
+				   chunk is released.
+
+				   The parser releases the chunks
+				   behind the furthest it may
+				   backtrack to, so the store holds
+				   only the tokens between there
+				   and its lookahead. The tokens
+				   the ast keeps as terminals are
+				   first copied into chunks of
+				   their own, which last for the
+				   life of the store.
+
+				   As with a SegmentedBuffer, a
+				   store may be given a source to
+				   fill it as cursors read it.   */
+
+#ifndef TOKEN_STORE_H
+#define TOKEN_STORE_H 1
+
+#include <cstddef>
+#include <iostream>
+
+#include "token.h"
+#include "segmented-buffer.h"
+
+#define TOKEN_STORE_CHUNK_TOKENS 1024
+
+using namespace std;
+
+/*****************************************************//**
+*                      Declarations                      *
+/********************************************************/
+
+/* Where a token was found and how it is spelt. */
+struct TokenLocation {
+	const char*    lexeme;
+	SourceLocation location;
+	uint32_t       atom;
+};
+
+/**
+* A fixed-size block of tokens within a token store,
+* one array for each field.
+**/
+struct TokenStoreChunk {
+	TokenStoreChunk* next_chunk;
+	size_t           count;
+	TokenName        names[TOKEN_STORE_CHUNK_TOKENS];
+	TokenForm        forms[TOKEN_STORE_CHUNK_TOKENS];
+	ConstantType     constant_types[TOKEN_STORE_CHUNK_TOKENS];
+	TokenValue       constant_vals[TOKEN_STORE_CHUNK_TOKENS];
+	TokenLocation    locations[TOKEN_STORE_CHUNK_TOKENS];
+};
+
+class TokenStoreCursor;
+
+class TokenStoreAppender;
+
+/**
+* Refers to a single token of a token store, reading
+* its fields from the store's arrays.
+**/
+class TokenRef {
+private:
+	const TokenStoreChunk* chunk;
+	size_t                 index;
+public:
+	inline TokenRef(
+		const TokenStoreChunk* const& c = NULL,
+		size_t                 const& i = 0)
+		: chunk(c),
+		  index(i) {
+	};
+
+	inline bool is_null() const
+	{
+		return chunk == NULL;
+	}
+
+	inline const TokenStoreChunk* get_chunk() const
+	{
+		return chunk;
+	}
+
+	inline size_t get_index() const
+	{
+		return index;
+	}
+
+	inline TokenName get_name() const
+	{
+		return chunk->names[index];
+	}
+
+	inline TokenForm get_form() const
+	{
+		return chunk->forms[index];
+	}
+
+	inline const char* get_lexeme() const
+	{
+		return chunk->locations[index].lexeme;
+	}
+
+	inline uint32_t get_atom() const
+	{
+		return chunk->locations[index].atom;
+	}
+
+	inline TokenValue get_constant_val() const
+	{
+		return chunk->constant_vals[index];
+	}
+
+	inline ConstantType get_constant_type() const
+	{
+		return chunk->constant_types[index];
+	}
+
+	inline SourceLocation get_location() const
+	{
+		return chunk->locations[index].location;
+	}
+
+	/**
+	* Gathers the token's fields into a whole Token.
+	**/
+	inline Token get_token() const
+	{
+		const TokenClassification classification = {
+			get_name(),
+			get_form(),
+			get_constant_type(),
+			get_constant_val()
+		};
+		return Token(
+			classification,
+			get_lexeme(),
+			get_location(),
+			get_atom());
+	}
+
+	inline void print(
+		ostream& out = cout) const
+	{
+		get_token().print(out);
+	}
+};
+
+/**
+* An append-only sequence of tokens, stored as a
+* structure of arrays.
+**/
+class TokenStore {
+private:
+	TokenStoreChunk*      first_chunk;
+	TokenStoreChunk*      last_chunk;
+	size_t                size;
+	size_t                num_chunks;
+	TokenStoreChunk*      first_kept_chunk;
+	TokenStoreChunk*      last_kept_chunk;
+	SegmentedBufferSource source;
+	void*                 source_context;
+
+	inline TokenStoreChunk* construct_chunk()
+	{
+		/* The arrays are left uninitialised; only
+		   committed tokens are ever read.        */
+		TokenStoreChunk* chunk
+			= new TokenStoreChunk;
+		chunk->next_chunk = NULL;
+		chunk->count      = 0;
+		return chunk;
+	}
+
+public:
+	inline TokenStore()
+		: first_chunk(NULL),
+		  last_chunk(NULL),
+		  size(0),
+		  num_chunks(1),
+		  first_kept_chunk(NULL),
+		  last_kept_chunk(NULL),
+		  source(NULL),
+		  source_context(NULL) {
+		first_chunk = construct_chunk();
+		last_chunk  = first_chunk;
+	};
+
+	TokenStore(const TokenStore&) = delete;
+	TokenStore& operator=(const TokenStore&) = delete;
+
+	inline ~TokenStore() {
+		TokenStoreChunk* chunks[2] = { first_chunk, first_kept_chunk };
+		for (TokenStoreChunk* chunk : chunks) {
+			while (chunk != NULL) {
+				TokenStoreChunk* next_chunk
+					= chunk->next_chunk;
+				delete chunk;
+				chunk = next_chunk;
+			}
+		}
+	};
+
+	/**
+	* Returns the slot the next appended token will
+	* occupy, opening a new chunk if the last is full.
+	* The slot is not counted until it is committed.
+	**/
+	inline TokenRef reserve()
+	{
+		if (last_chunk->count == TOKEN_STORE_CHUNK_TOKENS) {
+			TokenStoreChunk* chunk
+				= construct_chunk();
+			last_chunk->next_chunk = chunk;
+			last_chunk = chunk;
+			num_chunks++;
+		}
+		return TokenRef(last_chunk, last_chunk->count);
+	}
+
+	/**
+	* Counts the most recently reserved slot as part
+	* of the store.
+	**/
+	inline void commit()
+	{
+		last_chunk->count++;
+		size++;
+	}
+
+	/**
+	* Scatters a token's fields into a reserved slot.
+	**/
+	inline void write(
+		TokenRef const& slot,
+		Token    const& token)
+	{
+		TokenStoreChunk* const chunk
+			= (TokenStoreChunk*) slot.get_chunk();
+		const size_t index
+			= slot.get_index();
+		chunk->names[index]          = token.get_name();
+		chunk->forms[index]          = token.get_form();
+		chunk->constant_types[index] = token.get_constant_type();
+		chunk->constant_vals[index]  = token.get_constant_val();
+		TokenLocation& location
+			= chunk->locations[index];
+		location.lexeme   = token.get_lexeme();
+		location.location = token.get_location();
+		location.atom     = token.get_atom();
+	}
+
+	inline void push_back(
+		Token const& token)
+	{
+		write(reserve(), token);
+		commit();
+	}
+
+	/**
+	* Returns how many tokens have been appended, those
+	* released included.
+	**/
+	inline size_t get_size() const
+	{
+		return size;
+	}
+
+	/**
+	* Returns how many chunks of appended tokens are
+	* held, those released not included.
+	**/
+	inline size_t get_num_chunks() const
+	{
+		return num_chunks;
+	}
+
+	/**
+	* Copies a token into the chunks kept for the life
+	* of the store, so that it outlasts its own chunk.
+	*
+	* @param token The token to keep.
+	* @return Returns the kept copy.
+	**/
+	inline TokenRef keep(
+		TokenRef const& token)
+	{
+		if (last_kept_chunk == NULL
+			|| last_kept_chunk->count == TOKEN_STORE_CHUNK_TOKENS) {
+			TokenStoreChunk* chunk
+				= construct_chunk();
+			if (last_kept_chunk == NULL) {
+				first_kept_chunk = chunk;
+			} else {
+				last_kept_chunk->next_chunk = chunk;
+			}
+			last_kept_chunk = chunk;
+		}
+		const TokenStoreChunk* const from
+			= token.get_chunk();
+		const size_t i
+			= token.get_index();
+		TokenStoreChunk* const to
+			= last_kept_chunk;
+		const size_t j
+			= to->count++;
+		to->names[j]          = from->names[i];
+		to->forms[j]          = from->forms[i];
+		to->constant_types[j] = from->constant_types[i];
+		to->constant_vals[j]  = from->constant_vals[i];
+		to->locations[j]      = from->locations[i];
+		return TokenRef(to, j);
+	}
+
+	/**
+	* Frees the chunks wholly before a token. No token
+	* before it may be read afterwards, other than the
+	* copies kept.
+	*
+	* @param token The earliest token still to be read.
+	**/
+	inline void release_before(
+		TokenRef const& token)
+	{
+		while (first_chunk != token.get_chunk()
+			   && first_chunk != last_chunk) {
+			TokenStoreChunk* const next_chunk
+				= first_chunk->next_chunk;
+			delete first_chunk;
+			first_chunk = next_chunk;
+			num_chunks--;
+		}
+	}
+
+	/**
+	* Sets the source asked for more tokens when a
+	* cursor reaches the end of the store.
+	**/
+	inline void set_source(
+		SegmentedBufferSource const& s,
+		void*                 const& context)
+	{
+		source         = s;
+		source_context = context;
+	}
+
+	/**
+	* Asks the source for more tokens.
+	*
+	* @return Returns false if there is no source or
+	*		  the source has nothing left to append.
+	**/
+	inline bool pull() const
+	{
+		return source != NULL
+			   && source(source_context);
+	}
+
+	inline TokenStoreCursor begin();
+
+	inline TokenStoreAppender appender();
+};
+
+/**
+* Reads through a token store in order. Behaves like
+* a const pointer to the token it is at, so it may be
+* incremented, offset and dereferenced.
+**/
+class TokenStoreCursor {
+private:
+	TokenRef    token;
+	TokenStore* store;
+
+	inline void normalise()
+	{
+		const TokenStoreChunk* chunk
+			= token.get_chunk();
+		size_t index
+			= token.get_index();
+		while (index >= chunk->count) {
+			if (chunk->next_chunk != NULL) {
+				chunk = chunk->next_chunk;
+				index = 0;
+			} else if (store == NULL
+					   || !store->pull()) {
+				break;
+			}
+		}
+		token = TokenRef(chunk, index);
+	}
+
+public:
+	inline TokenStoreCursor()
+		: token(),
+		  store(NULL) {
+	};
+
+	inline TokenStoreCursor(
+		const TokenStoreChunk* const& c,
+		size_t                 const& i,
+		TokenStore*            const& s)
+		: token(c, i),
+		  store(s) {
+		normalise();
+	};
+
+	/**
+	* Keeps the token the cursor is at, as the store's
+	* keep does, for the ast to refer to.
+	**/
+	inline TokenRef keep() const
+	{
+		return store != NULL
+			   ? store->keep(token)
+			   : token;
+	}
+
+	/**
+	* Frees the chunks of the store wholly before the
+	* cursor, once nothing will backtrack behind it.
+	**/
+	inline void release_before() const
+	{
+		if (store != NULL) {
+			store->release_before(token);
+		}
+	}
+
+	inline const TokenRef& operator*() const
+	{
+		return token;
+	}
+
+	inline const TokenRef* operator->() const
+	{
+		return &token;
+	}
+
+	inline operator const TokenRef&() const
+	{
+		return token;
+	}
+
+	inline TokenStoreCursor& operator++()
+	{
+		token = TokenRef(
+			token.get_chunk(),
+			token.get_index() + 1);
+		normalise();
+		return *this;
+	}
+
+	inline TokenStoreCursor operator++(int)
+	{
+		TokenStoreCursor previous = *this;
+		++(*this);
+		return previous;
+	}
+
+	inline TokenStoreCursor& operator+=(
+		size_t const& n)
+	{
+		for (size_t i = 0; i < n; i++) {
+			++(*this);
+		}
+		return *this;
+	}
+
+	inline TokenStoreCursor operator+(
+		size_t const& n) const
+	{
+		TokenStoreCursor result = *this;
+		result += n;
+		return result;
+	}
+
+	inline bool operator==(
+		TokenStoreCursor const& other) const
+	{
+		return token.get_chunk() == other.token.get_chunk()
+			   && token.get_index() == other.token.get_index();
+	}
+
+	inline bool operator!=(
+		TokenStoreCursor const& other) const
+	{
+		return !(*this == other);
+	}
+};
+
+/**
+* The slot of a token store an appender writes to.
+* Assigning a Token to it scatters the token into
+* the store's arrays.
+**/
+class TokenStoreSlot {
+private:
+	TokenStore* store;
+	TokenRef    slot;
+public:
+	inline TokenStoreSlot(
+		TokenStore* const& s,
+		TokenRef    const& r)
+		: store(s),
+		  slot(r) {
+	};
+
+	inline TokenStoreSlot& operator=(
+		Token const& token)
+	{
+		store->write(slot, token);
+		return *this;
+	}
+};
+
+/**
+* Writes onto the end of a token store. Behaves like
+* an output pointer, so '*out++ = token' appends a
+* token.
+**/
+class TokenStoreAppender {
+private:
+	TokenStore* store;
+	TokenRef    slot;
+public:
+	inline TokenStoreAppender()
+		: store(NULL),
+		  slot() {
+	};
+
+	inline TokenStoreAppender(
+		TokenStore* const& s)
+		: store(s),
+		  slot(s->reserve()) {
+	};
+
+	inline TokenStoreSlot operator*() const
+	{
+		return TokenStoreSlot(store, slot);
+	}
+
+	inline TokenStoreAppender& operator++()
+	{
+		store->commit();
+		slot = store->reserve();
+		return *this;
+	}
+
+	inline TokenStoreAppender operator++(int)
+	{
+		TokenStoreAppender previous = *this;
+		++(*this);
+		return previous;
+	}
+
+	inline TokenStore* get_store() const
+	{
+		return store;
+	}
+};
+
+typedef TokenStore         TokenBuffer;
+typedef TokenStoreCursor   TokenCursor;
+typedef TokenStoreAppender TokenAppender;
+
+/*****************************************************//**
+*                         Definitions                    *
+/********************************************************/
+
+inline TokenStoreCursor TokenStore::begin()
+{
+	return TokenStoreCursor(first_chunk, 0, this);
+}
+
+inline TokenStoreAppender TokenStore::appender()
+{
+	return TokenStoreAppender(this);
+}
+
+#endif
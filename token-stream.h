@@ -0,0 +1,202 @@
+/* Authored by Charlie Keaney                      */
+/* token-stream.h - Responsible for streaming tokens
+					from the preprocessor, through
+					the lexer, into the parser as
+					the parser asks for them.
+
+					Implementation Notes:
+					The parser pulls tokens from a
+					TokenBuffer. When it runs off
+					the end, the buffer asks the
+					stream, which has the
+					preprocessor fill a ring of
+					preprocessing tokens as it
+					carries out the file's
+					directives, and lexes them from
+					it.
+
+					Only a ring of preprocessing
+					tokens lies between the two,
+					and the parser releases the
+					tokens behind where it may
+					backtrack to, so the tokens held
+					at once depend on how far the
+					parser looks ahead and back, not
+					on how long the file is.      */
+
+#ifndef TOKEN_STREAM_H
+#define TOKEN_STREAM_H 1
+
+#include "preprocessor.h"
+#include "lexer.h"
+#include "time-report.h"
+
+using namespace std;
+
+/*****************************************************//**
+*                      Declarations                      *
+/********************************************************/
+
+/**
+* Preprocesses and lexes into a TokenBuffer on demand,
+* finishing with the default (ERROR) token the parser
+* stops on.
+**/
+class TokenStream {
+private:
+	PreprocessorStream        pp_tokens;
+	PreprocessingTokenRing    ring;
+	PreprocessingTokenBuffer* recorded;
+	TokenBuffer*              tokens;
+	TokenAppender             output;
+	AlertList*                bkl;
+	TimeReport*               report;
+	LexerExitCode             exitcode;
+	bool                      finished;
+
+	static inline bool pull_tokens(
+		void* const& context)
+	{
+		return ((TokenStream*) context)->pull();
+	}
+
+public:
+	/**
+	* @param input The input from which to preprocess.
+	* @param lexema_pool The pool where lexema will be allocated.
+	* @param filename The input file name.
+	* @param sources The files of the compilation.
+	* @param includes The files included so far.
+	* @param t The buffer the parser reads tokens from.
+	* @param b The location to send alerts to.
+	* @param r The report to time each phase in, or NULL.
+	**/
+	inline TokenStream(
+		const char*  const& input,
+		LexemaPool        & lexema_pool,
+		const char*  const& filename,
+		SourceMap         & sources,
+		IncludeTable      & includes,
+		TokenBuffer* const& t,
+		AlertList*   const& b,
+		TimeReport*  const& r)
+		: pp_tokens(input, lexema_pool, filename, sources, includes, *b),
+		  ring(),
+		  recorded(NULL),
+		  tokens(t),
+		  output(t->appender()),
+		  bkl(b),
+		  report(r),
+		  exitcode(LexerExitCode::SUCCESS),
+		  finished(false) {
+		tokens->set_source(pull_tokens, this);
+	};
+
+	TokenStream(const TokenStream&) = delete;
+	TokenStream& operator=(const TokenStream&) = delete;
+
+	inline ~TokenStream() {
+		tokens->set_source(NULL, NULL);
+	};
+
+	/**
+	* Keeps a copy of each preprocessing token lexed
+	* from now on, so that they may be displayed.
+	*
+	* @param ppts The buffer to add the copies to.
+	**/
+	inline void record(
+		PreprocessingTokenBuffer* const& ppts)
+	{
+		recorded = ppts;
+	}
+
+	/**
+	* Preprocesses and lexes until at least one more
+	* token is in the buffer.
+	*
+	* @return Returns false once the stream has ended.
+	**/
+	inline bool pull()
+	{
+		if (finished) {
+			return false;
+		}
+		if (report) {
+			start_time_report_phase(*report, TimeReportPhase::LEX);
+		}
+		const size_t initial_size
+			= tokens->get_size();
+		while (tokens->get_size() == initial_size) {
+			if (ring.is_empty()) {
+				if (report) {
+					start_time_report_phase(*report, TimeReportPhase::PREPROCESS);
+				}
+				pp_tokens.fill(ring);
+				if (report) {
+					finish_time_report_phase(
+						*report,
+						TimeReportPhase::PREPROCESS,
+						pp_tokens.get_num_pp_tokens());
+				}
+			}
+			if (ring.is_empty()) {
+				/* The parser stops on the default (ERROR) token. */
+				*output++ = Token();
+				finished = true;
+				break;
+			}
+			while (!ring.is_empty()) {
+				const PreprocessingToken& pp_token
+					= ring.front();
+				if (recorded) {
+					recorded->push_back(pp_token);
+				}
+				if (lex_preprocessing_token(
+						&pp_token,
+						output,
+						*bkl)
+					!= LexerExitCode::SUCCESS) {
+					exitcode = LexerExitCode::FAILURE;
+
+				} else if (pp_token.get_name()
+						   == PreprocessingTokenName::END_OF_FILE) {
+					exitcode = LexerExitCode::SUCCESS;
+				}
+				ring.pop();
+			}
+		}
+		if (report) {
+			finish_time_report_phase(
+				*report,
+				TimeReportPhase::LEX,
+				tokens->get_size() - (finished ? 1 : 0));
+		}
+		return true;
+	}
+
+	/**
+	* Preprocesses and lexes everything left in the stream.
+	**/
+	inline void drain()
+	{
+		while (pull()) { }
+	}
+
+	inline LexerExitCode get_exitcode() const
+	{
+		return exitcode;
+	}
+
+	inline PreprocessorExitCode get_pp_exitcode() const
+	{
+		return pp_tokens.get_exitcode();
+	}
+
+	inline size_t get_num_pp_tokens() const
+	{
+		return pp_tokens.get_num_pp_tokens();
+	}
+};
+
+#endif
@@ -5,8 +5,10 @@
 #ifndef TOKEN_H
 #define TOKEN_H 1
 
+#include <cstdint>
 #include <iostream>
-#include "preprocessing-token.h"
+
+#include "file-location.h"
 
 #define NUM_TOKEN_NAMES 6
 
@@ -16,7 +18,7 @@
 
 using namespace std;
 
-enum class TokenName {
+enum class TokenName : uint8_t {
 	KEYWORD = 0,
 	IDENTIFIER,
 	CONSTANT,
@@ -37,7 +39,7 @@ const char* token_name_string_reprs[] {
 #define token_name_string(p) \
 		token_name_string_reprs[(int) p]
 
-enum class TokenForm {
+enum class TokenForm : uint8_t {
 	/* Mark as no specific form */
 	SIMPLE = 0,
 	/* KEYWORD */
@@ -245,25 +247,64 @@ const char* token_form_string_reprs[] {
 #define token_form_string(p) \
 		token_form_string_reprs[(int) p]
 
+/* The type C gives a constant, by its suffix and, for
+   an integer, the value it must be able to hold.    */
+enum class ConstantType : uint8_t {
+	NONE = 0,
+	INT,
+	UNSIGNED_INT,
+	LONG,
+	UNSIGNED_LONG,
+	LONG_LONG,
+	UNSIGNED_LONG_LONG,
+	FLOAT,
+	DOUBLE,
+	LONG_DOUBLE
+};
+
+
+/* The value of a constant. Which member holds it
+   follows from its ConstantType: integers of every
+   type are held in integervalue, float constants in
+   floatvalue and any other floating constant in
+   doublevalue.                                   */
 typedef union TokenValue {
-	float floatvalue;
-	int   intvalue;
+	uint64_t integervalue;
+	double   doublevalue;
+	float    floatvalue;
 } TokenValue;
 
+/**
+* What a token is, apart from where it is and how it
+* is spelt. The preprocessor works this out once for
+* each pp-token, so the lexer need only copy it.
+**/
+struct TokenClassification {
+	TokenName    name;
+	TokenForm    form;
+	ConstantType type;
+	TokenValue   value;
+};
+
 class Token {
 private:
 	TokenName              name;
 	TokenForm              form;
+	ConstantType           constant_type;
+	uint32_t               atom;
 	TokenValue             val;
 	const char*            lexeme;
-	FileLocationDescriptor file_descriptor;
+	SourceLocation         location;
 	
 public:
 	inline Token() {
 		name = TokenName::ERROR;
 		form = TokenForm::SIMPLE;
+		constant_type = ConstantType::NONE;
 		val = { };
 		lexeme = NULL;
+		location = construct_source_location();
+		atom = 0;
 	};
 
 	inline Token(
@@ -271,12 +312,29 @@ public:
 		TokenForm              const& f,
 		TokenValue             const& v,
 		const char*            const& l,
-		FileLocationDescriptor const& fld)
+		SourceLocation         const& loc,
+		uint32_t               const& a = 0)
 		: name(n), 
 		  form(f), 
+		  constant_type(ConstantType::NONE),
+		  atom(a),
 		  val(v), 
 		  lexeme(l),
-		  file_descriptor(fld) {
+		  location(loc) {
+	}
+
+	inline Token(
+		TokenClassification    const& c,
+		const char*            const& l,
+		SourceLocation         const& loc,
+		uint32_t               const& a = 0)
+		: name(c.name),
+		  form(c.form),
+		  constant_type(c.type),
+		  atom(a),
+		  val(c.value),
+		  lexeme(l),
+		  location(loc) {
 	}
 
 	inline TokenName get_name() const {    
@@ -291,28 +349,66 @@ public:
 		return lexeme; 
 	}
 
+	/**
+	* Returns the atom of the lexeme in its lexema pool,
+	* which identifies it as well as the lexeme does.
+	**/
+	inline uint32_t get_atom() const {
+		return atom;
+	}
+
 	inline TokenValue get_constant_val() const {    
 		return val;	   
 	}
 
-	inline FileLocationDescriptor get_file_descriptor() const {
-		return file_descriptor;
+	inline ConstantType get_constant_type() const {
+		return constant_type;
+	}
+
+	inline SourceLocation get_location() const {
+		return location;
 	}
 
-	inline void print() const
+	inline void print(
+		ostream& out = cout) const
 	{
 		const char* name_str
 			= token_name_string(name);
 		const char* form_str
 			= token_form_string(form);
-		cout << "<Token={"
-			 << lexeme
-			 << ","
-			 << name_str
-			 << ","
-			 << form_str
-			 << "}>";
+		out << "<Token={"
+			<< lexeme
+			<< ","
+			<< name_str
+			<< ","
+			<< form_str
+			<< "}>";
 	}
 };
 
+/**
+* Constructs the classification of a token not yet
+* classified, which the lexer must lex from its text.
+*
+* @return Returns the classification.
+**/
+static inline
+TokenClassification construct_token_classification();
+
+/*****************************************************//**
+*                         Definitions                    *
+/********************************************************/
+
+static inline
+TokenClassification construct_token_classification()
+{
+	TokenClassification classification = {
+		TokenName::ERROR,
+		TokenForm::SIMPLE,
+		ConstantType::NONE,
+		{ 0 }
+	};
+	return classification;
+}
+
 #endif
\ No newline at end of file
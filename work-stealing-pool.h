@@ -0,0 +1,208 @@
+/* Authored by Charlie Keaney                          */
+/* work-stealing-pool.h - Responsible for running a
+						  batch of independent jobs
+						  across several worker
+						  threads.
+
+						  Implementation Notes:
+						  Each worker owns a queue of
+						  job indices. A worker takes
+						  work from the back of its
+						  own queue and, once that is
+						  empty, steals from the front
+						  of the other workers' queues,
+						  so uneven jobs (a few large
+						  files amongst many small
+						  ones) still keep every
+						  worker busy. The calling
+						  thread acts as worker 0.    */
+
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H 1
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+/*****************************************************//**
+*                      Declarations                      *
+/********************************************************/
+
+/**
+* The function run for each job.
+*
+* @param job_index The index of the job to run.
+* @param context The context given to the pool.
+**/
+typedef void (*WorkStealingPoolJob)(
+	size_t const& job_index,
+	void*  const& context);
+
+struct WorkStealingQueue {
+	mutex         lock;
+	deque<size_t> job_indices;
+};
+
+/**
+* Runs jobs 0 to num_jobs - 1 across num_workers
+* workers, returning once every job has finished.
+*
+* @param num_jobs The number of jobs to run.
+* @param num_workers The number of workers to run them on.
+* @param job The function run for each job.
+* @param context The context passed to each job.
+**/
+static inline
+void run_work_stealing_pool(
+	size_t              const& num_jobs,
+	size_t              const& num_workers,
+	WorkStealingPoolJob const& job,
+	void*               const& context);
+
+/**
+* Finds the next job for a worker, either from its
+* own queue or by stealing from another worker.
+*
+* @param queues The queues of every worker.
+* @param num_workers The number of workers.
+* @param worker_index The worker looking for a job.
+* @param job_index The found job.
+* @return Returns true if a job was found.
+**/
+static inline
+bool take_work_stealing_job(
+	WorkStealingQueue* const& queues,
+	size_t             const& num_workers,
+	size_t             const& worker_index,
+	size_t                  & job_index);
+
+/**
+* Runs jobs for a worker until no work is left in
+* any queue.
+*
+* @param queues The queues of every worker.
+* @param num_workers The number of workers.
+* @param worker_index The worker to run as.
+* @param job The function run for each job.
+* @param context The context passed to each job.
+**/
+static inline
+void run_work_stealing_worker(
+	WorkStealingQueue*  const& queues,
+	size_t              const& num_workers,
+	size_t              const& worker_index,
+	WorkStealingPoolJob const& job,
+	void*               const& context);
+
+/*****************************************************//**
+*                         Definitions                    *
+/********************************************************/
+
+static inline
+bool take_work_stealing_job(
+	WorkStealingQueue* const& queues,
+	size_t             const& num_workers,
+	size_t             const& worker_index,
+	size_t                  & job_index)
+{
+	/* Prefer our own most recently queued job. */
+	{
+		WorkStealingQueue& own
+			= queues[worker_index];
+		lock_guard<mutex> guard(own.lock);
+		if (!own.job_indices.empty()) {
+			job_index = own.job_indices.back();
+			own.job_indices.pop_back();
+			return true;
+		}
+	}
+	/* Otherwise steal the oldest job of another worker. */
+	for (size_t i = 1; i < num_workers; i++) {
+		WorkStealingQueue& victim
+			= queues[(worker_index + i) % num_workers];
+		lock_guard<mutex> guard(victim.lock);
+		if (!victim.job_indices.empty()) {
+			job_index = victim.job_indices.front();
+			victim.job_indices.pop_front();
+			return true;
+		}
+	}
+	return false;
+}
+
+static inline
+void run_work_stealing_worker(
+	WorkStealingQueue*  const& queues,
+	size_t              const& num_workers,
+	size_t              const& worker_index,
+	WorkStealingPoolJob const& job,
+	void*               const& context)
+{
+	size_t job_index = 0;
+	while (take_work_stealing_job(
+			   queues,
+			   num_workers,
+			   worker_index,
+			   job_index)) {
+		job(job_index, context);
+	}
+}
+
+static inline
+void run_work_stealing_pool(
+	size_t              const& num_jobs,
+	size_t              const& num_workers,
+	WorkStealingPoolJob const& job,
+	void*               const& context)
+{
+	size_t workers
+		= num_workers;
+	if (workers > num_jobs) {
+		workers = num_jobs;
+	}
+	if (workers <= 1) {
+		for (size_t i = 0; i < num_jobs; i++) {
+			job(i, context);
+		}
+		return;
+	}
+
+	/* Deal the jobs out in contiguous runs, queued in
+	   reverse so each worker starts on its earliest. */
+	WorkStealingQueue* queues
+		= new WorkStealingQueue[workers];
+	for (size_t i = 0; i < num_jobs; i++) {
+		const size_t owner
+			= i * workers / num_jobs;
+		queues[owner].job_indices.push_front(i);
+	}
+
+	thread* threads
+		= new thread[workers - 1];
+	for (size_t w = 1; w < workers; w++) {
+		threads[w - 1] = thread(
+			run_work_stealing_worker,
+			queues,
+			workers,
+			w,
+			job,
+			context);
+	}
+	run_work_stealing_worker(
+		queues,
+		workers,
+		0,
+		job,
+		context);
+	for (size_t w = 1; w < workers; w++) {
+		threads[w - 1].join();
+	}
+
+	delete[] threads;
+	delete[] queues;
+}
+
+#endif